@@ -0,0 +1,114 @@
+#include "bench.hpp"
+#include "../src/animationclip.hpp"
+#include "../src/jobsystem.hpp"
+#include <cmath>
+
+namespace dxna::bench {
+	//A walk-like clip: every bone sways on all three tracks at 30 keys a second.
+	static AnimationClip CreateClip(uintcs bones, float seconds, float tolerance, bool quantize) {
+		const auto keys = static_cast<size_t>(seconds * 30.0F) + 1;
+		std::vector<float> times(keys);
+		std::vector<Vector3> translations(keys);
+		std::vector<Quaternion> rotations(keys);
+		std::vector<Vector3> scales(keys, Vector3::One());
+		AnimationClipBuilder builder(seconds);
+
+		for (uintcs bone = 0; bone < bones; ++bone) {
+			const auto phase = static_cast<float>(bone) * 0.37F;
+
+			for (size_t i = 0; i < keys; ++i) {
+				const auto time = static_cast<float>(i) / 30.0F;
+
+				times[i] = time;
+				translations[i] = Vector3(std::sin(time * 2.0F + phase) * 0.1F, 1.0F, 0.0F);
+				rotations[i] = Quaternion::CreateFromYawPitchRoll(std::sin(time * 3.0F + phase) * 0.5F, std::cos(time * 2.0F + phase) * 0.3F, 0.0F);
+			}
+
+			builder.AddTrack(bone, AnimationTrackType::Translation, times, translations, tolerance);
+			builder.AddTrack(bone, times, rotations, tolerance, quantize);
+			builder.AddTrack(bone, AnimationTrackType::Scale, times, scales, tolerance);
+		}
+
+		AnimationClip clip;
+		builder.Build(clip);
+		return clip;
+	}
+
+	void AnimationBenchmarks(Runner& runner) {
+		constexpr uintcs Bones = 60;
+		constexpr size_t Characters = 200;
+		constexpr float FrameTime = 1.0F / 60.0F;
+
+		const auto raw = CreateClip(Bones, 4.0F, 0.0F, false);
+		const auto walk = CreateClip(Bones, 4.0F, 0.001F, true);
+		const auto wave = CreateClip(Bones, 2.5F, 0.001F, true);
+
+		std::vector<AnimationPose> poses(Characters, AnimationPose(Bones));
+		std::vector<AnimationCursor> cursors(Characters * 2);
+		std::vector<AnimationLayer> layers(Characters * 2);
+		std::vector<AnimationInstance> instances(Characters);
+
+		//Every character plays the walk with a wave blended over it, at its own time.
+		for (size_t i = 0; i < Characters; ++i) {
+			const auto start = static_cast<float>(i) * 0.013F;
+
+			layers[i * 2] = { &walk, &cursors[i * 2], start, 1.0F, true };
+			layers[i * 2 + 1] = { &wave, &cursors[i * 2 + 1], start, 0.5F, true };
+			instances[i] = { std::span<AnimationLayer const>(layers).subspan(i * 2, 2), &poses[i] };
+		}
+
+		const auto advance = [&] {
+			for (auto& layer : layers)
+				layer.Time += FrameTime;
+		};
+
+		const auto& result = runner.Run("SampleAnimation 200 characters, 2 layers", Characters, advance, [&] {
+			SampleAnimation(instances);
+			DoNotOptimize(poses[0].Rotations[0]);
+		});
+
+		if (result.Repetitions > 0)
+			std::printf("  %-46s %10zu bytes raw %8zu bytes compressed\n", "clip size", raw.SizeInBytes(), walk.SizeInBytes());
+
+		runner.Run("SampleAnimation 200 characters, no cursors", Characters, advance, [&] {
+			for (auto& layer : layers)
+				layer.Cursor = nullptr;
+
+			SampleAnimation(instances);
+			DoNotOptimize(poses[0].Rotations[0]);
+		});
+
+		for (size_t i = 0; i < layers.size(); ++i)
+			layers[i].Cursor = &cursors[i];
+
+		JobSystem jobs;
+
+		runner.Run("SampleAnimation 200 characters, jobs", Characters, advance, [&] {
+			SampleAnimation(instances, &jobs);
+			DoNotOptimize(poses[0].Rotations[0]);
+		});
+
+		runner.Run("AnimationClip::Sample raw keys 200 characters", Characters, advance, [&] {
+			for (size_t i = 0; i < Characters; ++i)
+				raw.Sample(std::fmod(layers[i * 2].Time, raw.Duration()), cursors[i * 2], poses[i]);
+
+			DoNotOptimize(poses[0].Rotations[0]);
+		});
+
+		cs::MemoryStream stream(static_cast<size_t>(walk.SizeInBytes()));
+		cs::BinaryWriter writer(&stream);
+		walk.Write(writer);
+
+		AnimationClip loaded;
+
+		runner.Run("AnimationClip::Load zero-copy", 1, [&] { stream.Position(0); }, [&] {
+			AnimationClip::Load(stream, loaded);
+			DoNotOptimize(loaded.TrackCount());
+		});
+
+		runner.Run("AnimationClip::Read copy", 1, [&] { stream.Position(0); }, [&] {
+			AnimationClip::Read(stream, loaded);
+			DoNotOptimize(loaded.TrackCount());
+		});
+	}
+}
\ No newline at end of file
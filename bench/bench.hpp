@@ -0,0 +1,189 @@
+#ifndef DXNA_BENCH_BENCH_HPP
+#define DXNA_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+
+namespace dxna::bench {
+	struct BenchmarkResult {
+		std::string Name;
+		size_t Items{ 0 };
+		size_t Repetitions{ 0 };
+		double MinNanoseconds{ 0 };
+		double MedianNanoseconds{ 0 };
+
+		double NanosecondsPerItem() const {
+			return Items == 0 ? MedianNanoseconds : MedianNanoseconds / static_cast<double>(Items);
+		}
+	};
+
+	//Keeps the compiler from discarding a computed value.
+	template <typename T>
+	inline void DoNotOptimize(T const& value) {
+		static volatile unsigned char sink = 0;
+		sink = sink + *reinterpret_cast<const volatile unsigned char*>(&value);
+	}
+
+	//Runs each benchmark once to warm up, then a fixed number of timed repetitions,
+	//and reports the median so a single slow run does not skew the result.
+	class Runner {
+	public:
+		Runner(size_t repetitions = 15) : _repetitions(repetitions < 1 ? 1 : repetitions) {}
+
+		//Only the benchmarks whose name contains the filter are run. Empty runs all.
+		void Filter(std::string const& value) { _filter = value; }
+
+		template <typename TSetup, typename TFunc>
+		BenchmarkResult const& Run(std::string const& name, size_t items, TSetup&& setup, TFunc&& func) {
+			using clock = std::chrono::steady_clock;
+
+			//Skipped benchmarks report zero repetitions and are not kept.
+			if (!_filter.empty() && name.find(_filter) == std::string::npos) {
+				_skipped = BenchmarkResult();
+				_skipped.Name = name;
+				return _skipped;
+			}
+
+			std::vector<double> samples(_repetitions);
+
+			setup();
+			func();
+
+			for (size_t i = 0; i < _repetitions; ++i) {
+				setup();
+
+				const auto start = clock::now();
+				func();
+				const auto end = clock::now();
+
+				samples[i] = std::chrono::duration<double, std::nano>(end - start).count();
+			}
+
+			std::sort(samples.begin(), samples.end());
+
+			BenchmarkResult result;
+			result.Name = name;
+			result.Items = items;
+			result.Repetitions = _repetitions;
+			result.MinNanoseconds = samples.front();
+			result.MedianNanoseconds = samples[samples.size() / 2];
+
+			std::printf("%-48s %12.3f ms %10.2f ns/item\n",
+				name.c_str(), result.MedianNanoseconds / 1e6, result.NanosecondsPerItem());
+
+			_results.push_back(result);
+			return _results.back();
+		}
+
+		template <typename TFunc>
+		BenchmarkResult const& Run(std::string const& name, size_t items, TFunc&& func) {
+			return Run(name, items, [] {}, func);
+		}
+
+		std::vector<BenchmarkResult> const& Results() const { return _results; }
+
+		//Writes the results as JSON, one object per benchmark, so runs of different
+		//releases can be compared by name. Returns false if the file cannot be written.
+		bool WriteJson(std::string const& path) const {
+			auto file = std::fopen(path.c_str(), "w");
+
+			if (file == nullptr)
+				return false;
+
+			std::fprintf(file, "{\n\t\"context\": {\n");
+			std::fprintf(file, "\t\t\"date\": %lld,\n", static_cast<long long>(std::time(nullptr)));
+			std::fprintf(file, "\t\t\"compiler\": \"%s\",\n", escape(Compiler()).c_str());
+			std::fprintf(file, "\t\t\"repetitions\": %zu\n\t},\n", _repetitions);
+			std::fprintf(file, "\t\"benchmarks\": [");
+
+			for (size_t i = 0; i < _results.size(); ++i) {
+				const auto& result = _results[i];
+
+				std::fprintf(file, "%s\n\t\t{ \"name\": \"%s\", \"items\": %zu, \"repetitions\": %zu, "
+					"\"min_ns\": %.1f, \"median_ns\": %.1f, \"ns_per_item\": %.4f }",
+					i == 0 ? "" : ",", escape(result.Name).c_str(), result.Items, result.Repetitions,
+					result.MinNanoseconds, result.MedianNanoseconds, result.NanosecondsPerItem());
+			}
+
+			std::fprintf(file, "\n\t]\n}\n");
+			return std::fclose(file) == 0;
+		}
+
+		static std::string Compiler() {
+#if defined(__clang__)
+			return "clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+			return "unknown";
+#endif
+		}
+
+	private:
+		static std::string escape(std::string const& value) {
+			std::string result;
+
+			for (const auto c : value) {
+				if (c == '"' || c == '\\')
+					result.push_back('\\');
+
+				result.push_back(c);
+			}
+
+			return result;
+		}
+
+		size_t _repetitions{ 15 };
+		std::string _filter;
+		std::vector<BenchmarkResult> _results;
+		BenchmarkResult _skipped;
+	};
+
+	//Small deterministic generator, so every run measures the same data.
+	struct Random {
+		uint64_t State{ 0x9E3779B97F4A7C15ULL };
+
+		constexpr Random() = default;
+		constexpr Random(uint64_t seed) : State(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+		constexpr uint64_t Next() {
+			State ^= State << 13;
+			State ^= State >> 7;
+			State ^= State << 17;
+			return State;
+		}
+
+		constexpr uint32_t Next(uint32_t max) {
+			return static_cast<uint32_t>(Next() % max);
+		}
+
+		constexpr float NextFloat() {
+			return static_cast<float>(Next() >> 40) / static_cast<float>(1 << 24);
+		}
+	};
+
+	void RenderQueueBenchmarks(Runner& runner);
+	void SpriteBatchBenchmarks(Runner& runner);
+	void SoftwareBackendBenchmarks(Runner& runner);
+	void TextureBenchmarks(Runner& runner);
+	void JobSystemBenchmarks(Runner& runner);
+	void GameBenchmarks(Runner& runner);
+	void ProfilerBenchmarks(Runner& runner);
+	void MathBenchmarks(Runner& runner);
+	void IOBenchmarks(Runner& runner);
+	void EffectBenchmarks(Runner& runner);
+	void AnimationBenchmarks(Runner& runner);
+	void InputBenchmarks(Runner& runner);
+	void EventBenchmarks(Runner& runner);
+	void MemoryArenaBenchmarks(Runner& runner);
+	void ResourceBenchmarks(Runner& runner);
+}
+
+#endif
\ No newline at end of file
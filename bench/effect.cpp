@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "../src/graphics/effect.hpp"
+#include "../src/cs/binary.hpp"
+
+using namespace cs;
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	//The section readers and ConstantBuffer::Update are private to the effect; this friend
+	//reaches them so they can be timed without a full effect blob.
+	struct EffectAccess {
+		static EffectParameterCollectionPtr ReadParameters(BinaryReader& reader) {
+			return Effect::ReadParameters(reader);
+		}
+
+		static void Update(ConstantBuffer& buffer, EffectParameterCollection& parameters) {
+			buffer.Update(parameters);
+		}
+
+		static bytecs FirstByte(ConstantBuffer const& buffer) {
+			return buffer._buffer->at(0);
+		}
+	};
+
+	//Writes a MGFX parameter section: a world-view-projection style set of
+	//matrices, vectors and scalars, all floats.
+	static void WriteParameters(BinaryWriter& writer, intcs count) {
+		writer.Write(count);
+
+		for (intcs i = 0; i < count; ++i) {
+			const auto isMatrix = i % 4 == 0;
+			const auto isScalar = i % 4 == 3;
+			const auto rows = static_cast<bytecs>(isMatrix ? 4 : 1);
+			const auto columns = static_cast<bytecs>(isScalar ? 1 : 4);
+
+			writer.Write(static_cast<bytecs>(isMatrix ? EffectParameterClass::Matrix
+				: (isScalar ? EffectParameterClass::Scalar : EffectParameterClass::Vector)));
+			writer.Write(static_cast<bytecs>(EffectParameterType::Single));
+			writer.Write("Parameter" + std::to_string(i));
+			writer.Write(std::string());
+			//Annotations, elements and structure members.
+			writer.Write(static_cast<intcs>(0));
+			writer.Write(rows);
+			writer.Write(columns);
+			writer.Write(static_cast<intcs>(0));
+			writer.Write(static_cast<intcs>(0));
+
+			for (intcs j = 0; j < rows * columns; ++j)
+				writer.Write(static_cast<float>(i + j));
+		}
+	}
+
+	void EffectBenchmarks(Runner& runner) {
+		constexpr intcs ParameterCount = 64;
+
+		MemoryStream stream(4096);
+		BinaryWriter writer(&stream);
+		WriteParameters(writer, ParameterCount);
+
+		BinaryReader reader(&stream);
+
+		runner.Run("Effect::ReadParameters 64", ParameterCount, [&] { stream.Seek(0, SeekOrigin::Begin); }, [&] {
+			const auto parameters = EffectAccess::ReadParameters(reader);
+			DoNotOptimize(parameters);
+		});
+
+		stream.Seek(0, SeekOrigin::Begin);
+		const auto parameters = EffectAccess::ReadParameters(reader);
+
+		//One buffer holding every parameter, each starting on a 16-byte register.
+		auto indexes = NewVector<intcs>(ParameterCount);
+		auto offsets = NewVector<intcs>(ParameterCount);
+		intcs size = 0;
+
+		for (intcs i = 0; i < ParameterCount; ++i) {
+			indexes->at(i) = i;
+			offsets->at(i) = size;
+			size += parameters->At(i)->RowCount * 16;
+		}
+
+		ConstantBuffer buffer(nullptr, size, indexes, offsets, "Parameters");
+
+		runner.Run("ConstantBuffer::Update 64 changed", ParameterCount, [&] {
+			for (intcs i = 0; i < ParameterCount; ++i)
+				parameters->At(i)->StateKey = EffectParameter::NextStateKey++;
+		}, [&] {
+			EffectAccess::Update(buffer, *parameters);
+			DoNotOptimize(EffectAccess::FirstByte(buffer));
+		});
+
+		runner.Run("ConstantBuffer::Update 64 unchanged", ParameterCount, [&] {
+			EffectAccess::Update(buffer, *parameters);
+			DoNotOptimize(EffectAccess::FirstByte(buffer));
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "bench.hpp"
+#include "../src/cs/eventqueue.hpp"
+#include "../src/eventbus.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dxna::bench {
+	struct Sender {
+		size_t Value{ 0 };
+	};
+
+	struct HitArgs : cs::EventArgs {
+		size_t Target{ 0 };
+		float Damage{ 0 };
+	};
+
+	static size_t functionHits = 0;
+
+	static void onHit(Sender const&, HitArgs const& e) {
+		functionHits += e.Target;
+	}
+
+	struct Listener {
+		size_t Total{ 0 };
+
+		void OnHit(Sender const& sender, HitArgs const& e) {
+			Total += e.Target + sender.Value;
+		}
+	};
+
+	void EventBenchmarks(Runner& runner) {
+		constexpr size_t EventCount = 100000;
+
+		Sender sender;
+		Listener listener;
+		size_t captured = 0;
+		float damage = 0;
+
+		//Eight handlers: function pointers, capturing lambdas and a member function.
+		cs::EventHandler<Sender, HitArgs> hit;
+
+		for (size_t i = 0; i < 3; ++i)
+			hit += onHit;
+
+		for (size_t i = 0; i < 4; ++i)
+			hit.Subscribe([&captured, &damage](HitArgs const& e) { captured += e.Target; damage += e.Damage; });
+
+		hit.Subscribe(&listener, &Listener::OnHit);
+
+		runner.Run("EventHandler::Invoke 8 handlers 100k", EventCount, [&] {
+			HitArgs e;
+
+			for (size_t i = 0; i < EventCount; ++i) {
+				e.Target = i;
+				hit.Invoke(sender, e);
+			}
+
+			DoNotOptimize(captured);
+		});
+
+		//The events of an update, raised as they happen and dispatched at its end.
+		cs::EventQueue queue;
+		cs::EventHandler<Sender, cs::EventArgs> spawned;
+		size_t spawnCount = 0;
+
+		spawned.Subscribe([&spawnCount] { ++spawnCount; });
+
+		runner.Run("EventQueue::Raise+Dispatch 100k", EventCount, [&] {
+			HitArgs e;
+
+			for (size_t i = 0; i < EventCount; ++i) {
+				e.Target = i;
+				queue.Raise(hit, sender, e);
+
+				if ((i & 7) == 0)
+					queue.Raise(spawned, sender, cs::EventArgs::Empty());
+			}
+
+			queue.Dispatch();
+			DoNotOptimize(spawnCount);
+		});
+
+		//Four worker threads raising while the game thread drains, as Game::Tick does.
+		constexpr size_t ThreadCount = 4;
+
+		EventBus bus;
+
+		runner.Run("EventBus 4 threads 100k", EventCount, [&] {
+			std::atomic<size_t> running{ ThreadCount };
+			std::vector<std::thread> threads;
+
+			for (size_t t = 0; t < ThreadCount; ++t) {
+				threads.emplace_back([&] {
+					HitArgs e;
+
+					for (size_t i = 0; i < EventCount / ThreadCount; ) {
+						e.Target = i;
+
+						if (bus.Raise(hit, sender, e))
+							++i;
+						else
+							std::this_thread::yield();
+					}
+
+					--running;
+				});
+			}
+
+			while (running > 0) {
+				if (bus.Drain() == 0)
+					std::this_thread::yield();
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+
+			bus.Drain();
+			DoNotOptimize(captured);
+		});
+
+		const auto& statistics = bus.Statistics<Sender, HitArgs>();
+
+		if (statistics.Dispatched > 0)
+			std::printf("  %-46s %10.2f us p50 %8.2f us p99 %8llu dropped\n", "EventBus latency",
+				statistics.LatencyPercentile(0.5) / 1000.0, statistics.LatencyPercentile(0.99) / 1000.0,
+				static_cast<unsigned long long>(statistics.Dropped));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "bench.hpp"
+#include "../src/game.hpp"
+#include "../src/headlessgamewindow.hpp"
+
+namespace dxna::bench {
+	//Busy work standing in for a CPU-bound Update or Draw.
+	static void spin(std::chrono::microseconds duration) {
+		const auto end = std::chrono::steady_clock::now() + duration;
+
+		while (std::chrono::steady_clock::now() < end) {}
+	}
+
+	class PipelineGame : public Game {
+	public:
+		static constexpr int FrameCount = 60;
+
+		PipelineGame(bool useRenderThread) {
+			IsFixedTimeStep(false);
+			UseRenderThread(useRenderThread);
+		}
+
+		~PipelineGame() override {
+			Shutdown();
+		}
+
+	protected:
+		void Update(GameTime const&) override {
+			spin(std::chrono::microseconds(1000));
+
+			if (++_frames == FrameCount)
+				Exit();
+		}
+
+		void Draw(GameTime const&) override {
+			spin(std::chrono::microseconds(1000));
+		}
+
+	private:
+		int _frames{ 0 };
+	};
+
+	//An empty game on a headless window without vsync, toggling the focus and the size
+	//now and then, to measure what the loop itself costs per frame.
+	class HeadlessGame : public Game {
+	public:
+		static constexpr int FrameCount = 10000;
+
+		HeadlessGame() : _window(std::make_shared<HeadlessGameWindow>()) {
+			IsFixedTimeStep(false);
+			_window->VSync(false);
+			_window->ClientSizeChanged.Subscribe([this] { ++_resizes; });
+			Window(_window);
+		}
+
+		int Resizes() const { return _resizes; }
+		int Deactivations() const { return _deactivations; }
+
+	protected:
+		void Update(GameTime const&) override {
+			if (++_frames == FrameCount)
+				Exit();
+
+			if (_frames % 100 == 0) {
+				_window->Deactivate();
+				_window->ClientBounds(Rectangle(0, 0, 800 + _frames % 200, 600));
+			}
+			else if (_frames % 100 == 50) {
+				_window->Activate();
+			}
+		}
+
+		void OnDeactivated() override {
+			++_deactivations;
+		}
+
+	private:
+		std::shared_ptr<HeadlessGameWindow> _window;
+		int _frames{ 0 };
+		int _resizes{ 0 };
+		int _deactivations{ 0 };
+	};
+
+	void GameBenchmarks(Runner& runner) {
+		//Update and Draw take 1 ms each, pipelining them can halve the frame time with two cores.
+		runner.Run("Game::Run 60 frames, synchronous draw", PipelineGame::FrameCount, [] {
+			PipelineGame game(false);
+			game.Run();
+		});
+
+		runner.Run("Game::Run 60 frames, render thread", PipelineGame::FrameCount, [] {
+			PipelineGame game(true);
+			game.Run();
+		});
+
+		const auto& headless = runner.Run("Game::Run headless no vsync 10k frames", HeadlessGame::FrameCount, [] {
+			HeadlessGame game;
+			game.Run();
+			DoNotOptimize(game.Resizes() + game.Deactivations());
+		});
+
+		if (headless.Repetitions > 0)
+			std::printf("  %-46s %12.0f frames/s\n", "headless throughput", 1e9 / headless.NanosecondsPerItem());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "bench.hpp"
+#include "../src/input/input.hpp"
+#include "../src/input/inputrecorder.hpp"
+#include "../src/input/actionmap.hpp"
+#include "../src/game.hpp"
+#include <thread>
+
+using namespace dxna::input;
+
+namespace dxna::bench {
+	//Reads the input every update, as gameplay code does.
+	class ReplayGame : public Game {
+	protected:
+		void Update(GameTime const&) override {
+			_keys += Keyboard::GetState().GetPressedKeyCount();
+			_x += Mouse::GetState().X;
+		}
+
+	private:
+		size_t _keys{ 0 };
+		longcs _x{ 0 };
+	};
+
+	void InputBenchmarks(Runner& runner) {
+		constexpr size_t EventCount = 1000000;
+
+		InputEventQueue queue;
+		InputFrame frame;
+
+		//A window thread typing while the game thread builds frames of 64 events.
+		runner.Run("InputEventQueue producer thread 1M", EventCount, [&] {
+			std::thread producer([&] {
+				for (size_t i = 0; i < EventCount; ) {
+					if (queue.Push(InputEvent::Key(static_cast<Keys>(i & 255), (i & 1) == 0, static_cast<longcs>(i))))
+						++i;
+					else
+						std::this_thread::yield();
+				}
+			});
+
+			size_t consumed = 0;
+
+			while (consumed < EventCount) {
+				frame.Update(queue, static_cast<longcs>(consumed + 63));
+				consumed += frame.Events().size();
+
+				//Lets the producer run when both share a core.
+				if (frame.Events().empty())
+					std::this_thread::yield();
+			}
+
+			producer.join();
+			DoNotOptimize(frame.IsKeyDown(Keys::A));
+		});
+
+		runner.Run("InputFrame::Apply 1M", EventCount, [&] {
+			frame.Clear();
+
+			for (size_t i = 0; i < EventCount; ++i)
+				frame.Apply(InputEvent::Key(static_cast<Keys>(i & 255), (i & 1) == 0, static_cast<longcs>(i)));
+
+			DoNotOptimize(frame.WasKeyPressed(Keys::A));
+		});
+
+		//A frame of held keys, the next frame with a few of them changed.
+		constexpr size_t QueryCount = 100000;
+
+		Random random;
+		std::vector<Keys> bindings(64);
+		std::vector<KeyboardState> states(QueryCount);
+
+		for (auto& binding : bindings)
+			binding = static_cast<Keys>(random.Next(256));
+
+		for (size_t i = 0; i < QueryCount; ++i) {
+			Keys down[8];
+
+			for (auto& key : down)
+				key = static_cast<Keys>(random.Next(256));
+
+			states[i] = KeyboardState(down);
+		}
+
+		runner.Run("KeyboardState::IsKeyDown 64 bindings 100k", QueryCount * bindings.size(), [&] {
+			size_t count = 0;
+
+			for (const auto& state : states) {
+				for (const auto binding : bindings)
+					count += state.IsKeyDown(binding) ? 1 : 0;
+			}
+
+			DoNotOptimize(count);
+		});
+
+		runner.Run("KeyboardState::Pressed 100k", QueryCount, [&] {
+			size_t count = 0;
+
+			for (size_t i = 1; i < QueryCount; ++i)
+				count += KeyboardState::Pressed(states[i], states[i - 1]).GetPressedKeyCount();
+
+			DoNotOptimize(count);
+		});
+
+		runner.Run("KeyboardState::GetPressedKeys 100k", QueryCount, [&] {
+			Keys keys[KeyboardState::KeyCount];
+			size_t count = 0;
+
+			for (const auto& state : states)
+				count += state.GetPressedKeys(keys);
+
+			DoNotOptimize(count);
+		});
+
+		//512 actions of two bindings each, one in four a chord, and 16 axes.
+		constexpr size_t ActionCount = 512;
+		constexpr size_t SnapshotCount = 1024;
+
+		ActionMap actions;
+		std::vector<InputSnapshot> snapshots(SnapshotCount);
+
+		for (size_t i = 0; i < ActionCount; ++i) {
+			const auto action = actions.AddAction("action" + std::to_string(i));
+			const auto key = InputControl::Key(static_cast<Keys>(random.Next(256)));
+
+			if (i % 4 == 0)
+				actions.Bind(action, 0, { InputControl::Key(Keys::LeftControl), key });
+			else
+				actions.Bind(action, 0, { key });
+
+			actions.Bind(action, 1, { InputControl::Button(static_cast<MouseButton>(random.Next(5))) });
+		}
+
+		for (size_t i = 0; i < 16; ++i) {
+			const auto axis = actions.AddAxis("axis" + std::to_string(i), 0.1F);
+			actions.BindAxis(axis, 0, { InputControl::Key(Keys::A), InputControl::Key(Keys::D) });
+			actions.BindAxis(axis, 1, { InputControl::Never(), InputControl::Never(), InputAxis::MouseX, 0.01F });
+		}
+
+		for (size_t i = 0; i < SnapshotCount; ++i) {
+			MouseState mouse;
+			mouse.X = static_cast<int>(random.Next(64));
+			mouse.Left = (i & 1) != 0 ? ButtonState::Pressed : ButtonState::Released;
+			snapshots[i] = InputSnapshot::Capture(states[i], mouse, MouseState());
+		}
+
+		const auto& update = runner.Run("ActionMap::Update 512 actions 1k frames", SnapshotCount, [&] {
+			size_t count = 0;
+
+			for (const auto& snapshot : snapshots) {
+				actions.Update(snapshot);
+				count += actions.WasPressed(0) ? 1 : 0;
+			}
+
+			DoNotOptimize(count);
+		});
+
+		if (update.Repetitions > 0)
+			std::printf("  %-46s %12.3f us/frame\n", "ActionMap 512 actions", update.NanosecondsPerItem() / 1000.0);
+
+		//Eight pads looping scripts of moving sticks and changing buttons.
+		constexpr size_t PollCount = 100000;
+
+		VirtualGamePad pads;
+
+		for (size_t i = 0; i < GamePad::MaxCount; ++i) {
+			std::vector<GamePadReport> script(256);
+
+			for (auto& report : script) {
+				report.IsConnected = true;
+				report.Buttons = static_cast<ushortcs>(random.Next(65536));
+				report.LeftX = static_cast<shortcs>(random.Next(65536) - 32768);
+				report.LeftY = static_cast<shortcs>(random.Next(65536) - 32768);
+				report.RightX = static_cast<shortcs>(random.Next(65536) - 32768);
+				report.RightY = static_cast<shortcs>(random.Next(65536) - 32768);
+				report.LeftTrigger = static_cast<bytecs>(random.Next(256));
+				report.RightTrigger = static_cast<bytecs>(random.Next(256));
+			}
+
+			pads.Play(static_cast<PlayerIndex>(i), std::move(script), true);
+		}
+
+		GamePad::Device(&pads);
+
+		runner.Run("GamePad::Update 8 pads 100k", PollCount, [&] {
+			float sum = 0;
+
+			for (size_t i = 0; i < PollCount; ++i) {
+				GamePad::Update();
+				sum += GamePad::GetStates()[i & 7].ThumbSticks.Left.X;
+			}
+
+			DoNotOptimize(sum);
+		});
+
+		runner.Run("GamePad::GetState circular 8 pads 100k", PollCount, [&] {
+			float sum = 0;
+
+			for (size_t i = 0; i < PollCount; ++i)
+				sum += GamePad::GetState(static_cast<PlayerIndex>(i & 7), GamePadDeadZone::Circular).ThumbSticks.Right.Y;
+
+			DoNotOptimize(sum);
+		});
+
+		GamePad::Device(nullptr);
+
+		//Ten minutes at 60 frames a second, the keys and the mouse changing now and then.
+		constexpr size_t FrameCount = 36000;
+
+		cs::MemoryStream recording(1 << 16);
+		InputRecord record;
+		record.ElapsedGameTime = cs::TimeSpan(cs::TimeSpan::TicksPerSecond / 60);
+
+		runner.Run("InputRecorder::Record 10 minutes", FrameCount, [&] { recording.Position(0); }, [&] {
+			InputRecorder recorder(&recording);
+
+			for (size_t i = 0; i < FrameCount; ++i) {
+				record.Keyboard = states[i % QueryCount];
+				record.Mouse.X = static_cast<int>(i / 4);
+				recorder.Record(GameTime(cs::TimeSpan::Zero(), record.ElapsedGameTime, false), record.Keyboard, record.Mouse);
+			}
+		});
+
+		runner.Run("InputReplay::Run 10 minutes", FrameCount, [&] { recording.Position(0); }, [&] {
+			ReplayGame game;
+			InputReplay replay(&recording);
+			replay.Run(game);
+			DoNotOptimize(replay.Frames());
+		});
+	}
+}
\ No newline at end of file
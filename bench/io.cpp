@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "../src/cs/binary.hpp"
+#include <filesystem>
+
+using namespace cs;
+
+namespace dxna::bench {
+	//Writes and reads back a record of an int, a float and a short string per item.
+	template <typename TStream>
+	static void StreamBenchmarks(Runner& runner, std::string const& name, TStream& stream, size_t count) {
+		const std::string text = "dxna";
+
+		BinaryWriter writer(&stream);
+
+		runner.Run("BinaryWriter " + name + " 100k", count, [&] { stream.Seek(0, SeekOrigin::Begin); }, [&] {
+			for (size_t i = 0; i < count; ++i) {
+				writer.Write(static_cast<intcs>(i));
+				writer.Write(static_cast<float>(i));
+				writer.Write(text);
+			}
+
+			stream.Flush();
+		});
+
+		BinaryReader reader(&stream);
+
+		runner.Run("BinaryReader " + name + " 100k", count, [&] { stream.Seek(0, SeekOrigin::Begin); }, [&] {
+			longcs sum = 0;
+
+			for (size_t i = 0; i < count; ++i) {
+				sum += reader.ReadInt32();
+				sum += static_cast<intcs>(reader.ReadSingle());
+				sum += static_cast<intcs>(reader.ReadString().size());
+			}
+
+			DoNotOptimize(sum);
+		});
+	}
+
+	void IOBenchmarks(Runner& runner) {
+		constexpr size_t Count = 100000;
+
+		MemoryStream memory(Count * 16);
+		StreamBenchmarks(runner, "MemoryStream", memory, Count);
+
+		const auto path = (std::filesystem::temp_directory_path() / "dxna_bench.bin").string();
+
+		{
+			FileStream file(path);
+			StreamBenchmarks(runner, "FileStream", file, Count);
+		}
+
+		std::error_code error;
+		std::filesystem::remove(path, error);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "bench.hpp"
+#include "../src/jobsystem.hpp"
+#include <cmath>
+
+namespace dxna::bench {
+	void JobSystemBenchmarks(Runner& runner) {
+		constexpr size_t ElementCount = 1 << 22;
+		constexpr size_t JobCount = 100000;
+
+		std::vector<float> values(ElementCount);
+		const auto cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+		double baseline = 0;
+
+		//The waiting thread runs jobs too, so n cores use n - 1 workers.
+		for (size_t threads = 1; threads <= cores; ++threads) {
+			JobSystem jobs(threads - 1);
+			const auto suffix = " (" + std::to_string(threads) + " cores)";
+
+			const auto& result = runner.Run("JobSystem::ParallelFor 4M" + suffix, ElementCount, [&] {
+				jobs.ParallelFor(0, ElementCount, [&](size_t first, size_t last) {
+					for (auto i = first; i < last; ++i)
+						values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+				});
+
+				DoNotOptimize(values[ElementCount / 2]);
+			});
+
+			if (threads == 1)
+				baseline = result.MedianNanoseconds;
+
+			if (result.Repetitions > 0 && baseline > 0)
+				std::printf("%-48s %12.2fx\n", ("  speedup" + suffix).c_str(), baseline / result.MedianNanoseconds);
+
+			runner.Run("JobSystem::Run 100k empty jobs" + suffix, JobCount, [&] {
+				JobCounter counter;
+
+				//Spawned from a job, so they go through the lock-free deques.
+				jobs.Run(counter, [&] {
+					for (size_t i = 0; i < JobCount; ++i)
+						jobs.Run(counter, [] {});
+				});
+
+				jobs.Wait(counter);
+			});
+		}
+	}
+}
\ No newline at end of file
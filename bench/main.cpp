@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include <cstdlib>
+#include <cstring>
+
+using namespace dxna::bench;
+
+//Usage: dxna_bench [--filter text] [--repetitions n] [--json file]
+int main(int argc, char* argv[]) {
+	const char* json = nullptr;
+	const char* filter = nullptr;
+	size_t repetitions = 15;
+
+	for (int i = 1; i < argc; ++i) {
+		const auto hasValue = i + 1 < argc;
+
+		if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+			json = argv[++i];
+		else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+			filter = argv[++i];
+		else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue)
+			repetitions = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+		else {
+			std::fprintf(stderr, "usage: %s [--filter text] [--repetitions n] [--json file]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Runner runner(repetitions);
+
+	if (filter != nullptr)
+		runner.Filter(filter);
+
+	RenderQueueBenchmarks(runner);
+	SpriteBatchBenchmarks(runner);
+	SoftwareBackendBenchmarks(runner);
+	TextureBenchmarks(runner);
+	JobSystemBenchmarks(runner);
+	GameBenchmarks(runner);
+	ProfilerBenchmarks(runner);
+	MathBenchmarks(runner);
+	IOBenchmarks(runner);
+	EffectBenchmarks(runner);
+	AnimationBenchmarks(runner);
+	InputBenchmarks(runner);
+	EventBenchmarks(runner);
+	MemoryArenaBenchmarks(runner);
+	ResourceBenchmarks(runner);
+
+	if (json != nullptr && !runner.WriteJson(json)) {
+		std::fprintf(stderr, "could not write %s\n", json);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "bench.hpp"
+#include "../src/structs.hpp"
+#include "../src/curve.hpp"
+#include "../src/compiledcurve.hpp"
+
+namespace dxna::bench {
+	void MathBenchmarks(Runner& runner) {
+		constexpr size_t Count = 100000;
+
+		Random random;
+		std::vector<Matrix> matrices(Count);
+		std::vector<Matrix> results(Count);
+		std::vector<Vector3> vectors(Count);
+		std::vector<Vector3> transformed(Count);
+		std::vector<Quaternion> quaternions(Count);
+
+		for (size_t i = 0; i < Count; ++i) {
+			matrices[i] = Matrix::CreateFromYawPitchRoll(random.NextFloat() * 6.0F, random.NextFloat() * 6.0F, random.NextFloat() * 6.0F)
+				* Matrix::CreateTranslation(random.NextFloat(), random.NextFloat(), random.NextFloat());
+			vectors[i] = Vector3(random.NextFloat(), random.NextFloat(), random.NextFloat());
+			quaternions[i] = Quaternion::CreateFromYawPitchRoll(random.NextFloat() * 6.0F, random.NextFloat() * 6.0F, random.NextFloat() * 6.0F);
+		}
+
+		runner.Run("Matrix::Multiply 100k", Count, [&] {
+			for (size_t i = 0; i < Count; ++i)
+				results[i] = Matrix::Multiply(matrices[i], matrices[Count - 1 - i]);
+
+			DoNotOptimize(results[0]);
+		});
+
+		runner.Run("Matrix::Invert 100k", Count, [&] {
+			for (size_t i = 0; i < Count; ++i)
+				results[i] = Matrix::Invert(matrices[i]);
+
+			DoNotOptimize(results[0]);
+		});
+
+		runner.Run("Matrix::CreateFromQuaternion 100k", Count, [&] {
+			for (size_t i = 0; i < Count; ++i)
+				results[i] = Matrix::CreateFromQuaternion(quaternions[i]);
+
+			DoNotOptimize(results[0]);
+		});
+
+		runner.Run("Vector3::Transform 100k", Count, [&] {
+			const auto& matrix = matrices[0];
+
+			for (size_t i = 0; i < Count; ++i)
+				transformed[i] = Vector3::Transform(vectors[i], matrix);
+
+			DoNotOptimize(transformed[0]);
+		});
+
+		runner.Run("Quaternion::Multiply 100k", Count, [&] {
+			auto result = Quaternion::Identity();
+
+			for (size_t i = 0; i < Count; ++i)
+				result = Quaternion::Multiply(result, quaternions[i]);
+
+			DoNotOptimize(result);
+		});
+
+		Matrix projection;
+		Matrix::CreatePerspectiveFieldOfView(1.0F, 16.0F / 9.0F, 0.1F, 100.0F, projection);
+		const BoundingFrustum frustum(Matrix::CreateLookAt(Vector3(0, 0, 10), Vector3(0, 0, 0), Vector3(0, 1, 0)) * projection);
+
+		std::vector<BoundingBox> boxes(Count);
+		std::vector<BoundingSphere> spheres(Count);
+
+		//Spread around the camera, so every containment type shows up.
+		for (size_t i = 0; i < Count; ++i) {
+			const auto center = Vector3(random.NextFloat() * 200.0F - 100.0F, random.NextFloat() * 200.0F - 100.0F, random.NextFloat() * 200.0F - 100.0F);
+			const auto extent = random.NextFloat() * 4.0F;
+
+			boxes[i] = BoundingBox(center - Vector3(extent), center + Vector3(extent));
+			spheres[i] = BoundingSphere(center, extent);
+		}
+
+		runner.Run("BoundingFrustum::Contains box 100k", Count, [&] {
+			size_t visible = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				visible += frustum.Contains(boxes[i]) != ContainmentType::Disjoint;
+
+			DoNotOptimize(visible);
+		});
+
+		runner.Run("BoundingFrustum::Contains sphere 100k", Count, [&] {
+			size_t visible = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				visible += frustum.Contains(spheres[i]) != ContainmentType::Disjoint;
+
+			DoNotOptimize(visible);
+		});
+
+		Curve curve;
+
+		for (size_t i = 0; i < 16; ++i)
+			curve.Keys.Add(CurveKey(static_cast<float>(i), random.NextFloat()));
+
+		curve.ComputeTangents(CurveTangent::Smooth, CurveTangent::Smooth);
+
+		std::vector<float> positions(Count);
+
+		for (auto& position : positions)
+			position = random.NextFloat() * 15.0F;
+
+		runner.Run("Curve::Evaluate 16 keys 100k", Count, [&] {
+			float sum = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				sum += curve.Evaluate(positions[i]);
+
+			DoNotOptimize(sum);
+		});
+
+		CompiledCurve compiled(curve);
+
+		runner.Run("CompiledCurve::Evaluate 16 keys 100k", Count, [&] {
+			float sum = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				sum += compiled.Evaluate(positions[i]);
+
+			DoNotOptimize(sum);
+		});
+
+		//Time moving forward, as when each particle keeps its hint between frames.
+		std::vector<float> sorted(positions);
+		std::sort(sorted.begin(), sorted.end());
+
+		runner.Run("CompiledCurve::Evaluate hint, sorted 100k", Count, [&] {
+			float sum = 0;
+			size_t hint = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				sum += compiled.Evaluate(sorted[i], hint);
+
+			DoNotOptimize(sum);
+		});
+
+		//Particles past the ends of the curve, looping over it.
+		Curve looping = curve;
+		looping.PreLoop = CurveLoopType::Oscillate;
+		looping.PostLoop = CurveLoopType::CycleOffset;
+
+		const CompiledCurve compiledLooping(looping);
+		std::vector<float> looped(Count);
+		std::vector<float> values(Count);
+
+		for (auto& position : looped)
+			position = random.NextFloat() * 45.0F - 15.0F;
+
+		runner.Run("Curve::Evaluate scalar, looped 100k", Count, [&] {
+			for (size_t i = 0; i < Count; ++i)
+				values[i] = looping.Evaluate(looped[i]);
+
+			DoNotOptimize(values[0]);
+		});
+
+		runner.Run("Curve::Evaluate span, looped 100k", Count, [&] {
+			looping.Evaluate(looped, values);
+			DoNotOptimize(values[0]);
+		});
+
+		runner.Run("CompiledCurve::Evaluate span, looped 100k", Count, [&] {
+			compiledLooping.Evaluate(looped, values);
+			DoNotOptimize(values[0]);
+		});
+
+		compiled.Bake(1024);
+
+		runner.Run("CompiledCurve::EvaluateBaked 1024 100k", Count, [&] {
+			float sum = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+				sum += compiled.EvaluateBaked(positions[i]);
+
+			DoNotOptimize(sum);
+		});
+	}
+}
\ No newline at end of file
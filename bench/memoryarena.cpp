@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "../src/cs/cstypes.hpp"
+#include "../src/memoryarena.hpp"
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace dxna::bench {
+	struct Particle {
+		float Position[3]{};
+		float Velocity[3]{};
+		uintcs Color{ 0 };
+	};
+
+	void MemoryArenaBenchmarks(Runner& runner) {
+		constexpr size_t ObjectCount = 1000;
+		constexpr size_t ListCount = 100;
+
+		std::vector<std::shared_ptr<Particle>> shared(ObjectCount);
+		std::vector<Particle*> pointers(ObjectCount);
+		MemoryArena arena;
+
+		runner.Run("std::make_shared 1000 objects", ObjectCount, [&] {
+			for (size_t i = 0; i < ObjectCount; ++i)
+				shared[i] = std::make_shared<Particle>();
+
+			DoNotOptimize(shared[0]->Color);
+			shared.assign(ObjectCount, nullptr);
+		});
+
+		runner.Run("MemoryArena::New 1000 objects", ObjectCount, [&] {
+			for (size_t i = 0; i < ObjectCount; ++i)
+				pointers[i] = arena.New<Particle>();
+
+			DoNotOptimize(pointers[0]->Color);
+			arena.Reset();
+		});
+
+		//Short lists of indices, as culling or batching builds them every frame.
+		runner.Run("std::vector 100 temporary lists", ListCount, [&] {
+			size_t total = 0;
+
+			for (size_t list = 0; list < ListCount; ++list) {
+				std::vector<uintcs> indices;
+
+				for (uintcs i = 0; i < 64; ++i)
+					indices.push_back(i);
+
+				total += indices.size();
+			}
+
+			DoNotOptimize(total);
+		});
+
+		runner.Run("std::pmr::vector on scratch 100 lists", ListCount, [&] {
+			size_t total = 0;
+
+			for (size_t list = 0; list < ListCount; ++list) {
+				ScratchScope scope;
+				std::pmr::vector<uintcs> indices(&scope.Arena());
+
+				for (uintcs i = 0; i < 64; ++i)
+					indices.push_back(i);
+
+				total += indices.size();
+			}
+
+			DoNotOptimize(total);
+		});
+
+		const auto statistics = arena.Statistics();
+
+		if (statistics.HighWaterMark > 0)
+			std::printf("  %-46s %10zu bytes high water %4zu chunk allocations\n", "MemoryArena",
+				statistics.HighWaterMark, statistics.ChunkAllocations);
+	}
+}
\ No newline at end of file
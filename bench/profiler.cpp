@@ -0,0 +1,26 @@
+#include "bench.hpp"
+#include "../src/profiler.hpp"
+
+namespace dxna::bench {
+	void ProfilerBenchmarks(Runner& runner) {
+		constexpr size_t ZoneCount = 100000;
+
+		//ProfileScope directly, so the cost is measured whether or not DXNA_PROFILE is defined.
+		runner.Run("ProfileScope 100k zones", ZoneCount, [] { Profiler::Clear(); }, [] {
+			for (size_t i = 0; i < ZoneCount; ++i) {
+				ProfileScope scope("bench");
+			}
+		});
+
+		Profiler::Enabled(false);
+
+		runner.Run("ProfileScope 100k zones, disabled", ZoneCount, [] {
+			for (size_t i = 0; i < ZoneCount; ++i) {
+				ProfileScope scope("bench");
+			}
+		});
+
+		Profiler::Enabled(true);
+		Profiler::Clear();
+	}
+}
\ No newline at end of file
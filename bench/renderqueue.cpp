@@ -0,0 +1,75 @@
+#include "bench.hpp"
+#include "../src/graphics/graphics.hpp"
+#include "../src/graphics/renderqueue.hpp"
+
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	void RenderQueueBenchmarks(Runner& runner) {
+		constexpr size_t DrawCount = 100000;
+		constexpr size_t PassCount = 64;
+
+		std::vector<EffectPass> passes(PassCount);
+		BlendState blends[] = { BlendState::Opaque(), BlendState::AlphaBlend(), BlendState::Additive() };
+		DepthStencilState depths[] = { DepthStencilState::Default(), DepthStencilState::DepthRead() };
+		RasterizerState rasterizers[] = { RasterizerState::CullCounterClockwise(), RasterizerState::CullNone() };
+
+		Random random;
+		std::vector<RenderItem> items(DrawCount);
+
+		for (auto& item : items) {
+			const auto transparent = random.Next(4) == 0;
+
+			item.Pass = &passes[random.Next(PassCount)];
+			item.Blend = transparent ? &blends[1 + random.Next(2)] : &blends[0];
+			item.DepthStencil = transparent ? &depths[1] : &depths[0];
+			item.Rasterizer = &rasterizers[random.Next(2)];
+			item.PrimitiveCount = 2 + static_cast<intcs>(random.Next(64));
+			item.Depth = random.NextFloat() * 1000.0F;
+			item.Layer = static_cast<bytecs>(random.Next(4));
+			item.Bucket = transparent ? RenderBucket::Transparent : RenderBucket::Opaque;
+		}
+
+		RenderQueue queue;
+		CommandList commandList;
+
+		auto fill = [&] {
+			queue.Clear();
+
+			for (const auto& item : items)
+				queue.Add(item);
+		};
+
+		runner.Run("RenderQueue.Add (100k draws)", DrawCount, [&] { queue.Clear(); }, fill);
+		runner.Run("RenderQueue.Sort (100k draws)", DrawCount, fill, [&] { queue.Sort(); });
+
+		std::vector<ulongcs> keys;
+		runner.Run("std::sort baseline (100k keys)", DrawCount,
+			[&] {
+				keys.clear();
+				for (size_t i = 0; i < queue.Count(); ++i)
+					keys.push_back(queue.SortKey(i));
+			},
+			[&] { std::sort(keys.begin(), keys.end()); });
+
+		runner.Run("RenderQueue.Submit (100k draws)", DrawCount,
+			[&] { fill(); queue.Sort(); commandList.Reset(); },
+			[&] { queue.Submit(commandList); });
+
+		auto backend = std::make_shared<HeadlessBackend>();
+		GraphicsDevice device(backend);
+
+		runner.Run("RenderQueue frame, headless (100k draws)", DrawCount,
+			[&] { commandList.Reset(); },
+			[&] {
+				fill();
+				commandList.SetViewport(Viewport(0, 0, 1280, 720));
+				queue.Submit(commandList);
+				device.BeginFrame();
+				device.Submit(commandList);
+				device.Present();
+			});
+
+		DoNotOptimize(backend->Statistics().Draws);
+	}
+}
\ No newline at end of file
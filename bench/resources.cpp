@@ -0,0 +1,87 @@
+#include "bench.hpp"
+#include "../src/graphics/graphics.hpp"
+#include <memory>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	void ResourceBenchmarks(Runner& runner) {
+		constexpr size_t ResourceCount = 4096;
+
+		Random random;
+		std::vector<size_t> order(ResourceCount);
+
+		for (size_t i = 0; i < ResourceCount; ++i)
+			order[i] = i;
+
+		for (size_t i = ResourceCount - 1; i > 0; --i)
+			std::swap(order[i], order[random.Next() % (i + 1)]);
+
+		std::vector<BlendStatePtr> pointers(ResourceCount);
+		std::vector<BlendStatePtr> copies(ResourceCount);
+		HandlePool<BlendState> pool;
+		std::vector<BlendStateHandle> handles(ResourceCount);
+		std::vector<BlendStateHandle> recorded(ResourceCount);
+
+		for (size_t i = 0; i < ResourceCount; ++i) {
+			pointers[i] = std::make_shared<BlendState>();
+			handles[i] = pool.Create();
+		}
+
+		//Recording: every draw keeps a reference to its state and reads it.
+		runner.Run("BlendStatePtr copy and read 4096", ResourceCount, [&] {
+			size_t total = 0;
+
+			for (size_t i = 0; i < ResourceCount; ++i) {
+				copies[i] = pointers[order[i]];
+				total += static_cast<size_t>(copies[i]->ColorSourceBlend());
+			}
+
+			DoNotOptimize(total);
+		});
+
+		runner.Run("HandlePool::Get and read 4096", ResourceCount, [&] {
+			size_t total = 0;
+
+			for (size_t i = 0; i < ResourceCount; ++i) {
+				recorded[i] = handles[order[i]];
+				total += static_cast<size_t>(pool.Get(recorded[i])->ColorSourceBlend());
+			}
+
+			DoNotOptimize(total);
+		});
+
+		runner.Run("std::make_shared<BlendState> 4096", ResourceCount, [&] {
+			for (size_t i = 0; i < ResourceCount; ++i)
+				copies[i] = std::make_shared<BlendState>();
+
+			DoNotOptimize(copies[0]);
+			copies.assign(ResourceCount, nullptr);
+		});
+
+		HandlePool<BlendState> churn(1);
+
+		runner.Run("HandlePool create and release 4096", ResourceCount, [&] {
+			for (size_t i = 0; i < ResourceCount; ++i)
+				recorded[i] = churn.Create();
+
+			DoNotOptimize(recorded[0]);
+
+			for (size_t i = 0; i < ResourceCount; ++i)
+				churn.Release(recorded[i]);
+
+			churn.EndFrame();
+		});
+
+		//A budget that is never exceeded: the cost of checking it every frame.
+		auto& registry = ResourceRegistry::Shared();
+		registry.Budget(ResourceRegistry::Unlimited - 1);
+
+		runner.Run("ResourceRegistry::EndFrame under budget", registry.Count(), [&] {
+			DoNotOptimize(registry.EndFrame());
+		});
+
+		registry.Budget(ResourceRegistry::Unlimited);
+	}
+}
\ No newline at end of file
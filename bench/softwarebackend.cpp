@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "../src/graphics/graphics.hpp"
+#include "../src/graphics/softwarebackend.hpp"
+
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	void SoftwareBackendBenchmarks(Runner& runner) {
+		constexpr size_t SpriteCount = 10000;
+		constexpr intcs Width = 1280;
+		constexpr intcs Height = 720;
+
+		auto backend = std::make_shared<SoftwareBackend>(Width, Height);
+		auto device = std::make_shared<GraphicsDevice>(backend);
+		device->Viewport(Viewport(0, 0, Width, Height));
+
+		auto texture = std::make_shared<Texture2D>(device, 32, 32);
+		auto alphaBlend = std::make_shared<BlendState>(BlendState::AlphaBlend());
+		auto opaque = std::make_shared<BlendState>(BlendState::Opaque());
+
+		Random random;
+		std::vector<Vector2> positions(SpriteCount);
+		std::vector<Color> colors(SpriteCount);
+
+		for (size_t i = 0; i < SpriteCount; ++i) {
+			positions[i] = Vector2(random.NextFloat() * Width, random.NextFloat() * Height);
+			colors[i] = Color(static_cast<uintcs>(random.Next()) | 0x80000000);
+		}
+
+		SpriteBatch spriteBatch(device);
+		//The software backend executes each list as it is submitted.
+		spriteBatch.FramesInFlight(1);
+		CommandList clear;
+		clear.Clear(ClearOptions::All, Colors::CornflowerBlue, 1.0F, 0);
+
+		auto frame = [&](BlendStatePtr const& blendState) {
+			device->BeginFrame();
+			device->Submit(clear);
+			spriteBatch.Begin(SpriteSortMode::Deferred, blendState);
+
+			for (size_t i = 0; i < SpriteCount; ++i)
+				spriteBatch.Draw(texture, positions[i], cs::Nullable<Rectangle>(), colors[i], 0.5F, Vector2(16.0F), 1.0F, SpriteEffects::None, 0.0F);
+
+			spriteBatch.End();
+			device->Present();
+		};
+
+		std::printf("  software backend: %d threads, %dx%d\n", backend->ThreadCount(), Width, Height);
+
+		runner.Run("SoftwareBackend frame, opaque (10k 32x32 sprites)", SpriteCount, [&] { frame(opaque); });
+		runner.Run("SoftwareBackend frame, alpha (10k 32x32 sprites)", SpriteCount, [&] { frame(alphaBlend); });
+
+		DoNotOptimize(backend->Statistics().Pixels);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "../src/graphics/graphics.hpp"
+#include "../src/graphics/spritebatch.hpp"
+
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	void SpriteBatchBenchmarks(Runner& runner) {
+		constexpr size_t SpriteCount = 200000;
+		constexpr size_t TextureCount = 32;
+
+		auto backend = std::make_shared<HeadlessBackend>();
+		auto device = std::make_shared<GraphicsDevice>(backend);
+		device->Viewport(Viewport(0, 0, 1280, 720));
+
+		std::vector<Texture2DPtr> textures;
+
+		for (size_t i = 0; i < TextureCount; ++i)
+			textures.push_back(std::make_shared<Texture2D>(device, 64, 64));
+
+		struct Sprite {
+			size_t Texture;
+			Vector2 Position;
+			Rectangle Source;
+			Color Tint;
+			float Rotation;
+			float Depth;
+		};
+
+		Random random;
+		std::vector<Sprite> sprites(SpriteCount);
+
+		for (auto& sprite : sprites) {
+			sprite.Texture = random.Next(TextureCount);
+			sprite.Position = Vector2(random.NextFloat() * 1280.0F, random.NextFloat() * 720.0F);
+			sprite.Source = Rectangle(static_cast<int>(random.Next(4)) * 16, 0, 16, 16);
+			sprite.Tint = Color(static_cast<uintcs>(random.Next()));
+			sprite.Rotation = random.NextFloat() * 6.28F;
+			sprite.Depth = random.NextFloat();
+		}
+
+		SpriteBatch spriteBatch(device);
+		//The headless backend executes each list as it is submitted.
+		spriteBatch.FramesInFlight(1);
+
+		auto frame = [&](SpriteSortMode sortMode) {
+			device->BeginFrame();
+			spriteBatch.Begin(sortMode);
+
+			for (const auto& sprite : sprites) {
+				spriteBatch.Draw(textures[sprite.Texture], sprite.Position, sprite.Source, sprite.Tint,
+					sprite.Rotation, Vector2(8.0F), 1.0F, SpriteEffects::None, sprite.Depth);
+			}
+
+			spriteBatch.End();
+			device->Present();
+		};
+
+		auto report = [&](char const* mode) {
+			const auto& statistics = spriteBatch.Statistics();
+
+			//Filtered out.
+			if (statistics.Batches == 0)
+				return;
+
+			std::printf("  %-46s %10.2f sprites/batch %6llu batches/frame\n", mode, statistics.SpritesPerBatch(),
+				static_cast<unsigned long long>(statistics.Batches));
+		};
+
+		auto reset = [&] { spriteBatch.ResetStatistics(); };
+
+		runner.Run("SpriteBatch frame, Deferred (200k sprites)", SpriteCount, reset, [&] { frame(SpriteSortMode::Deferred); });
+		report("Deferred");
+
+		runner.Run("SpriteBatch frame, Texture (200k sprites)", SpriteCount, reset, [&] { frame(SpriteSortMode::Texture); });
+		report("Texture");
+
+		runner.Run("SpriteBatch frame, BackToFront (200k sprites)", SpriteCount, reset, [&] { frame(SpriteSortMode::BackToFront); });
+		report("BackToFront");
+
+		DoNotOptimize(backend->Statistics().Draws);
+		DoNotOptimize(backend->Statistics().Errors);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "bench.hpp"
+#include "../src/graphics/graphics.hpp"
+#include "../src/graphics/pixelconverter.hpp"
+
+using namespace dxna::graphics;
+
+namespace dxna::bench {
+	void TextureBenchmarks(Runner& runner) {
+		constexpr size_t TexelCount = 1024 * 1024;
+
+		Random random;
+		std::vector<uintcs> texels(TexelCount);
+		std::vector<uintcs> converted(TexelCount);
+		std::vector<float> floats(TexelCount * 4);
+
+		for (auto& texel : texels)
+			texel = static_cast<uintcs>(random.Next());
+
+		runner.Run("PixelConverter::SwapRedBlue 1M", TexelCount, [&] {
+			PixelConverter::SwapRedBlue(texels.data(), converted.data(), TexelCount);
+			DoNotOptimize(converted[0]);
+		});
+
+		runner.Run("PixelConverter::PremultiplyAlpha 1M", TexelCount, [&] {
+			PixelConverter::PremultiplyAlpha(texels.data(), converted.data(), TexelCount);
+			DoNotOptimize(converted[0]);
+		});
+
+		runner.Run("PixelConverter::UnpackRgba8 1M", TexelCount, [&] {
+			PixelConverter::UnpackRgba8(texels.data(), floats.data(), TexelCount);
+			DoNotOptimize(floats[0]);
+		});
+
+		runner.Run("PixelConverter::PackRgba8 1M", TexelCount, [&] {
+			PixelConverter::PackRgba8(floats.data(), converted.data(), TexelCount);
+			DoNotOptimize(converted[0]);
+		});
+
+		Texture2D texture(nullptr, 1024, 1024, true);
+		texture.SetData(texels.data(), TexelCount);
+
+		runner.Run("Texture2D::GenerateMipmaps box 1024x1024", TexelCount, [&] {
+			texture.GenerateMipmaps(MipmapFilter::Box);
+			DoNotOptimize(texture.LevelData(1)[0]);
+		});
+
+		runner.Run("Texture2D::GenerateMipmaps kaiser 1024x1024", TexelCount, [&] {
+			texture.GenerateMipmaps(MipmapFilter::Kaiser);
+			DoNotOptimize(texture.LevelData(1)[0]);
+		});
+	}
+}
\ No newline at end of file
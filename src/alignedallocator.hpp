@@ -0,0 +1,35 @@
+#ifndef DXNA_ALIGNEDALLOCATOR_HPP
+#define DXNA_ALIGNEDALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace dxna {
+	//Allocator whose blocks start on an Alignment boundary, e.g. a cache line,
+	//so SIMD loops and uploads can stream the memory directly.
+	template <typename T, size_t Alignment = 64>
+	struct AlignedAllocator {
+		using value_type = T;
+
+		template <typename U>
+		struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+		constexpr AlignedAllocator() noexcept = default;
+
+		template <typename U>
+		constexpr AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept {}
+
+		T* allocate(size_t count) {
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+		}
+
+		void deallocate(T* pointer, size_t) noexcept {
+			::operator delete(pointer, std::align_val_t(Alignment));
+		}
+
+		template <typename U>
+		constexpr bool operator==(AlignedAllocator<U, Alignment> const&) const noexcept { return true; }
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,666 @@
+#include "animationclip.hpp"
+#include "jobsystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace dxna {
+	//Clip data is read with memcpy, so it may sit at any alignment in a stream.
+	template <typename T>
+	static T read(bytecs const* data, size_t offset) {
+		T value;
+		std::memcpy(&value, data + offset, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	static void append(std::vector<bytecs>& data, T const& value) {
+		const auto offset = data.size();
+		data.resize(offset + sizeof(T));
+		std::memcpy(data.data() + offset, &value, sizeof(T));
+	}
+
+	static size_t keySize(AnimationKeyFormat format) {
+		switch (format) {
+		case AnimationKeyFormat::Vector3:
+			return 12;
+		case AnimationKeyFormat::Quaternion:
+			return 16;
+		case AnimationKeyFormat::QuantizedQuaternion:
+			return 6;
+		default:
+			return 0;
+		}
+	}
+
+	//Smallest three: the largest component is dropped and rebuilt from the others,
+	//which then fit in [-1/sqrt(2), 1/sqrt(2)]. Its index goes in the top bits
+	//of the first two components.
+	static constexpr float QuantizedRange = 0.70710678F;
+	static constexpr float QuantizedScale = 32767.0F;
+
+	static void quantize(Quaternion const& value, ushortcs* destination) {
+		const auto normalized = Quaternion::Normalize(value);
+		const float components[4] = { normalized.X, normalized.Y, normalized.Z, normalized.W };
+		int largest = 0;
+
+		for (int i = 1; i < 4; ++i) {
+			if (std::abs(components[i]) > std::abs(components[largest]))
+				largest = i;
+		}
+
+		const auto sign = components[largest] < 0 ? -1.0F : 1.0F;
+
+		for (int i = 0, j = 0; i < 4; ++i) {
+			if (i == largest)
+				continue;
+
+			const auto unit = std::clamp(components[i] * sign / QuantizedRange * 0.5F + 0.5F, 0.0F, 1.0F);
+			destination[j++] = static_cast<ushortcs>(std::lround(unit * QuantizedScale));
+		}
+
+		destination[0] |= static_cast<ushortcs>((largest & 1) << 15);
+		destination[1] |= static_cast<ushortcs>((largest >> 1) << 15);
+	}
+
+	static Quaternion dequantize(bytecs const* data) {
+		const auto a = read<ushortcs>(data, 0);
+		const auto b = read<ushortcs>(data, 2);
+		const auto c = read<ushortcs>(data, 4);
+		const auto largest = (a >> 15) | ((b >> 15) << 1);
+		const auto decode = [](ushortcs value) {
+			return (static_cast<float>(value & 0x7FFF) / QuantizedScale * 2.0F - 1.0F) * QuantizedRange;
+		};
+
+		float components[4];
+		const float small[3] = { decode(a), decode(b), decode(c) };
+		auto sum = 0.0F;
+
+		for (int i = 0, j = 0; i < 4; ++i) {
+			if (i == largest)
+				continue;
+
+			components[i] = small[j++];
+			sum += components[i] * components[i];
+		}
+
+		components[largest] = std::sqrt(std::max(0.0F, 1.0F - sum));
+		return Quaternion(components[0], components[1], components[2], components[3]);
+	}
+
+	static Quaternion readQuaternion(bytecs const* data, AnimationTrack const& track, size_t key) {
+		if (track.Format == AnimationKeyFormat::QuantizedQuaternion)
+			return dequantize(data + track.ValuesOffset + key * 6);
+
+		return read<Quaternion>(data, track.ValuesOffset + key * sizeof(Quaternion));
+	}
+
+	//The distance between two rotations as unit quaternions, q and -q being the same rotation.
+	static float rotationDistance(Quaternion const& value1, Quaternion const& value2) {
+		const auto other = Quaternion::Dot(value1, value2) < 0 ? -value2 : value2;
+		return (value1 - other).Length();
+	}
+
+	//The keys to keep so that interpolating between them is within the tolerance of
+	//every key. Grows each span of dropped keys while all of them stay within it.
+	//Stored holds the values as they will be sampled back, source the given ones.
+	template <typename TValue, typename TLerp, typename TDistance>
+	static std::vector<size_t> reduceKeys(std::span<float const> times, std::vector<TValue> const& stored,
+		std::span<TValue const> source, float tolerance, TLerp&& lerp, TDistance&& distance) {
+		const auto count = times.size();
+		auto constant = true;
+
+		for (size_t i = 1; i < count && constant; ++i)
+			constant = distance(stored[0], source[i]) <= tolerance;
+
+		if (constant)
+			return { 0 };
+
+		std::vector<size_t> kept = { 0 };
+		size_t start = 0;
+
+		while (start + 1 < count) {
+			auto end = start + 1;
+
+			for (auto candidate = end + 1; candidate < count; ++candidate) {
+				const auto length = times[candidate] - times[start];
+				auto fits = true;
+
+				for (auto i = start + 1; i < candidate && fits; ++i) {
+					const auto amount = (times[i] - times[start]) / length;
+					fits = distance(lerp(stored[start], stored[candidate], amount), source[i]) <= tolerance;
+				}
+
+				if (!fits)
+					break;
+
+				end = candidate;
+			}
+
+			kept.push_back(end);
+			start = end;
+		}
+
+		return kept;
+	}
+
+	static Error checkKeys(std::span<float const> times, size_t valueCount, float tolerance) {
+		if (times.empty())
+			return Error(ErrorCode::ARGUMENT_IS_SMALLER, 2);
+
+		if (valueCount != times.size())
+			return Error(ErrorCode::ARGUMENT_IS_SMALLER, 3);
+
+		if (tolerance < 0)
+			return Error(ErrorCode::ARGUMENT_LESS_ZERO, 4);
+
+		for (size_t i = 1; i < times.size(); ++i) {
+			if (!(times[i] > times[i - 1]))
+				return Error(ErrorCode::ANIMATION_KEYS_NOT_SORTED, 2);
+		}
+
+		return NoError;
+	}
+
+	void AnimationPose::Reset(size_t targetCount) {
+		Translations.assign(targetCount, Vector3::Zero());
+		Rotations.assign(targetCount, Quaternion::Identity());
+		Scales.assign(targetCount, Vector3::One());
+	}
+
+	AnimationClip::AnimationClip(AnimationClip const& other) {
+		*this = other;
+	}
+
+	AnimationClip::AnimationClip(AnimationClip&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	AnimationClip& AnimationClip::operator=(AnimationClip const& other) {
+		if (this == &other)
+			return *this;
+
+		_storage = other._storage;
+		_data = other.OwnsData() ? _storage.data() : other._data;
+		_size = other._size;
+		_duration = other._duration;
+		_targetCount = other._targetCount;
+		_tracks = other._tracks;
+		return *this;
+	}
+
+	AnimationClip& AnimationClip::operator=(AnimationClip&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		//Moving a vector keeps its buffer, so the data pointer stays valid.
+		_storage = std::move(other._storage);
+		_data = other._data;
+		_size = other._size;
+		_duration = other._duration;
+		_targetCount = other._targetCount;
+		_tracks = std::move(other._tracks);
+
+		other._storage.clear();
+		other._data = nullptr;
+		other._size = 0;
+		other._duration = 0;
+		other._targetCount = 0;
+		other._tracks.clear();
+		return *this;
+	}
+
+	Error AnimationClip::Load(std::span<bytecs const> data, AnimationClip& clip) {
+		AnimationClip loaded;
+		const auto error = loaded.bind(data.data(), data.size());
+
+		if (error.HasError())
+			return error;
+
+		clip = std::move(loaded);
+		return NoError;
+	}
+
+	Error AnimationClip::Load(cs::MemoryStream& stream, AnimationClip& clip) {
+		std::span<bytecs const> buffer;
+
+		if (!stream.TryGetBuffer(buffer))
+			return Read(stream, clip);
+
+		const auto position = static_cast<size_t>(stream.Position());
+
+		if (position > buffer.size())
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		const auto error = Load(buffer.subspan(position), clip);
+
+		if (error.HasError())
+			return error;
+
+		stream.Position(static_cast<longcs>(position + clip.SizeInBytes()));
+		return NoError;
+	}
+
+	Error AnimationClip::Read(cs::Stream& stream, AnimationClip& clip) {
+		std::vector<bytecs> storage(HeaderSize);
+
+		if (stream.Read(storage.data(), static_cast<intcs>(HeaderSize), 0, static_cast<intcs>(HeaderSize)) != static_cast<intcs>(HeaderSize))
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		const auto size = read<uintcs>(storage.data(), 8);
+
+		if (read<uintcs>(storage.data(), 0) != Magic || size < HeaderSize)
+			return Error(ErrorCode::ANIMATION_BAD_FORMAT);
+
+		storage.resize(size);
+
+		for (size_t offset = HeaderSize; offset < size; ) {
+			const auto count = stream.Read(storage.data(), static_cast<intcs>(size), static_cast<intcs>(offset), static_cast<intcs>(size - offset));
+
+			if (count <= 0)
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			offset += static_cast<size_t>(count);
+		}
+
+		AnimationClip loaded;
+		loaded._storage = std::move(storage);
+
+		const auto error = loaded.bind(loaded._storage.data(), loaded._storage.size());
+
+		if (error.HasError())
+			return error;
+
+		clip = std::move(loaded);
+		return NoError;
+	}
+
+	Error AnimationClip::Write(cs::BinaryWriter& writer) const {
+		if (writer._stream == nullptr)
+			return Error(ErrorCode::CS_STREAM_IS_NULL);
+
+		if (_data != nullptr)
+			writer.Write(_data, _size);
+
+		return NoError;
+	}
+
+	Error AnimationClip::bind(bytecs const* data, size_t size) {
+		if (size < HeaderSize)
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		if (read<uintcs>(data, 0) != Magic || read<uintcs>(data, 4) != Version)
+			return Error(ErrorCode::ANIMATION_BAD_FORMAT);
+
+		const auto clipSize = static_cast<size_t>(read<uintcs>(data, 8));
+		const auto trackCount = static_cast<size_t>(read<uintcs>(data, 16));
+
+		if (clipSize > size)
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		if (clipSize < HeaderSize + trackCount * TrackSize)
+			return Error(ErrorCode::ANIMATION_BAD_FORMAT);
+
+		_tracks.resize(trackCount);
+		_targetCount = 0;
+
+		for (size_t i = 0; i < trackCount; ++i) {
+			const auto offset = HeaderSize + i * TrackSize;
+			auto& track = _tracks[i];
+
+			track.Target = read<uintcs>(data, offset);
+			track.Type = static_cast<AnimationTrackType>(data[offset + 4]);
+			track.Format = static_cast<AnimationKeyFormat>(data[offset + 5]);
+			track.KeyCount = read<uintcs>(data, offset + 8);
+			track.TimesOffset = read<uintcs>(data, offset + 12);
+			track.ValuesOffset = read<uintcs>(data, offset + 16);
+
+			const auto isRotation = track.Type == AnimationTrackType::Rotation;
+			const auto isQuaternion = track.Format == AnimationKeyFormat::Quaternion
+				|| track.Format == AnimationKeyFormat::QuantizedQuaternion;
+			const auto stride = keySize(track.Format);
+			const auto keys = static_cast<ulongcs>(track.KeyCount);
+
+			if (track.Type > AnimationTrackType::Scale || stride == 0 || isRotation != isQuaternion || keys == 0
+				|| track.TimesOffset + keys * sizeof(float) > clipSize
+				|| track.ValuesOffset + keys * stride > clipSize)
+				return Error(ErrorCode::ANIMATION_BAD_FORMAT, static_cast<int>(i));
+
+			if (track.Target >= MaxTargetCount)
+				return Error(ErrorCode::ANIMATION_TARGET_OUT_OF_RANGE, static_cast<int>(i));
+
+			//findKey searches the times and divides by the length between two keys.
+			for (uintcs key = 1; key < track.KeyCount; ++key) {
+				const auto offset = track.TimesOffset + static_cast<size_t>(key) * sizeof(float);
+
+				if (!(read<float>(data, offset) > read<float>(data, offset - sizeof(float))))
+					return Error(ErrorCode::ANIMATION_KEYS_NOT_SORTED, static_cast<int>(i));
+			}
+
+			_targetCount = std::max<size_t>(_targetCount, static_cast<size_t>(track.Target) + 1);
+		}
+
+		const auto duration = read<float>(data, 12);
+
+		if (!(duration >= 0.0F && duration <= std::numeric_limits<float>::max()))
+			return Error(ErrorCode::ANIMATION_BAD_FORMAT);
+
+		_data = data;
+		_size = clipSize;
+		_duration = duration;
+		return NoError;
+	}
+
+	float AnimationClip::findKey(AnimationTrack const& track, float time, uintcs& key) const {
+		const auto* times = _data + track.TimesOffset;
+		const auto last = track.KeyCount - 1;
+		const auto at = [times](size_t index) { return read<float>(times, index * sizeof(float)); };
+
+		if (last == 0 || time <= at(0)) {
+			key = 0;
+			return 0.0F;
+		}
+
+		if (time >= at(last)) {
+			key = last;
+			return 0.0F;
+		}
+
+		//Keys i covers [times[i], times[i + 1]). Try the cursor and the key after it
+		//before searching.
+		auto index = key;
+
+		if (index >= last || !(time >= at(index) && time < at(index + 1))) {
+			if (index + 1 < last && time >= at(index + 1) && time < at(index + 2)) {
+				++index;
+			}
+			else {
+				uintcs base = 0;
+				auto count = last + 1;
+
+				while (count > 1) {
+					const auto half = count / 2;
+					base = at(base + half) <= time ? base + half : base;
+					count -= half;
+				}
+
+				index = base;
+			}
+		}
+
+		key = index;
+
+		const auto start = at(index);
+		return (time - start) / (at(index + 1) - start);
+	}
+
+	Vector3 AnimationClip::SampleVector3(size_t track, float time, uintcs& key) const {
+		const auto& info = _tracks[track];
+		const auto amount = findKey(info, time, key);
+		const auto offset = info.ValuesOffset + static_cast<size_t>(key) * sizeof(Vector3);
+		const auto value1 = read<Vector3>(_data, offset);
+
+		if (amount <= 0.0F)
+			return value1;
+
+		return Vector3::Lerp(value1, read<Vector3>(_data, offset + sizeof(Vector3)), amount);
+	}
+
+	Quaternion AnimationClip::SampleQuaternion(size_t track, float time, uintcs& key) const {
+		const auto& info = _tracks[track];
+		const auto amount = findKey(info, time, key);
+		const auto value1 = readQuaternion(_data, info, key);
+
+		if (amount <= 0.0F)
+			return value1;
+
+		return Quaternion::Slerp(value1, readQuaternion(_data, info, static_cast<size_t>(key) + 1), amount);
+	}
+
+	void AnimationClip::Sample(float time, AnimationCursor& cursor, AnimationPose& pose, float weight) const {
+		if (weight <= 0.0F)
+			return;
+
+		if (cursor.Keys.size() != _tracks.size())
+			cursor.Keys.assign(_tracks.size(), 0);
+
+		time = std::clamp(time, 0.0F, _duration);
+
+		const auto targetCount = std::min({ pose.Translations.size(), pose.Rotations.size(), pose.Scales.size() });
+
+		for (size_t i = 0; i < _tracks.size(); ++i) {
+			const auto target = _tracks[i].Target;
+			auto& key = cursor.Keys[i];
+
+			if (target >= targetCount)
+				continue;
+
+			switch (_tracks[i].Type) {
+			case AnimationTrackType::Translation: {
+				const auto value = SampleVector3(i, time, key);
+				auto& translation = pose.Translations[target];
+				translation = weight >= 1.0F ? value : Vector3::Lerp(translation, value, weight);
+				break;
+			}
+			case AnimationTrackType::Rotation: {
+				const auto value = SampleQuaternion(i, time, key);
+				auto& rotation = pose.Rotations[target];
+				rotation = weight >= 1.0F ? value : Quaternion::Lerp(rotation, value, weight);
+				break;
+			}
+			case AnimationTrackType::Scale: {
+				const auto value = SampleVector3(i, time, key);
+				auto& scale = pose.Scales[target];
+				scale = weight >= 1.0F ? value : Vector3::Lerp(scale, value, weight);
+				break;
+			}
+			}
+		}
+	}
+
+	Error AnimationClipBuilder::AddTrack(uintcs target, AnimationTrackType type, std::span<float const> times,
+		std::span<Vector3 const> values, float tolerance) {
+		if (target >= AnimationClip::MaxTargetCount)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0);
+
+		if (type == AnimationTrackType::Rotation)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1);
+
+		const auto error = checkKeys(times, values.size(), tolerance);
+
+		if (error.HasError())
+			return error;
+
+		const std::vector<Vector3> stored(values.begin(), values.end());
+		const auto kept = reduceKeys(times, stored, values, tolerance,
+			[](Vector3 const& value1, Vector3 const& value2, float amount) { return Vector3::Lerp(value1, value2, amount); },
+			[](Vector3 const& value1, Vector3 const& value2) { return Vector3::Distance(value1, value2); });
+
+		BuilderTrack track;
+		track.Track.Target = target;
+		track.Track.Type = type;
+		track.Track.Format = AnimationKeyFormat::Vector3;
+
+		for (const auto index : kept) {
+			track.Times.push_back(times[index]);
+			track.Vectors.push_back(stored[index]);
+		}
+
+		_tracks.push_back(std::move(track));
+		_inputKeys += times.size();
+		return NoError;
+	}
+
+	Error AnimationClipBuilder::AddTrack(uintcs target, std::span<float const> times, std::span<Quaternion const> values,
+		float tolerance, bool quantize) {
+		if (target >= AnimationClip::MaxTargetCount)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0);
+
+		const auto error = checkKeys(times, values.size(), tolerance);
+
+		if (error.HasError())
+			return error;
+
+		//Drops keys against the values as they will be read back, so the quantization
+		//error counts toward the tolerance.
+		std::vector<Quaternion> stored(values.size());
+
+		for (size_t i = 0; i < values.size(); ++i) {
+			if (quantize) {
+				bytecs packed[6];
+				ushortcs components[3];
+
+				dxna::quantize(values[i], components);
+				std::memcpy(packed, components, sizeof(packed));
+				stored[i] = dequantize(packed);
+			}
+			else {
+				stored[i] = Quaternion::Normalize(values[i]);
+			}
+		}
+
+		const auto kept = reduceKeys(times, stored, values, tolerance,
+			[](Quaternion const& value1, Quaternion const& value2, float amount) { return Quaternion::Slerp(value1, value2, amount); },
+			[](Quaternion const& value1, Quaternion const& value2) { return rotationDistance(value1, Quaternion::Normalize(value2)); });
+
+		BuilderTrack track;
+		track.Track.Target = target;
+		track.Track.Type = AnimationTrackType::Rotation;
+		track.Track.Format = quantize ? AnimationKeyFormat::QuantizedQuaternion : AnimationKeyFormat::Quaternion;
+
+		for (const auto index : kept) {
+			track.Times.push_back(times[index]);
+			track.Rotations.push_back(quantize ? values[index] : stored[index]);
+		}
+
+		_tracks.push_back(std::move(track));
+		_inputKeys += times.size();
+		return NoError;
+	}
+
+	size_t AnimationClipBuilder::KeyCount() const {
+		size_t count = 0;
+
+		for (const auto& track : _tracks)
+			count += track.Times.size();
+
+		return count;
+	}
+
+	Error AnimationClipBuilder::Build(AnimationClip& clip) const {
+		auto duration = _duration;
+		auto size = AnimationClip::HeaderSize + _tracks.size() * AnimationClip::TrackSize;
+		std::vector<AnimationTrack> tracks;
+
+		for (const auto& source : _tracks) {
+			auto track = source.Track;
+			track.KeyCount = static_cast<uintcs>(source.Times.size());
+			track.TimesOffset = static_cast<uintcs>(size);
+			size += source.Times.size() * sizeof(float);
+			track.ValuesOffset = static_cast<uintcs>(size);
+			//Keeps every block 4 byte aligned.
+			size += (source.Times.size() * keySize(track.Format) + 3) & ~size_t{ 3 };
+
+			duration = std::max(duration, source.Times.back());
+			tracks.push_back(track);
+		}
+
+		std::vector<bytecs> data;
+		data.reserve(size);
+
+		append(data, AnimationClip::Magic);
+		append(data, AnimationClip::Version);
+		append(data, static_cast<uintcs>(size));
+		append(data, duration);
+		append(data, static_cast<uintcs>(tracks.size()));
+
+		for (const auto& track : tracks) {
+			append(data, track.Target);
+			append(data, static_cast<bytecs>(track.Type));
+			append(data, static_cast<bytecs>(track.Format));
+			append(data, static_cast<ushortcs>(0));
+			append(data, track.KeyCount);
+			append(data, track.TimesOffset);
+			append(data, track.ValuesOffset);
+		}
+
+		for (size_t i = 0; i < _tracks.size(); ++i) {
+			const auto& source = _tracks[i];
+
+			for (const auto time : source.Times)
+				append(data, time);
+
+			switch (tracks[i].Format) {
+			case AnimationKeyFormat::Vector3:
+				for (const auto& value : source.Vectors)
+					append(data, value);
+				break;
+
+			case AnimationKeyFormat::Quaternion:
+				for (const auto& value : source.Rotations)
+					append(data, value);
+				break;
+
+			case AnimationKeyFormat::QuantizedQuaternion:
+				for (const auto& value : source.Rotations) {
+					ushortcs components[3];
+					quantize(value, components);
+					append(data, components);
+				}
+				break;
+			}
+
+			data.resize((data.size() + 3) & ~size_t{ 3 });
+		}
+
+		AnimationClip built;
+		built._storage = std::move(data);
+
+		const auto error = built.bind(built._storage.data(), built._storage.size());
+
+		if (error.HasError())
+			return error;
+
+		clip = std::move(built);
+		return NoError;
+	}
+
+	static float wrapTime(float time, float duration) {
+		if (duration <= 0.0F)
+			return 0.0F;
+
+		time = std::fmod(time, duration);
+		return time < 0.0F ? time + duration : time;
+	}
+
+	void SampleAnimation(std::span<AnimationLayer const> layers, AnimationPose& pose) {
+		AnimationCursor scratch;
+
+		for (const auto& layer : layers) {
+			if (layer.Clip == nullptr)
+				continue;
+
+			const auto time = layer.Loop ? wrapTime(layer.Time, layer.Clip->Duration()) : layer.Time;
+			auto& cursor = layer.Cursor != nullptr ? *layer.Cursor : scratch;
+
+			layer.Clip->Sample(time, cursor, pose, layer.Weight);
+		}
+	}
+
+	void SampleAnimation(std::span<AnimationInstance const> instances, JobSystem* jobs) {
+		const auto sample = [instances](size_t first, size_t last) {
+			for (auto i = first; i < last; ++i) {
+				if (instances[i].Pose != nullptr)
+					SampleAnimation(instances[i].Layers, *instances[i].Pose);
+			}
+		};
+
+		if (jobs == nullptr) {
+			sample(0, instances.size());
+			return;
+		}
+
+		jobs->ParallelFor(0, instances.size(), sample);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef DXNA_ANIMATIONCLIP_HPP
+#define DXNA_ANIMATIONCLIP_HPP
+
+#include <span>
+#include <vector>
+#include "structs.hpp"
+#include "error.hpp"
+#include "cs/stream.hpp"
+#include "cs/binary.hpp"
+
+namespace dxna {
+	class JobSystem;
+
+	//What a track animates on its target.
+	enum class AnimationTrackType : bytecs {
+		Translation,
+		Rotation,
+		Scale,
+	};
+
+	//How the keys of a track are stored.
+	enum class AnimationKeyFormat : bytecs {
+		//Three floats.
+		Vector3,
+		//Four floats.
+		Quaternion,
+		//The three smallest components in 15 bits each, 6 bytes a key.
+		QuantizedQuaternion,
+	};
+
+	struct AnimationTrack {
+		uintcs Target{ 0 };
+		AnimationTrackType Type{ AnimationTrackType::Translation };
+		AnimationKeyFormat Format{ AnimationKeyFormat::Vector3 };
+		uintcs KeyCount{ 0 };
+		//Byte offsets in the clip data.
+		uintcs TimesOffset{ 0 };
+		uintcs ValuesOffset{ 0 };
+	};
+
+	//The key where each track of a clip was last sampled. While the time moves little
+	//between samples, as it does during playback, keys are found without searching.
+	//Keep one cursor per playing clip.
+	struct AnimationCursor {
+		std::vector<uintcs> Keys;
+	};
+
+	//The local transform of every target, indexed by AnimationTrack::Target.
+	struct AnimationPose {
+		AnimationPose() = default;
+
+		AnimationPose(size_t targetCount) { Reset(targetCount); }
+
+		//Sets every target to the identity transform.
+		void Reset(size_t targetCount);
+
+		size_t TargetCount() const { return Rotations.size(); }
+
+		std::vector<Vector3> Translations;
+		std::vector<Quaternion> Rotations;
+		std::vector<Vector3> Scales;
+	};
+
+	//Keyframe tracks of Vector3 and Quaternion values over time.
+	//A clip is one block of bytes, the same in memory and serialized, so loading
+	//a clip from memory only validates it and points into the bytes.
+	//The block is little endian.
+	class AnimationClip {
+	public:
+		//"DNAC"
+		static constexpr uintcs Magic = 0x43414E44;
+		static constexpr uintcs Version = 1;
+		static constexpr size_t HeaderSize = 20;
+		static constexpr size_t TrackSize = 20;
+		//Targets index the pose, so clips with a target at or above this are rejected.
+		static constexpr uintcs MaxTargetCount = 0x10000;
+
+		AnimationClip() = default;
+		AnimationClip(AnimationClip const& other);
+		AnimationClip(AnimationClip&& other) noexcept;
+		AnimationClip& operator=(AnimationClip const& other);
+		AnimationClip& operator=(AnimationClip&& other) noexcept;
+
+		//Views the clip at the start of data without copying it.
+		//The data must outlive the clip. Clips whose tracks have a target at or above
+		//MaxTargetCount, or key times that do not increase, are rejected.
+		static Error Load(std::span<bytecs const> data, AnimationClip& clip);
+
+		//Views the clip at the position of the stream without copying it, and moves
+		//the position past it. The stream must outlive the clip and not be written to.
+		//Streams whose buffer is not publicly visible are read into a copy instead.
+		static Error Load(cs::MemoryStream& stream, AnimationClip& clip);
+
+		//Reads a copy of the clip at the position of the stream.
+		static Error Read(cs::Stream& stream, AnimationClip& clip);
+
+		Error Write(cs::BinaryWriter& writer) const;
+
+		float Duration() const { return _duration; }
+
+		size_t TrackCount() const { return _tracks.size(); }
+
+		AnimationTrack const& Track(size_t index) const { return _tracks[index]; }
+
+		//The largest target of the tracks plus one.
+		size_t TargetCount() const { return _targetCount; }
+
+		size_t SizeInBytes() const { return _size; }
+
+		//Whether the clip keeps a copy of its data or views data owned elsewhere.
+		bool OwnsData() const { return !_storage.empty(); }
+
+		//Samples a Translation or Scale track. Key is the cursor of the track.
+		Vector3 SampleVector3(size_t track, float time, uintcs& key) const;
+
+		//Samples a Rotation track with Quaternion::Slerp. Key is the cursor of the track.
+		Quaternion SampleQuaternion(size_t track, float time, uintcs& key) const;
+
+		//Samples every track into the pose, blended over it by weight.
+		//The pose should have TargetCount targets; tracks of targets beyond it are skipped.
+		void Sample(float time, AnimationCursor& cursor, AnimationPose& pose, float weight = 1.0F) const;
+
+	private:
+		friend class AnimationClipBuilder;
+
+		Error bind(bytecs const* data, size_t size);
+		float findKey(AnimationTrack const& track, float time, uintcs& key) const;
+
+		std::vector<bytecs> _storage;
+		bytecs const* _data{ nullptr };
+		size_t _size{ 0 };
+		float _duration{ 0 };
+		size_t _targetCount{ 0 };
+		std::vector<AnimationTrack> _tracks;
+	};
+
+	//Builds clips from keys, dropping every key that interpolating its neighbours
+	//reproduces within the tolerance of its track.
+	class AnimationClipBuilder {
+	public:
+		AnimationClipBuilder(float duration = 0) : _duration(duration) {}
+
+		//Adds a Translation or Scale track. The tolerance is the largest distance
+		//allowed between a dropped key and the sampled value.
+		Error AddTrack(uintcs target, AnimationTrackType type, std::span<float const> times,
+			std::span<Vector3 const> values, float tolerance = 0);
+
+		//Adds a Rotation track. The tolerance is the largest distance allowed between
+		//a dropped key and the sampled value, both as unit quaternions. Quantized keys
+		//take 6 bytes instead of 16, with an error below 0.0001.
+		Error AddTrack(uintcs target, std::span<float const> times, std::span<Quaternion const> values,
+			float tolerance = 0, bool quantize = true);
+
+		Error Build(AnimationClip& clip) const;
+
+		//Keys given to AddTrack, and the keys kept of them.
+		size_t InputKeyCount() const { return _inputKeys; }
+		size_t KeyCount() const;
+
+	private:
+		struct BuilderTrack {
+			AnimationTrack Track;
+			std::vector<float> Times;
+			std::vector<Vector3> Vectors;
+			std::vector<Quaternion> Rotations;
+		};
+
+		std::vector<BuilderTrack> _tracks;
+		float _duration{ 0 };
+		size_t _inputKeys{ 0 };
+	};
+
+	//A clip playing on a character, blended over the layers before it by Weight.
+	struct AnimationLayer {
+		AnimationClip const* Clip{ nullptr };
+		//Optional, the keys are searched for without one.
+		AnimationCursor* Cursor{ nullptr };
+		float Time{ 0 };
+		float Weight{ 1 };
+		//Wraps the time into the clip instead of clamping it.
+		bool Loop{ false };
+	};
+
+	//The layers of a character and the pose they are sampled to.
+	struct AnimationInstance {
+		std::span<AnimationLayer const> Layers;
+		AnimationPose* Pose{ nullptr };
+	};
+
+	//Samples the layers in order over the pose.
+	void SampleAnimation(std::span<AnimationLayer const> layers, AnimationPose& pose);
+
+	//Samples every instance, split over the job system when one is given.
+	//Instances must not share poses or cursors.
+	void SampleAnimation(std::span<AnimationInstance const> instances, JobSystem* jobs = nullptr);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include "compiledcurve.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+using dxna::simd::Float4;
+
+namespace dxna {
+	CompiledCurve::CompiledCurve(Curve const& curve) :
+		_preLoop(curve.PreLoop), _postLoop(curve.PostLoop) {
+		const auto& keys = *curve.Keys.data;
+
+		_positions.reserve(keys.size());
+		_values.reserve(keys.size());
+
+		for (const auto& key : keys) {
+			_positions.push_back(key.Position);
+			_values.push_back(key.Value);
+		}
+
+		if (keys.empty())
+			return;
+
+		_firstTangentIn = keys.front().TangentIn;
+		_lastTangentOut = keys.back().TangentOut;
+		_segments.resize(keys.size() - 1);
+
+		for (size_t i = 0; i + 1 < keys.size(); ++i) {
+			const auto& prev = keys[i];
+			const auto& next = keys[i + 1];
+			const auto length = next.Position - prev.Position;
+			auto& segment = _segments[i];
+
+			segment.Start = prev.Position;
+			segment.InverseLength = length > 0 ? 1.0F / length : 0.0F;
+			segment.D = prev.Value;
+
+			if (prev.Continuity == CurveContinuity::Step)
+				continue;
+
+			//The Hermite basis of Curve::GetCurvePosition, expanded in powers of t.
+			const auto v0 = prev.Value;
+			const auto m0 = prev.TangentOut;
+			const auto v1 = next.Value;
+			const auto m1 = next.TangentIn;
+
+			segment.A = 2 * v0 + m0 - 2 * v1 + m1;
+			segment.B = -3 * v0 - 2 * m0 + 3 * v1 - m1;
+			segment.C = m0;
+		}
+	}
+
+	template <typename TInside>
+	float CompiledCurve::evaluate(float position, TInside&& inside) const {
+		if (isConstant())
+			return constantValue();
+
+		const auto first = _positions.front();
+		const auto last = _positions.back();
+
+		if (position >= first && position <= last)
+			return inside(position);
+
+		const auto before = position < first;
+		const auto length = last - first;
+
+		//The same cycle count as Curve::GetNumberOfCycle.
+		auto cycles = (position - first) / length;
+
+		if (cycles < 0.0F)
+			cycles--;
+
+		const auto cycle = static_cast<int>(cycles);
+		const auto offset = static_cast<float>(cycle) * length;
+
+		switch (before ? _preLoop : _postLoop) {
+		case CurveLoopType::Constant:
+			return before ? _values.front() : _values.back();
+
+		case CurveLoopType::Cycle:
+			return inside(position - offset);
+
+		case CurveLoopType::CycleOffset:
+			return inside(position - offset) + static_cast<float>(cycle) * (_values.back() - _values.front());
+
+		case CurveLoopType::Oscillate:
+			if (cycle % 2 == 0)
+				return inside(position - offset);
+
+			return inside(last - position + first + offset);
+
+		case CurveLoopType::Linear:
+			if (before)
+				return _values.front() - _firstTangentIn * (first - position);
+
+			return _values.back() + _lastTangentOut * (position - last);
+
+		default:
+			return inside(position);
+		}
+	}
+
+	float CompiledCurve::Evaluate(float position, size_t& hint) const {
+		return evaluate(position, [&](float value) { return evaluateSegment(value, hint); });
+	}
+
+	float CompiledCurve::EvaluateBaked(float position) const {
+		if (_table.empty()) {
+			size_t hint = 0;
+			return Evaluate(position, hint);
+		}
+
+		return evaluate(position, [&](float value) { return evaluateTable(value); });
+	}
+
+	//Where a position outside the keys is evaluated, and what is added to the
+	//value found there, under one loop type. The loop type is the same for
+	//every lane, so the switch does not branch per element.
+	struct LoopedPosition {
+		Float4 Position;
+		Float4 Offset;
+	};
+
+	static LoopedPosition loopPosition(CurveLoopType loop, Float4 position, Float4 cycles, Float4 wrapped,
+		Float4 mirrored, Float4 end, Float4 tangent, Float4 cycleOffset) {
+		const auto zero = Float4::Set(0.0F);
+
+		switch (loop) {
+		case CurveLoopType::Constant:
+			return { end, zero };
+
+		case CurveLoopType::Cycle:
+			return { wrapped, zero };
+
+		case CurveLoopType::CycleOffset:
+			return { wrapped, cycles * cycleOffset };
+
+		case CurveLoopType::Oscillate: {
+			const auto half = cycles * Float4::Set(0.5F);
+			return { Float4::Select(Float4::Equal(Float4::Truncate(half), half), wrapped, mirrored), zero };
+		}
+
+		case CurveLoopType::Linear:
+			return { end, tangent * (position - end) };
+
+		default:
+			return { position, zero };
+		}
+	}
+
+	Error CompiledCurve::Evaluate(std::span<const float> positions, std::span<float> values) const {
+		if (values.size() < positions.size())
+			return Error(ErrorCode::ARGUMENT_IS_SMALLER, 1);
+
+		const auto count = positions.size();
+		size_t i = 0;
+
+		if (!isConstant()) {
+			const auto zero = Float4::Set(0.0F);
+			const auto one = Float4::Set(1.0F);
+			const auto first = Float4::Set(Start());
+			const auto last = Float4::Set(End());
+			const auto length = Float4::Set(End() - Start());
+			const auto lastValue = Float4::Set(_values.back());
+			const auto cycleOffset = Float4::Set(_values.back() - _values.front());
+			const auto firstTangent = Float4::Set(_firstTangentIn);
+			const auto lastTangent = Float4::Set(_lastTangentOut);
+
+			alignas(16) float lanes[4];
+			alignas(16) float a[4], b[4], c[4], d[4], start[4], inverseLength[4];
+
+			for (; i + 4 <= count; i += 4) {
+				const auto position = Float4::Load(positions.data() + i);
+
+				//The same cycle count as Curve::GetNumberOfCycle.
+				auto cycles = (position - first) / length;
+				cycles = Float4::Truncate(cycles - Float4::Select(Float4::Less(cycles, zero), one, zero));
+
+				const auto offset = cycles * length;
+				const auto wrapped = position - offset;
+				const auto mirrored = last - position + first + offset;
+
+				const auto before = loopPosition(_preLoop, position, cycles, wrapped, mirrored, first, firstTangent, cycleOffset);
+				const auto after = loopPosition(_postLoop, position, cycles, wrapped, mirrored, last, lastTangent, cycleOffset);
+				const auto isBefore = Float4::Less(position, first);
+				const auto isAfter = Float4::Less(last, position);
+
+				auto inside = Float4::Select(isBefore, before.Position, Float4::Select(isAfter, after.Position, position));
+				const auto added = Float4::Select(isBefore, before.Offset, Float4::Select(isAfter, after.Offset, zero));
+
+				inside = Float4::Min(Float4::Max(inside, first), last);
+				inside.Store(lanes);
+
+				//Gathers the segment of each lane, then runs the cubics side by side.
+				for (int lane = 0; lane < 4; ++lane) {
+					const auto& segment = _segments[findSegment(lanes[lane])];
+
+					a[lane] = segment.A;
+					b[lane] = segment.B;
+					c[lane] = segment.C;
+					d[lane] = segment.D;
+					start[lane] = segment.Start;
+					inverseLength[lane] = segment.InverseLength;
+				}
+
+				const auto t = (inside - Float4::Load(start)) * Float4::Load(inverseLength);
+				auto value = Float4::MultiplyAdd(Float4::Load(a), t, Float4::Load(b));
+				value = Float4::MultiplyAdd(value, t, Float4::Load(c));
+				value = Float4::MultiplyAdd(value, t, Float4::Load(d));
+
+				//The last key has no segment of its own.
+				value = Float4::Select(Float4::Less(inside, last), value, lastValue);
+
+				(value + added).Store(values.data() + i);
+			}
+		}
+
+		for (; i < count; ++i)
+			values[i] = Evaluate(positions[i]);
+
+		return NoError;
+	}
+
+	Error CompiledCurve::Bake(size_t resolution) {
+		resolution = std::max<size_t>(resolution, 2);
+		_table.resize(resolution);
+
+		if (isConstant()) {
+			std::fill(_table.begin(), _table.end(), constantValue());
+			_tableScale = 0;
+			_bakedError = 0;
+			return NoError;
+		}
+
+		const auto start = Start();
+		const auto length = End() - start;
+		const auto step = length / static_cast<float>(resolution - 1);
+		size_t hint = 0;
+
+		for (size_t i = 0; i + 1 < resolution; ++i)
+			_table[i] = evaluateSegment(start + step * static_cast<float>(i), hint);
+
+		_table[resolution - 1] = _values.back();
+		_tableScale = static_cast<float>(resolution - 1) / length;
+		_bakedError = measureError();
+
+		return NoError;
+	}
+
+	Error CompiledCurve::Bake(float tolerance, size_t maxResolution) {
+		if (tolerance < 0)
+			return Error(ErrorCode::ARGUMENT_LESS_ZERO, 0);
+
+		maxResolution = std::max<size_t>(maxResolution, 2);
+
+		for (size_t resolution = 2; ; resolution *= 2) {
+			resolution = std::min(resolution, maxResolution);
+			Bake(resolution);
+
+			if (_bakedError <= tolerance)
+				return NoError;
+
+			if (resolution == maxResolution)
+				return Error(ErrorCode::CURVE_TOLERANCE_NOT_MET);
+		}
+	}
+
+	float CompiledCurve::evaluateSegment(float position, size_t& hint) const {
+		const auto& positions = _positions;
+
+		if (position >= positions.back())
+			return _values.back();
+
+		position = std::max(position, positions.front());
+
+		//Segment i covers [positions[i], positions[i + 1]). Try the hint and the
+		//segment after it before searching.
+		auto index = hint;
+
+		if (index >= _segments.size() || !(position >= positions[index] && position < positions[index + 1])) {
+			if (index + 2 < positions.size() && position >= positions[index + 1] && position < positions[index + 2]) {
+				++index;
+			}
+			else {
+				index = findSegment(position);
+			}
+		}
+
+		hint = index;
+
+		const auto& segment = _segments[index];
+		const auto t = (position - segment.Start) * segment.InverseLength;
+
+		return ((segment.A * t + segment.B) * t + segment.C) * t + segment.D;
+	}
+
+	size_t CompiledCurve::findSegment(float position) const {
+		//Branchless search for the last key at or before the position,
+		//random positions would mispredict most branches of std::upper_bound.
+		const auto* base = _positions.data();
+		auto count = _positions.size();
+
+		while (count > 1) {
+			const auto half = count / 2;
+			base = base[half] <= position ? base + half : base;
+			count -= half;
+		}
+
+		return std::min(static_cast<size_t>(base - _positions.data()), _segments.size() - 1);
+	}
+
+	float CompiledCurve::evaluateTable(float position) const {
+		const auto last = _table.size() - 1;
+		const auto x = std::clamp((position - Start()) * _tableScale, 0.0F, static_cast<float>(last));
+		const auto index = std::min(static_cast<size_t>(x), last - 1);
+		const auto fraction = x - static_cast<float>(index);
+
+		return _table[index] + (_table[index + 1] - _table[index]) * fraction;
+	}
+
+	float CompiledCurve::measureError() const {
+		//Compares inside every table interval and at the keys, where steps are.
+		constexpr float Fractions[] = { 0.125F, 0.375F, 0.5F, 0.625F, 0.875F };
+
+		const auto start = Start();
+		const auto step = (End() - start) / static_cast<float>(_table.size() - 1);
+		float error = 0;
+		size_t hint = 0;
+
+		for (size_t i = 0; i + 1 < _table.size(); ++i) {
+			for (const auto fraction : Fractions) {
+				const auto position = start + step * (static_cast<float>(i) + fraction);
+				error = std::max(error, std::abs(evaluateTable(position) - evaluateSegment(position, hint)));
+			}
+		}
+
+		for (const auto position : _positions)
+			error = std::max(error, std::abs(evaluateTable(position) - evaluateSegment(position, hint)));
+
+		return error;
+	}
+}
\ No newline at end of file
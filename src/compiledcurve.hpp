@@ -0,0 +1,108 @@
+#ifndef DXNA_COMPILEDCURVE_HPP
+#define DXNA_COMPILEDCURVE_HPP
+
+#include <vector>
+#include <span>
+#include "curve.hpp"
+#include "error.hpp"
+
+namespace dxna {
+	//A read-only copy of a Curve laid out for evaluation.
+	//The keys are flattened into arrays and each segment keeps its Hermite polynomial,
+	//so evaluating is a binary search plus a cubic. Results match Curve::Evaluate
+	//up to float rounding.
+	class CompiledCurve {
+	public:
+		//A segment of the curve, between two keys.
+		struct Segment {
+			float Start{ 0 };
+			float InverseLength{ 0 };
+			//Value(t) = ((A * t + B) * t + C) * t + D, with t in [0, 1].
+			float A{ 0 };
+			float B{ 0 };
+			float C{ 0 };
+			float D{ 0 };
+		};
+
+		CompiledCurve() = default;
+
+		CompiledCurve(Curve const& curve);
+
+		//Evaluates the curve at the position, finding the segment with a binary search.
+		float Evaluate(float position) const {
+			size_t hint = 0;
+			return Evaluate(position, hint);
+		}
+
+		//Evaluates the curve starting the segment search at hint, which is updated.
+		//Keep one hint per caller: when the position moves little between calls,
+		//as time does, the segment is found in constant time.
+		float Evaluate(float position, size_t& hint) const;
+
+		//Evaluates the curve at every position, four at a time with SIMD.
+		//Values must hold at least as many elements as positions.
+		Error Evaluate(std::span<const float> positions, std::span<float> values) const;
+
+		//Samples the curve at resolution evenly spaced positions between the first
+		//and the last key, for EvaluateBaked. Resolution is at least 2.
+		Error Bake(size_t resolution);
+
+		//Bakes with the lowest power of two resolution whose error does not exceed
+		//the tolerance. Fails if maxResolution is not enough; the table of
+		//maxResolution samples is kept in that case.
+		Error Bake(float tolerance, size_t maxResolution);
+
+		//Evaluates the curve by linear interpolation of the baked table. Positions
+		//outside the keys follow PreLoop and PostLoop as in Evaluate.
+		float EvaluateBaked(float position) const;
+
+		bool IsBaked() const { return !_table.empty(); }
+
+		size_t BakedResolution() const { return _table.size(); }
+
+		//The largest difference found between EvaluateBaked and Evaluate.
+		float BakedError() const { return _bakedError; }
+
+		size_t KeyCount() const { return _positions.size(); }
+
+		std::vector<Segment> const& Segments() const { return _segments; }
+
+		float Start() const { return _positions.empty() ? 0.0F : _positions.front(); }
+
+		float End() const { return _positions.empty() ? 0.0F : _positions.back(); }
+
+		CurveLoopType PreLoop() const { return _preLoop; }
+
+		CurveLoopType PostLoop() const { return _postLoop; }
+
+	private:
+		template <typename TInside>
+		float evaluate(float position, TInside&& inside) const;
+
+		//No keys, one key or every key at one position: there is no length to loop over,
+		//so the curve is the value of its first key everywhere.
+		bool isConstant() const { return _positions.size() < 2 || !(_positions.back() > _positions.front()); }
+
+		float constantValue() const { return _positions.empty() ? 0.0F : _values[0]; }
+
+		float evaluateSegment(float position, size_t& hint) const;
+		size_t findSegment(float position) const;
+		float evaluateTable(float position) const;
+		float measureError() const;
+
+		CurveLoopType _preLoop{ CurveLoopType::Constant };
+		CurveLoopType _postLoop{ CurveLoopType::Constant };
+
+		std::vector<float> _positions;
+		std::vector<float> _values;
+		float _firstTangentIn{ 0 };
+		float _lastTangentOut{ 0 };
+		std::vector<Segment> _segments;
+
+		std::vector<float> _table;
+		float _tableScale{ 0 };
+		float _bakedError{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
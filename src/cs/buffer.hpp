@@ -2,13 +2,15 @@
 #define DXNA_CS_BUFFER_HPP
 
 #include "cstypes.hpp"
+#include <cstddef>
+#include <cstring>
 
 namespace cs {
 	class Buffer {
 	public:
 		template <typename T>
-		static void BlockCopy(T const* src, rsize_t srcOffset, T* dst, rsize_t dstOffset, rsize_t byteCount) {
-			memmove_s(dst + dstOffset, byteCount, src + srcOffset, byteCount);
+		static void BlockCopy(T const* src, size_t srcOffset, T* dst, size_t dstOffset, size_t byteCount) {
+			std::memmove(dst + dstOffset, src + srcOffset, byteCount);
 		}
 
 	private:
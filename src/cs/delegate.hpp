@@ -0,0 +1,175 @@
+#ifndef DXNA_CS_DELEGATE_HPP
+#define DXNA_CS_DELEGATE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cs {
+	template <typename TSignature>
+	class Delegate;
+
+	//Holds any callable of the signature: a function pointer, a lambda with captures or an
+	//object and one of its member functions. Callables up to BufferSize bytes are stored
+	//inside the delegate, so creating, copying and calling them does not allocate.
+	template <typename TResult, typename... TArgs>
+	class Delegate<TResult(TArgs...)> {
+	public:
+		static constexpr size_t BufferSize = 3 * sizeof(void*);
+
+		constexpr Delegate() noexcept = default;
+		constexpr Delegate(std::nullptr_t) noexcept {}
+
+		template <typename TFunc>
+			requires (!std::is_same_v<std::decay_t<TFunc>, Delegate> && std::is_invocable_r_v<TResult, std::decay_t<TFunc>&, TArgs...>)
+		Delegate(TFunc&& func) {
+			assign<std::decay_t<TFunc>>(std::forward<TFunc>(func));
+		}
+
+		//Calls method on object, which must outlive the delegate.
+		template <typename TObject>
+		Delegate(TObject* object, TResult(TObject::* method)(TArgs...)) :
+			Delegate([object, method](TArgs... args) -> TResult { return (object->*method)(std::forward<TArgs>(args)...); }) {
+		}
+
+		template <typename TObject>
+		Delegate(TObject const* object, TResult(TObject::* method)(TArgs...) const) :
+			Delegate([object, method](TArgs... args) -> TResult { return (object->*method)(std::forward<TArgs>(args)...); }) {
+		}
+
+		Delegate(Delegate const& other) {
+			if (other._manage != nullptr)
+				other._manage(Operation::Copy, *this, const_cast<Delegate&>(other));
+		}
+
+		Delegate(Delegate&& other) noexcept {
+			if (other._manage != nullptr)
+				other._manage(Operation::Move, *this, other);
+		}
+
+		~Delegate() {
+			reset();
+		}
+
+		Delegate& operator=(Delegate const& other) {
+			if (this != &other) {
+				Delegate copy(other);
+				*this = std::move(copy);
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(Delegate&& other) noexcept {
+			if (this != &other) {
+				reset();
+
+				if (other._manage != nullptr)
+					other._manage(Operation::Move, *this, other);
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+
+		TResult operator()(TArgs... args) const {
+			return _invoke(const_cast<Delegate&>(*this).target(), std::forward<TArgs>(args)...);
+		}
+
+		explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+		//Whether the callable lives in the delegate rather than on the heap.
+		bool IsInline() const noexcept { return _invoke != nullptr && !_onHeap; }
+
+	private:
+		enum class Operation {
+			Copy,
+			Move,
+			Destroy
+		};
+
+		using Invoker = TResult(*)(void* target, TArgs&&... args);
+		using Manager = void(*)(Operation operation, Delegate& destination, Delegate& source);
+
+		template <typename TFunc>
+		static constexpr bool fits = sizeof(TFunc) <= BufferSize
+			&& alignof(TFunc) <= alignof(void*)
+			&& std::is_nothrow_move_constructible_v<TFunc>;
+
+		template <typename TFunc, typename TValue>
+		void assign(TValue&& func) {
+			if constexpr (fits<TFunc>) {
+				::new (static_cast<void*>(_buffer)) TFunc(std::forward<TValue>(func));
+				_onHeap = false;
+			}
+			else {
+				_heap = new TFunc(std::forward<TValue>(func));
+				_onHeap = true;
+			}
+
+			_invoke = [](void* target, TArgs&&... args) -> TResult {
+				return (*static_cast<TFunc*>(target))(std::forward<TArgs>(args)...);
+			};
+
+			_manage = &manage<TFunc>;
+		}
+
+		template <typename TFunc>
+		static void manage(Operation operation, Delegate& destination, Delegate& source) {
+			switch (operation)
+			{
+			case Operation::Copy:
+				destination.template assign<TFunc>(*static_cast<TFunc const*>(source.target()));
+				return;
+			case Operation::Move:
+				if (source._onHeap)
+					destination._heap = source._heap;
+				else {
+					::new (static_cast<void*>(destination._buffer)) TFunc(std::move(*static_cast<TFunc*>(source.target())));
+					static_cast<TFunc*>(source.target())->~TFunc();
+				}
+
+				destination._onHeap = source._onHeap;
+				destination._invoke = source._invoke;
+				destination._manage = source._manage;
+				source._invoke = nullptr;
+				source._manage = nullptr;
+				return;
+			case Operation::Destroy:
+				if (source._onHeap)
+					delete static_cast<TFunc*>(source._heap);
+				else
+					static_cast<TFunc*>(source.target())->~TFunc();
+				return;
+			}
+		}
+
+		void* target() noexcept {
+			return _onHeap ? _heap : static_cast<void*>(_buffer);
+		}
+
+		void reset() noexcept {
+			if (_manage != nullptr)
+				_manage(Operation::Destroy, *this, *this);
+
+			_invoke = nullptr;
+			_manage = nullptr;
+		}
+
+		union {
+			alignas(void*) std::byte _buffer[BufferSize];
+			void* _heap;
+		};
+
+		Invoker _invoke{ nullptr };
+		Manager _manage{ nullptr };
+		bool _onHeap{ false };
+	};
+}
+
+#endif
\ No newline at end of file
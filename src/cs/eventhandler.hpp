@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <algorithm>
+#include <type_traits>
+#include "cstypes.hpp"
+#include "delegate.hpp"
 
 namespace cs {
 	class EventArgs {
@@ -10,46 +13,189 @@ namespace cs {
 		constexpr EventArgs() = default;
 
 		virtual ~EventArgs() {
-		}		
+		}
 
 		static EventArgs Empty() {
 			return EventArgs();
-		}		
+		}
+	};
+
+	//Identifies a subscription, to remove it later. Zero is no subscription.
+	struct EventToken {
+		ulongcs Id{ 0 };
+
+		constexpr bool IsValid() const { return Id != 0; }
+
+		constexpr bool operator==(EventToken const& other) const = default;
 	};
 
+	//Handlers are called in the order they subscribed. They may subscribe and unsubscribe
+	//while the event is being invoked: new handlers are called from the next Invoke on.
 	template <typename TOBJECT, typename TEVENTARGS>
 	class EventHandler {
 	public:
 		using EventHandlerCallBack = void(*)(TOBJECT const& sender, TEVENTARGS const& e);
+		using Callback = Delegate<void(TOBJECT const&, TEVENTARGS const&)>;
 
-		constexpr void operator+=(EventHandlerCallBack const& del) {
-			delegates.push_back(del);
+		void operator+=(EventHandlerCallBack const& del) {
+			Subscribe(del);
 		}
 
-		constexpr void operator-=(EventHandlerCallBack const& del) {
-			std::remove(delegates.begin(), delegates.end(), del);
+		//Removes the last subscription of the function, as C# does.
+		void operator-=(EventHandlerCallBack const& del) {
+			for (size_t i = delegates.size(); i > 0; --i) {
+				if (delegates[i - 1].Function == del && delegates[i - 1].Id != 0) {
+					remove(i - 1);
+					return;
+				}
+			}
+
+			for (size_t i = pending.size(); i > 0; --i) {
+				if (pending[i - 1].Function == del) {
+					pending.erase(pending.begin() + (i - 1));
+					return;
+				}
+			}
+		}
+
+		//Subscribes a callable taking the sender and the arguments, only the arguments or nothing.
+		template <typename TFunc>
+		EventToken Subscribe(TFunc&& func) {
+			using TDecay = std::decay_t<TFunc>;
+			Entry entry;
+
+			if constexpr (std::is_convertible_v<TDecay, EventHandlerCallBack>)
+				entry.Function = func;
+
+			if constexpr (std::is_invocable_v<TDecay&, TOBJECT const&, TEVENTARGS const&>)
+				entry.Call = Callback(std::forward<TFunc>(func));
+			else if constexpr (std::is_invocable_v<TDecay&, TEVENTARGS const&>)
+				entry.Call = Callback([func = TDecay(std::forward<TFunc>(func))](TOBJECT const&, TEVENTARGS const& e) mutable { func(e); });
+			else {
+				static_assert(std::is_invocable_v<TDecay&>, "The handler must take (sender, e), (e) or nothing.");
+				entry.Call = Callback([func = TDecay(std::forward<TFunc>(func))](TOBJECT const&, TEVENTARGS const&) mutable { func(); });
+			}
+
+			return add(std::move(entry));
+		}
+
+		//Subscribes a member function of object, which must outlive the subscription.
+		template <typename TObject>
+		EventToken Subscribe(TObject* object, void(TObject::* method)(TOBJECT const&, TEVENTARGS const&)) {
+			Entry entry;
+			entry.Call = Callback(object, method);
+			return add(std::move(entry));
+		}
+
+		//Removes the subscription. Returns false if it was already removed.
+		bool Unsubscribe(EventToken const& token) {
+			if (!token.IsValid())
+				return false;
+
+			const auto byId = [&](Entry const& entry) { return entry.Id == token.Id; };
+			const auto found = std::find_if(delegates.begin(), delegates.end(), byId);
+
+			if (found != delegates.end()) {
+				remove(static_cast<size_t>(found - delegates.begin()));
+				return true;
+			}
+
+			const auto waiting = std::find_if(pending.begin(), pending.end(), byId);
+
+			if (waiting != pending.end()) {
+				pending.erase(waiting);
+				return true;
+			}
+
+			return false;
 		}
 
+		//Calls every handler. Does not allocate.
 		void Invoke(TOBJECT const& obj, TEVENTARGS const& e) const {
 			if (delegates.empty())
 				return;
 
+			const InvokeScope scope(*this);
 			const auto size = delegates.size();
 
 			for (size_t i = 0; i < size; ++i) {
-				const EventHandlerCallBack del = delegates[i];
+				const auto& del = delegates[i];
 
-				if (del != nullptr)
-					del(obj, e);
+				if (del.Id != 0)
+					del.Call(obj, e);
 			}
 		}
 
 		constexpr bool IsEmpty() const {
-			return delegates.empty();
+			return Count() == 0;
+		}
+
+		constexpr size_t Count() const {
+			return delegates.size() - removed + pending.size();
 		}
 
 	private:
-		std::vector<EventHandlerCallBack> delegates;
+		struct Entry {
+			ulongcs Id{ 0 };
+			//The function pointer subscribed, for operator-=.
+			EventHandlerCallBack Function{ nullptr };
+			Callback Call;
+		};
+
+		//Counts an Invoke while it runs, and tidies up when the outermost one ends, even if a handler throws.
+		struct InvokeScope {
+			EventHandler const& Handler;
+
+			InvokeScope(EventHandler const& handler) : Handler(handler) {
+				++Handler.invoking;
+			}
+
+			~InvokeScope() {
+				if (--Handler.invoking == 0 && (Handler.removed || !Handler.pending.empty()))
+					Handler.settle();
+			}
+		};
+
+		EventToken add(Entry&& entry) {
+			entry.Id = ++lastId;
+			const EventToken token{ entry.Id };
+
+			//Adding to delegates could move the handler being called.
+			if (invoking > 0)
+				pending.push_back(std::move(entry));
+			else
+				delegates.push_back(std::move(entry));
+
+			return token;
+		}
+
+		void remove(size_t index) {
+			if (invoking > 0) {
+				delegates[index].Id = 0;
+				++removed;
+			}
+			else
+				delegates.erase(delegates.begin() + index);
+		}
+
+		void settle() const {
+			if (removed > 0) {
+				delegates.erase(std::remove_if(delegates.begin(), delegates.end(), [](Entry const& entry) { return entry.Id == 0; }), delegates.end());
+				removed = 0;
+			}
+
+			for (auto& entry : pending)
+				delegates.push_back(std::move(entry));
+
+			pending.clear();
+		}
+
+		//Invoke is const, but tidies up the subscriptions changed while it ran.
+		mutable std::vector<Entry> delegates;
+		mutable std::vector<Entry> pending;
+		mutable size_t removed{ 0 };
+		mutable size_t invoking{ 0 };
+		ulongcs lastId{ 0 };
 	};
 }
 
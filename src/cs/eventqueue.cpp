@@ -0,0 +1,78 @@
+#include "eventqueue.hpp"
+#include <algorithm>
+
+namespace cs {
+	void* EventQueue::allocate(size_t size) {
+		size = roundUp(size);
+
+		auto& buffer = _buffers[_write];
+
+		while (buffer.Current < buffer.Blocks.size()) {
+			auto& block = buffer.Blocks[buffer.Current];
+
+			if (block.Capacity - block.Used >= size) {
+				auto data = block.Data.get() + block.Used;
+				block.Used += size;
+				++buffer.Count;
+				return data;
+			}
+
+			++buffer.Current;
+		}
+
+		//Events larger than a block get one of their own.
+		Block block;
+		block.Capacity = std::max(BlockSize, size);
+		block.Data = std::make_unique<std::byte[]>(block.Capacity);
+		block.Used = size;
+
+		auto data = block.Data.get();
+		buffer.Blocks.push_back(std::move(block));
+		buffer.Current = buffer.Blocks.size() - 1;
+		++buffer.Count;
+
+		return data;
+	}
+
+	void EventQueue::finish(Buffer& buffer, bool invoke) {
+		if (buffer.Count == 0)
+			return;
+
+		for (auto& block : buffer.Blocks) {
+			size_t offset = 0;
+
+			while (offset < block.Used) {
+				auto record = reinterpret_cast<RecordHeader*>(block.Data.get() + offset);
+				offset += record->Size;
+				record->Finish(record, invoke);
+			}
+
+			block.Used = 0;
+		}
+
+		buffer.Current = 0;
+		buffer.Count = 0;
+	}
+
+	size_t EventQueue::Dispatch() {
+		//Nested, it would flip the buffers back and finish the one the outer Dispatch is reading.
+		if (_dispatching)
+			return 0;
+
+		auto& buffer = _buffers[_write];
+		const auto count = buffer.Count;
+
+		//Handlers raising events write to the other buffer.
+		_write ^= 1;
+		_dispatching = true;
+		finish(buffer, true);
+		_dispatching = false;
+
+		return count;
+	}
+
+	void EventQueue::Clear() {
+		finish(_buffers[0], false);
+		finish(_buffers[1], false);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#ifndef DXNA_CS_EVENTQUEUE_HPP
+#define DXNA_CS_EVENTQUEUE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+#include "eventhandler.hpp"
+
+namespace cs {
+	//Collects events raised during an update and invokes them later, in one pass and in
+	//the order they were raised. Events of any type share the queue: each is copied with
+	//its arguments into blocks that are kept between passes, so once the blocks have grown
+	//to the largest batch neither Raise nor Dispatch allocates.
+	//The handler and the sender of a queued event must outlive its dispatch.
+	class EventQueue {
+	public:
+		static constexpr size_t BlockSize = 4096;
+
+		EventQueue() = default;
+		EventQueue(EventQueue const&) = delete;
+		EventQueue& operator=(EventQueue const&) = delete;
+
+		~EventQueue() {
+			Clear();
+		}
+
+		template <typename TOBJECT, typename TEVENTARGS>
+		void Raise(EventHandler<TOBJECT, TEVENTARGS> const& handler, TOBJECT const& sender, TEVENTARGS const& e) {
+			using TRecord = Record<TOBJECT, TEVENTARGS>;
+			static_assert(alignof(TRecord) <= alignof(std::max_align_t), "Over-aligned event arguments are not supported.");
+
+			::new (allocate(sizeof(TRecord))) TRecord(handler, sender, e);
+		}
+
+		//Invokes the queued events. Events raised by the handlers wait for the next Dispatch.
+		//Returns how many events were invoked. A Dispatch called by a handler invokes nothing and returns 0.
+		size_t Dispatch();
+
+		//Drops the queued events without invoking them.
+		void Clear();
+
+		size_t Count() const { return _buffers[_write].Count; }
+
+		bool IsEmpty() const { return Count() == 0; }
+
+	private:
+		struct RecordHeader {
+			//Invokes the event if invoke is true, then destroys the record.
+			void(*Finish)(RecordHeader* record, bool invoke);
+			size_t Size;
+		};
+
+		template <typename TOBJECT, typename TEVENTARGS>
+		struct Record : RecordHeader {
+			EventHandler<TOBJECT, TEVENTARGS> const* Handler;
+			TOBJECT const* Sender;
+			TEVENTARGS Args;
+
+			Record(EventHandler<TOBJECT, TEVENTARGS> const& handler, TOBJECT const& sender, TEVENTARGS const& e) :
+				RecordHeader{ &finish, roundUp(sizeof(Record)) }, Handler(&handler), Sender(&sender), Args(e) {
+			}
+
+			static void finish(RecordHeader* header, bool invoke) {
+				auto record = static_cast<Record*>(header);
+
+				if (invoke)
+					record->Handler->Invoke(*record->Sender, record->Args);
+
+				record->~Record();
+			}
+		};
+
+		struct Block {
+			std::unique_ptr<std::byte[]> Data;
+			size_t Capacity{ 0 };
+			size_t Used{ 0 };
+		};
+
+		//The blocks of one batch, filled in order.
+		struct Buffer {
+			std::vector<Block> Blocks;
+			size_t Current{ 0 };
+			size_t Count{ 0 };
+		};
+
+		static constexpr size_t roundUp(size_t size) {
+			constexpr auto alignment = alignof(std::max_align_t);
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+
+		void* allocate(size_t size);
+
+		static void finish(Buffer& buffer, bool invoke);
+
+		Buffer _buffers[2];
+		size_t _write{ 0 };
+		bool _dispatching{ false };
+	};
+}
+
+#endif
\ No newline at end of file
@@ -3,11 +3,14 @@
 
 #include "cstypes.hpp"
 #include "enumerations.hpp"
+#include "../profiler.hpp"
 #include <vector>
 #include <memory>
 #include <fstream>
 #include <string>
 #include <filesystem>
+#include <algorithm>
+#include <span>
 
 namespace cs {
 	class Stream {
@@ -50,7 +53,7 @@ namespace cs {
 		FileStream(std::string const& path) {
 
 			const auto exists = std::filesystem::exists(path);
-			int flags = std::fstream::in
+			std::ios_base::openmode flags = std::fstream::in
 				| std::fstream::out
 				| std::fstream::binary
 				| std::fstream::ate;
@@ -94,6 +97,8 @@ namespace cs {
 		}
 
 		virtual intcs Read(bytecs* buffer, intcs bufferLength, intcs offset, intcs count) override {
+			DXNA_PROFILE_SCOPE("FileStream::Read");
+
 			if (!CanRead())
 				return -1;
 
@@ -126,7 +131,7 @@ namespace cs {
 			if (!CanSeek())
 				return -1;
 
-			int seek;
+			std::ios_base::seekdir seek;
 
 			switch (origin)
 			{
@@ -152,6 +157,8 @@ namespace cs {
 		}
 
 		virtual void Write(bytecs const* buffer, intcs bufferLength, intcs offset, intcs count) override {
+			DXNA_PROFILE_SCOPE("FileStream::Write");
+
 			if (!CanWrite())
 				return;
 
@@ -284,24 +291,15 @@ namespace cs {
 			if (buffer == nullptr || bufferLength - offset < count || offset < 0 || count < 0 || !_isOpen)
 				return -1;
 
+			if (_position >= _length)
+				return 0;
+
 			auto byteCount = _length - _position;
 
-			if (byteCount > count)
+			if (byteCount > static_cast<size_t>(count))
 				byteCount = count;
 
-			if (byteCount <= 8)
-			{
-				auto num = byteCount;
-				while (--num >= 0)
-					buffer[offset + num] = _buffer[_position + num];
-			}
-			else {
-				size_t bufferIndex = 0;
-				for (size_t i = _position; i < _position + byteCount; ++i) {
-					buffer[bufferIndex + offset] = _buffer[i];
-					++bufferIndex;
-				}
-			}
+			std::copy_n(_buffer.data() + _position, byteCount, buffer + offset);
 
 			_position += byteCount;
 			return static_cast<intcs>(byteCount);
@@ -444,6 +442,16 @@ namespace cs {
 
 		virtual void WriteTo(Stream* stream) const;
 
+		//The bytes of the stream, from its origin to its length, without copying them.
+		//Fails if the buffer is not publicly visible. The span is invalidated by writes.
+		constexpr bool TryGetBuffer(std::span<bytecs const>& buffer) const noexcept {
+			if (!_exposable || !_isOpen)
+				return false;
+
+			buffer = std::span<bytecs const>(_buffer.data() + _origin, _length - _origin);
+			return true;
+		}
+
 	private:
 		constexpr bool EnsureCapacity(intcs value) {
 			if (value < 0)
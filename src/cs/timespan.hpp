@@ -22,12 +22,12 @@ namespace cs {
 		constexpr TimeSpan(int32_t days, int32_t hours, int32_t minutes, int32_t seconds, int32_t milliseconds) :
 			_ticks(DayToTicks(days, hours, minutes, seconds, milliseconds)) {}
 
-		constexpr TimeSpan operator -(TimeSpan const& t) {
-			return TimeSpan(-t._ticks);
+		constexpr TimeSpan operator -() const {
+			return TimeSpan(-_ticks);
 		}
 
-		constexpr TimeSpan operator +(TimeSpan const& t) {
-			return t;
+		constexpr TimeSpan operator +() const {
+			return *this;
 		}
 
 		constexpr friend TimeSpan operator +(TimeSpan const& t1, TimeSpan const& t2) {
@@ -0,0 +1,8 @@
+#include "curve.hpp"
+#include "compiledcurve.hpp"
+
+namespace dxna {
+	Error Curve::Evaluate(std::span<const float> positions, std::span<float> values) const {
+		return CompiledCurve(*this).Evaluate(positions, values);
+	}
+}
\ No newline at end of file
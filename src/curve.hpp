@@ -4,7 +4,11 @@
 #include "enumerations.hpp"
 #include "utility.hpp"
 #include "types.hpp"
+#include "error.hpp"
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <span>
 
 namespace dxna {
 
@@ -51,42 +55,35 @@ namespace dxna {
 			data = NewVector<CurveKey>();
 		}
 
-		constexpr CurveKey* operator[](size_t index) {
+		CurveKey* operator[](size_t index) {
 			if (data->empty() || index >= data->size())
 				return nullptr;
 
 			return &data->at(index);
 		}
 
-		constexpr CurveKey* At(size_t index) {
+		CurveKey* At(size_t index) {
 			if (data->empty() || index >= data->size())
 				return nullptr;
 
 			return &data->at(index);
 		}
 
-		constexpr size_t Count() const noexcept { return data->size(); }
+		size_t Count() const noexcept { return data->size(); }
 
-		constexpr CurveKey* Last() const {
+		CurveKey* Last() const {
 			return data->empty() ? nullptr : &data->at(data->size() - 1);
 		}
 
-		constexpr void Add(CurveKey const& item) const {
-			if (Count() == 0) {
-				data->push_back(item);
-			}
-
-			for (size_t i = 0; i < data->size(); ++i) {
-				if (item.Position < data->at(i).Position) {
-					data->insert(data->begin() + i, item);
-					return;
-				}
-			}
+		//Inserts the key after the keys with a lower or equal position.
+		void Add(CurveKey const& item) const {
+			const auto next = std::upper_bound(data->begin(), data->end(), item.Position,
+				[](float position, CurveKey const& key) { return position < key.Position; });
 
-			data->push_back(item);
+			data->insert(next, item);
 		}
 
-		constexpr void Clear() const noexcept {
+		void Clear() const noexcept {
 			data->clear();
 		}
 
@@ -99,12 +96,12 @@ namespace dxna {
 		Curve() = default;
 
 		//Returns true if this curve is constant (has zero or one points).
-		constexpr bool IsConstant() const noexcept {
+		bool IsConstant() const noexcept {
 			return Keys.Count() <= 1;
 		}
 
 		// Evaluate the value at a position of this Curve.
-		constexpr float Evaluate(float position) {
+		float Evaluate(float position) {
 			if (Keys.Count() == 0)
 				return 0.0F;
 
@@ -178,23 +175,30 @@ namespace dxna {
 					return GetCurvePosition(virtualPos);
 
 				case dxna::CurveLoopType::Linear:
-					return last->Value + first->TangentOut * (position - last->Position);
+					return last->Value + last->TangentOut * (position - last->Position);
 
 				default:
 					break;
 				}
 			}
+
+			//The position is inside the curve.
+			return GetCurvePosition(position);
 		}
 
+		// Evaluates the curve at every position, four at a time with SIMD.
+		// Compiles the curve on each call; keep a CompiledCurve to evaluate it repeatedly.
+		Error Evaluate(std::span<const float> positions, std::span<float> values) const;
+
 		// Computes tangents for all keys in the collection.
-		constexpr void ComputeTangents(CurveTangent const& tangentInType, CurveTangent const& tangentOutType) {
+		void ComputeTangents(CurveTangent const& tangentInType, CurveTangent const& tangentOutType) {
 			for (size_t i = 0; i < Keys.Count(); ++i) {
 				ComputeTangent(i, tangentInType, tangentOutType);
 			}
 		}
 
 		// Computes tangents for all keys in the collection.
-		constexpr void ComputeTangent(size_t keyIndex, CurveTangent tangentInType, CurveTangent tangentOutType) {
+		void ComputeTangent(size_t keyIndex, CurveTangent tangentInType, CurveTangent tangentOutType) {
 			auto key = Keys[keyIndex];
 
 			float p0, p, p1;
@@ -260,32 +264,32 @@ namespace dxna {
 		}
 
 		float GetCurvePosition(float position) {			
-			auto& prev = *Keys[0];
+			const auto* prev = Keys[0];
 
 			for (size_t i = 1; i < Keys.Count(); ++i) {
 				const auto& next = *Keys[i];
 
 				if (next.Position >= position) {
-					if (prev.Continuity == CurveContinuity::Step) {
-						if (position >= 1.0f) {
+					if (prev->Continuity == CurveContinuity::Step) {
+						if (position >= next.Position) {
 							return next.Value;
 						}
 
-						return prev.Value;
+						return prev->Value;
 					}
 
-					const auto t = (position - prev.Position) / (next.Position - prev.Position);
+					const auto t = (position - prev->Position) / (next.Position - prev->Position);
 					const auto ts = t * t;
 					const auto tss = ts * t;
 
 					return (2 * tss - 3 * ts + 1.0f)
-						* prev.Value + (tss - 2 * ts + t) 
-						* prev.TangentOut + (3 * ts - 2 * tss) 
+						* prev->Value + (tss - 2 * ts + t) 
+						* prev->TangentOut + (3 * ts - 2 * tss) 
 						* next.Value + (tss - ts) 
 						* next.TangentIn;
 				}
 
-				prev = next;
+				prev = &next;
 			}
 
 			return 0.0f;
@@ -294,10 +298,10 @@ namespace dxna {
 	public:
 		// Defines how to handle weighting 
 		// values that are less than the first control point in the curve.
-		CurveLoopType PreLoop;
+		CurveLoopType PreLoop{ CurveLoopType::Constant };
 		// Defines how to handle weighting values that are greater than the
 		// last control point in the curve.
-		CurveLoopType PostLoop;
+		CurveLoopType PostLoop{ CurveLoopType::Constant };
 		// The collection of curve keys.
 		CurveKeyCollection Keys;
 	};
@@ -22,7 +22,36 @@ namespace dxna {
 		CS_STREAM_IS_NULL,
 		CS_STREAM_READ_RANGE_ERROR,
 		CS_STREAM_ENDOFFILE,
-		CS_STREAM_BAD_FORMAT_7BIT		
+		CS_STREAM_BAD_FORMAT_7BIT,
+
+		CURVE_TOLERANCE_NOT_MET,
+
+		ANIMATION_BAD_FORMAT,
+		ANIMATION_KEYS_NOT_SORTED,
+		ANIMATION_TARGET_OUT_OF_RANGE,
+
+		INPUT_BAD_RECORDING,
+
+		GRAPHICS_NO_BACKEND,
+		GRAPHICS_STATE_IS_NULL,
+		GRAPHICS_VIEWPORT_NOT_SET,
+		GRAPHICS_INVALID_VIEWPORT,
+		GRAPHICS_INVALID_CONSTANT_SLOT,
+		GRAPHICS_CONSTANT_DATA_OUT_OF_RANGE,
+		GRAPHICS_INVALID_PRIMITIVE_COUNT,
+		GRAPHICS_UNKNOWN_COMMAND,
+		GRAPHICS_INVALID_TEXTURE_SLOT,
+		GRAPHICS_VERTEX_DATA_NOT_SET,
+		GRAPHICS_INDEX_DATA_NOT_SET,
+		GRAPHICS_INDEX_OUT_OF_RANGE,
+		GRAPHICS_UNSUPPORTED_PRIMITIVE,
+		GRAPHICS_INVALID_LEVEL,
+		GRAPHICS_INVALID_RECTANGLE,
+		GRAPHICS_INVALID_ELEMENT_SIZE,
+		GRAPHICS_BEGIN_NOT_CALLED,
+		GRAPHICS_BEGIN_ALREADY_CALLED,
+		GRAPHICS_RESOURCE_EVICTED,
+		GRAPHICS_UNSUPPORTED_STATE
 	};
 }
 
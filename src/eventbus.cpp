@@ -0,0 +1,180 @@
+#include "eventbus.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace dxna {
+	//The queue this thread last used, and the bus it belongs to.
+	static thread_local ulongcs cachedBus = 0;
+	static thread_local void* cachedQueue = nullptr;
+
+	static ulongcs nextBusId() {
+		static std::atomic<ulongcs> next{ 1 };
+		return next.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	ulongcs EventStatistics::LatencyPercentile(double percentile) const {
+		if (Dispatched == 0)
+			return 0;
+
+		const auto rank = static_cast<ulongcs>(percentile * static_cast<double>(Dispatched - 1)) + 1;
+		ulongcs seen = 0;
+
+		for (size_t i = 0; i < BucketCount - 1; ++i) {
+			seen += Latency[i];
+
+			if (seen >= rank)
+				return (ulongcs{ 1 } << i) * 1000;
+		}
+
+		return MaxLatency;
+	}
+
+	size_t EventStatistics::Bucket(ulongcs latency) {
+		const auto bucket = static_cast<size_t>(std::bit_width(latency / 1000));
+		return bucket < BucketCount ? bucket : BucketCount - 1;
+	}
+
+	EventBus::ThreadQueue::ThreadQueue(size_t capacity, std::thread::id owner, ThreadQueue* next) :
+		Slots(std::make_unique<Slot[]>(capacity)), Mask(capacity - 1), Owner(owner), Next(next) {
+	}
+
+	EventBus::EventBus(size_t capacity) :
+		_id(nextBusId()), _capacity(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity)) {
+	}
+
+	EventBus::~EventBus() {
+		auto queue = _queues.load(std::memory_order_acquire);
+
+		while (queue != nullptr) {
+			const auto head = queue->Head.load(std::memory_order_acquire);
+
+			for (auto tail = queue->Tail.load(std::memory_order_relaxed); tail != head; ++tail) {
+				auto record = reinterpret_cast<RecordHeader*>(queue->Slots[tail & queue->Mask].Data);
+				record->Finish(record, false);
+			}
+
+			const auto next = queue->Next;
+			delete queue;
+			queue = next;
+		}
+
+		if (cachedBus == _id)
+			cachedBus = 0;
+	}
+
+	size_t EventBus::nextTypeId() {
+		static std::atomic<size_t> next{ 0 };
+		return next.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	ulongcs EventBus::now() {
+		return static_cast<ulongcs>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	EventBus::ThreadQueue* EventBus::queue() {
+		if (cachedBus == _id)
+			return static_cast<ThreadQueue*>(cachedQueue);
+
+		const auto owner = std::this_thread::get_id();
+		auto head = _queues.load(std::memory_order_acquire);
+		ThreadQueue* found = nullptr;
+
+		for (auto queue = head; queue != nullptr && found == nullptr; queue = queue->Next) {
+			if (queue->Owner == owner)
+				found = queue;
+		}
+
+		//First event of this thread: its queue is pushed to the front of the list.
+		if (found == nullptr) {
+			found = new ThreadQueue(_capacity, owner, head);
+
+			while (!_queues.compare_exchange_weak(found->Next, found, std::memory_order_release, std::memory_order_acquire)) {
+			}
+		}
+
+		cachedBus = _id;
+		cachedQueue = found;
+		return found;
+	}
+
+	void* EventBus::reserve(size_t type) {
+		auto queue = this->queue();
+		const auto head = queue->Head.load(std::memory_order_relaxed);
+
+		if (head - queue->CachedTail > queue->Mask) {
+			queue->CachedTail = queue->Tail.load(std::memory_order_acquire);
+
+			if (head - queue->CachedTail > queue->Mask) {
+				queue->Dropped[type < MaxEventTypes ? type : MaxEventTypes - 1].fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+		}
+
+		return queue->Slots[head & queue->Mask].Data;
+	}
+
+	void EventBus::commit() {
+		auto queue = static_cast<ThreadQueue*>(cachedQueue);
+		queue->Head.store(queue->Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	size_t EventBus::Drain() {
+		const auto start = now();
+		size_t count = 0;
+
+		//The heads of every queue are read before any handler runs: new queues go to the front of the
+		//list, so a handler may raise on a queue the loop has yet to reach. Those events, and the queues
+		//of threads raising for the first time, wait for the next Drain.
+		_heads.clear();
+
+		for (auto queue = _queues.load(std::memory_order_acquire); queue != nullptr; queue = queue->Next)
+			_heads.push_back({ queue, queue->Head.load(std::memory_order_acquire) });
+
+		for (const auto& [queue, head] : _heads) {
+			auto tail = queue->Tail.load(std::memory_order_relaxed);
+
+			for (; tail != head; ++tail) {
+				auto record = reinterpret_cast<RecordHeader*>(queue->Slots[tail & queue->Mask].Data);
+				auto& statistics = _statistics[record->Type < MaxEventTypes ? record->Type : MaxEventTypes - 1];
+				const auto latency = start > record->RaisedAt ? start - record->RaisedAt : 0;
+
+				++statistics.Dispatched;
+				statistics.TotalLatency += latency;
+				statistics.MaxLatency = std::max(statistics.MaxLatency, latency);
+				++statistics.Latency[EventStatistics::Bucket(latency)];
+
+				record->Finish(record, true);
+
+				//Frees the slot at once, so the thread can raise again while the rest is dispatched.
+				queue->Tail.store(tail + 1, std::memory_order_release);
+				++count;
+			}
+
+			for (size_t type = 0; type < MaxEventTypes; ++type) {
+				const auto dropped = queue->Dropped[type].load(std::memory_order_relaxed);
+
+				if (dropped != 0) {
+					queue->Dropped[type].fetch_sub(dropped, std::memory_order_relaxed);
+					_statistics[type].Dropped += dropped;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	void EventBus::ResetStatistics() {
+		_statistics.fill(EventStatistics());
+	}
+
+	size_t EventBus::ThreadCount() const {
+		size_t count = 0;
+
+		for (auto queue = _queues.load(std::memory_order_acquire); queue != nullptr; queue = queue->Next)
+			++count;
+
+		return count;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef DXNA_EVENTBUS_HPP
+#define DXNA_EVENTBUS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "cs/cstypes.hpp"
+#include "cs/eventhandler.hpp"
+
+namespace dxna {
+	//What the bus measured for one type of event, counted on the draining thread.
+	struct EventStatistics {
+		//Bucket i counts the events that waited less than 2^i microseconds; the last one counts the rest.
+		static constexpr size_t BucketCount = 20;
+
+		ulongcs Dispatched{ 0 };
+		ulongcs Dropped{ 0 };
+		//In nanoseconds, from Raise to the start of the Drain that dispatched the event.
+		ulongcs MaxLatency{ 0 };
+		ulongcs TotalLatency{ 0 };
+		std::array<ulongcs, BucketCount> Latency{};
+
+		double AverageLatency() const {
+			return Dispatched == 0 ? 0.0 : static_cast<double>(TotalLatency) / static_cast<double>(Dispatched);
+		}
+
+		//The upper bound, in nanoseconds, of the bucket holding the percentile, from 0 to 1.
+		ulongcs LatencyPercentile(double percentile) const;
+
+		//The bucket of a latency in nanoseconds.
+		static size_t Bucket(ulongcs latency);
+	};
+
+	//Lets any thread raise a cs::EventHandler event, to be dispatched later on the thread calling Drain.
+	//Each raising thread gets its own single-producer queue, found through a thread local cache,
+	//so Raise takes no lock and threads do not contend. The arguments are copied into the queue.
+	//Events of one thread are dispatched in the order it raised them; events of different threads
+	//are not ordered. The handler and the sender of a queued event must outlive its dispatch.
+	class EventBus {
+	public:
+		//Events a thread can have queued. Raise drops events past it.
+		static constexpr size_t DefaultCapacity = 1024;
+		//Distinct event types with their own statistics. Later types share the last slot.
+		static constexpr size_t MaxEventTypes = 64;
+		static constexpr size_t SlotSize = 128;
+
+		EventBus(size_t capacity = DefaultCapacity);
+		EventBus(EventBus const&) = delete;
+		EventBus& operator=(EventBus const&) = delete;
+
+		//Drops the queued events without dispatching them.
+		~EventBus();
+
+		//Queues the event from any thread. Returns false if the queue of the thread is full.
+		template <typename TOBJECT, typename TEVENTARGS>
+		bool Raise(cs::EventHandler<TOBJECT, TEVENTARGS> const& handler, TOBJECT const& sender, TEVENTARGS const& e) {
+			using TRecord = Record<TOBJECT, TEVENTARGS>;
+			static_assert(sizeof(TRecord) <= SlotSize, "The event arguments are too large for the bus.");
+			static_assert(alignof(TRecord) <= alignof(std::max_align_t), "Over-aligned event arguments are not supported.");
+
+			const auto type = TypeId<TOBJECT, TEVENTARGS>();
+			auto slot = reserve(type);
+
+			if (slot == nullptr)
+				return false;
+
+			::new (slot) TRecord(handler, sender, e, type, now());
+			commit();
+			return true;
+		}
+
+		//Dispatches the events queued by every thread before the call. Call it from one thread only,
+		//at a point where the handlers may run; events raised by the handlers wait for the next Drain.
+		//Returns how many events were dispatched.
+		size_t Drain();
+
+		//The number of the event type, the index of its statistics.
+		template <typename TOBJECT, typename TEVENTARGS>
+		static size_t TypeId() {
+			static const size_t id = nextTypeId();
+			return id;
+		}
+
+		//Read from the draining thread. Drops are counted by the next Drain.
+		EventStatistics const& Statistics(size_t typeId) const {
+			return _statistics[typeId < MaxEventTypes ? typeId : MaxEventTypes - 1];
+		}
+
+		template <typename TOBJECT, typename TEVENTARGS>
+		EventStatistics const& Statistics() const {
+			return Statistics(TypeId<TOBJECT, TEVENTARGS>());
+		}
+
+		void ResetStatistics();
+
+		//How many threads have raised events on the bus.
+		size_t ThreadCount() const;
+
+	private:
+		struct RecordHeader {
+			//Invokes the event if invoke is true, then destroys the record.
+			void(*Finish)(RecordHeader* record, bool invoke);
+			uintcs Type;
+			ulongcs RaisedAt;
+		};
+
+		template <typename TOBJECT, typename TEVENTARGS>
+		struct Record : RecordHeader {
+			cs::EventHandler<TOBJECT, TEVENTARGS> const* Handler;
+			TOBJECT const* Sender;
+			TEVENTARGS Args;
+
+			Record(cs::EventHandler<TOBJECT, TEVENTARGS> const& handler, TOBJECT const& sender, TEVENTARGS const& e, size_t type, ulongcs raisedAt) :
+				RecordHeader{ &finish, static_cast<uintcs>(type), raisedAt }, Handler(&handler), Sender(&sender), Args(e) {
+			}
+
+			static void finish(RecordHeader* header, bool invoke) {
+				auto record = static_cast<Record*>(header);
+
+				if (invoke)
+					record->Handler->Invoke(*record->Sender, record->Args);
+
+				record->~Record();
+			}
+		};
+
+		struct alignas(64) Slot {
+			std::byte Data[SlotSize];
+		};
+
+		//The queue of one thread. Only that thread writes Head, only the draining thread writes Tail.
+		struct ThreadQueue {
+			ThreadQueue(size_t capacity, std::thread::id owner, ThreadQueue* next);
+
+			std::unique_ptr<Slot[]> Slots;
+			size_t Mask;
+			std::thread::id Owner;
+			ThreadQueue* Next;
+			alignas(64) std::atomic<size_t> Head{ 0 };
+			size_t CachedTail{ 0 };
+			alignas(64) std::atomic<size_t> Tail{ 0 };
+			std::array<std::atomic<ulongcs>, MaxEventTypes> Dropped{};
+		};
+
+		static size_t nextTypeId();
+		static ulongcs now();
+
+		//The slot for the next event of this thread, or null if its queue is full.
+		void* reserve(size_t type);
+		void commit();
+		ThreadQueue* queue();
+
+		//Tells buses apart in the thread local cache, even one created where another was freed.
+		ulongcs _id;
+		size_t _capacity;
+		std::atomic<ThreadQueue*> _queues{ nullptr };
+		//The queues and their heads at the start of the current Drain, kept to reuse the storage.
+		std::vector<std::pair<ThreadQueue*, size_t>> _heads;
+		std::array<EventStatistics, MaxEventTypes> _statistics{};
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef DXNA_FRAMEPACKET_HPP
+#define DXNA_FRAMEPACKET_HPP
+
+#include "cs/cstypes.hpp"
+#include "gametime.hpp"
+#include <memory>
+
+namespace dxna {
+	class GameWindow;
+
+	//What the update side hands to the draw side for one frame.
+	//Games derive from it to carry a copy of the state Draw reads,
+	//so the next Update may change the live state while this frame is drawn.
+	class FramePacket {
+	public:
+		virtual ~FramePacket() {}
+
+		ulongcs FrameNumber{ 0 };
+		GameTime Time;
+		//The window the frame is presented to, as it was when the frame was filled.
+		std::shared_ptr<GameWindow> Window;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "framepipeline.hpp"
+#include "profiler.hpp"
+
+namespace dxna {
+	FramePipeline::FramePipeline(std::vector<std::unique_ptr<FramePacket>> packets, DrawFunction draw) :
+		_packets(std::move(packets)), _draw(std::move(draw)) {
+		for (auto& packet : _packets)
+			_free.push_back(packet.get());
+
+		_thread = std::thread(&FramePipeline::renderLoop, this);
+	}
+
+	FramePipeline::~FramePipeline() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+
+		_submitted.notify_one();
+		_thread.join();
+	}
+
+	FramePacket& FramePipeline::Acquire() {
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		if (_free.empty()) {
+			++_stalls;
+			_released.wait(lock, [this] { return !_free.empty(); });
+		}
+
+		auto packet = _free.front();
+		_free.pop_front();
+		return *packet;
+	}
+
+	void FramePipeline::Submit(FramePacket& packet) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_ready.push_back(&packet);
+		}
+
+		_submitted.notify_one();
+	}
+
+	void FramePipeline::Wait() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_released.wait(lock, [this] { return _ready.empty() && _drawing == 0; });
+	}
+
+	size_t FramePipeline::Pending() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _ready.size() + _drawing;
+	}
+
+	size_t FramePipeline::Discard() {
+		size_t count;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			count = _ready.size();
+			_free.insert(_free.end(), _ready.begin(), _ready.end());
+			_ready.clear();
+		}
+
+		_released.notify_all();
+		return count;
+	}
+
+	ulongcs FramePipeline::Stalls() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _stalls;
+	}
+
+	void FramePipeline::renderLoop() {
+		DXNA_PROFILE_THREAD("dxna render");
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		for (;;) {
+			//Packets already submitted are drawn before stopping.
+			_submitted.wait(lock, [this] { return _stopping || !_ready.empty(); });
+
+			if (_ready.empty())
+				return;
+
+			auto packet = _ready.front();
+			_ready.pop_front();
+			++_drawing;
+
+			lock.unlock();
+			_draw(*packet);
+			lock.lock();
+
+			--_drawing;
+			_free.push_back(packet);
+			_released.notify_all();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef DXNA_FRAMEPIPELINE_HPP
+#define DXNA_FRAMEPIPELINE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "framepacket.hpp"
+
+namespace dxna {
+	//Draws frame packets on a thread of its own.
+	//The packets form a ring: the producer fills a free packet and submits it, the render
+	//thread draws the submitted packets in order and frees them. Acquire blocks while every
+	//packet is in flight, which bounds how far the producer may run ahead.
+	class FramePipeline {
+	public:
+		using DrawFunction = std::function<void(FramePacket const& packet)>;
+
+		FramePipeline(std::vector<std::unique_ptr<FramePacket>> packets, DrawFunction draw);
+		~FramePipeline();
+
+		FramePipeline(FramePipeline const&) = delete;
+		FramePipeline& operator=(FramePipeline const&) = delete;
+
+		size_t FramesInFlight() const { return _packets.size(); }
+
+		//Waits for a free packet.
+		FramePacket& Acquire();
+
+		//Queues a packet returned by Acquire to be drawn.
+		void Submit(FramePacket& packet);
+
+		//Waits until every submitted packet has been drawn.
+		void Wait();
+
+		//Submitted packets not drawn yet, counting the one being drawn.
+		size_t Pending() const;
+
+		//Frees the submitted packets the render thread has not started to draw. Returns how many were dropped.
+		size_t Discard();
+
+		//Times Acquire had to wait for the render thread.
+		ulongcs Stalls() const;
+
+	private:
+		void renderLoop();
+
+		std::vector<std::unique_ptr<FramePacket>> _packets;
+		DrawFunction _draw;
+		mutable std::mutex _mutex;
+		std::condition_variable _submitted;
+		std::condition_variable _released;
+		std::deque<FramePacket*> _free;
+		std::deque<FramePacket*> _ready;
+		size_t _drawing{ 0 };
+		ulongcs _stalls{ 0 };
+		bool _stopping{ false };
+		std::thread _thread;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "framestatistics.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dxna {
+	void FrameStatistics::AddFrame(cs::TimeSpan frameTime) {
+		_samples[_next] = frameTime.Ticks();
+		_next = (_next + 1) % _samples.size();
+		_count = std::min(_count + 1, _samples.size());
+		++_frames;
+	}
+
+	cs::TimeSpan FrameStatistics::Min() const {
+		if (_count == 0)
+			return cs::TimeSpan::Zero();
+
+		return cs::TimeSpan(*std::min_element(_samples.begin(), _samples.begin() + _count));
+	}
+
+	cs::TimeSpan FrameStatistics::Max() const {
+		if (_count == 0)
+			return cs::TimeSpan::Zero();
+
+		return cs::TimeSpan(*std::max_element(_samples.begin(), _samples.begin() + _count));
+	}
+
+	cs::TimeSpan FrameStatistics::Average() const {
+		if (_count == 0)
+			return cs::TimeSpan::Zero();
+
+		int64_t total = 0;
+
+		for (size_t i = 0; i < _count; ++i)
+			total += _samples[i];
+
+		return cs::TimeSpan(total / static_cast<int64_t>(_count));
+	}
+
+	cs::TimeSpan FrameStatistics::Percentile(double fraction) const {
+		if (_count == 0)
+			return cs::TimeSpan::Zero();
+
+		//Nearest rank, so P99 of 100 frames is the second slowest.
+		const auto clamped = std::clamp(fraction, 0.0, 1.0);
+		const auto rank = static_cast<size_t>(std::ceil(clamped * _count));
+		const auto index = rank > 0 ? rank - 1 : 0;
+
+		std::vector<int64_t> sorted(_samples.begin(), _samples.begin() + _count);
+		std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+
+		return cs::TimeSpan(sorted[index]);
+	}
+
+	void FrameStatistics::Reset() {
+		_next = 0;
+		_count = 0;
+		_frames = 0;
+		_updates = 0;
+		_skippedUpdates = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef DXNA_FRAMESTATISTICS_HPP
+#define DXNA_FRAMESTATISTICS_HPP
+
+#include "cs/cstypes.hpp"
+#include "cs/timespan.hpp"
+#include "defincludes.hpp"
+
+namespace dxna {
+	//Frame times of the most recent frames, plus counters since the last Reset.
+	class FrameStatistics {
+	public:
+		static constexpr size_t DefaultCapacity = 240;
+
+		FrameStatistics(size_t capacity = DefaultCapacity) : _samples(capacity > 0 ? capacity : 1) {}
+
+		void AddFrame(cs::TimeSpan frameTime);
+
+		void AddUpdates(ulongcs updates, ulongcs skippedUpdates) {
+			_updates += updates;
+			_skippedUpdates += skippedUpdates;
+		}
+
+		//Frames measured since the last Reset.
+		ulongcs Frames() const { return _frames; }
+
+		//Updates run since the last Reset.
+		ulongcs Updates() const { return _updates; }
+
+		//Fixed updates dropped because the game fell too far behind.
+		ulongcs SkippedUpdates() const { return _skippedUpdates; }
+
+		//Number of frames kept for the statistics below.
+		size_t SampleCount() const { return _count; }
+
+		cs::TimeSpan Min() const;
+		cs::TimeSpan Max() const;
+		cs::TimeSpan Average() const;
+
+		//The frame time below which the given fraction of the kept frames fall, in [0, 1].
+		cs::TimeSpan Percentile(double fraction) const;
+
+		cs::TimeSpan P99() const { return Percentile(0.99); }
+
+		void Reset();
+
+	private:
+		std::vector<int64_t> _samples;
+		size_t _next{ 0 };
+		size_t _count{ 0 };
+		ulongcs _frames{ 0 };
+		ulongcs _updates{ 0 };
+		ulongcs _skippedUpdates{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
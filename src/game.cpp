@@ -1 +1,346 @@
-#include "game.hpp"
\ No newline at end of file
+#include "game.hpp"
+#include "framepipeline.hpp"
+#include "profiler.hpp"
+#include "input/input.hpp"
+#include "graphics/resourceregistry.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace dxna {
+	Game::Game() : _clock(std::make_shared<SteadyGameClock>()) {
+	}
+
+	Game::~Game() {
+		//The derived game is already destroyed, so the render thread must have nothing left to draw:
+		//stopping an idle thread calls into nothing. Run and RunOneFrame return with every frame drawn;
+		//a game driven by Tick must call WaitForDraw or Shutdown. Without asserts, the queued frames are dropped.
+		assert((!_pipeline || _pipeline->Pending() == 0) && "WaitForDraw must run before the game is destroyed.");
+
+		if (_pipeline)
+			_pipeline->Discard();
+
+		stopRenderThread();
+		Window(nullptr);
+	}
+
+	void Game::Clock(PtrGameClock const& value) {
+		if (!value)
+			return;
+
+		_clock = value;
+		ResetElapsedTime();
+	}
+
+	void Game::Window(std::shared_ptr<GameWindow> const& value) {
+		if (_window) {
+			_window->Activated.Unsubscribe(_activatedToken);
+			_window->Deactivated.Unsubscribe(_deactivatedToken);
+		}
+
+		_window = value;
+		_isActive = !_window || _window->IsActive();
+
+		if (_window) {
+			_activatedToken = _window->Activated.Subscribe([this] {
+				_isActive = true;
+				OnActived();
+			});
+
+			_deactivatedToken = _window->Deactivated.Subscribe([this] {
+				_isActive = false;
+				OnDeactivated();
+			});
+		}
+	}
+
+	void Game::Run() {
+		RunGame(true);
+	}
+
+	void Game::RunOneFrame() {
+		EnsureHost();
+
+		if (!_isInitialized) {
+			Initialize();
+			_isInitialized = true;
+			ResetElapsedTime();
+		}
+
+		Tick();
+
+		//A single frame is complete only once it has been drawn, so no draw runs after the call returns,
+		//not even into a game destroyed right after. The render thread is kept for the next frame.
+		WaitForDraw();
+	}
+
+	void Game::RunGame(bool useBlockingRun) {
+		EnsureHost();
+
+		if (!_isInitialized) {
+			Initialize();
+			_isInitialized = true;
+		}
+
+		BeginRun();
+		ResetElapsedTime();
+
+		//The first frame is an update and a draw with no elapsed time.
+		updateInput();
+		Update(_gameTime);
+		_frameStatistics.AddUpdates(1, 0);
+		DrawFrame();
+
+		if (!useBlockingRun)
+			return;
+
+		while (!_isExiting)
+			Tick();
+
+		Shutdown();
+		EndRun();
+		OnExiting();
+		UnloadContent();
+	}
+
+	void Game::Tick() {
+		DXNA_PROFILE_FRAME();
+
+		//The time since the previous tick, without the fraction of a step carried over from it.
+		auto frameTime = cs::TimeSpan::Zero();
+
+		//Waits until a whole step has accumulated, sleeping first and spinning at the end.
+		for (;;) {
+			DXNA_PROFILE_SCOPE("Game::Wait");
+
+			const auto now = _clock->Now();
+			const auto elapsed = now - _previousTicks;
+
+			_previousTicks = now;
+			frameTime = frameTime + elapsed;
+			_accumulatedElapsedTime = _accumulatedElapsedTime + elapsed;
+
+			if (!_isFixedTimeStep || _accumulatedElapsedTime >= _targetElapsedTime)
+				break;
+
+			_clock->Wait(_targetElapsedTime - _accumulatedElapsedTime);
+		}
+
+		_frameStatistics.AddFrame(frameTime);
+
+		drainEvents();
+
+		//A long stall, such as a debugger break, is not caught up.
+		if (_accumulatedElapsedTime > _maxElapsedTime)
+			_accumulatedElapsedTime = _maxElapsedTime;
+
+		if (_isFixedTimeStep) {
+			const auto target = _targetElapsedTime.Ticks();
+			const auto pending = _accumulatedElapsedTime.Ticks() / target;
+			const auto steps = std::min<int64_t>(pending, _maxUpdatesPerFrame);
+
+			//Updates beyond the cap are dropped, keeping only the fraction of a step.
+			_accumulatedElapsedTime = cs::TimeSpan(pending > steps
+				? _accumulatedElapsedTime.Ticks() % target
+				: _accumulatedElapsedTime.Ticks() - steps * target);
+
+			//The game is running slowly after several frames needing more than one update,
+			//and recovers once the lag has been paid back one frame at a time.
+			_updateFrameLag += static_cast<intcs>(std::max<int64_t>(0, pending - 1));
+
+			if (_gameTime.IsRunningSlowly) {
+				if (_updateFrameLag == 0)
+					_gameTime.IsRunningSlowly = false;
+			}
+			else if (_updateFrameLag >= 5) {
+				_gameTime.IsRunningSlowly = true;
+			}
+
+			if (pending == 1 && _updateFrameLag > 0)
+				--_updateFrameLag;
+
+			_gameTime.ElapsedGameTime = _targetElapsedTime;
+
+			int64_t updates = 0;
+			DXNA_PROFILE_SCOPE("Game::Update");
+
+			for (; updates < steps && !_isExiting; ++updates) {
+				_gameTime.TotalGameTime = _gameTime.TotalGameTime + _targetElapsedTime;
+				updateInput();
+				Update(_gameTime);
+			}
+
+			_frameStatistics.AddUpdates(static_cast<ulongcs>(updates), static_cast<ulongcs>(pending - steps));
+			DXNA_PROFILE_COUNTER("Game::Updates", updates);
+
+			//Draw reports the time covered by the updates of the frame.
+			_gameTime.ElapsedGameTime = cs::TimeSpan(target * updates);
+		}
+		else {
+			_gameTime.ElapsedGameTime = _accumulatedElapsedTime;
+			_gameTime.TotalGameTime = _gameTime.TotalGameTime + _accumulatedElapsedTime;
+			_gameTime.IsRunningSlowly = false;
+			_accumulatedElapsedTime = cs::TimeSpan::Zero();
+
+			DXNA_PROFILE_SCOPE("Game::Update");
+			updateInput();
+			Update(_gameTime);
+			_frameStatistics.AddUpdates(1, 0);
+		}
+
+		drainEvents();
+
+		if (!_isExiting)
+			DrawFrame();
+
+		DXNA_PROFILE_COUNTER("Game::FrameArena", _frameArena.Statistics().Used);
+		_frameArena.Reset();
+	}
+
+	void Game::SupressDraw() {
+		_suppressDraw = true;
+	}
+
+	void Game::Exit() {
+		_isExiting = true;
+	}
+
+	void Game::ResetElapsedTime() {
+		_previousTicks = _clock->Now();
+		_accumulatedElapsedTime = cs::TimeSpan::Zero();
+		_gameTime.ElapsedGameTime = cs::TimeSpan::Zero();
+		_gameTime.IsRunningSlowly = false;
+		_updateFrameLag = 0;
+	}
+
+	void Game::DrawFrame() {
+		if (_suppressDraw) {
+			_suppressDraw = false;
+			return;
+		}
+
+		if (!_useRenderThread || (_pipeline && _pipeline->FramesInFlight() != static_cast<size_t>(_framesInFlight)))
+			stopRenderThread();
+
+		if (!_useRenderThread) {
+			if (!_packet)
+				_packet = CreateFramePacket();
+
+			_packet->FrameNumber = ++_frameNumber;
+			_packet->Time = _gameTime;
+			_packet->Window = _window;
+
+			{
+				DXNA_PROFILE_SCOPE("Game::FillFramePacket");
+				FillFramePacket(*_packet);
+			}
+
+			drawPacket(*_packet);
+			return;
+		}
+
+		if (!_pipeline) {
+			std::vector<std::unique_ptr<FramePacket>> packets;
+
+			for (intcs i = 0; i < _framesInFlight; ++i)
+				packets.push_back(CreateFramePacket());
+
+			_pipeline = std::make_unique<FramePipeline>(std::move(packets),
+				[this](FramePacket const& packet) { drawPacket(packet); });
+		}
+
+		//Blocks when the render thread is FramesInFlight frames behind.
+		auto& packet = [this]() -> FramePacket& {
+			DXNA_PROFILE_SCOPE("Game::AcquireFramePacket");
+			return _pipeline->Acquire();
+		}();
+
+		packet.FrameNumber = ++_frameNumber;
+		packet.Time = _gameTime;
+		packet.Window = _window;
+
+		{
+			DXNA_PROFILE_SCOPE("Game::FillFramePacket");
+			FillFramePacket(packet);
+		}
+
+		_pipeline->Submit(packet);
+	}
+
+	void Game::drawPacket(FramePacket const& packet) {
+		DXNA_PROFILE_SCOPE("Game::Draw");
+
+		if (BeginDraw()) {
+			Draw(packet);
+			EndDraw();
+
+			//The window of the packet, since the game thread may set another one while this frame is drawn.
+			if (packet.Window)
+				packet.Window->Present();
+		}
+
+		//Evicts graphics content past the budgets once the frame has been drawn, on the thread that draws,
+		//so no draw can be reading what is evicted.
+		[[maybe_unused]] const auto evicted = graphics::ResourceRegistry::Shared().EndFrame();
+		DXNA_PROFILE_COUNTER("Game::EvictedBytes", evicted);
+	}
+
+	void Game::WaitForDraw() {
+		if (_pipeline)
+			_pipeline->Wait();
+	}
+
+	void Game::Shutdown() {
+		stopRenderThread();
+	}
+
+	void Game::stopRenderThread() {
+		//Frames already submitted are drawn before the thread ends.
+		_pipeline.reset();
+	}
+
+	void Game::drainEvents() {
+		DXNA_PROFILE_SCOPE("Game::Events");
+		[[maybe_unused]] const auto count = _events.Drain();
+		DXNA_PROFILE_COUNTER("Game::Events", count);
+	}
+
+	void Game::updateInput() {
+		//One input frame per update: WasKeyPressed and the other edges are seen by a single
+		//update, and the later updates of a tick see only the events queued since.
+		input::Input::Update();
+	}
+
+	void Game::EnsureHost() {
+		//The loop runs without a window until a platform host is attached.
+	}
+
+	void Game::Update(GameTime const&) {}
+
+	bool Game::BeginDraw() {
+		return true;
+	}
+
+	void Game::Draw(GameTime const&) {}
+
+	void Game::Draw(FramePacket const& packet) {
+		Draw(packet.Time);
+	}
+
+	std::unique_ptr<FramePacket> Game::CreateFramePacket() {
+		return std::make_unique<FramePacket>();
+	}
+
+	void Game::Initialize() {
+		LoadContent();
+	}
+
+	void Game::OnActived() {}
+
+	void Game::OnDeactivated() {}
+
+	void Game::OnExiting() {}
+
+	void Game::LoadContent() {}
+
+	void Game::UnloadContent() {}
+}
\ No newline at end of file
@@ -2,22 +2,113 @@
 #define DXNA_GAME_HPP
 
 #include "gametime.hpp"
+#include "gameclock.hpp"
+#include "framestatistics.hpp"
+#include "framepacket.hpp"
+#include "eventbus.hpp"
+#include "memoryarena.hpp"
+#include "gamewindow.hpp"
+#include <memory>
 
 namespace dxna {
+	class FramePipeline;
+
 	class Game {
 	public:
+		static constexpr intcs DefaultMaxUpdatesPerFrame = 5;
+		static constexpr size_t DefaultFrameArenaSize = 256 * 1024;
+		static constexpr intcs DefaultFramesInFlight = 2;
+
+		Game();
+
+		virtual ~Game();
+
 		void Run();
 		void RunOneFrame();
 		void Tick();
 		void SupressDraw();
 		void Exit();
 
+		//Gets the time between fixed updates. The default is 1/60 of a second.
+		cs::TimeSpan TargetElapsedTime() const { return _targetElapsedTime; }
+		//Sets the time between fixed updates. Values not greater than zero are ignored.
+		void TargetElapsedTime(cs::TimeSpan value) {
+			if (value > cs::TimeSpan::Zero())
+				_targetElapsedTime = value;
+		}
+
+		//Gets whether Update runs in steps of TargetElapsedTime or once per frame.
+		bool IsFixedTimeStep() const { return _isFixedTimeStep; }
+		void IsFixedTimeStep(bool value) { _isFixedTimeStep = value; }
+
+		//Gets the largest time a single frame may account for, longer pauses are not caught up.
+		cs::TimeSpan MaxElapsedTime() const { return _maxElapsedTime; }
+		void MaxElapsedTime(cs::TimeSpan value) {
+			if (value > cs::TimeSpan::Zero())
+				_maxElapsedTime = value;
+		}
+
+		//Gets the most fixed updates run in a frame to catch up,
+		//the remaining time is dropped and counted as skipped.
+		intcs MaxUpdatesPerFrame() const { return _maxUpdatesPerFrame; }
+		void MaxUpdatesPerFrame(intcs value) { _maxUpdatesPerFrame = value > 0 ? value : 1; }
+
+		//Gets the time source of the loop.
+		PtrGameClock const& Clock() const { return _clock; }
+		//Sets the time source of the loop, such as a ManualGameClock to run headless.
+		void Clock(PtrGameClock const& value);
+
+		dxna::FrameStatistics const& FrameStatistics() const { return _frameStatistics; }
+		dxna::FrameStatistics& FrameStatistics() { return _frameStatistics; }
+
+		//Gets whether BeginDraw, Draw and EndDraw run on a render thread,
+		//overlapping the draw of a frame with the updates of the next.
+		bool UseRenderThread() const { return _useRenderThread; }
+		//Sets whether the render thread is used, from the next frame on. See Shutdown.
+		void UseRenderThread(bool value) { _useRenderThread = value; }
+
+		//Gets how many frame packets may be in flight with the render thread.
+		//With one, the updates of a frame already overlap the draw of the previous one;
+		//more let the update side run further ahead and absorb uneven frames.
+		intcs FramesInFlight() const { return _framesInFlight; }
+		void FramesInFlight(intcs value) { _framesInFlight = value > 0 ? value : 1; }
+
+		//Blocks until every frame handed to the render thread has been drawn.
+		void WaitForDraw();
+
+		bool IsExiting() const { return _isExiting; }
+
+		//Gets the window the game runs in, or null when it runs without one.
+		GameWindow* Window() const { return _window.get(); }
+		//Sets the window, such as a HeadlessGameWindow. The game starts as active as the window is,
+		//its activation calls OnActived and OnDeactivated, and it presents every frame drawn.
+		void Window(std::shared_ptr<GameWindow> const& value);
+
+		//Whether the window has the focus. True without a window.
+		bool IsActive() const { return _isActive; }
+
+		//Events raised here from any thread are dispatched on the game thread at two points
+		//of each Tick: before the updates, and after the updates, before the draw.
+		EventBus& Events() { return _events; }
+
+		//Memory for temporaries of the frame, freed at the end of each Tick. Use it on the game thread only,
+		//and not for anything a FramePacket keeps, since the render thread may draw the packet later.
+		MemoryArena& FrameArena() { return _frameArena; }
+
 	protected:
 		virtual void BeginRun(){}
 		virtual void EndRun(){}
 		virtual void Update(GameTime const& gameTime);
 		virtual bool BeginDraw();
 		virtual void Draw(GameTime const& gameTime);
+		//Draws a frame from its packet. Calls Draw(GameTime) unless overridden.
+		//Runs on the render thread when UseRenderThread is set.
+		virtual void Draw(FramePacket const& packet);
+		virtual void EndDraw() {}
+		//Creates one of the packets the frames are drawn from.
+		virtual std::unique_ptr<FramePacket> CreateFramePacket();
+		//Copies the state Draw reads into the packet. Always runs on the update thread.
+		virtual void FillFramePacket(FramePacket& packet) {}
 		virtual void Initialize();
 		void ResetElapsedTime();
 		virtual void OnActived();
@@ -25,11 +116,44 @@ namespace dxna {
 		virtual void OnExiting();
 		virtual void LoadContent();
 		virtual void UnloadContent();
+		//Stops the render thread once the frames already submitted are drawn. Run calls it when the loop ends.
+		//A game driven by Tick with the render thread must call it, or WaitForDraw, before it is destroyed,
+		//since ~Game runs after the derived game is gone and may no longer draw.
+		void Shutdown();
 
 	private:
 		void RunGame(bool useBlockingRun);
 		void DrawFrame();
 		void EnsureHost();
+		void drawPacket(FramePacket const& packet);
+		void stopRenderThread();
+		void drainEvents();
+		void updateInput();
+
+		PtrGameClock _clock;
+		std::unique_ptr<FramePipeline> _pipeline;
+		std::unique_ptr<FramePacket> _packet;
+		dxna::FrameStatistics _frameStatistics;
+		EventBus _events;
+		MemoryArena _frameArena{ DefaultFrameArenaSize };
+		std::shared_ptr<GameWindow> _window;
+		cs::EventToken _activatedToken;
+		cs::EventToken _deactivatedToken;
+		GameTime _gameTime;
+		cs::TimeSpan _targetElapsedTime{ cs::TimeSpan::TicksPerSecond / 60 };
+		cs::TimeSpan _maxElapsedTime{ cs::TimeSpan::TicksPerMillisecond * 500 };
+		cs::TimeSpan _accumulatedElapsedTime{ cs::TimeSpan::Zero() };
+		cs::TimeSpan _previousTicks{ cs::TimeSpan::Zero() };
+		intcs _maxUpdatesPerFrame{ DefaultMaxUpdatesPerFrame };
+		intcs _updateFrameLag{ 0 };
+		intcs _framesInFlight{ DefaultFramesInFlight };
+		ulongcs _frameNumber{ 0 };
+		bool _isFixedTimeStep{ true };
+		bool _isInitialized{ false };
+		bool _isExiting{ false };
+		bool _isActive{ true };
+		bool _suppressDraw{ false };
+		bool _useRenderThread{ false };
 	};
 }
 
@@ -0,0 +1,27 @@
+#include "gameclock.hpp"
+#include <thread>
+
+namespace dxna {
+	using Ticks = std::chrono::duration<int64_t, std::ratio<1, cs::TimeSpan::TicksPerSecond>>;
+
+	cs::TimeSpan SteadyGameClock::Now() {
+		return cs::TimeSpan(std::chrono::duration_cast<Ticks>(std::chrono::steady_clock::now() - _start).count());
+	}
+
+	void SteadyGameClock::Wait(cs::TimeSpan duration) {
+		const auto deadline = std::chrono::steady_clock::now() + Ticks(duration.Ticks());
+		const auto spin = Ticks(SpinThreshold.Ticks());
+
+		for (;;) {
+			const auto remaining = deadline - std::chrono::steady_clock::now();
+
+			if (remaining <= remaining.zero())
+				return;
+
+			if (remaining > spin)
+				std::this_thread::sleep_for(remaining - spin);
+			else
+				std::this_thread::yield();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef DXNA_GAMECLOCK_HPP
+#define DXNA_GAMECLOCK_HPP
+
+#include <chrono>
+#include "cs/timespan.hpp"
+#include "defincludes.hpp"
+
+namespace dxna {
+	//Source of time for the game loop.
+	class GameClock {
+	public:
+		virtual ~GameClock() {}
+
+		//Time elapsed since the clock was created.
+		virtual cs::TimeSpan Now() = 0;
+
+		//Blocks until the given time has passed.
+		virtual void Wait(cs::TimeSpan duration) = 0;
+	};
+
+	//A clock over std::chrono::steady_clock.
+	//Waits sleep while the remaining time is above SpinThreshold and spin for the rest,
+	//since a sleep can overshoot by a scheduler quantum.
+	class SteadyGameClock : public GameClock {
+	public:
+		SteadyGameClock() : _start(std::chrono::steady_clock::now()) {}
+
+		virtual cs::TimeSpan Now() override;
+		virtual void Wait(cs::TimeSpan duration) override;
+
+		cs::TimeSpan SpinThreshold{ cs::TimeSpan::TicksPerMillisecond * 2 };
+
+	private:
+		std::chrono::steady_clock::time_point _start;
+	};
+
+	//A clock that only moves when told to, so the game loop can run headless and deterministic.
+	class ManualGameClock : public GameClock {
+	public:
+		ManualGameClock() = default;
+
+		virtual cs::TimeSpan Now() override { return _now; }
+
+		//Advances the clock by the waited time instead of blocking.
+		virtual void Wait(cs::TimeSpan duration) override {
+			if (duration > cs::TimeSpan::Zero())
+				_now = _now + duration;
+		}
+
+		void Advance(cs::TimeSpan duration) { _now = _now + duration; }
+
+	private:
+		cs::TimeSpan _now{ cs::TimeSpan::Zero() };
+	};
+
+	using PtrGameClock = std::shared_ptr<GameClock>;
+}
+
+#endif
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace dxna {
 		//Obtm a altura padro da rea cliente.
 		static constexpr int DefaultClientHeight = 600;
 
+		virtual ~GameWindow() = default;
+
 		//Obtm o ttulo da janela.
 		constexpr std::string Title() const {
 			return std::string(title);
@@ -42,9 +44,16 @@ namespace dxna {
 		//Obtm se a janela est minimizada.
 		virtual bool IsMinimizedState() const {	return false; }
 
+		//Whether the window has the focus. Activated and Deactivated are raised when it changes.
+		virtual bool IsActive() const { return true; }
+
 		//Obtm os limites da janela.
 		virtual Rectangle ClientBounds() const = 0;
 
+		//Called by the game after each frame is drawn. A window synchronized with the
+		//vertical retrace waits here for the next refresh.
+		virtual void Present() {}
+
 		//Eventos ativados quando a janela for ativada.
 		cs::EventHandler<GameWindow, cs::EventArgs> Activated;
 		//Eventos ativados quando a janela for desativada.
@@ -0,0 +1,91 @@
+#include "commandlist.hpp"
+#include <algorithm>
+#include <cstring>
+#include "states.hpp"
+#include "texture.hpp"
+
+namespace dxna::graphics {
+	void CommandList::SetBlendState(BlendState const* state) {
+		if (state != nullptr)
+			state->Touch();
+
+		auto& command = push(CommandType::SetBlendState);
+		command.Blend = state;
+	}
+
+	void CommandList::SetDepthStencilState(DepthStencilState const* state) {
+		if (state != nullptr)
+			state->Touch();
+
+		auto& command = push(CommandType::SetDepthStencilState);
+		command.DepthStencil = state;
+	}
+
+	void CommandList::SetRasterizerState(RasterizerState const* state) {
+		if (state != nullptr)
+			state->Touch();
+
+		auto& command = push(CommandType::SetRasterizerState);
+		command.Rasterizer = state;
+	}
+
+	void CommandList::SetTexture(intcs slot, Texture2D const* texture) {
+		if (texture != nullptr)
+			texture->Touch();
+
+		auto& command = push(CommandType::SetTexture);
+		command.Texture = { texture, slot };
+	}
+
+	void CommandList::SetConstantData(ShaderStage stage, intcs slot, bytecs const* data, size_t sizeInBytes) {
+		const auto offset = _constantData.size();
+
+		if (data != nullptr && sizeInBytes > 0) {
+			_constantData.resize(offset + sizeInBytes);
+			std::memcpy(_constantData.data() + offset, data, sizeInBytes);
+		}
+		else {
+			sizeInBytes = 0;
+		}
+
+		auto& command = push(CommandType::SetConstantData);
+		command.ConstantData = { stage, slot, static_cast<uintcs>(offset), static_cast<uintcs>(sizeInBytes) };
+	}
+
+	CommandList& CommandListSet::Acquire(intcs sortOrder) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_used == _lists.size())
+			_lists.push_back(std::make_unique<CommandList>());
+
+		auto& list = *_lists[_used++];
+		list.Reset();
+		list.SortOrder = sortOrder;
+
+		return list;
+	}
+
+	std::vector<CommandList const*> const& CommandListSet::Merge() {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_ordered.clear();
+
+		for (size_t i = 0; i < _used; ++i)
+			_ordered.push_back(_lists[i].get());
+
+		std::stable_sort(_ordered.begin(), _ordered.end(),
+			[](CommandList const* a, CommandList const* b) { return a->SortOrder < b->SortOrder; });
+
+		return _ordered;
+	}
+
+	void CommandListSet::Reset() {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for (size_t i = 0; i < _used; ++i)
+			_lists[i]->Reset();
+
+		_ordered.clear();
+		_used = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#ifndef DXNA_GRAPHICS_COMMANDLIST_HPP
+#define DXNA_GRAPHICS_COMMANDLIST_HPP
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include "../cs/cstypes.hpp"
+#include "enumerations.hpp"
+#include "forward.hpp"
+#include "viewport.hpp"
+#include "../structs.hpp"
+
+namespace dxna::graphics {
+
+	//--------------------------------------------------------------------------------//
+	//								Command											  //
+	//--------------------------------------------------------------------------------//
+
+	enum class CommandType : bytecs {
+		Clear,
+		SetBlendState,
+		SetDepthStencilState,
+		SetRasterizerState,
+		SetConstantData,
+		SetViewport,
+		SetScissorRectangle,
+		SetVertexData,
+		SetIndexData,
+		SetTexture,
+		Draw,
+		DrawIndexed,
+	};
+
+	struct ClearCommand {
+		ClearOptions Options;
+		uintcs Color;
+		float Depth;
+		intcs Stencil;
+	};
+
+	//Constant data is stored in the owning CommandList arena, the command only keeps its range.
+	struct ConstantDataCommand {
+		ShaderStage Stage;
+		intcs Slot;
+		uintcs Offset;
+		uintcs Size;
+	};
+
+	struct ViewportCommand {
+		intcs X;
+		intcs Y;
+		intcs Width;
+		intcs Height;
+	};
+
+	struct ScissorRectangleCommand {
+		intcs X;
+		intcs Y;
+		intcs Width;
+		intcs Height;
+	};
+
+	//Vertex and index data are referenced, not copied, and must outlive the submission.
+	struct VertexDataCommand {
+		void const* Data;
+		intcs VertexCount;
+		VertexFormat Format;
+	};
+
+	struct IndexDataCommand {
+		ushortcs const* Data;
+		intcs IndexCount;
+	};
+
+	struct TextureCommand {
+		Texture2D const* Texture;
+		intcs Slot;
+	};
+
+	struct DrawCommand {
+		PrimitiveType Primitive;
+		intcs StartVertex;
+		intcs PrimitiveCount;
+		intcs InstanceCount;
+	};
+
+	struct DrawIndexedCommand {
+		PrimitiveType Primitive;
+		intcs BaseVertex;
+		intcs StartIndex;
+		intcs PrimitiveCount;
+	};
+
+	//A compact, trivially copyable command recorded by a CommandList.
+	//State objects are referenced by raw pointer and must outlive the submission.
+	struct Command {
+		CommandType Type;
+
+		union {
+			ClearCommand Clear;
+			BlendState const* Blend;
+			DepthStencilState const* DepthStencil;
+			RasterizerState const* Rasterizer;
+			ConstantDataCommand ConstantData;
+			ViewportCommand Viewport;
+			ScissorRectangleCommand ScissorRectangle;
+			VertexDataCommand VertexData;
+			IndexDataCommand IndexData;
+			TextureCommand Texture;
+			DrawCommand Draw;
+			DrawIndexedCommand DrawIndexed;
+		};
+	};
+
+	static_assert(std::is_trivially_copyable_v<Command>, "Command must be a POD type.");
+	static_assert(sizeof(Command) <= 24, "Command must stay compact.");
+
+	//--------------------------------------------------------------------------------//
+	//								CommandList										  //
+	//--------------------------------------------------------------------------------//
+
+	//Records commands for later submission to a GraphicsDevice.
+	//A CommandList is not thread-safe: each recording thread must own its list.
+	class CommandList {
+	public:
+		CommandList() = default;
+
+		CommandList(intcs sortOrder) : SortOrder(sortOrder) {}
+
+		void Clear(ClearOptions options, Color const& color, float depth, intcs stencil) {
+			auto& command = push(CommandType::Clear);
+			command.Clear = { options, color.PackedValue(), depth, stencil };
+		}
+
+		//The state and texture setters touch the resource, so the registry does not evict it while the list is in flight.
+		void SetBlendState(BlendState const* state);
+
+		void SetDepthStencilState(DepthStencilState const* state);
+
+		void SetRasterizerState(RasterizerState const* state);
+
+		//Copies the data into the list, so the caller may reuse its buffer right away.
+		void SetConstantData(ShaderStage stage, intcs slot, bytecs const* data, size_t sizeInBytes);
+
+		void SetViewport(Viewport const& viewport) {
+			auto& command = push(CommandType::SetViewport);
+			command.Viewport = { viewport.X, viewport.Y, viewport.Width, viewport.Height };
+		}
+
+		//Pixels outside the rectangle are not drawn while the rasterizer state has ScissorTestEnable.
+		//The whole render target is used until the first call of the frame.
+		void SetScissorRectangle(Rectangle const& rectangle) {
+			auto& command = push(CommandType::SetScissorRectangle);
+			command.ScissorRectangle = { rectangle.X, rectangle.Y, rectangle.Width, rectangle.Height };
+		}
+
+		template <typename TVertex>
+		void SetVertexData(TVertex const* vertices, intcs vertexCount) {
+			auto& command = push(CommandType::SetVertexData);
+			command.VertexData = { vertices, vertexCount, TVertex::Format };
+		}
+
+		void SetIndexData(ushortcs const* indices, intcs indexCount) {
+			auto& command = push(CommandType::SetIndexData);
+			command.IndexData = { indices, indexCount };
+		}
+
+		//A null texture unbinds the slot.
+		void SetTexture(intcs slot, Texture2D const* texture);
+
+		void Draw(PrimitiveType primitiveType, intcs startVertex, intcs primitiveCount, intcs instanceCount = 1) {
+			auto& command = push(CommandType::Draw);
+			command.Draw = { primitiveType, startVertex, primitiveCount, instanceCount };
+		}
+
+		//Draws from the current index data, baseVertex is added to every index.
+		void DrawIndexed(PrimitiveType primitiveType, intcs baseVertex, intcs startIndex, intcs primitiveCount) {
+			auto& command = push(CommandType::DrawIndexed);
+			command.DrawIndexed = { primitiveType, baseVertex, startIndex, primitiveCount };
+		}
+
+		//Clears the recorded commands, keeping the allocated memory.
+		void Reset() {
+			_commands.clear();
+			_constantData.clear();
+		}
+
+		size_t Count() const { return _commands.size(); }
+
+		bool IsEmpty() const { return _commands.empty(); }
+
+		Command const& At(size_t index) const { return _commands[index]; }
+
+		Command const& operator[](size_t index) const { return _commands[index]; }
+
+		std::vector<Command> const& Commands() const { return _commands; }
+
+		bytecs const* ConstantData(Command const& command) const {
+			return _constantData.data() + command.ConstantData.Offset;
+		}
+
+		size_t ConstantDataSize() const { return _constantData.size(); }
+
+		//Key used to merge lists recorded on different threads in a deterministic order.
+		intcs SortOrder{ 0 };
+
+	private:
+		Command& push(CommandType type) {
+			auto& command = _commands.emplace_back();
+			command.Type = type;
+			return command;
+		}
+
+		std::vector<Command> _commands;
+		std::vector<bytecs> _constantData;
+	};
+
+	//--------------------------------------------------------------------------------//
+	//								CommandListSet									  //
+	//--------------------------------------------------------------------------------//
+
+	//The command lists of one frame.
+	//Lists are handed out to recording threads and merged by SortOrder on submission,
+	//so the result does not depend on which thread finished first.
+	class CommandListSet {
+	public:
+		CommandListSet() = default;
+		CommandListSet(CommandListSet const&) = delete;
+		CommandListSet& operator=(CommandListSet const&) = delete;
+
+		//Thread-safe. Returns an empty list that stays valid until Reset.
+		//Sort orders should be unique within a frame to guarantee a deterministic merge.
+		CommandList& Acquire(intcs sortOrder);
+
+		//Returns the acquired lists ordered by SortOrder.
+		std::vector<CommandList const*> const& Merge();
+
+		size_t Count() const { return _used; }
+
+		//Recycles all lists for the next frame.
+		void Reset();
+
+	private:
+		std::mutex _mutex;
+		std::vector<std::unique_ptr<CommandList>> _lists;
+		std::vector<CommandList const*> _ordered;
+		size_t _used{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
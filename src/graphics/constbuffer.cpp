@@ -1,6 +1,7 @@
 #include "constbuffer.hpp"
 #include "../cs/buffer.hpp"
 #include "effect.hpp"
+#include "../profiler.hpp"
 
 using namespace cs;
 
@@ -11,13 +12,13 @@ namespace dxna::graphics {
 
 		if (rows == 1 && columns == 1) {
 			if (isarray) {
-				auto source = AnyTo<vectorptr<bytecs>>(data);
+				auto source = AnyTo<vectorptr<bytecs>>(*data);
 
 				Buffer::BlockCopy(source->data(), 0, _buffer->data(), offset, elementSize);
 			}
 		}
 		else if (rows == 1 || (rows == 4 && columns == 4)) {
-			auto source = AnyTo<vectorptr<bytecs>>(data);
+			auto source = AnyTo<vectorptr<bytecs>>(*data);
 			auto len = rows * columns * elementSize;
 
 			if (_buffer->size() - offset > len)
@@ -26,7 +27,7 @@ namespace dxna::graphics {
 			Buffer::BlockCopy(source->data(), 0, _buffer->data(), offset, rows * columns * elementSize);
 		}
 		else {
-			auto source = AnyTo<vectorptr<bytecs>>(data);
+			auto source = AnyTo<vectorptr<bytecs>>(*data);
 			auto stride = (columns * elementSize);
 			
 			for (size_t y = 0; y < rows; ++y)
@@ -74,6 +75,8 @@ namespace dxna::graphics {
 	}
 
 	void ConstantBuffer::Update(EffectParameterCollection& parameters) {
+		DXNA_PROFILE_SCOPE("ConstantBuffer::Update");
+
 		if (_stateKey > EffectParameter::NextStateKey)
 			_stateKey = 0;
 
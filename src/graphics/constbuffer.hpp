@@ -3,18 +3,23 @@
 
 #include "graphicsresource.hpp"
 
+namespace dxna::bench {
+	struct EffectAccess;
+}
+
 namespace dxna::graphics {
 	class ConstantBuffer : public GraphicsResource {
 	public:
-		ConstantBuffer() = default;
+		ConstantBuffer() : GraphicsResource(ResourceType::ConstantBuffer) {}
 
 		ConstantBuffer(GraphicsDevicePtr const& device, intcs sizeInBytes,
 			vectorptr<intcs> const& parametersIndexes,
 			vectorptr<intcs> const& parameterOffsets,
 			std::string name) :
-			_parameters(parametersIndexes), _offsets(parameterOffsets), _name(name)	{
+			GraphicsResource(ResourceType::ConstantBuffer), _parameters(parametersIndexes), _offsets(parameterOffsets), _name(name)	{
 			_buffer = NewVector<bytecs>(sizeInBytes);
 			Device(device);
+			ReportSize(_buffer->size());
 
 			PlatformInitialize();
 		}
@@ -47,6 +52,9 @@ namespace dxna::graphics {
 		}
 
 	private:
+		//The benchmarks update a buffer without a full effect blob.
+		friend struct bench::EffectAccess;
+
 		void SetData(intcs offset, intcs rows, intcs columns, anyptr const& data, bool isarray = true);
 		intcs SetParameter(intcs offset, EffectParameter& param);
 		void Update(EffectParameterCollection& parameters);
@@ -1,5 +1,6 @@
 #include "effect.hpp"
 #include "states.hpp"
+#include "../profiler.hpp"
 
 using namespace cs;
 
@@ -7,7 +8,9 @@ namespace dxna::graphics {
 	ulongcs EffectParameter::NextStateKey = 0;
 
 	Effect::Effect(GraphicsDevicePtr const& graphicsDevice,
-		vectorptr<bytecs> const& effectCode, intcs index, intcs count) {
+		vectorptr<bytecs> const& effectCode, intcs index, intcs count) : GraphicsResource(ResourceType::Effect) {
+		DXNA_PROFILE_SCOPE("Effect::Effect");
+
 		auto header = ReadHeader(effectCode, index);
 		auto effectKey = header.EffectKey;
 		auto headerSize = header.HeaderSize;
@@ -18,14 +21,16 @@ namespace dxna::graphics {
 	}
 
 	EffectParameterCollectionPtr Effect::ReadParameters(cs::BinaryReader& reader) {
+		DXNA_PROFILE_SCOPE("Effect::ReadParameters");
+
 		const auto count = reader.ReadInt32();
 
-		if (count == 0)
-			return New<EffectParameterCollection>();
+		if (count <= 0)
+			return New<EffectParameterCollection>(NewVector<EffectParameterPtr>(0));
 
 		auto parameters = NewVector<EffectParameterPtr>(count);
 
-		for (size_t i = 0; i < count; ++i) {
+		for (size_t i = 0; i < parameters->size(); ++i) {
 			const auto class_ = (EffectParameterClass)reader.ReadByte();
 			const auto type = (EffectParameterType)reader.ReadByte();
 			const auto name = reader.ReadString();
@@ -40,23 +45,22 @@ namespace dxna::graphics {
 			if (elements->Count() == 0 && structMembers->Count() == 0) {
 				switch (type) {
 				case EffectParameterType::Bool:
-				case EffectParameterType::Int32: {
+				case EffectParameterType::Int32:
+				case EffectParameterType::Single: {
 					//TODO #if !OPENGL
-					auto buffer = NewVector<intcs>(rowCount * columnCount);
+					//The values are kept as the raw 4-byte words the constant buffers copy.
+					auto buffer = NewVector<bytecs>(rowCount * columnCount * 4);
 
-					for (size_t j = 0; j < buffer->size(); ++j)
-						buffer->at(j) = reader.ReadInt32();
+					for (size_t j = 0; j < buffer->size(); j += 4) {
+						const auto value = static_cast<uintcs>(reader.ReadInt32());
 
-					*data = buffer;
+						buffer->at(j) = static_cast<bytecs>(value);
+						buffer->at(j + 1) = static_cast<bytecs>(value >> 8);
+						buffer->at(j + 2) = static_cast<bytecs>(value >> 16);
+						buffer->at(j + 3) = static_cast<bytecs>(value >> 24);
+					}
 
-					break;
-				}
-				case EffectParameterType::Single: {
-					auto buffer = NewVector<intcs>(rowCount * columnCount);
-					for (size_t j = 0; j < buffer->size(); ++j)
-						buffer->at(j) = reader.ReadSingle();
-
-					*data = buffer;
+					data = New<std::any>(buffer);
 					break;
 				}
 				default:
@@ -73,6 +77,8 @@ namespace dxna::graphics {
 	}
 
 	EffectPassCollectionPtr Effect::ReadPasses(BinaryReader& reader, EffectPtr const& effect, vectorptr<ShaderPtr> const& shaders) {
+		DXNA_PROFILE_SCOPE("Effect::ReadPasses");
+
 		auto passes = NewVector<EffectPassPtr>(reader.ReadInt32());
 
 		for (size_t i = 0; i < passes->size(); i++) {
@@ -150,8 +156,8 @@ namespace dxna::graphics {
 	EffectAnnotationCollectionPtr Effect::ReadAnnotations(cs::BinaryReader& reader) {
 		const auto count = reader.ReadInt32();
 		
-		if (count == 0)
-			return New<EffectAnnotationCollection>();
+		if (count <= 0)
+			return New<EffectAnnotationCollection>(NewVector<EffectAnnotationPtr>(0));
 
 		const auto annotations = NewVector<EffectAnnotationPtr>(count);
 
@@ -159,6 +165,8 @@ namespace dxna::graphics {
 	}
 
 	void Effect::ReadEffect(cs::BinaryReader& reader) {
+		DXNA_PROFILE_SCOPE("Effect::ReadEffect");
+
 		ConstantBuffers = NewVector<ConstantBufferPtr>(reader.ReadInt32());
 
 		for (size_t c = 0; c < ConstantBuffers->size(); c++) {
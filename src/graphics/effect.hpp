@@ -37,7 +37,7 @@ namespace dxna::graphics {
 			_annotations(annotations) {
 		}
 
-		constexpr size_t Count() { return _annotations->size(); }
+		size_t Count() { return _annotations->size(); }
 
 		EffectAnnotationPtr At(size_t index) { return _annotations->at(index); }
 
@@ -109,12 +109,12 @@ namespace dxna::graphics {
 			for (size_t i = 0; i < _parameters->size(); ++i) {
 				const auto name = &_parameters->at(i)->Name;
 
-				if (name->empty())
+				if (!name->empty())
 					_indexLookup->emplace(*name, static_cast<intcs>(i));
 			}
 		}
 
-		constexpr size_t Count() { return _parameters->size(); }
+		size_t Count() { return _parameters->size(); }
 
 		EffectParameterPtr At(size_t index) { return _parameters->at(index); }
 
@@ -183,7 +183,7 @@ namespace dxna::graphics {
 			_passes(passes) {
 		}
 
-		constexpr size_t Count() { return _passes->size(); }
+		size_t Count() { return _passes->size(); }
 
 		EffectPassPtr At(size_t index) { return _passes->at(index); }
 
@@ -231,7 +231,7 @@ namespace dxna::graphics {
 			_techniques(techniques) {
 		}
 
-		constexpr size_t Count() { return _techniques->size(); }
+		size_t Count() { return _techniques->size(); }
 
 		EffectTechniquePtr At(size_t index) { return _techniques->at(index); }
 
@@ -281,6 +281,9 @@ namespace dxna::graphics {
 		virtual void OnApply(){}
 
 	private:
+		//The benchmarks drive the section readers without a full effect blob.
+		friend struct bench::EffectAccess;
+
 		MGFXHeader ReadHeader(vectorptr<bytecs> const& effectCode, intcs index) {
 			return MGFXHeader();
 		}
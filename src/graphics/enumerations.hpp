@@ -121,6 +121,40 @@ namespace dxna::graphics {
         TessellateFactor
     };
 
+    enum class PrimitiveType {
+        TriangleList,
+        TriangleStrip,
+        LineList,
+        LineStrip,
+        PointList,
+    };
+
+    enum class ClearOptions {
+        Target = 1,
+        DepthBuffer = 2,
+        Stencil = 4,
+        All = Target | DepthBuffer | Stencil,
+    };
+
+    enum class SurfaceFormat {
+        //RGBA, 8 bits per channel, red in the least significant byte.
+        Color,
+        //BGRA, 8 bits per channel, blue in the least significant byte.
+        Bgra32,
+        //RGBA, a float per channel.
+        Vector4,
+    };
+
+    enum class MipmapFilter {
+        Box,
+        Kaiser,
+    };
+
+    enum class VertexFormat {
+        PositionColor,
+        PositionColorTexture,
+    };
+
     enum class ShaderStage {
         Vertex,
         Pixel,
@@ -146,6 +180,20 @@ namespace dxna::graphics {
         Texture3D,
         TextureCube
     };
+
+    enum class SpriteSortMode {
+        Deferred,
+        Immediate,
+        Texture,
+        BackToFront,
+        FrontToBack,
+    };
+
+    enum class SpriteEffects {
+        None = 0,
+        FlipHorizontally = 1,
+        FlipVertically = 2,
+    };
 }
 
 #endif
\ No newline at end of file
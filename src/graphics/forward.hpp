@@ -33,6 +33,19 @@ namespace dxna::graphics {
 	class ConstantBufferCollection;
 
 	class TextureCollection;
+	class Texture;
+	class Texture2D;
+
+	class CommandList;
+	class CommandListSet;
+	class GraphicsBackend;
+	class HeadlessBackend;
+	class SoftwareBackend;
+	class RenderQueue;
+	class SpriteBatch;
+
+	template <typename T> struct Handle;
+	template <typename T> class HandlePool;
 
 	using GraphicsResourcePtr				= std::shared_ptr<GraphicsResource>;
 	using GraphicsDevicePtr					= std::shared_ptr<GraphicsDevice>;
@@ -57,6 +70,23 @@ namespace dxna::graphics {
 	using EffectTechniqueCollectionPtr		= std::shared_ptr<EffectTechniqueCollection>;
 	using ConstantBufferCollectionPtr		= std::shared_ptr<ConstantBufferCollection>;	
 	using TextureCollectionPtr				= std::shared_ptr<TextureCollection>;	
+	using TexturePtr						= std::shared_ptr<Texture>;
+	using Texture2DPtr						= std::shared_ptr<Texture2D>;
+	using CommandListPtr					= std::shared_ptr<CommandList>;
+	using GraphicsBackendPtr				= std::shared_ptr<GraphicsBackend>;
+	using HeadlessBackendPtr				= std::shared_ptr<HeadlessBackend>;
+	using SoftwareBackendPtr				= std::shared_ptr<SoftwareBackend>;
+	using RenderQueuePtr					= std::shared_ptr<RenderQueue>;
+	using SpriteBatchPtr					= std::shared_ptr<SpriteBatch>;
+
+	using ShaderHandle						= Handle<Shader>;
+	using SamplerStateHandle				= Handle<SamplerState>;
+	using BlendStateHandle					= Handle<BlendState>;
+	using DepthStencilStateHandle			= Handle<DepthStencilState>;
+	using RasterizerStateHandle				= Handle<RasterizerState>;
+	using EffectHandle						= Handle<Effect>;
+	using ConstantBufferHandle				= Handle<ConstantBuffer>;
+	using Texture2DHandle					= Handle<Texture2D>;
 }
 
 #endif
\ No newline at end of file
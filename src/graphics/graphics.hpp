@@ -4,6 +4,17 @@
 #include "viewport.hpp"
 #include "graphicsdevice.hpp"
 #include "graphicsresource.hpp"
+#include "resourceregistry.hpp"
+#include "handlepool.hpp"
 #include "shader.hpp"
 #include "effect.hpp"
-#include "constbuffer.hpp"
\ No newline at end of file
+#include "constbuffer.hpp"
+#include "commandlist.hpp"
+#include "graphicsbackend.hpp"
+#include "headlessbackend.hpp"
+#include "renderqueue.hpp"
+#include "pixelconverter.hpp"
+#include "texture.hpp"
+#include "vertextypes.hpp"
+#include "spritebatch.hpp"
+#include "softwarebackend.hpp"
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef DXNA_GRAPHICS_GRAPHICSBACKEND_HPP
+#define DXNA_GRAPHICS_GRAPHICSBACKEND_HPP
+
+#include "../error.hpp"
+#include "forward.hpp"
+
+namespace dxna::graphics {
+	//Represents the platform layer that executes the commands submitted to a GraphicsDevice.
+	class GraphicsBackend {
+	public:
+		virtual ~GraphicsBackend() {}
+
+		virtual void BeginFrame() {}
+
+		//Executes the commands of the list in order.
+		//Returns the first error found; the index of the error is the index of the failing command.
+		virtual Error Execute(CommandList const& commandList) = 0;
+
+		virtual void EndFrame() {}
+	};
+}
+
+#endif
\ No newline at end of file
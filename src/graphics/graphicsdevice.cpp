@@ -0,0 +1,40 @@
+#include "graphicsdevice.hpp"
+#include "graphicsbackend.hpp"
+#include "commandlist.hpp"
+
+namespace dxna::graphics {
+	void GraphicsDevice::BeginFrame() {
+		++_frame;
+
+		if (_backend != nullptr)
+			_backend->BeginFrame();
+	}
+
+	Error GraphicsDevice::Submit(CommandList const& commandList) {
+		if (_backend == nullptr)
+			return Error(ErrorCode::GRAPHICS_NO_BACKEND);
+
+		return _backend->Execute(commandList);
+	}
+
+	Error GraphicsDevice::Submit(CommandListSet& commandLists) {
+		if (_backend == nullptr)
+			return Error(ErrorCode::GRAPHICS_NO_BACKEND);
+
+		auto result = NoError;
+
+		for (const auto list : commandLists.Merge()) {
+			const auto error = _backend->Execute(*list);
+
+			if (error.HasError() && !result.HasError())
+				result = error;
+		}
+
+		return result;
+	}
+
+	void GraphicsDevice::Present() {
+		if (_backend != nullptr)
+			_backend->EndFrame();
+	}
+}
\ No newline at end of file
@@ -4,17 +4,63 @@
 #include <memory>
 #include "forward.hpp"
 #include "viewport.hpp"
+#include "enumerations.hpp"
 #include "../structs.hpp"
+#include "../error.hpp"
 
 namespace dxna::graphics {
 	class GraphicsDevice {
 	public:
+		GraphicsDevice() = default;
+
+		GraphicsDevice(GraphicsBackendPtr const& backend) : _backend(backend) {}
+
+		GraphicsBackendPtr Backend() const { return _backend; }
+
+		void Backend(GraphicsBackendPtr const& value) { _backend = value; }
+
+		graphics::Viewport Viewport() const { return _viewport; }
+
+		void Viewport(graphics::Viewport const& value) { _viewport = value; }
+
+		//Starts a new frame on the backend.
+		void BeginFrame();
+
+		//The frames started by BeginFrame.
+		ulongcs Frame() const { return _frame; }
+
+		//Executes a single command list.
+		Error Submit(CommandList const& commandList);
+
+		//Merges the lists recorded for the frame by SortOrder and executes them in that order.
+		Error Submit(CommandListSet& commandLists);
+
+		//Finishes the current frame on the backend.
+		void Present();
+
+		//Number of vertices or indices read by a draw of primitiveCount primitives.
+		static constexpr intcs GetElementCount(PrimitiveType primitiveType, intcs primitiveCount) {
+			switch (primitiveType)
+			{
+			case PrimitiveType::TriangleList:
+				return primitiveCount * 3;
+			case PrimitiveType::TriangleStrip:
+				return primitiveCount + 2;
+			case PrimitiveType::LineList:
+				return primitiveCount * 2;
+			case PrimitiveType::LineStrip:
+				return primitiveCount + 1;
+			default:
+				return primitiveCount;
+			}
+		}
+
 		bool UseHalfPixelOffset = false;
 
 	private:
 		static Color _discardColor;
 
-		Viewport _viewport;
+		graphics::Viewport _viewport;
 		Color _blendFactor = Colors::White;
 		
 		BlendStatePtr _blendState;
@@ -37,6 +83,9 @@ namespace dxna::graphics {
 		RasterizerStatePtr _rasterizerStateCullNone;
 
 		Rectangle _scissorRectangle;
+
+		GraphicsBackendPtr _backend;
+		ulongcs _frame{ 0 };
 	};
 }
 
@@ -1,6 +1,7 @@
 #ifndef DXNA_GRAPHICS_GRAPHICSRESOURCE_HPP
 #define DXNA_GRAPHICS_GRAPHICSRESOURCE_HPP
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <vector>
@@ -9,14 +10,63 @@
 #include "../cs/cs.hpp"
 #include "enumerations.hpp"
 #include "forward.hpp"
+#include "resourceregistry.hpp"
 
 namespace dxna::graphics {	
 
+	//Every resource is tracked by ResourceRegistry::Shared() from its construction to its destruction.
+	//The registry never calls the virtual functions of a resource to read its type or size: the type is
+	//given to the constructor and the most derived class reports its size with ReportSize.
 	class GraphicsResource {	
 	public:	
-		constexpr GraphicsResource() = default;
+		GraphicsResource(ResourceType type = ResourceType::Unknown) :
+			_registry(&ResourceRegistry::Shared()), _type(type), _lastUsedFrame(_registry->Frame()) {
+			_registry->add(this);
+		}
+
+		GraphicsResource(GraphicsResource const& other) :
+			graphicsDevice(other.graphicsDevice), _registry(other._registry), _type(other._type),
+			_lastUsedFrame(other.LastUsedFrame()) {
+			_registry->add(this);
+			Name(other.Name());
+			ReportSize(other.SizeInBytes());
+		}
+
+		GraphicsResource& operator=(GraphicsResource const& other) {
+			Name(other.Name());
+			graphicsDevice = other.graphicsDevice;
+			return *this;
+		}
+
+		virtual ~GraphicsResource() {
+			_registry->remove(this);
+		}
+
+		ResourceType Type() const { return _type; }
+
+		//Identifies the resource in the registry, such as in ResourceRegistry::Evicted. Never reused.
+		ResourceId Id() const { return _id; }
 
-		virtual ~GraphicsResource(){}		
+		//Bytes of content the resource holds, counted against the budgets of the registry.
+		size_t SizeInBytes() const { return _sizeInBytes.load(std::memory_order_relaxed); }
+
+		//Frees the content that can be loaded again and returns the bytes freed.
+		//Resources that cannot be evicted return 0.
+		size_t Evict() { return _registry->evict(this); }
+
+		//The frame of the registry the resource was last recorded for drawing.
+		ulongcs LastUsedFrame() const { return _lastUsedFrame.load(std::memory_order_relaxed); }
+
+		//Marks the resource as used in the current frame, which keeps it from being evicted.
+		void Touch() const { _lastUsedFrame.store(_registry->Frame(), std::memory_order_relaxed); }
+
+		std::string const& Name() const { return _name; }
+
+		//Sets the name, and the copy of it the registry reports from any thread.
+		void Name(std::string const& value) {
+			_name = value;
+			_registry->rename(this, value);
+		}
 
 		GraphicsDevicePtr Device() const { 
 			return graphicsDevice; 
@@ -32,12 +82,27 @@ namespace dxna::graphics {
 
 	protected:
 		virtual void GraphicsDeviceResetting() {}
-	
-	public:
-		std::string Name;
+
+		//Sets the size counted against the budgets, and whether the registry may call EvictContent.
+		//Evictable resources report it once fully constructed and report 0 at the start of their
+		//destructor, so the registry never evicts a resource that is being built or destroyed.
+		void ReportSize(size_t bytes, bool evictable = false) { _registry->update(this, bytes, evictable); }
+
+		//Frees the content and returns the bytes freed. Called by the registry under its lock, so it
+		//must not call back into the registry, such as through ReportSize.
+		virtual size_t EvictContent() { return 0; }
 
 	private:
+		friend class ResourceRegistry;
+
+		std::string _name;
 		GraphicsDevicePtr graphicsDevice;
+		ResourceRegistry* _registry;
+		ResourceType _type;
+		ResourceId _id{ 0 };
+		std::atomic<size_t> _sizeInBytes{ 0 };
+		mutable std::atomic<ulongcs> _lastUsedFrame;
+		size_t _registryIndex{ 0 };
 	};	
 }
 
@@ -0,0 +1,248 @@
+#ifndef DXNA_GRAPHICS_HANDLEPOOL_HPP
+#define DXNA_GRAPHICS_HANDLEPOOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "../cs/cstypes.hpp"
+#include "forward.hpp"
+
+namespace dxna::test {
+	struct HandlePoolAccess;
+}
+
+namespace dxna::graphics {
+	//Refers to an object of a HandlePool. A handle is two integers: copying it touches no reference count,
+	//and it can be stored in commands and components. The null handle has generation 0.
+	template <typename T>
+	struct Handle {
+		uintcs Index{ 0 };
+		uintcs Generation{ 0 };
+
+		constexpr bool IsNull() const { return Generation == 0; }
+
+		constexpr explicit operator bool() const { return Generation != 0; }
+
+		friend constexpr bool operator==(Handle const& left, Handle const& right) = default;
+	};
+
+	//Owns objects of one type and hands out generational handles to them.
+	//The objects are stored in pages of PageSize contiguous objects and never move, so a pointer
+	//from Get stays valid until the object is destroyed. A handle is checked in O(1): its slot
+	//must still have the generation the handle was created with.
+	//Release makes the handles stale at once, but destroys the object only after FramesInFlight
+	//calls to EndFrame, so frames already recorded may still read it on the render thread.
+	//Not thread safe: create, release and end frames on one thread, usually the game thread.
+	template <typename T>
+	class HandlePool {
+	public:
+		static constexpr size_t PageSize = 64;
+		//The frames a packet can wait to be drawn, plus the one being recorded.
+		static constexpr ulongcs DefaultFramesInFlight = 3;
+
+		HandlePool(ulongcs framesInFlight = DefaultFramesInFlight) :
+			_framesInFlight(framesInFlight) {
+		}
+
+		HandlePool(HandlePool const&) = delete;
+		HandlePool& operator=(HandlePool const&) = delete;
+
+		//Destroys every object, released or not.
+		~HandlePool() {
+			for (size_t index = 0; index < _slots.size(); ++index) {
+				if (_slots[index].State != SlotState::Free)
+					item(index)->~T();
+			}
+		}
+
+		//Constructs an object in a free slot. If the constructor throws, the pool is left as it was.
+		template <typename... TArgs>
+		Handle<T> Create(TArgs&&... args) {
+			const auto reuse = !_free.empty();
+			const auto index = reuse ? _free.back() : _slots.size();
+
+			//Allocates before constructing, so the slot is taken only once nothing else can throw.
+			if (!reuse) {
+				if (index / PageSize >= _pages.size())
+					_pages.push_back(std::make_unique<Page>());
+
+				if (_slots.size() == _slots.capacity())
+					_slots.reserve(_slots.size() + _slots.size() / 2 + PageSize);
+			}
+
+			const auto object = ::new (static_cast<void*>(item(index))) T(std::forward<TArgs>(args)...);
+
+			if (reuse)
+				_free.pop_back();
+			else
+				_slots.push_back(Slot());
+
+			auto& slot = _slots[index];
+			slot.Object = object;
+			slot.State = SlotState::Alive;
+			++_count;
+
+			return Handle<T>{ static_cast<uintcs>(index), slot.Generation };
+		}
+
+		//The object, or null if the handle is null or stale.
+		T* Get(Handle<T> const& handle) const {
+			if (handle.Index >= _slots.size())
+				return nullptr;
+
+			const auto& slot = _slots[handle.Index];
+			return slot.Generation == handle.Generation ? slot.Object : nullptr;
+		}
+
+		bool IsValid(Handle<T> const& handle) const {
+			return Get(handle) != nullptr;
+		}
+
+		//Makes the handle stale and queues the object to be destroyed. Returns false if the handle was
+		//already stale, so releasing twice is harmless.
+		bool Release(Handle<T> const& handle) {
+			if (!IsValid(handle))
+				return false;
+
+			auto& slot = _slots[handle.Index];
+			slot.Object = nullptr;
+			slot.State = SlotState::Retired;
+			++slot.Generation;
+			--_count;
+
+			_retired.push_back(Retired{ handle.Index, _frame });
+			return true;
+		}
+
+		//Ends a frame, destroying the objects released FramesInFlight frames ago.
+		void EndFrame() {
+			++_frame;
+
+			while (!_retired.empty() && _retired.front().Frame + _framesInFlight <= _frame) {
+				destroy(_retired.front().Index);
+				_retired.pop_front();
+			}
+		}
+
+		//Destroys every released object now. Call it when no frame can read them, such as after
+		//FramePipeline::Wait.
+		void Flush() {
+			for (const auto& retired : _retired)
+				destroy(retired.Index);
+
+			_retired.clear();
+		}
+
+		//The handle of an object of the pool, or the null handle.
+		//For code moving from pointers to handles; it searches the pages.
+		Handle<T> HandleOf(T const* object) const {
+			//std::less orders any pointers, where < is unspecified for ones outside the page.
+			const std::less<T const*> less;
+
+			for (size_t page = 0; page < _pages.size(); ++page) {
+				const auto first = reinterpret_cast<T const*>(_pages[page]->Data);
+
+				if (less(object, first) || !less(object, first + PageSize))
+					continue;
+
+				const auto index = page * PageSize + static_cast<size_t>(object - first);
+
+				if (index < _slots.size() && _slots[index].Object != nullptr)
+					return Handle<T>{ static_cast<uintcs>(index), _slots[index].Generation };
+			}
+
+			return Handle<T>();
+		}
+
+		//A shared_ptr to the object that releases the handle when the last copy goes away,
+		//for code that still takes the Ptr types. The shared_ptr then owns the object: share a handle once,
+		//and keep the pool alive longer than the shared_ptr.
+		//Release runs on whichever thread drops the last copy, so the pool is only as thread safe as
+		//those copies: drop the last one on the thread that owns the pool.
+		std::shared_ptr<T> Share(Handle<T> const& handle) {
+			const auto object = Get(handle);
+
+			if (object == nullptr)
+				return nullptr;
+
+			return std::shared_ptr<T>(object, [this, handle](T*) { Release(handle); });
+		}
+
+		//Calls function(handle, object) for every live object, in storage order.
+		template <typename TFUNCTION>
+		void ForEach(TFUNCTION&& function) {
+			for (size_t index = 0; index < _slots.size(); ++index) {
+				if (_slots[index].Object != nullptr)
+					function(Handle<T>{ static_cast<uintcs>(index), _slots[index].Generation }, *_slots[index].Object);
+			}
+		}
+
+		//Live objects.
+		size_t Count() const { return _count; }
+
+		//Objects released but not destroyed yet.
+		size_t RetiredCount() const { return _retired.size(); }
+
+		size_t Capacity() const { return _pages.size() * PageSize; }
+
+		ulongcs FramesInFlight() const { return _framesInFlight; }
+
+		ulongcs Frame() const { return _frame; }
+
+	private:
+		//The tests age a slot to the last generation without billions of releases.
+		friend struct test::HandlePoolAccess;
+
+		enum class SlotState : bytecs {
+			Free,
+			Alive,
+			Retired,
+		};
+
+		//Object is set only while the slot is alive, so Get needs no other check.
+		struct Slot {
+			T* Object{ nullptr };
+			uintcs Generation{ 1 };
+			SlotState State{ SlotState::Free };
+		};
+
+		struct Retired {
+			uintcs Index;
+			ulongcs Frame;
+		};
+
+		struct Page {
+			alignas(T) std::byte Data[sizeof(T) * PageSize];
+		};
+
+		T* item(size_t index) const {
+			return std::launder(reinterpret_cast<T*>(_pages[index / PageSize]->Data) + index % PageSize);
+		}
+
+		void destroy(size_t index) {
+			item(index)->~T();
+
+			auto& slot = _slots[index];
+			slot.State = SlotState::Free;
+
+			//A slot whose generation would wrap is never reused, so an old handle cannot become valid again.
+			if (slot.Generation != std::numeric_limits<uintcs>::max())
+				_free.push_back(index);
+		}
+
+		ulongcs _framesInFlight;
+		ulongcs _frame{ 0 };
+		size_t _count{ 0 };
+		std::vector<std::unique_ptr<Page>> _pages;
+		std::vector<Slot> _slots;
+		std::vector<size_t> _free;
+		std::deque<Retired> _retired;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "headlessbackend.hpp"
+#include "graphicsdevice.hpp"
+#include "texture.hpp"
+#include <algorithm>
+
+namespace dxna::graphics {
+	void HeadlessBackend::BeginFrame() {
+		++_statistics.Frames;
+		_hasViewport = false;
+		_vertexData = {};
+		_indexData = {};
+
+		for (auto& texture : _textures)
+			texture = nullptr;
+	}
+
+	Error HeadlessBackend::Execute(CommandList const& commandList) {
+		auto result = NoError;
+		const auto& commands = commandList.Commands();
+
+		++_statistics.CommandLists;
+		_statistics.Commands += commands.size();
+
+		for (size_t i = 0; i < commands.size(); ++i) {
+			const auto error = validate(commandList, commands[i]);
+
+			if (!error.HasError())
+				continue;
+
+			++_statistics.Errors;
+
+			const auto indexed = Error(error.Flag, static_cast<int>(i));
+
+			if (!result.HasError())
+				result = indexed;
+
+			if (!_firstError.HasError())
+				_firstError = indexed;
+		}
+
+		return result;
+	}
+
+	Error HeadlessBackend::validate(CommandList const& commandList, Command const& command) {
+		switch (command.Type)
+		{
+		case CommandType::Clear:
+			++_statistics.Clears;
+			return NoError;
+
+		case CommandType::SetBlendState:
+			if (command.Blend == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_blendState = command.Blend;
+			++_statistics.StateChanges;
+			return NoError;
+
+		case CommandType::SetDepthStencilState:
+			if (command.DepthStencil == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_depthStencilState = command.DepthStencil;
+			++_statistics.StateChanges;
+			return NoError;
+
+		case CommandType::SetRasterizerState:
+			if (command.Rasterizer == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_rasterizerState = command.Rasterizer;
+			++_statistics.StateChanges;
+			return NoError;
+
+		case CommandType::SetConstantData: {
+			const auto& data = command.ConstantData;
+
+			if (data.Slot < 0 || data.Slot >= MaxConstantBufferSlots)
+				return Error(ErrorCode::GRAPHICS_INVALID_CONSTANT_SLOT);
+
+			if (data.Size > MaxConstantBufferSize
+				|| static_cast<size_t>(data.Offset) + data.Size > commandList.ConstantDataSize())
+				return Error(ErrorCode::GRAPHICS_CONSTANT_DATA_OUT_OF_RANGE);
+
+			_statistics.ConstantBytes += data.Size;
+			return NoError;
+		}
+
+		case CommandType::SetViewport: {
+			const auto& viewport = command.Viewport;
+
+			if (viewport.Width <= 0 || viewport.Height <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_VIEWPORT);
+
+			_viewport = Viewport(viewport.X, viewport.Y, viewport.Width, viewport.Height);
+			_hasViewport = true;
+			++_statistics.StateChanges;
+			return NoError;
+		}
+
+		case CommandType::Draw: {
+			const auto& draw = command.Draw;
+
+			if (!_hasViewport)
+				return Error(ErrorCode::GRAPHICS_VIEWPORT_NOT_SET);
+
+			if (draw.PrimitiveCount <= 0 || draw.StartVertex < 0 || draw.InstanceCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_PRIMITIVE_COUNT);
+
+			++_statistics.Draws;
+			_statistics.Primitives += static_cast<ulongcs>(draw.PrimitiveCount) * draw.InstanceCount;
+			_statistics.Vertices += static_cast<ulongcs>(GraphicsDevice::GetElementCount(draw.Primitive, draw.PrimitiveCount)) * draw.InstanceCount;
+			return NoError;
+		}
+
+		case CommandType::SetScissorRectangle: {
+			const auto& rectangle = command.ScissorRectangle;
+
+			if (rectangle.Width < 0 || rectangle.Height < 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_RECTANGLE);
+
+			++_statistics.StateChanges;
+			return NoError;
+		}
+
+		case CommandType::SetVertexData:
+			_vertexData = command.VertexData;
+			return NoError;
+
+		case CommandType::SetIndexData:
+			_indexData = command.IndexData;
+			return NoError;
+
+		case CommandType::SetTexture: {
+			const auto& texture = command.Texture;
+
+			if (texture.Slot < 0 || texture.Slot >= MaxTextureSlots)
+				return Error(ErrorCode::GRAPHICS_INVALID_TEXTURE_SLOT);
+
+			if (texture.Texture != nullptr && texture.Texture->IsEvicted())
+				return Error(ErrorCode::GRAPHICS_RESOURCE_EVICTED);
+
+			_textures[texture.Slot] = texture.Texture;
+			++_statistics.StateChanges;
+			return NoError;
+		}
+
+		case CommandType::DrawIndexed: {
+			const auto& draw = command.DrawIndexed;
+
+			if (!_hasViewport)
+				return Error(ErrorCode::GRAPHICS_VIEWPORT_NOT_SET);
+
+			if (_vertexData.Data == nullptr || _vertexData.VertexCount <= 0)
+				return Error(ErrorCode::GRAPHICS_VERTEX_DATA_NOT_SET);
+
+			if (_indexData.Data == nullptr || _indexData.IndexCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INDEX_DATA_NOT_SET);
+
+			if (draw.PrimitiveCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_PRIMITIVE_COUNT);
+
+			const auto indexCount = GraphicsDevice::GetElementCount(draw.Primitive, draw.PrimitiveCount);
+
+			if (draw.StartIndex < 0 || draw.BaseVertex < 0 || draw.BaseVertex >= _vertexData.VertexCount
+				|| static_cast<longcs>(draw.StartIndex) + indexCount > _indexData.IndexCount)
+				return Error(ErrorCode::GRAPHICS_INDEX_OUT_OF_RANGE);
+
+			//Every vertex the indices reach must be in the bound vertex data.
+			const auto indices = _indexData.Data + draw.StartIndex;
+			const auto maxIndex = *std::max_element(indices, indices + indexCount);
+
+			if (static_cast<longcs>(draw.BaseVertex) + maxIndex >= _vertexData.VertexCount)
+				return Error(ErrorCode::GRAPHICS_INDEX_OUT_OF_RANGE);
+
+			++_statistics.Draws;
+			_statistics.Primitives += static_cast<ulongcs>(draw.PrimitiveCount);
+			_statistics.Vertices += static_cast<ulongcs>(indexCount);
+			return NoError;
+		}
+
+		default:
+			return Error(ErrorCode::GRAPHICS_UNKNOWN_COMMAND);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef DXNA_GRAPHICS_HEADLESSBACKEND_HPP
+#define DXNA_GRAPHICS_HEADLESSBACKEND_HPP
+
+#include "graphicsbackend.hpp"
+#include "commandlist.hpp"
+
+namespace dxna::graphics {
+	struct HeadlessStatistics {
+		ulongcs Frames{ 0 };
+		ulongcs CommandLists{ 0 };
+		ulongcs Commands{ 0 };
+		ulongcs Clears{ 0 };
+		ulongcs Draws{ 0 };
+		ulongcs Vertices{ 0 };
+		ulongcs Primitives{ 0 };
+		ulongcs StateChanges{ 0 };
+		ulongcs ConstantBytes{ 0 };
+		ulongcs Errors{ 0 };
+	};
+
+	//A backend without a GPU: it executes the commands against a shadow of the device
+	//state, validates them and keeps counters, so throughput can be measured on any platform.
+	class HeadlessBackend : public GraphicsBackend {
+	public:
+		static constexpr intcs MaxConstantBufferSlots = 16;
+		static constexpr uintcs MaxConstantBufferSize = 65536;
+		static constexpr intcs MaxTextureSlots = 16;
+
+		HeadlessBackend() = default;
+
+		virtual void BeginFrame() override;
+		virtual Error Execute(CommandList const& commandList) override;
+		virtual void EndFrame() override {}
+
+		HeadlessStatistics const& Statistics() const { return _statistics; }
+
+		//The first error found since the last ResetStatistics.
+		Error FirstError() const { return _firstError; }
+
+		void ResetStatistics() {
+			_statistics = HeadlessStatistics();
+			_firstError = NoError;
+		}
+
+		BlendState const* CurrentBlendState() const { return _blendState; }
+		DepthStencilState const* CurrentDepthStencilState() const { return _depthStencilState; }
+		RasterizerState const* CurrentRasterizerState() const { return _rasterizerState; }
+		Viewport CurrentViewport() const { return _viewport; }
+		Texture2D const* CurrentTexture(intcs slot) const { return _textures[slot]; }
+
+	private:
+		Error validate(CommandList const& commandList, Command const& command);
+
+		HeadlessStatistics _statistics;
+		Error _firstError;
+
+		BlendState const* _blendState = nullptr;
+		DepthStencilState const* _depthStencilState = nullptr;
+		RasterizerState const* _rasterizerState = nullptr;
+		Viewport _viewport;
+		bool _hasViewport{ false };
+		Texture2D const* _textures[MaxTextureSlots]{};
+		VertexDataCommand _vertexData{};
+		IndexDataCommand _indexData{};
+	};
+}
+
+#endif
\ No newline at end of file
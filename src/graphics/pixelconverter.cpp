@@ -0,0 +1,235 @@
+#include "pixelconverter.hpp"
+#include "../simd.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace dxna::graphics {
+	static uintcs swapRedBlue(uintcs pixel) {
+		return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+	}
+
+	//Rounds value / 255 to nearest for value in [0, 65025].
+	static uintcs divide255(uintcs value) {
+		value += 128;
+		return (value + (value >> 8)) >> 8;
+	}
+
+	void PixelConverter::SwapRedBlue(uintcs const* source, uintcs* destination, size_t count) {
+		size_t i = 0;
+
+#if defined(DXNA_SIMD_SSE2)
+		const auto greenAlpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+		const auto lowByte = _mm_set1_epi32(0xFF);
+
+		for (; i + 4 <= count; i += 4) {
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+			const auto swapped = _mm_or_si128(_mm_and_si128(pixels, greenAlpha),
+				_mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), lowByte), _mm_slli_epi32(_mm_and_si128(pixels, lowByte), 16)));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), swapped);
+		}
+#elif defined(DXNA_SIMD_NEON)
+		for (; i + 16 <= count; i += 16) {
+			auto pixels = vld4q_u8(reinterpret_cast<uint8_t const*>(source + i));
+			const auto red = pixels.val[0];
+			pixels.val[0] = pixels.val[2];
+			pixels.val[2] = red;
+			vst4q_u8(reinterpret_cast<uint8_t*>(destination + i), pixels);
+		}
+#endif
+
+		for (; i < count; ++i)
+			destination[i] = swapRedBlue(source[i]);
+	}
+
+	void PixelConverter::PremultiplyAlpha(uintcs const* source, uintcs* destination, size_t count) {
+		size_t i = 0;
+
+#if defined(DXNA_SIMD_SSE2)
+		const auto zero = _mm_setzero_si128();
+		const auto colorLanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+		const auto alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+		const auto rounding = _mm_set1_epi16(128);
+
+		//Two pixels per register, as 16-bit channels.
+		const auto premultiply = [&](__m128i pixels) {
+			auto alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+			alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+			alpha = _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes);
+
+			const auto product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), rounding);
+			return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+		};
+
+		for (; i + 4 <= count; i += 4) {
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+			const auto low = premultiply(_mm_unpacklo_epi8(pixels, zero));
+			const auto high = premultiply(_mm_unpackhi_epi8(pixels, zero));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+		}
+#elif defined(DXNA_SIMD_NEON)
+		for (; i + 8 <= count; i += 8) {
+			auto pixels = vld4_u8(reinterpret_cast<uint8_t const*>(source + i));
+			const auto alpha = pixels.val[3];
+
+			for (int channel = 0; channel < 3; ++channel) {
+				const auto product = vmull_u8(pixels.val[channel], alpha);
+				pixels.val[channel] = vrshrn_n_u16(vrsraq_n_u16(product, product, 8), 8);
+			}
+
+			vst4_u8(reinterpret_cast<uint8_t*>(destination + i), pixels);
+		}
+#endif
+
+		for (; i < count; ++i) {
+			const auto pixel = source[i];
+			const auto alpha = pixel >> 24;
+
+			destination[i] = divide255((pixel & 0xFF) * alpha)
+				| divide255(((pixel >> 8) & 0xFF) * alpha) << 8
+				| divide255(((pixel >> 16) & 0xFF) * alpha) << 16
+				| alpha << 24;
+		}
+	}
+
+	void PixelConverter::UnpackRgba8(uintcs const* source, float* destination, size_t count) {
+		constexpr auto scale = 1.0F / 255.0F;
+		size_t i = 0;
+
+#if defined(DXNA_SIMD_SSE2)
+		const auto zero = _mm_setzero_si128();
+		const auto factor = _mm_set1_ps(scale);
+
+		for (; i + 4 <= count; i += 4) {
+			const auto pixels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(source + i));
+			const auto low = _mm_unpacklo_epi8(pixels, zero);
+			const auto high = _mm_unpackhi_epi8(pixels, zero);
+			auto output = destination + i * 4;
+
+			_mm_storeu_ps(output, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), factor));
+			_mm_storeu_ps(output + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), factor));
+			_mm_storeu_ps(output + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), factor));
+			_mm_storeu_ps(output + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), factor));
+		}
+#elif defined(DXNA_SIMD_NEON)
+		const auto factor = vdupq_n_f32(scale);
+
+		for (; i + 4 <= count; i += 4) {
+			const auto pixels = vreinterpretq_u8_u32(vld1q_u32(source + i));
+			const auto low = vmovl_u8(vget_low_u8(pixels));
+			const auto high = vmovl_u8(vget_high_u8(pixels));
+			auto output = destination + i * 4;
+
+			vst1q_f32(output, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(low))), factor));
+			vst1q_f32(output + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(low))), factor));
+			vst1q_f32(output + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(high))), factor));
+			vst1q_f32(output + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(high))), factor));
+		}
+#endif
+
+		for (; i < count; ++i) {
+			const auto pixel = source[i];
+			auto output = destination + i * 4;
+
+			output[0] = (pixel & 0xFF) * scale;
+			output[1] = ((pixel >> 8) & 0xFF) * scale;
+			output[2] = ((pixel >> 16) & 0xFF) * scale;
+			output[3] = (pixel >> 24) * scale;
+		}
+	}
+
+	void PixelConverter::PackRgba8(float const* source, uintcs* destination, size_t count) {
+		size_t i = 0;
+
+#if defined(DXNA_SIMD_SSE2)
+		const auto zero = _mm_setzero_ps();
+		const auto one = _mm_set1_ps(1.0F);
+		const auto scale = _mm_set1_ps(255.0F);
+		const auto half = _mm_set1_ps(0.5F);
+		const auto convert = [&](float const* pixel) {
+			const auto clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pixel), zero), one);
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+		};
+
+		for (; i + 4 <= count; i += 4) {
+			const auto input = source + i * 4;
+			const auto low = _mm_packs_epi32(convert(input), convert(input + 4));
+			const auto high = _mm_packs_epi32(convert(input + 8), convert(input + 12));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+		}
+#elif defined(DXNA_SIMD_NEON)
+		const auto convert = [](float const* pixel) {
+			const auto clamped = vminq_f32(vmaxq_f32(vld1q_f32(pixel), vdupq_n_f32(0.0F)), vdupq_n_f32(1.0F));
+			return vmovn_u32(vcvtq_u32_f32(vaddq_f32(vmulq_f32(clamped, vdupq_n_f32(255.0F)), vdupq_n_f32(0.5F))));
+		};
+
+		for (; i + 2 <= count; i += 2) {
+			const auto input = source + i * 4;
+			const auto bytes = vmovn_u16(vcombine_u16(convert(input), convert(input + 4)));
+
+			vst1_u8(reinterpret_cast<uint8_t*>(destination + i), bytes);
+		}
+#endif
+
+		for (; i < count; ++i) {
+			const auto input = source + i * 4;
+			uintcs pixel = 0;
+
+			for (intcs channel = 0; channel < 4; ++channel) {
+				const auto value = std::clamp(input[channel], 0.0F, 1.0F);
+				pixel |= static_cast<uintcs>(value * 255.0F + 0.5F) << (channel * 8);
+			}
+
+			destination[i] = pixel;
+		}
+	}
+
+	void PixelConverter::ToVector4(SurfaceFormat format, void const* source, float* destination, size_t count) {
+		switch (format)
+		{
+		case SurfaceFormat::Color:
+			UnpackRgba8(static_cast<uintcs const*>(source), destination, count);
+			return;
+
+		case SurfaceFormat::Bgra32: {
+			constexpr size_t ChunkSize = 256;
+			uintcs chunk[ChunkSize];
+			const auto pixels = static_cast<uintcs const*>(source);
+
+			for (size_t i = 0; i < count; i += ChunkSize) {
+				const auto size = std::min(ChunkSize, count - i);
+				SwapRedBlue(pixels + i, chunk, size);
+				UnpackRgba8(chunk, destination + i * 4, size);
+			}
+
+			return;
+		}
+
+		default:
+			std::memmove(destination, source, count * 4 * sizeof(float));
+			return;
+		}
+	}
+
+	void PixelConverter::FromVector4(SurfaceFormat format, float const* source, void* destination, size_t count) {
+		switch (format)
+		{
+		case SurfaceFormat::Color:
+			PackRgba8(source, static_cast<uintcs*>(destination), count);
+			return;
+
+		case SurfaceFormat::Bgra32: {
+			const auto pixels = static_cast<uintcs*>(destination);
+			PackRgba8(source, pixels, count);
+			SwapRedBlue(pixels, pixels, count);
+			return;
+		}
+
+		default:
+			std::memmove(destination, source, count * 4 * sizeof(float));
+			return;
+		}
+	}
+}
\ No newline at end of file
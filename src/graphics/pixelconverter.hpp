@@ -0,0 +1,37 @@
+#ifndef DXNA_GRAPHICS_PIXELCONVERTER_HPP
+#define DXNA_GRAPHICS_PIXELCONVERTER_HPP
+
+#include <cstddef>
+#include "../cs/cstypes.hpp"
+#include "enumerations.hpp"
+
+namespace dxna::graphics {
+	//Converts runs of pixels between surface formats, with SIMD where the target supports it.
+	//Source and destination may be the same buffer when both use the same pixel size.
+	struct PixelConverter {
+		//Size in bytes of a pixel.
+		static constexpr intcs GetSize(SurfaceFormat format) {
+			return format == SurfaceFormat::Vector4 ? 16 : 4;
+		}
+
+		//Swaps red and blue, converting RGBA8 to BGRA8 and back.
+		static void SwapRedBlue(uintcs const* source, uintcs* destination, size_t count);
+
+		//Multiplies the color channels of RGBA8 or BGRA8 pixels by their alpha, rounding to nearest.
+		static void PremultiplyAlpha(uintcs const* source, uintcs* destination, size_t count);
+
+		//RGBA8 to four floats per pixel in [0, 1].
+		static void UnpackRgba8(uintcs const* source, float* destination, size_t count);
+
+		//Four floats per pixel, clamped to [0, 1], to RGBA8.
+		static void PackRgba8(float const* source, uintcs* destination, size_t count);
+
+		//Pixels of any format to four floats per pixel in RGBA order.
+		static void ToVector4(SurfaceFormat format, void const* source, float* destination, size_t count);
+
+		//Four floats per pixel in RGBA order to pixels of any format.
+		static void FromVector4(SurfaceFormat format, float const* source, void* destination, size_t count);
+	};
+}
+
+#endif
\ No newline at end of file
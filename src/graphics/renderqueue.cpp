@@ -0,0 +1,74 @@
+#include "renderqueue.hpp"
+#include "commandlist.hpp"
+
+namespace dxna::graphics {
+	ulongcs RenderQueue::CreateSortKey(RenderItem const& item) {
+		const auto layer = static_cast<ulongcs>(item.Layer);
+		const auto bucket = static_cast<ulongcs>(item.Bucket == RenderBucket::Transparent ? 1 : 0);
+		const auto pass = static_cast<ulongcs>(_passIds.Get(item.Pass) & 0x7FFF);
+		const auto blend = static_cast<ulongcs>(_blendIds.Get(item.Blend) & 0xFF);
+		const auto depthStencil = static_cast<ulongcs>(_depthStencilIds.Get(item.DepthStencil) & 0xFF);
+		const auto depth = static_cast<ulongcs>(QuantizeDepth(item.Depth) & 0xFFFFFF);
+
+		auto key = layer << 56 | bucket << 55;
+
+		if (item.Bucket == RenderBucket::Transparent) {
+			key |= (0xFFFFFF - depth) << 31;
+			key |= pass << 16 | blend << 8 | depthStencil;
+		}
+		else {
+			key |= pass << 40 | blend << 32 | depthStencil << 24;
+			key |= depth;
+		}
+
+		return key;
+	}
+
+	void RenderQueue::Sort() {
+		const auto count = _items.size();
+
+		_entries.resize(count);
+		_scratch.resize(count);
+		_order.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+			_entries[i] = { _keys[i], static_cast<uintcs>(i) };
+
+		const auto sorted = RadixSort(_entries.data(), _scratch.data(), count);
+
+		for (size_t i = 0; i < count; ++i)
+			_order[i] = sorted[i].Index;
+
+		_sorted = true;
+	}
+
+	void RenderQueue::Submit(CommandList& commandList) {
+		if (!_sorted || _order.size() != _items.size())
+			Sort();
+
+		BlendState const* blend = nullptr;
+		DepthStencilState const* depthStencil = nullptr;
+		RasterizerState const* rasterizer = nullptr;
+
+		for (const auto index : _order) {
+			const auto& item = _items[index];
+
+			if (item.Blend != nullptr && item.Blend != blend) {
+				blend = item.Blend;
+				commandList.SetBlendState(blend);
+			}
+
+			if (item.DepthStencil != nullptr && item.DepthStencil != depthStencil) {
+				depthStencil = item.DepthStencil;
+				commandList.SetDepthStencilState(depthStencil);
+			}
+
+			if (item.Rasterizer != nullptr && item.Rasterizer != rasterizer) {
+				rasterizer = item.Rasterizer;
+				commandList.SetRasterizerState(rasterizer);
+			}
+
+			commandList.Draw(item.Primitive, item.StartVertex, item.PrimitiveCount);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef DXNA_GRAPHICS_RENDERQUEUE_HPP
+#define DXNA_GRAPHICS_RENDERQUEUE_HPP
+
+#include <vector>
+#include <bit>
+#include "../cs/cstypes.hpp"
+#include "../radixsort.hpp"
+#include "enumerations.hpp"
+#include "forward.hpp"
+#include "stateidtable.hpp"
+
+namespace dxna::graphics {
+	enum class RenderBucket : bytecs {
+		//Sorted by state first and front to back, to reduce state changes and overdraw.
+		Opaque,
+		//Sorted back to front first, as required by blending.
+		Transparent,
+	};
+
+	//A draw queued for the frame.
+	struct RenderItem {
+		EffectPass const* Pass = nullptr;
+		BlendState const* Blend = nullptr;
+		DepthStencilState const* DepthStencil = nullptr;
+		RasterizerState const* Rasterizer = nullptr;
+		PrimitiveType Primitive{ PrimitiveType::TriangleList };
+		intcs StartVertex{ 0 };
+		intcs PrimitiveCount{ 0 };
+		//View depth of the draw. Negative values are clamped to zero.
+		float Depth{ 0 };
+		bytecs Layer{ 0 };
+		RenderBucket Bucket{ RenderBucket::Opaque };
+	};
+
+	//Collects the draws of a frame, orders them by a 64-bit sort key and records them.
+	//
+	//Key layout, from the most significant bit:
+	//	Opaque:      layer(8) | bucket(1) | pass(15) | blend(8) | depthStencil(8) | depth(24)
+	//	Transparent: layer(8) | bucket(1) | inverted depth(24) | pass(15) | blend(8) | depthStencil(8)
+	//Ids that do not fit in their field wrap around, which only costs extra state changes.
+	class RenderQueue {
+	public:
+		RenderQueue() = default;
+
+		void Add(RenderItem const& item) {
+			_keys.push_back(CreateSortKey(item));
+			_items.push_back(item);
+			_sorted = false;
+		}
+
+		//Sorts the queued draws with an LSD radix sort over the keys, O(n).
+		void Sort();
+
+		//Records the draws in submission order, skipping redundant state changes.
+		//Sorts the queue first if needed.
+		void Submit(CommandList& commandList);
+
+		//Indexes of the queued draws in submission order. Valid after Sort.
+		std::vector<uintcs> const& SubmissionOrder() const { return _order; }
+
+		RenderItem const& At(size_t index) const { return _items[index]; }
+
+		ulongcs SortKey(size_t index) const { return _keys[index]; }
+
+		size_t Count() const { return _items.size(); }
+
+		//Removes the queued draws for the next frame, keeping the memory and the state ids.
+		void Clear() {
+			_items.clear();
+			_keys.clear();
+			_order.clear();
+			_sorted = true;
+		}
+
+		ulongcs CreateSortKey(RenderItem const& item);
+
+		static constexpr uintcs QuantizeDepth(float depth) {
+			if (!(depth > 0.0F))
+				return 0;
+
+			//The bits of a positive float grow with its value, keep the 24 most significant.
+			return std::bit_cast<uintcs>(depth) >> 7;
+		}
+
+	private:
+		using SortEntry = RadixEntry<ulongcs>;
+
+		std::vector<RenderItem> _items;
+		std::vector<ulongcs> _keys;
+		std::vector<SortEntry> _entries;
+		std::vector<SortEntry> _scratch;
+		std::vector<uintcs> _order;
+		bool _sorted{ true };
+
+		StateIdTable _passIds;
+		StateIdTable _blendIds;
+		StateIdTable _depthStencilIds;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "resourceregistry.hpp"
+#include <algorithm>
+#include <cstdio>
+#include "graphicsresource.hpp"
+#include "../cs/stream.hpp"
+
+namespace dxna::graphics {
+	char const* ResourceTypeName(ResourceType type) {
+		switch (type)
+		{
+		case ResourceType::Texture:
+			return "Texture";
+		case ResourceType::Shader:
+			return "Shader";
+		case ResourceType::Effect:
+			return "Effect";
+		case ResourceType::ConstantBuffer:
+			return "ConstantBuffer";
+		case ResourceType::SamplerState:
+			return "SamplerState";
+		case ResourceType::BlendState:
+			return "BlendState";
+		case ResourceType::DepthStencilState:
+			return "DepthStencilState";
+		case ResourceType::RasterizerState:
+			return "RasterizerState";
+		case ResourceType::SpriteBatch:
+			return "SpriteBatch";
+		default:
+			return "Unknown";
+		}
+	}
+
+	ResourceRegistry::ResourceRegistry() {
+		_budgets.fill(Unlimited);
+	}
+
+	ResourceRegistry& ResourceRegistry::Shared() {
+		static ResourceRegistry registry;
+		return registry;
+	}
+
+	void ResourceRegistry::add(GraphicsResource* resource) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		resource->_registryIndex = _resources.size();
+		resource->_id = _nextId++;
+		_resources.push_back(Entry{ resource, {}, resource->_type, 0, false });
+	}
+
+	void ResourceRegistry::remove(GraphicsResource* resource) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		const auto index = resource->_registryIndex;
+
+		_resources[index] = std::move(_resources.back());
+		_resources[index].Resource->_registryIndex = index;
+		_resources.pop_back();
+	}
+
+	void ResourceRegistry::rename(GraphicsResource* resource, std::string const& name) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_resources[resource->_registryIndex].Name = name;
+	}
+
+	void ResourceRegistry::update(GraphicsResource* resource, size_t bytes, bool evictable) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto& entry = _resources[resource->_registryIndex];
+		entry.Bytes = bytes;
+		entry.Evictable = evictable;
+		resource->_sizeInBytes.store(bytes, std::memory_order_relaxed);
+	}
+
+	size_t ResourceRegistry::evict(GraphicsResource* resource) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return evictEntry(_resources[resource->_registryIndex]);
+	}
+
+	size_t ResourceRegistry::evictEntry(Entry& entry) {
+		if (!entry.Evictable)
+			return 0;
+
+		const auto bytes = std::min(entry.Resource->EvictContent(), entry.Bytes);
+
+		entry.Bytes -= bytes;
+		entry.Resource->_sizeInBytes.store(entry.Bytes, std::memory_order_relaxed);
+		return bytes;
+	}
+
+	size_t ResourceRegistry::EndFrame() {
+		_frame.fetch_add(1, std::memory_order_relaxed);
+
+		return _hasBudget ? EnforceBudgets() : 0;
+	}
+
+	size_t ResourceRegistry::EnforceBudgets() {
+		std::vector<ResourceEvictedEventArgs> evictions;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			std::array<size_t, ResourceTypeCount> totals{};
+			size_t total = 0;
+
+			for (const auto& entry : _resources) {
+				totals[static_cast<size_t>(entry.Type)] += entry.Bytes;
+				total += entry.Bytes;
+			}
+
+			auto over = total > _budget;
+
+			for (size_t type = 0; type < ResourceTypeCount; ++type)
+				over = over || totals[type] > _budgets[type];
+
+			if (!over)
+				return 0;
+
+			//Least recently used first, leaving out what a frame in flight may read.
+			struct Candidate {
+				ulongcs LastUsedFrame;
+				size_t Index;
+			};
+
+			const auto frame = Frame();
+			std::vector<Candidate> candidates;
+
+			for (size_t index = 0; index < _resources.size(); ++index) {
+				const auto& entry = _resources[index];
+				const auto lastUsedFrame = entry.Resource->LastUsedFrame();
+
+				if (entry.Evictable && entry.Bytes > 0 && lastUsedFrame + _framesInFlight <= frame)
+					candidates.push_back({ lastUsedFrame, index });
+			}
+
+			std::sort(candidates.begin(), candidates.end(), [](Candidate const& left, Candidate const& right) {
+				return left.LastUsedFrame < right.LastUsedFrame;
+			});
+
+			for (const auto& candidate : candidates) {
+				auto& entry = _resources[candidate.Index];
+				const auto type = static_cast<size_t>(entry.Type);
+
+				if (total <= _budget && totals[type] <= _budgets[type])
+					continue;
+
+				const auto bytes = evictEntry(entry);
+
+				if (bytes == 0)
+					continue;
+
+				total -= std::min(bytes, total);
+				totals[type] -= std::min(bytes, totals[type]);
+				++_evictions[type];
+				_evictedBytes[type] += bytes;
+
+				ResourceEvictedEventArgs e;
+				e.Resource = entry.Resource->_id;
+				e.Name = entry.Name;
+				e.Type = entry.Type;
+				e.Bytes = bytes;
+				evictions.push_back(std::move(e));
+			}
+		}
+
+		size_t evicted = 0;
+
+		for (const auto& e : evictions) {
+			evicted += e.Bytes;
+			Evicted.Invoke(*this, e);
+		}
+
+		return evicted;
+	}
+
+	size_t ResourceRegistry::Budget() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _budget;
+	}
+
+	void ResourceRegistry::Budget(size_t bytes) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_budget = bytes;
+		_hasBudget = _budget != Unlimited
+			|| std::any_of(_budgets.begin(), _budgets.end(), [](size_t budget) { return budget != Unlimited; });
+	}
+
+	size_t ResourceRegistry::Budget(ResourceType type) const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _budgets[static_cast<size_t>(type)];
+	}
+
+	void ResourceRegistry::Budget(ResourceType type, size_t bytes) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_budgets[static_cast<size_t>(type)] = bytes;
+		_hasBudget = _budget != Unlimited
+			|| std::any_of(_budgets.begin(), _budgets.end(), [](size_t budget) { return budget != Unlimited; });
+	}
+
+	ulongcs ResourceRegistry::FramesInFlight() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _framesInFlight;
+	}
+
+	void ResourceRegistry::FramesInFlight(ulongcs value) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_framesInFlight = value;
+	}
+
+	size_t ResourceRegistry::Count() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _resources.size();
+	}
+
+	ResourceReport ResourceRegistry::Report() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		ResourceReport report;
+		report.Frame = Frame();
+		report.Count = _resources.size();
+		report.Budget = _budget;
+
+		for (const auto& entry : _resources) {
+			auto& type = report.Types[static_cast<size_t>(entry.Type)];
+
+			++type.Count;
+			type.Bytes += entry.Bytes;
+			report.Bytes += entry.Bytes;
+		}
+
+		for (size_t type = 0; type < ResourceTypeCount; ++type) {
+			report.Types[type].Budget = _budgets[type];
+			report.Types[type].Evictions = _evictions[type];
+			report.Types[type].EvictedBytes = _evictedBytes[type];
+			report.Evictions += _evictions[type];
+			report.EvictedBytes += _evictedBytes[type];
+		}
+
+		return report;
+	}
+
+	std::vector<ResourceInfo> ResourceRegistry::Resources() const {
+		std::vector<ResourceInfo> resources;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			resources.reserve(_resources.size());
+
+			for (const auto& entry : _resources) {
+				ResourceInfo info;
+				info.Id = entry.Resource->_id;
+				info.Name = entry.Name;
+				info.Type = entry.Type;
+				info.Bytes = entry.Bytes;
+				info.LastUsedFrame = entry.Resource->LastUsedFrame();
+				resources.push_back(std::move(info));
+			}
+		}
+
+		std::stable_sort(resources.begin(), resources.end(), [](ResourceInfo const& left, ResourceInfo const& right) {
+			return left.LastUsedFrame < right.LastUsedFrame;
+		});
+
+		return resources;
+	}
+
+	static void appendJsonString(std::string& json, char const* text) {
+		json += '"';
+
+		for (auto c = text != nullptr ? text : ""; *c != '\0'; ++c) {
+			switch (*c) {
+			case '"': json += "\\\""; break;
+			case '\\': json += "\\\\"; break;
+			case '\n': json += "\\n"; break;
+			default:
+				if (static_cast<unsigned char>(*c) < 0x20) {
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+					json += escaped;
+				}
+				else {
+					json += *c;
+				}
+			}
+		}
+
+		json += '"';
+	}
+
+	//Unlimited budgets are written as null.
+	static void appendBudget(std::string& json, size_t budget) {
+		char number[32];
+
+		if (budget == ResourceRegistry::Unlimited) {
+			json += "null";
+			return;
+		}
+
+		std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(budget));
+		json += number;
+	}
+
+	void ResourceRegistry::WriteJson(cs::Stream& stream) const {
+		const auto report = Report();
+		const auto resources = Resources();
+
+		std::string json;
+		char number[160];
+
+		std::snprintf(number, sizeof(number), "{\"frame\":%llu,\"count\":%llu,\"bytes\":%llu,\"evictions\":%llu,\"evictedBytes\":%llu,\"budget\":",
+			static_cast<unsigned long long>(report.Frame), static_cast<unsigned long long>(report.Count),
+			static_cast<unsigned long long>(report.Bytes), static_cast<unsigned long long>(report.Evictions),
+			static_cast<unsigned long long>(report.EvictedBytes));
+		json += number;
+		appendBudget(json, report.Budget);
+		json += ",\n\"types\":[";
+
+		for (size_t type = 0; type < ResourceTypeCount; ++type) {
+			const auto& entry = report.Types[type];
+
+			json += type == 0 ? "\n" : ",\n";
+			json += "{\"type\":";
+			appendJsonString(json, ResourceTypeName(static_cast<ResourceType>(type)));
+			std::snprintf(number, sizeof(number), ",\"count\":%llu,\"bytes\":%llu,\"evictions\":%llu,\"evictedBytes\":%llu,\"budget\":",
+				static_cast<unsigned long long>(entry.Count), static_cast<unsigned long long>(entry.Bytes),
+				static_cast<unsigned long long>(entry.Evictions), static_cast<unsigned long long>(entry.EvictedBytes));
+			json += number;
+			appendBudget(json, entry.Budget);
+			json += "}";
+		}
+
+		json += "],\n\"resources\":[";
+
+		for (size_t i = 0; i < resources.size(); ++i) {
+			const auto& resource = resources[i];
+
+			json += i == 0 ? "\n" : ",\n";
+			std::snprintf(number, sizeof(number), "{\"id\":%llu,\"name\":", static_cast<unsigned long long>(resource.Id));
+			json += number;
+			appendJsonString(json, resource.Name.c_str());
+			json += ",\"type\":";
+			appendJsonString(json, ResourceTypeName(resource.Type));
+			std::snprintf(number, sizeof(number), ",\"bytes\":%llu,\"lastUsedFrame\":%llu}",
+				static_cast<unsigned long long>(resource.Bytes), static_cast<unsigned long long>(resource.LastUsedFrame));
+			json += number;
+		}
+
+		json += "]}\n";
+		stream.Write(reinterpret_cast<bytecs const*>(json.data()), static_cast<intcs>(json.size()), 0, static_cast<intcs>(json.size()));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef DXNA_GRAPHICS_RESOURCEREGISTRY_HPP
+#define DXNA_GRAPHICS_RESOURCEREGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../cs/cstypes.hpp"
+#include "../cs/eventhandler.hpp"
+#include "forward.hpp"
+
+namespace cs {
+	class Stream;
+}
+
+namespace dxna::graphics {
+	enum class ResourceType : bytecs {
+		Unknown,
+		Texture,
+		Shader,
+		Effect,
+		ConstantBuffer,
+		SamplerState,
+		BlendState,
+		DepthStencilState,
+		RasterizerState,
+		SpriteBatch,
+	};
+
+	static constexpr size_t ResourceTypeCount = static_cast<size_t>(ResourceType::SpriteBatch) + 1;
+
+	char const* ResourceTypeName(ResourceType type);
+
+	//Identifies a resource for as long as the registry lives: ids are never reused, so an id
+	//kept after the resource is destroyed matches no other resource.
+	using ResourceId = ulongcs;
+
+	//One live resource, as seen by ResourceRegistry::Resources.
+	struct ResourceInfo {
+		ResourceId Id{ 0 };
+		std::string Name;
+		ResourceType Type{ ResourceType::Unknown };
+		size_t Bytes{ 0 };
+		ulongcs LastUsedFrame{ 0 };
+	};
+
+	struct ResourceTypeReport {
+		size_t Count{ 0 };
+		size_t Bytes{ 0 };
+		size_t Budget{ 0 };
+		ulongcs Evictions{ 0 };
+		size_t EvictedBytes{ 0 };
+	};
+
+	struct ResourceReport {
+		ulongcs Frame{ 0 };
+		size_t Count{ 0 };
+		size_t Bytes{ 0 };
+		size_t Budget{ 0 };
+		ulongcs Evictions{ 0 };
+		size_t EvictedBytes{ 0 };
+		std::array<ResourceTypeReport, ResourceTypeCount> Types{};
+	};
+
+	//The resource may have been destroyed by the time the handler runs: compare Resource with
+	//GraphicsResource::Id to find it among the resources the handler owns.
+	struct ResourceEvictedEventArgs : cs::EventArgs {
+		ResourceId Resource{ 0 };
+		std::string Name;
+		ResourceType Type{ ResourceType::Unknown };
+		size_t Bytes{ 0 };
+	};
+
+	//Tracks every live GraphicsResource: they add themselves when constructed and remove themselves when destroyed.
+	//Each entry holds the type and size the resource reported, so reports and budgets never call into a resource.
+	//EndFrame advances the frame resources are stamped with when touched, and keeps the memory within the budgets
+	//by evicting the least recently used resources that can be evicted, such as the texels of a Texture2D.
+	//A resource touched in the last FramesInFlight frames is never evicted, since a frame still being drawn may read it.
+	//The registry is locked when resources are added, removed or resized, and it only evicts a resource between
+	//the end of the constructor and the start of the destructor of its most derived class, so those may run on
+	//any thread. Call EndFrame from the thread that executes the draws, after the frame is executed, so a resource
+	//is never evicted while a draw is reading it; Game does so after each drawn frame, on the render thread if it uses one.
+	class ResourceRegistry {
+	public:
+		static constexpr size_t Unlimited = std::numeric_limits<size_t>::max();
+		static constexpr ulongcs DefaultFramesInFlight = 3;
+
+		ResourceRegistry();
+		ResourceRegistry(ResourceRegistry const&) = delete;
+		ResourceRegistry& operator=(ResourceRegistry const&) = delete;
+
+		//The registry every GraphicsResource adds itself to.
+		static ResourceRegistry& Shared();
+
+		ulongcs Frame() const { return _frame.load(std::memory_order_relaxed); }
+
+		//Ends the frame and evicts resources until the budgets are met. Returns the bytes evicted.
+		size_t EndFrame();
+
+		//Evicts resources until the budgets are met. Returns the bytes evicted.
+		size_t EnforceBudgets();
+
+		//The most bytes all resources together may use. Unlimited by default.
+		size_t Budget() const;
+		void Budget(size_t bytes);
+
+		//The most bytes the resources of one type may use. Unlimited by default.
+		size_t Budget(ResourceType type) const;
+		void Budget(ResourceType type, size_t bytes);
+
+		ulongcs FramesInFlight() const;
+		void FramesInFlight(ulongcs value);
+
+		size_t Count() const;
+
+		ResourceReport Report() const;
+
+		//A copy of the live resources, from the least to the most recently used.
+		std::vector<ResourceInfo> Resources() const;
+
+		//Writes the report and the resources as JSON.
+		void WriteJson(cs::Stream& stream) const;
+
+		//Raised by EndFrame and EnforceBudgets for each evicted resource, after the registry is unlocked,
+		//so the handler may load the resource again or destroy it.
+		cs::EventHandler<ResourceRegistry, ResourceEvictedEventArgs> Evicted;
+
+	private:
+		friend class GraphicsResource;
+
+		struct Entry {
+			GraphicsResource* Resource;
+			//A copy of GraphicsResource::Name, which only the owner of the resource may read.
+			std::string Name;
+			ResourceType Type;
+			size_t Bytes;
+			//Set by the most derived class between the end of its constructor and the start of its destructor.
+			bool Evictable;
+		};
+
+		void add(GraphicsResource* resource);
+		void remove(GraphicsResource* resource);
+		void rename(GraphicsResource* resource, std::string const& name);
+		void update(GraphicsResource* resource, size_t bytes, bool evictable);
+		size_t evict(GraphicsResource* resource);
+		size_t evictEntry(Entry& entry);
+
+		mutable std::mutex _mutex;
+		std::vector<Entry> _resources;
+		ResourceId _nextId{ 1 };
+		std::atomic<ulongcs> _frame{ 0 };
+		ulongcs _framesInFlight{ DefaultFramesInFlight };
+		size_t _budget{ Unlimited };
+		std::array<size_t, ResourceTypeCount> _budgets{};
+		std::array<ulongcs, ResourceTypeCount> _evictions{};
+		std::array<size_t, ResourceTypeCount> _evictedBytes{};
+		std::atomic<bool> _hasBudget{ false };
+	};
+}
+
+#endif
\ No newline at end of file
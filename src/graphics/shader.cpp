@@ -1,7 +1,7 @@
 #include "shader.hpp"
 
 namespace dxna::graphics {
-	Shader::Shader(GraphicsDevicePtr const& device, cs::BinaryReader& reader) {
+	Shader::Shader(GraphicsDevicePtr const& device, cs::BinaryReader& reader) : GraphicsResource(ResourceType::Shader) {
 		this->Device(device);		
 
 		const auto isVertexShader = reader.ReadBoolean();
@@ -0,0 +1,987 @@
+#include "softwarebackend.hpp"
+#include "graphicsdevice.hpp"
+#include "texture.hpp"
+#include "vertextypes.hpp"
+#include "../simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+using dxna::simd::Float4;
+
+namespace dxna::graphics {
+	//--------------------------------------------------------------------------------//
+	//								Pixel operations								  //
+	//--------------------------------------------------------------------------------//
+
+	template <typename T>
+	static bool compare(CompareFunction function, T value, T stored) {
+		switch (function)
+		{
+		case CompareFunction::Always:
+			return true;
+		case CompareFunction::Never:
+			return false;
+		case CompareFunction::Less:
+			return value < stored;
+		case CompareFunction::LessEqual:
+			return value <= stored;
+		case CompareFunction::Equal:
+			return value == stored;
+		case CompareFunction::GreaterEqual:
+			return value >= stored;
+		case CompareFunction::Greater:
+			return value > stored;
+		default:
+			return value != stored;
+		}
+	}
+
+	static intcs applyStencil(StencilOperation operation, intcs value, intcs reference) {
+		switch (operation)
+		{
+		case StencilOperation::Keep:
+			return value;
+		case StencilOperation::Zero:
+			return 0;
+		case StencilOperation::Replace:
+			return reference;
+		case StencilOperation::Increment:
+			return (value + 1) & 0xFF;
+		case StencilOperation::Decrement:
+			return (value - 1) & 0xFF;
+		case StencilOperation::IncrementSaturation:
+			return std::min(value + 1, 0xFF);
+		case StencilOperation::DecrementSaturation:
+			return std::max(value - 1, 0);
+		default:
+			return ~value & 0xFF;
+		}
+	}
+
+	static float blendFactor(Blend blend, intcs channel, float const* source, float const* destination, float const* constant) {
+		switch (blend)
+		{
+		case Blend::One:
+			return 1.0F;
+		case Blend::Zero:
+			return 0.0F;
+		case Blend::SourceColor:
+			return source[channel];
+		case Blend::InverseSourceColor:
+			return 1.0F - source[channel];
+		case Blend::SourceAlpha:
+			return source[3];
+		case Blend::InverseSourceAlpha:
+			return 1.0F - source[3];
+		case Blend::DestinationColor:
+			return destination[channel];
+		case Blend::InverseDestinationColor:
+			return 1.0F - destination[channel];
+		case Blend::DestinationAlpha:
+			return destination[3];
+		case Blend::InverseDestinationAlpha:
+			return 1.0F - destination[3];
+		case Blend::BlendFactor:
+			return constant[channel];
+		case Blend::InverseBlendFactor:
+			return 1.0F - constant[channel];
+		default:
+			return channel == 3 ? 1.0F : std::min(source[3], 1.0F - destination[3]);
+		}
+	}
+
+	static float blendFunction(BlendFunction function, float source, float destination, float sourceFactor, float destinationFactor) {
+		switch (function)
+		{
+		case BlendFunction::Add:
+			return source * sourceFactor + destination * destinationFactor;
+		case BlendFunction::Subtract:
+			return source * sourceFactor - destination * destinationFactor;
+		case BlendFunction::ReverseSubtract:
+			return destination * destinationFactor - source * sourceFactor;
+		case BlendFunction::Min:
+			return std::min(source, destination);
+		default:
+			return std::max(source, destination);
+		}
+	}
+
+	static void unpack(uintcs packed, float* color) {
+		constexpr auto scale = 1.0F / 255.0F;
+
+		color[0] = (packed & 0xFF) * scale;
+		color[1] = ((packed >> 8) & 0xFF) * scale;
+		color[2] = ((packed >> 16) & 0xFF) * scale;
+		color[3] = (packed >> 24) * scale;
+	}
+
+	//Wraps a texture coordinate to a texel in [0, size). The wrap and the clamp are done in float,
+	//so NaN, infinite and huge coordinates never reach the conversion: they sample texel 0.
+	static intcs wrap(float coordinate, intcs size) {
+		const auto texel = (coordinate - std::floor(coordinate)) * static_cast<float>(size);
+
+		//Also false for NaN.
+		if (!(texel >= 0.0F))
+			return 0;
+
+		//A fraction just below 1 may round to 1.
+		return texel < static_cast<float>(size) ? static_cast<intcs>(texel) : size - 1;
+	}
+
+	//Converts a coordinate already rounded to [low, high], with NaN going to low.
+	static intcs clampToInt(float value, intcs low, intcs high) {
+		if (!(value > static_cast<float>(low)))
+			return low;
+
+		return value < static_cast<float>(high) ? static_cast<intcs>(value) : high;
+	}
+
+	//Point sampling of level 0 with wrapped coordinates.
+	static void sample(Texture2D const& texture, float u, float v, float* color) {
+		const auto width = texture.Width();
+		const auto x = wrap(u, width);
+		const auto y = wrap(v, texture.Height());
+		const auto texel = static_cast<size_t>(y) * width + x;
+		const auto data = texture.LevelData(0);
+
+		switch (texture.Format())
+		{
+		case SurfaceFormat::Vector4:
+			std::memcpy(color, data + texel * 16, sizeof(float) * 4);
+			return;
+		case SurfaceFormat::Bgra32: {
+			uintcs packed;
+			std::memcpy(&packed, data + texel * 4, sizeof(packed));
+			unpack((packed & 0xFF00FF00) | ((packed & 0xFF) << 16) | ((packed >> 16) & 0xFF), color);
+			return;
+		}
+		default: {
+			uintcs packed;
+			std::memcpy(&packed, data + texel * 4, sizeof(packed));
+			unpack(packed, color);
+			return;
+		}
+		}
+	}
+
+	static uintcs pack(float const* color) {
+		uintcs packed = 0;
+
+		for (intcs i = 0; i < 4; ++i) {
+			const auto value = std::clamp(color[i], 0.0F, 1.0F);
+			packed |= static_cast<uintcs>(value * 255.0F + 0.5F) << (i * 8);
+		}
+
+		return packed;
+	}
+
+	//--------------------------------------------------------------------------------//
+	//								Framebuffer										  //
+	//--------------------------------------------------------------------------------//
+
+	void Framebuffer::Resize(intcs width, intcs height) {
+		_width = std::max(width, 0);
+		_height = std::max(height, 0);
+
+		const auto size = static_cast<size_t>(_width) * _height;
+
+		_colors.assign(size, 0);
+		_depth.assign(size, 1.0F);
+		_stencil.assign(size, 0);
+	}
+
+	//--------------------------------------------------------------------------------//
+	//								SoftwareBackend									  //
+	//--------------------------------------------------------------------------------//
+
+	SoftwareBackend::SoftwareBackend(intcs width, intcs height, intcs threadCount) {
+		Resize(width, height);
+
+		if (threadCount <= 0)
+			threadCount = std::max(static_cast<intcs>(std::thread::hardware_concurrency()), 1);
+
+		for (intcs i = 1; i < threadCount; ++i)
+			_workers.emplace_back([this] { workerLoop(); });
+	}
+
+	SoftwareBackend::~SoftwareBackend() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+
+		_wake.notify_all();
+
+		for (auto& worker : _workers)
+			worker.join();
+	}
+
+	void SoftwareBackend::Resize(intcs width, intcs height) {
+		flush();
+
+		_framebuffer.Resize(width, height);
+		_tilesX = (_framebuffer.Width() + TileSize - 1) / TileSize;
+		_tilesY = (_framebuffer.Height() + TileSize - 1) / TileSize;
+		_bins.assign(static_cast<size_t>(_tilesX) * _tilesY, {});
+	}
+
+	void SoftwareBackend::BeginFrame() {
+		++_statistics.Frames;
+		_hasViewport = false;
+		_hasScissorRectangle = false;
+	}
+
+	Error SoftwareBackend::Execute(CommandList const& commandList) {
+		auto result = NoError;
+		const auto& commands = commandList.Commands();
+
+		for (size_t i = 0; i < commands.size(); ++i) {
+			const auto error = execute(commandList, commands[i]);
+
+			if (error.HasError() && !result.HasError())
+				result = Error(error.Flag, static_cast<int>(i));
+		}
+
+		flush();
+
+		return result;
+	}
+
+	Error SoftwareBackend::execute(CommandList const& commandList, Command const& command) {
+		switch (command.Type)
+		{
+		case CommandType::Clear:
+			flush();
+			clear(command.Clear);
+			return NoError;
+
+		case CommandType::SetBlendState:
+			if (command.Blend == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_blendState = command.Blend;
+			_stateChanged = true;
+			return NoError;
+
+		case CommandType::SetDepthStencilState:
+			if (command.DepthStencil == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_depthStencilState = command.DepthStencil;
+			_stateChanged = true;
+			return NoError;
+
+		case CommandType::SetRasterizerState:
+			if (command.Rasterizer == nullptr)
+				return Error(ErrorCode::GRAPHICS_STATE_IS_NULL);
+
+			_rasterizerState = command.Rasterizer;
+			_stateChanged = true;
+			return NoError;
+
+		case CommandType::SetConstantData: {
+			const auto& data = command.ConstantData;
+
+			if (static_cast<size_t>(data.Offset) + data.Size > commandList.ConstantDataSize())
+				return Error(ErrorCode::GRAPHICS_CONSTANT_DATA_OUT_OF_RANGE);
+
+			if (data.Stage == ShaderStage::Vertex && data.Slot == 0 && data.Size >= sizeof(Matrix))
+				std::memcpy(&_transform, commandList.ConstantData(command), sizeof(Matrix));
+
+			return NoError;
+		}
+
+		case CommandType::SetViewport: {
+			const auto& viewport = command.Viewport;
+
+			if (viewport.Width <= 0 || viewport.Height <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_VIEWPORT);
+
+			_viewport = Viewport(viewport.X, viewport.Y, viewport.Width, viewport.Height);
+			_hasViewport = true;
+			return NoError;
+		}
+
+		case CommandType::SetScissorRectangle: {
+			const auto& rectangle = command.ScissorRectangle;
+
+			if (rectangle.Width < 0 || rectangle.Height < 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_RECTANGLE);
+
+			_scissorRectangle = Rectangle(rectangle.X, rectangle.Y, rectangle.Width, rectangle.Height);
+			_hasScissorRectangle = true;
+			return NoError;
+		}
+
+		case CommandType::SetVertexData:
+			if (command.VertexData.Format != _vertexData.Format)
+				_stateChanged = true;
+
+			_vertexData = command.VertexData;
+			return NoError;
+
+		case CommandType::SetIndexData:
+			_indexData = command.IndexData;
+			return NoError;
+
+		case CommandType::SetTexture:
+			if (command.Texture.Slot < 0 || command.Texture.Slot >= MaxTextureSlots)
+				return Error(ErrorCode::GRAPHICS_INVALID_TEXTURE_SLOT);
+
+			if (command.Texture.Texture != nullptr && command.Texture.Texture->IsEvicted())
+				return Error(ErrorCode::GRAPHICS_RESOURCE_EVICTED);
+
+			_textures[command.Texture.Slot] = command.Texture.Texture;
+			_stateChanged = true;
+			return NoError;
+
+		case CommandType::Draw: {
+			const auto& draw = command.Draw;
+
+			if (draw.PrimitiveCount <= 0 || draw.StartVertex < 0 || draw.InstanceCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_PRIMITIVE_COUNT);
+
+			if (static_cast<longcs>(draw.StartVertex) + GraphicsDevice::GetElementCount(draw.Primitive, draw.PrimitiveCount) > _vertexData.VertexCount)
+				return Error(ErrorCode::GRAPHICS_INDEX_OUT_OF_RANGE);
+
+			for (intcs instance = 0; instance < draw.InstanceCount; ++instance) {
+				const auto error = this->draw(draw.Primitive, draw.PrimitiveCount, draw.StartVertex, nullptr);
+
+				if (error.HasError())
+					return error;
+			}
+
+			return NoError;
+		}
+
+		case CommandType::DrawIndexed: {
+			const auto& draw = command.DrawIndexed;
+
+			if (_indexData.Data == nullptr || _indexData.IndexCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INDEX_DATA_NOT_SET);
+
+			if (draw.PrimitiveCount <= 0)
+				return Error(ErrorCode::GRAPHICS_INVALID_PRIMITIVE_COUNT);
+
+			if (draw.StartIndex < 0 || draw.BaseVertex < 0
+				|| static_cast<longcs>(draw.StartIndex) + GraphicsDevice::GetElementCount(draw.Primitive, draw.PrimitiveCount) > _indexData.IndexCount)
+				return Error(ErrorCode::GRAPHICS_INDEX_OUT_OF_RANGE);
+
+			return this->draw(draw.Primitive, draw.PrimitiveCount, draw.BaseVertex, _indexData.Data + draw.StartIndex);
+		}
+
+		default:
+			return Error(ErrorCode::GRAPHICS_UNKNOWN_COMMAND);
+		}
+	}
+
+	Error SoftwareBackend::draw(PrimitiveType primitiveType, intcs primitiveCount, intcs baseVertex, ushortcs const* indices) {
+		if (!_hasViewport)
+			return Error(ErrorCode::GRAPHICS_VIEWPORT_NOT_SET);
+
+		if (_vertexData.Data == nullptr || _vertexData.VertexCount <= 0)
+			return Error(ErrorCode::GRAPHICS_VERTEX_DATA_NOT_SET);
+
+		if (primitiveType != PrimitiveType::TriangleList && primitiveType != PrimitiveType::TriangleStrip)
+			return Error(ErrorCode::GRAPHICS_UNSUPPORTED_PRIMITIVE);
+
+		if (_stateChanged) {
+			_states.push_back(createState());
+			_stateChanged = false;
+		}
+
+		if (_states.back().Rasterizer->FillMode != FillMode::Solid)
+			return Error(ErrorCode::GRAPHICS_UNSUPPORTED_STATE);
+
+		++_statistics.Draws;
+
+		ClipVertex vertices[3];
+
+		for (intcs primitive = 0; primitive < primitiveCount; ++primitive) {
+			//Odd strip triangles swap two vertices to keep the winding of the strip.
+			intcs element[3] = { primitive * 3, primitive * 3 + 1, primitive * 3 + 2 };
+
+			if (primitiveType == PrimitiveType::TriangleStrip) {
+				const auto odd = (primitive & 1) != 0;
+				element[0] = odd ? primitive + 1 : primitive;
+				element[1] = odd ? primitive : primitive + 1;
+				element[2] = primitive + 2;
+			}
+
+			for (intcs i = 0; i < 3; ++i) {
+				const auto index = baseVertex + (indices != nullptr ? indices[element[i]] : element[i]);
+
+				if (index >= _vertexData.VertexCount)
+					return Error(ErrorCode::GRAPHICS_INDEX_OUT_OF_RANGE);
+
+				vertices[i] = fetch(index);
+			}
+
+			++_statistics.Triangles;
+			clipAndSetup(vertices);
+		}
+
+		//Bounds the memory held by the bins on very long command lists.
+		if (_triangles.size() >= (size_t(1) << 20))
+			flush();
+
+		return NoError;
+	}
+
+	SoftwareBackend::DrawState SoftwareBackend::createState() const {
+		DrawState state{};
+		state.Blend = _blendState != nullptr ? _blendState : &_defaultBlendState;
+		state.DepthStencil = _depthStencilState != nullptr ? _depthStencilState : &_defaultDepthStencilState;
+		state.Rasterizer = _rasterizerState != nullptr ? _rasterizerState : &_defaultRasterizerState;
+
+		const auto& blend = *state.Blend;
+		const auto& depthStencil = *state.DepthStencil;
+		const auto channels = static_cast<intcs>(blend.ColorWriteChannels());
+
+		for (intcs channel = 0; channel < 4; ++channel) {
+			if ((channels & (1 << channel)) != 0)
+				state.WriteMask |= 0xFFu << (channel * 8);
+		}
+
+		unpack(blend.BlendFactor.PackedValue(), state.BlendFactor);
+
+		state.Opaque = blend.ColorSourceBlend() == Blend::One && blend.ColorDestinationBlend() == Blend::Zero
+			&& blend.AlphaSourceBlend() == Blend::One && blend.AlphaDestinationBlend() == Blend::Zero
+			&& blend.ColorBlendFunction() == BlendFunction::Add && blend.AlphaBlendFunction() == BlendFunction::Add
+			&& state.WriteMask == 0xFFFFFFFF;
+
+		//Factors that are the same for every channel reduce blending to one multiply-add per channel.
+		const auto uniform = [](Blend factor) {
+			return factor == Blend::One || factor == Blend::Zero || factor == Blend::SourceAlpha || factor == Blend::InverseSourceAlpha;
+		};
+
+		state.SourceBlend = blend.ColorSourceBlend();
+		state.DestinationBlend = blend.ColorDestinationBlend();
+		state.UniformBlend = blend.ColorBlendFunction() == BlendFunction::Add && blend.AlphaBlendFunction() == BlendFunction::Add
+			&& blend.AlphaSourceBlend() == state.SourceBlend && blend.AlphaDestinationBlend() == state.DestinationBlend
+			&& uniform(state.SourceBlend) && uniform(state.DestinationBlend);
+
+		//A stencil that always passes and keeps its values is skipped.
+		const auto keepsStencil = [](CompareFunction function, StencilOperation pass, StencilOperation fail, StencilOperation depthFail) {
+			return function == CompareFunction::Always && pass == StencilOperation::Keep
+				&& fail == StencilOperation::Keep && depthFail == StencilOperation::Keep;
+		};
+
+		state.StencilTest = depthStencil.StencilEnable
+			&& !(keepsStencil(depthStencil.StencilFunction, depthStencil.StencilPass, depthStencil.StencilFail, depthStencil.StencilDepthBufferFail)
+				&& (!depthStencil.TwoSidedStencilMode || keepsStencil(depthStencil.CounterClockwiseStencilFunction, depthStencil.CounterClockwiseStencilPass,
+					depthStencil.CounterClockwiseStencilFail, depthStencil.CounterClockwiseStencilDepthBufferFail)));
+
+		state.DepthTest = depthStencil.DepthBufferEnable;
+		state.DepthWrite = depthStencil.DepthBufferEnable && depthStencil.DepthBufferWriteEnable;
+		state.DepthBias = state.Rasterizer->DepthBias;
+		state.Simple = state.Opaque && !state.DepthTest && !state.StencilTest;
+
+		if (_vertexData.Format == VertexFormat::PositionColorTexture && _textures[0] != nullptr)
+			state.Texture = _textures[0];
+
+		return state;
+	}
+
+	SoftwareBackend::ClipVertex SoftwareBackend::fetch(intcs index) const {
+		constexpr auto scale = 1.0F / 255.0F;
+
+		Vector3 position;
+		uintcs color = 0xFFFFFFFF;
+		Vector2 textureCoordinate;
+
+		if (_vertexData.Format == VertexFormat::PositionColorTexture) {
+			const auto& vertex = static_cast<VertexPositionColorTexture const*>(_vertexData.Data)[index];
+			position = vertex.Position;
+			color = vertex.Color.PackedValue();
+			textureCoordinate = vertex.TextureCoordinate;
+		}
+		else {
+			const auto& vertex = static_cast<VertexPositionColor const*>(_vertexData.Data)[index];
+			position = vertex.Position;
+			color = vertex.Color.PackedValue();
+		}
+
+		//Row vector times matrix, as in Vector4::Transform.
+		const auto& m = _transform;
+		const auto clip = Float4::Set(m.M11, m.M12, m.M13, m.M14) * Float4::Set(position.X)
+			+ Float4::Set(m.M21, m.M22, m.M23, m.M24) * Float4::Set(position.Y)
+			+ Float4::Set(m.M31, m.M32, m.M33, m.M34) * Float4::Set(position.Z)
+			+ Float4::Set(m.M41, m.M42, m.M43, m.M44);
+
+		ClipVertex vertex;
+		clip.Store(vertex.Position);
+		vertex.Color[0] = (color & 0xFF) * scale;
+		vertex.Color[1] = ((color >> 8) & 0xFF) * scale;
+		vertex.Color[2] = ((color >> 16) & 0xFF) * scale;
+		vertex.Color[3] = (color >> 24) * scale;
+		vertex.TextureCoordinate[0] = textureCoordinate.X;
+		vertex.TextureCoordinate[1] = textureCoordinate.Y;
+
+		return vertex;
+	}
+
+	void SoftwareBackend::clipAndSetup(ClipVertex const* vertices) {
+		//Distances to the near (z >= 0) and far (z <= w) planes.
+		const auto nearDistance = [](ClipVertex const& v) { return v.Position[2]; };
+		const auto farDistance = [](ClipVertex const& v) { return v.Position[3] - v.Position[2]; };
+
+		auto inside = true;
+
+		for (intcs i = 0; i < 3; ++i)
+			inside = inside && nearDistance(vertices[i]) >= 0.0F && farDistance(vertices[i]) >= 0.0F;
+
+		if (inside) {
+			setup(vertices[0], vertices[1], vertices[2]);
+			return;
+		}
+
+		ClipVertex polygon[9];
+		ClipVertex clipped[9];
+		intcs count = 3;
+
+		std::copy(vertices, vertices + 3, polygon);
+
+		const auto clipPlane = [&](auto distance) {
+			intcs result = 0;
+
+			for (intcs i = 0; i < count; ++i) {
+				const auto& a = polygon[i];
+				const auto& b = polygon[(i + 1) % count];
+				const auto da = distance(a);
+				const auto db = distance(b);
+
+				if (da >= 0.0F)
+					clipped[result++] = a;
+
+				if ((da >= 0.0F) != (db >= 0.0F)) {
+					const auto t = da / (da - db);
+					auto& v = clipped[result++];
+					auto const* from = reinterpret_cast<float const*>(&a);
+					auto const* to = reinterpret_cast<float const*>(&b);
+					auto* out = reinterpret_cast<float*>(&v);
+
+					for (size_t k = 0; k < sizeof(ClipVertex) / sizeof(float); ++k)
+						out[k] = from[k] + (to[k] - from[k]) * t;
+				}
+			}
+
+			std::copy(clipped, clipped + result, polygon);
+			count = result;
+		};
+
+		clipPlane(nearDistance);
+		clipPlane(farDistance);
+
+		if (count < 3) {
+			++_statistics.CulledTriangles;
+			return;
+		}
+
+		for (intcs i = 1; i + 1 < count; ++i)
+			setup(polygon[0], polygon[i], polygon[i + 1]);
+	}
+
+	void SoftwareBackend::setup(ClipVertex const& v0, ClipVertex const& v1, ClipVertex const& v2) {
+		ClipVertex const* vertices[3] = { &v0, &v1, &v2 };
+		float x[3], y[3], values[3][AttributeCount];
+
+		for (intcs i = 0; i < 3; ++i) {
+			const auto& v = *vertices[i];
+
+			if (!(v.Position[3] > 0.0F)) {
+				++_statistics.CulledTriangles;
+				return;
+			}
+
+			const auto inverseW = 1.0F / v.Position[3];
+
+			x[i] = (v.Position[0] * inverseW + 1.0F) * 0.5F * _viewport.Width + _viewport.X;
+			y[i] = (1.0F - v.Position[1] * inverseW) * 0.5F * _viewport.Height + _viewport.Y;
+
+			values[i][AttributeDepth] = v.Position[2] * inverseW;
+			values[i][AttributeInverseW] = inverseW;
+			values[i][AttributeRed] = v.Color[0] * inverseW;
+			values[i][AttributeGreen] = v.Color[1] * inverseW;
+			values[i][AttributeBlue] = v.Color[2] * inverseW;
+			values[i][AttributeAlpha] = v.Color[3] * inverseW;
+			values[i][AttributeU] = v.TextureCoordinate[0] * inverseW;
+			values[i][AttributeV] = v.TextureCoordinate[1] * inverseW;
+		}
+
+		//Positive area means clockwise on screen, since y grows downwards.
+		auto area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		const auto clockwise = area > 0.0F;
+		const auto& state = _states.back();
+		const auto cullMode = state.Rasterizer->CullMode;
+
+		if (area == 0.0F
+			|| (cullMode == CullMode::CullClockwiseFace && clockwise)
+			|| (cullMode == CullMode::CullCounterClockwiseFace && !clockwise)) {
+			++_statistics.CulledTriangles;
+			return;
+		}
+
+		//The clip rectangle is the viewport inside the framebuffer, and inside the scissor rectangle when tested.
+		auto clipLeft = std::max(_viewport.X, 0);
+		auto clipTop = std::max(_viewport.Y, 0);
+		auto clipRight = std::min(_viewport.X + _viewport.Width, _framebuffer.Width());
+		auto clipBottom = std::min(_viewport.Y + _viewport.Height, _framebuffer.Height());
+
+		if (state.Rasterizer->ScissorTestEnable && _hasScissorRectangle) {
+			clipLeft = std::max(clipLeft, _scissorRectangle.Left());
+			clipTop = std::max(clipTop, _scissorRectangle.Top());
+			clipRight = std::min(clipRight, _scissorRectangle.Right());
+			clipBottom = std::min(clipBottom, _scissorRectangle.Bottom());
+		}
+
+		Triangle triangle;
+		triangle.MinX = clampToInt(std::floor(std::min({ x[0], x[1], x[2] })), clipLeft, clipRight);
+		triangle.MinY = clampToInt(std::floor(std::min({ y[0], y[1], y[2] })), clipTop, clipBottom);
+		triangle.MaxX = clampToInt(std::ceil(std::max({ x[0], x[1], x[2] })), clipLeft, clipRight);
+		triangle.MaxY = clampToInt(std::ceil(std::max({ y[0], y[1], y[2] })), clipTop, clipBottom);
+
+		if (triangle.MinX >= triangle.MaxX || triangle.MinY >= triangle.MaxY) {
+			++_statistics.CulledTriangles;
+			return;
+		}
+
+		//Edge i is opposite to vertex i, and is positive inside a clockwise triangle.
+		const auto sign = clockwise ? 1.0F : -1.0F;
+		area *= sign;
+		triangle.TopLeft = 0;
+
+		for (intcs i = 0; i < 3; ++i) {
+			const auto a = (i + 1) % 3;
+			const auto b = (i + 2) % 3;
+			const auto edgeA = (y[a] - y[b]) * sign;
+			const auto edgeB = (x[b] - x[a]) * sign;
+
+			triangle.EdgeA[i] = edgeA;
+			triangle.EdgeB[i] = edgeB;
+			triangle.EdgeC[i] = -(edgeA * x[a] + edgeB * y[a]);
+
+			//Pixels centered on a top or left edge belong to the triangle, on other edges they do not.
+			if (edgeA > 0.0F || (edgeA == 0.0F && edgeB > 0.0F))
+				triangle.TopLeft |= static_cast<bytecs>(1 << i);
+		}
+
+		const auto inverseArea = 1.0F / area;
+
+		for (intcs attribute = 0; attribute < AttributeCount; ++attribute) {
+			auto& plane = triangle.Planes[attribute];
+			plane[0] = plane[1] = plane[2] = 0.0F;
+
+			for (intcs i = 0; i < 3; ++i) {
+				plane[0] += values[i][attribute] * triangle.EdgeA[i];
+				plane[1] += values[i][attribute] * triangle.EdgeB[i];
+				plane[2] += values[i][attribute] * triangle.EdgeC[i];
+			}
+
+			plane[0] *= inverseArea;
+			plane[1] *= inverseArea;
+			plane[2] *= inverseArea;
+		}
+
+		triangle.State = static_cast<uintcs>(_states.size() - 1);
+		triangle.FrontFace = clockwise;
+
+		const auto index = static_cast<uintcs>(_triangles.size());
+		_triangles.push_back(triangle);
+
+		for (auto tileY = triangle.MinY / TileSize; tileY <= (triangle.MaxY - 1) / TileSize; ++tileY) {
+			for (auto tileX = triangle.MinX / TileSize; tileX <= (triangle.MaxX - 1) / TileSize; ++tileX) {
+				const auto tile = tileY * _tilesX + tileX;
+				auto& bin = _bins[tile];
+
+				if (bin.empty())
+					_activeTiles.push_back(tile);
+
+				bin.push_back(index);
+			}
+		}
+	}
+
+	void SoftwareBackend::clear(ClearCommand const& clear) {
+		const auto size = static_cast<size_t>(_framebuffer.Width()) * _framebuffer.Height();
+		const auto options = static_cast<intcs>(clear.Options);
+
+		if ((options & static_cast<intcs>(ClearOptions::Target)) != 0)
+			std::fill(_framebuffer.Colors(), _framebuffer.Colors() + size, clear.Color);
+
+		if ((options & static_cast<intcs>(ClearOptions::DepthBuffer)) != 0)
+			std::fill(_framebuffer.Depth(), _framebuffer.Depth() + size, clear.Depth);
+
+		if ((options & static_cast<intcs>(ClearOptions::Stencil)) != 0)
+			std::fill(_framebuffer.Stencil(), _framebuffer.Stencil() + size, static_cast<bytecs>(clear.Stencil));
+	}
+
+	//--------------------------------------------------------------------------------//
+	//								Rasterization									  //
+	//--------------------------------------------------------------------------------//
+
+	void SoftwareBackend::flush() {
+		if (!_activeTiles.empty()) {
+			_nextTile = 0;
+			_pixels = 0;
+
+			if (!_workers.empty()) {
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_busy = _workers.size();
+					++_generation;
+				}
+
+				_wake.notify_all();
+			}
+
+			runTiles();
+
+			if (!_workers.empty()) {
+				std::unique_lock<std::mutex> lock(_mutex);
+				_done.wait(lock, [this] { return _busy == 0; });
+			}
+
+			_statistics.Pixels += _pixels;
+
+			for (const auto tile : _activeTiles)
+				_bins[tile].clear();
+
+			_activeTiles.clear();
+		}
+
+		_triangles.clear();
+		_states.clear();
+		_stateChanged = true;
+	}
+
+	void SoftwareBackend::runTiles() {
+		ulongcs pixels = 0;
+
+		for (auto i = _nextTile++; i < _activeTiles.size(); i = _nextTile++)
+			pixels += rasterizeTile(_activeTiles[i]);
+
+		_pixels += pixels;
+	}
+
+	void SoftwareBackend::workerLoop() {
+		ulongcs generation = 0;
+
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wake.wait(lock, [&] { return _stop || _generation != generation; });
+
+				if (_stop)
+					return;
+
+				generation = _generation;
+			}
+
+			runTiles();
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (--_busy == 0)
+					_done.notify_one();
+			}
+		}
+	}
+
+	ulongcs SoftwareBackend::rasterizeTile(intcs tile) {
+		const auto tileLeft = (tile % _tilesX) * TileSize;
+		const auto tileTop = (tile / _tilesX) * TileSize;
+		const auto offsets = Float4::Set(0.5F, 1.5F, 2.5F, 3.5F);
+		const auto zero = Float4::Set(0.0F);
+		const auto colors = _framebuffer.Colors();
+		ulongcs pixels = 0;
+
+		for (const auto index : _bins[tile]) {
+			const auto& triangle = _triangles[index];
+			const auto& state = _states[triangle.State];
+			const auto left = std::max(triangle.MinX, tileLeft);
+			const auto top = std::max(triangle.MinY, tileTop);
+			const auto right = std::min(triangle.MaxX, tileLeft + TileSize);
+			const auto bottom = std::min(triangle.MaxY, tileTop + TileSize);
+
+			Float4 edgeA[3];
+
+			for (intcs i = 0; i < 3; ++i)
+				edgeA[i] = Float4::Set(triangle.EdgeA[i]);
+
+			for (auto y = top; y < bottom; ++y) {
+				const auto centerY = y + 0.5F;
+				Float4 rowC[3];
+
+				for (intcs i = 0; i < 3; ++i)
+					rowC[i] = Float4::Set(triangle.EdgeB[i] * centerY + triangle.EdgeC[i]);
+
+				for (auto x = left; x < right; x += 4) {
+					const auto centerX = Float4::Set(static_cast<float>(x)) + offsets;
+					auto mask = right - x < 4 ? (1 << (right - x)) - 1 : 0xF;
+
+					for (intcs i = 0; i < 3 && mask != 0; ++i) {
+						const auto edge = Float4::MultiplyAdd(edgeA[i], centerX, rowC[i]);
+
+						mask &= (triangle.TopLeft & (1 << i)) != 0
+							? Float4::GreaterEqualMask(edge, zero)
+							: Float4::GreaterMask(edge, zero);
+					}
+
+					if (mask == 0)
+						continue;
+
+					//Interpolates the attributes of the four pixels, then shades the covered ones.
+					const auto plane = [&](intcs attribute) {
+						const auto& p = triangle.Planes[attribute];
+						return Float4::MultiplyAdd(Float4::Set(p[0]), centerX, Float4::Set(p[1] * centerY + p[2]));
+					};
+
+					const auto w = Float4::Set(1.0F) / plane(AttributeInverseW);
+					auto red = plane(AttributeRed) * w;
+					auto green = plane(AttributeGreen) * w;
+					auto blue = plane(AttributeBlue) * w;
+					auto alpha = plane(AttributeAlpha) * w;
+
+					if (state.Texture != nullptr) {
+						float u[4], v[4], texels[4][4];
+
+						(plane(AttributeU) * w).Store(u);
+						(plane(AttributeV) * w).Store(v);
+
+						for (intcs lane = 0; lane < 4; ++lane) {
+							float texel[4];
+							sample(*state.Texture, u[lane], v[lane], texel);
+
+							for (intcs channel = 0; channel < 4; ++channel)
+								texels[channel][lane] = texel[channel];
+						}
+
+						red = red * Float4::Load(texels[0]);
+						green = green * Float4::Load(texels[1]);
+						blue = blue * Float4::Load(texels[2]);
+						alpha = alpha * Float4::Load(texels[3]);
+					}
+
+					const auto pixel = static_cast<size_t>(y) * _framebuffer.Width() + x;
+
+					uint32_t packed[4];
+					simd::PackUnorm8(red, green, blue, alpha, packed);
+
+					if (state.Simple) {
+						for (; mask != 0; mask &= mask - 1) {
+							const auto lane = std::countr_zero(static_cast<unsigned>(mask));
+							colors[pixel + lane] = packed[lane];
+							++pixels;
+						}
+
+						continue;
+					}
+
+					float depth[4];
+					float color[4][4];
+
+					plane(AttributeDepth).Store(depth);
+					red.Store(color[0]);
+					green.Store(color[1]);
+					blue.Store(color[2]);
+					alpha.Store(color[3]);
+
+					for (; mask != 0; mask &= mask - 1) {
+						const auto lane = std::countr_zero(static_cast<unsigned>(mask));
+						const float source[4] = { color[0][lane], color[1][lane], color[2][lane], color[3][lane] };
+
+						if (shade(triangle, state, pixel + lane, depth[lane], packed[lane], source))
+							++pixels;
+					}
+				}
+			}
+		}
+
+		return pixels;
+	}
+
+	bool SoftwareBackend::shade(Triangle const& triangle, DrawState const& state, size_t pixel, float depth, uintcs packed, float const* source) {
+		const auto& depthStencil = *state.DepthStencil;
+		auto& storedDepth = _framebuffer.Depth()[pixel];
+
+		depth += state.DepthBias;
+
+		if (state.StencilTest) {
+			const auto ccw = !triangle.FrontFace && depthStencil.TwoSidedStencilMode;
+			const auto function = ccw ? depthStencil.CounterClockwiseStencilFunction : depthStencil.StencilFunction;
+			const auto mask = depthStencil.StencilMask & 0xFF;
+			const auto reference = depthStencil.ReferenceStencil & 0xFF;
+			auto& stored = _framebuffer.Stencil()[pixel];
+
+			StencilOperation operation;
+			auto passed = compare(function, reference & mask, stored & mask);
+
+			if (!passed) {
+				operation = ccw ? depthStencil.CounterClockwiseStencilFail : depthStencil.StencilFail;
+			}
+			else if (state.DepthTest && !compare(depthStencil.DepthBufferFunction, depth, storedDepth)) {
+				operation = ccw ? depthStencil.CounterClockwiseStencilDepthBufferFail : depthStencil.StencilDepthBufferFail;
+				passed = false;
+			}
+			else {
+				operation = ccw ? depthStencil.CounterClockwiseStencilPass : depthStencil.StencilPass;
+			}
+
+			if (operation != StencilOperation::Keep) {
+				const auto writeMask = depthStencil.StencilWriteMask & 0xFF;
+				const auto value = applyStencil(operation, stored, reference);
+				stored = static_cast<bytecs>((stored & ~writeMask) | (value & writeMask));
+			}
+
+			if (!passed)
+				return false;
+		}
+		else if (state.DepthTest && !compare(depthStencil.DepthBufferFunction, depth, storedDepth)) {
+			return false;
+		}
+
+		if (state.DepthWrite)
+			storedDepth = depth;
+
+		auto& target = _framebuffer.Colors()[pixel];
+
+		if (state.Opaque) {
+			target = packed;
+			return true;
+		}
+
+		float destination[4];
+		float result[4];
+
+		unpack(target, destination);
+
+		if (state.UniformBlend) {
+			const auto sourceFactor = blendFactor(state.SourceBlend, 3, source, destination, state.BlendFactor);
+			const auto destinationFactor = blendFactor(state.DestinationBlend, 3, source, destination, state.BlendFactor);
+
+			for (intcs channel = 0; channel < 4; ++channel)
+				result[channel] = source[channel] * sourceFactor + destination[channel] * destinationFactor;
+
+			target = (target & ~state.WriteMask) | (pack(result) & state.WriteMask);
+			return true;
+		}
+
+		const auto& blend = *state.Blend;
+
+		for (intcs channel = 0; channel < 4; ++channel) {
+			const auto alpha = channel == 3;
+			const auto sourceFactor = blendFactor(alpha ? blend.AlphaSourceBlend() : blend.ColorSourceBlend(), channel, source, destination, state.BlendFactor);
+			const auto destinationFactor = blendFactor(alpha ? blend.AlphaDestinationBlend() : blend.ColorDestinationBlend(), channel, source, destination, state.BlendFactor);
+			const auto function = alpha ? blend.AlphaBlendFunction() : blend.ColorBlendFunction();
+
+			result[channel] = blendFunction(function, source[channel], destination[channel], sourceFactor, destinationFactor);
+		}
+
+		target = (target & ~state.WriteMask) | (pack(result) & state.WriteMask);
+		return true;
+	}
+}
\ No newline at end of file
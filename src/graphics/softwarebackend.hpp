@@ -0,0 +1,214 @@
+#ifndef DXNA_GRAPHICS_SOFTWAREBACKEND_HPP
+#define DXNA_GRAPHICS_SOFTWAREBACKEND_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "../structs.hpp"
+#include "graphicsbackend.hpp"
+#include "commandlist.hpp"
+#include "states.hpp"
+
+namespace dxna::graphics {
+	//Color, depth and stencil planes in memory, tightly packed row by row.
+	//Colors use the packed layout of Color.
+	class Framebuffer {
+	public:
+		Framebuffer() = default;
+
+		Framebuffer(intcs width, intcs height) { Resize(width, height); }
+
+		void Resize(intcs width, intcs height);
+
+		intcs Width() const { return _width; }
+
+		intcs Height() const { return _height; }
+
+		uintcs* Colors() { return _colors.data(); }
+
+		uintcs const* Colors() const { return _colors.data(); }
+
+		float* Depth() { return _depth.data(); }
+
+		float const* Depth() const { return _depth.data(); }
+
+		bytecs* Stencil() { return _stencil.data(); }
+
+		bytecs const* Stencil() const { return _stencil.data(); }
+
+		Color GetPixel(intcs x, intcs y) const { return Color(_colors[static_cast<size_t>(y) * _width + x]); }
+
+	private:
+		intcs _width{ 0 };
+		intcs _height{ 0 };
+		std::vector<uintcs> _colors;
+		std::vector<float> _depth;
+		std::vector<bytecs> _stencil;
+	};
+
+	struct SoftwareStatistics {
+		ulongcs Frames{ 0 };
+		ulongcs Draws{ 0 };
+		ulongcs Triangles{ 0 };
+		//Triangles removed by culling, clipping or for covering no pixel center.
+		ulongcs CulledTriangles{ 0 };
+		//Pixels that passed the depth and stencil tests.
+		ulongcs Pixels{ 0 };
+	};
+
+	//Renders on the CPU into a Framebuffer, for platforms without a GPU backend,
+	//visual regression tests and performance tests.
+	//
+	//Triangles are set up and binned into screen tiles as they are drawn; at the end of every
+	//command list the tiles are rasterized in parallel, each tile by one thread in submission
+	//order, so the result does not depend on the number of threads. Coverage is tested four
+	//pixels at a time with SIMD edge functions.
+	//
+	//The vertex stage transforms positions by the matrix in vertex constant slot 0
+	//(the world-view-projection, identity if not set) and interpolates color and texture
+	//coordinates with perspective correction. Only triangle primitives are rasterized, and only
+	//with FillMode::Solid: a draw with a WireFrame rasterizer state returns GRAPHICS_UNSUPPORTED_STATE.
+	//The scissor test clips the triangles to the scissor rectangle.
+	class SoftwareBackend : public GraphicsBackend {
+	public:
+		static constexpr intcs TileSize = 64;
+		static constexpr intcs MaxTextureSlots = 16;
+
+		//threadCount 0 uses one thread per hardware thread.
+		SoftwareBackend(intcs width, intcs height, intcs threadCount = 0);
+
+		virtual ~SoftwareBackend() override;
+
+		SoftwareBackend(SoftwareBackend const&) = delete;
+		SoftwareBackend& operator=(SoftwareBackend const&) = delete;
+
+		virtual void BeginFrame() override;
+		virtual Error Execute(CommandList const& commandList) override;
+		virtual void EndFrame() override {}
+
+		graphics::Framebuffer& Framebuffer() { return _framebuffer; }
+
+		graphics::Framebuffer const& Framebuffer() const { return _framebuffer; }
+
+		//Resizes the framebuffer, its contents are undefined until the next clear.
+		void Resize(intcs width, intcs height);
+
+		SoftwareStatistics const& Statistics() const { return _statistics; }
+
+		void ResetStatistics() { _statistics = SoftwareStatistics(); }
+
+		intcs ThreadCount() const { return static_cast<intcs>(_workers.size()) + 1; }
+
+	private:
+		//Interpolated values, stored divided by w.
+		enum Attribute {
+			AttributeDepth,
+			AttributeInverseW,
+			AttributeRed,
+			AttributeGreen,
+			AttributeBlue,
+			AttributeAlpha,
+			AttributeU,
+			AttributeV,
+			AttributeCount
+		};
+
+		struct ClipVertex {
+			float Position[4];
+			float Color[4];
+			float TextureCoordinate[2];
+		};
+
+		//States in effect for a group of triangles.
+		struct DrawState {
+			BlendState const* Blend;
+			DepthStencilState const* DepthStencil;
+			RasterizerState const* Rasterizer;
+			//Texture of slot 0, sampled when the vertices have texture coordinates.
+			Texture2D const* Texture;
+			float BlendFactor[4];
+			graphics::Blend SourceBlend;
+			graphics::Blend DestinationBlend;
+			float DepthBias;
+			uintcs WriteMask;
+			bool Opaque;
+			//Blending with factors shared by every channel and an Add function.
+			bool UniformBlend;
+			bool DepthTest;
+			bool DepthWrite;
+			bool StencilTest;
+			//Opaque without depth and stencil tests, pixels are written directly.
+			bool Simple;
+		};
+
+		//A triangle ready to be rasterized, in screen space.
+		struct Triangle {
+			float EdgeA[3];
+			float EdgeB[3];
+			float EdgeC[3];
+			float Planes[AttributeCount][3];
+			intcs MinX;
+			intcs MinY;
+			intcs MaxX;
+			intcs MaxY;
+			uintcs State;
+			bytecs TopLeft;
+			bool FrontFace;
+		};
+
+		Error execute(CommandList const& commandList, Command const& command);
+		Error draw(PrimitiveType primitiveType, intcs primitiveCount, intcs baseVertex, ushortcs const* indices);
+		DrawState createState() const;
+		ClipVertex fetch(intcs index) const;
+		void clipAndSetup(ClipVertex const* vertices);
+		void setup(ClipVertex const& v0, ClipVertex const& v1, ClipVertex const& v2);
+		void clear(ClearCommand const& clear);
+
+		void flush();
+		void runTiles();
+		ulongcs rasterizeTile(intcs tile);
+		bool shade(Triangle const& triangle, DrawState const& state, size_t pixel, float depth, uintcs packed, float const* source);
+		void workerLoop();
+
+		graphics::Framebuffer _framebuffer;
+		SoftwareStatistics _statistics;
+
+		BlendState _defaultBlendState{ BlendState::Opaque() };
+		DepthStencilState _defaultDepthStencilState{ DepthStencilState::Default() };
+		RasterizerState _defaultRasterizerState{ RasterizerState::CullCounterClockwise() };
+
+		BlendState const* _blendState = nullptr;
+		DepthStencilState const* _depthStencilState = nullptr;
+		RasterizerState const* _rasterizerState = nullptr;
+		Texture2D const* _textures[MaxTextureSlots]{};
+		VertexDataCommand _vertexData{};
+		IndexDataCommand _indexData{};
+		Viewport _viewport;
+		bool _hasViewport{ false };
+		Rectangle _scissorRectangle;
+		bool _hasScissorRectangle{ false };
+		Matrix _transform{ Matrix::Identity() };
+		bool _stateChanged{ true };
+
+		std::vector<DrawState> _states;
+		std::vector<Triangle> _triangles;
+		std::vector<std::vector<uintcs>> _bins;
+		std::vector<intcs> _activeTiles;
+		intcs _tilesX{ 0 };
+		intcs _tilesY{ 0 };
+
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		ulongcs _generation{ 0 };
+		size_t _busy{ 0 };
+		bool _stop{ false };
+		std::atomic<size_t> _nextTile{ 0 };
+		std::atomic<ulongcs> _pixels{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
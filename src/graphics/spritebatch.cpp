@@ -0,0 +1,451 @@
+#include "spritebatch.hpp"
+#include "graphicsdevice.hpp"
+#include "states.hpp"
+#include "../simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+using dxna::simd::Float4;
+
+namespace dxna::graphics {
+	//Orders positive depths by their bits, which grow with the value.
+	static uintcs depthKey(float depth) {
+		return depth > 0.0F ? std::bit_cast<uintcs>(depth) : 0;
+	}
+
+	void SpriteBatch::SpriteList::Grow() {
+		const auto capacity = Textures.empty() ? 1024 : Textures.size() * 2;
+
+		Textures.resize(capacity);
+		X.resize(capacity);
+		Y.resize(capacity);
+		Width.resize(capacity);
+		Height.resize(capacity);
+		OriginX.resize(capacity);
+		OriginY.resize(capacity);
+		Sin.resize(capacity);
+		Cos.resize(capacity);
+		U0.resize(capacity);
+		V0.resize(capacity);
+		U1.resize(capacity);
+		V1.resize(capacity);
+		Depth.resize(capacity);
+		Colors.resize(capacity);
+	}
+
+	SpriteBatch::SpriteBatch(GraphicsDevicePtr const& device, intcs ringCapacity) : GraphicsResource(ResourceType::SpriteBatch) {
+		Device(device);
+
+		_ringCapacity = ringCapacity > 0 ? ringCapacity : DefaultRingCapacity;
+		_vertices.resize(static_cast<size_t>(_ringCapacity) * 4);
+
+		//The quads of a batch share one index buffer, the ring position is passed as base vertex.
+		_indices.resize(static_cast<size_t>(MaxBatchSize) * 6);
+
+		for (size_t i = 0, vertex = 0; i < _indices.size(); i += 6, vertex += 4) {
+			_indices[i] = static_cast<ushortcs>(vertex);
+			_indices[i + 1] = static_cast<ushortcs>(vertex + 1);
+			_indices[i + 2] = static_cast<ushortcs>(vertex + 2);
+			_indices[i + 3] = static_cast<ushortcs>(vertex + 1);
+			_indices[i + 4] = static_cast<ushortcs>(vertex + 3);
+			_indices[i + 5] = static_cast<ushortcs>(vertex + 2);
+		}
+
+		_defaultBlendState = New<BlendState>(BlendState::AlphaBlend());
+		_defaultDepthStencilState = New<DepthStencilState>(DepthStencilState::None());
+		_defaultRasterizerState = New<RasterizerState>(RasterizerState::CullCounterClockwise());
+
+		reportSize();
+	}
+
+	//The rings, the retired ones included, and the indices.
+	void SpriteBatch::reportSize() {
+		auto bytes = _vertices.capacity() * sizeof(VertexPositionColorTexture) + _indices.capacity() * sizeof(ushortcs);
+
+		for (const auto& ring : _retiredRings)
+			bytes += ring.Vertices.capacity() * sizeof(VertexPositionColorTexture);
+
+		ReportSize(bytes);
+	}
+
+	Error SpriteBatch::Begin(SpriteSortMode sortMode, BlendStatePtr const& blendState, DepthStencilStatePtr const& depthStencilState,
+		RasterizerStatePtr const& rasterizerState, Matrix const& transformMatrix) {
+		if (_beginCalled)
+			return Error(ErrorCode::GRAPHICS_BEGIN_ALREADY_CALLED);
+
+		if (Device() == nullptr)
+			return Error(ErrorCode::ARGUMENT_IS_NULL);
+
+		_sortMode = sortMode;
+		_blendState = blendState != nullptr ? blendState : _defaultBlendState;
+		_depthStencilState = depthStencilState != nullptr ? depthStencilState : _defaultDepthStencilState;
+		_rasterizerState = rasterizerState != nullptr ? rasterizerState : _defaultRasterizerState;
+		_transformMatrix = transformMatrix;
+		_error = NoError;
+		_beginCalled = true;
+
+		return NoError;
+	}
+
+	Error SpriteBatch::End() {
+		if (!_beginCalled)
+			return Error(ErrorCode::GRAPHICS_BEGIN_NOT_CALLED);
+
+		const auto error = flush();
+
+		if (error.HasError() && !_error.HasError())
+			_error = error;
+
+		_beginCalled = false;
+
+		//Ids only need to be consistent within one sort, drop textures that may be gone.
+		if (_textureIds.Count() > 4096)
+			_textureIds.Clear();
+
+		return _error;
+	}
+
+	void SpriteBatch::Draw(Texture2DPtr const& texture, Vector2 const& position, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color,
+		float rotation, Vector2 const& origin, Vector2 const& scale, SpriteEffects effects, float layerDepth) {
+		if (texture == nullptr)
+			return;
+
+		const auto source = sourceRectangle.HasValue() ? sourceRectangle.Value() : texture->Bounds();
+
+		push(texture.get(), position.X, position.Y, source.Width * scale.X, source.Height * scale.Y, sourceRectangle,
+			color, rotation, origin.X * scale.X, origin.Y * scale.Y, effects, layerDepth);
+	}
+
+	void SpriteBatch::Draw(Texture2DPtr const& texture, Rectangle const& destinationRectangle, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color,
+		float rotation, Vector2 const& origin, SpriteEffects effects, float layerDepth) {
+		if (texture == nullptr)
+			return;
+
+		const auto source = sourceRectangle.HasValue() ? sourceRectangle.Value() : texture->Bounds();
+
+		//The origin is given in texels, scale it to the destination.
+		const auto originX = source.Width != 0 ? origin.X * destinationRectangle.Width / source.Width : 0.0F;
+		const auto originY = source.Height != 0 ? origin.Y * destinationRectangle.Height / source.Height : 0.0F;
+
+		push(texture.get(), static_cast<float>(destinationRectangle.X), static_cast<float>(destinationRectangle.Y),
+			static_cast<float>(destinationRectangle.Width), static_cast<float>(destinationRectangle.Height), sourceRectangle,
+			color, rotation, originX, originY, effects, layerDepth);
+	}
+
+	void SpriteBatch::push(Texture2D const* texture, float x, float y, float width, float height, cs::Nullable<Rectangle> const& sourceRectangle,
+		Color const& color, float rotation, float originX, float originY, SpriteEffects effects, float depth) {
+		if (!_beginCalled)
+			return;
+
+		auto u0 = 0.0F;
+		auto v0 = 0.0F;
+		auto u1 = 1.0F;
+		auto v1 = 1.0F;
+
+		if (sourceRectangle.HasValue() && texture->Width() > 0 && texture->Height() > 0) {
+			const auto source = sourceRectangle.Value();
+			const auto texelWidth = 1.0F / texture->Width();
+			const auto texelHeight = 1.0F / texture->Height();
+
+			u0 = source.X * texelWidth;
+			v0 = source.Y * texelHeight;
+			u1 = (source.X + source.Width) * texelWidth;
+			v1 = (source.Y + source.Height) * texelHeight;
+		}
+
+		if ((static_cast<intcs>(effects) & static_cast<intcs>(SpriteEffects::FlipHorizontally)) != 0)
+			std::swap(u0, u1);
+
+		if ((static_cast<intcs>(effects) & static_cast<intcs>(SpriteEffects::FlipVertically)) != 0)
+			std::swap(v0, v1);
+
+		auto& sprites = _sprites;
+
+		if (sprites.Count == sprites.Textures.size())
+			sprites.Grow();
+
+		const auto i = sprites.Count++;
+
+		sprites.Textures[i] = texture;
+		sprites.X[i] = x;
+		sprites.Y[i] = y;
+		sprites.Width[i] = width;
+		sprites.Height[i] = height;
+		sprites.OriginX[i] = originX;
+		sprites.OriginY[i] = originY;
+		sprites.Sin[i] = rotation == 0.0F ? 0.0F : std::sin(rotation);
+		sprites.Cos[i] = rotation == 0.0F ? 1.0F : std::cos(rotation);
+		sprites.U0[i] = u0;
+		sprites.V0[i] = v0;
+		sprites.U1[i] = u1;
+		sprites.V1[i] = v1;
+		sprites.Depth[i] = depth;
+		sprites.Colors[i] = color.PackedValue();
+
+		if (_sortMode == SpriteSortMode::Immediate) {
+			const auto error = flush();
+
+			if (error.HasError() && !_error.HasError())
+				_error = error;
+		}
+	}
+
+	uintcs const* SpriteBatch::sort() {
+		const auto count = _sprites.Count;
+
+		if (_sortMode != SpriteSortMode::Texture
+			&& _sortMode != SpriteSortMode::BackToFront
+			&& _sortMode != SpriteSortMode::FrontToBack)
+			return nullptr;
+
+		_entries.resize(count);
+		_scratch.resize(count);
+		_order.resize(count);
+
+		for (size_t i = 0; i < count; ++i) {
+			uintcs key = 0;
+
+			switch (_sortMode)
+			{
+			case SpriteSortMode::Texture:
+				key = _textureIds.Get(_sprites.Textures[i]);
+				break;
+			case SpriteSortMode::BackToFront:
+				key = ~depthKey(_sprites.Depth[i]);
+				break;
+			default:
+				key = depthKey(_sprites.Depth[i]);
+				break;
+			}
+
+			_entries[i] = { key, static_cast<uintcs>(i) };
+		}
+
+		//The sort is stable, so sprites with the same key keep their drawing order.
+		const auto sorted = RadixSort(_entries.data(), _scratch.data(), count);
+
+		for (size_t i = 0; i < count; ++i)
+			_order[i] = sorted[i].Index;
+
+		return _order.data();
+	}
+
+	void SpriteBatch::setup() {
+		const auto device = Device();
+		const auto viewport = device->Viewport();
+
+		auto projection = Matrix::CreateOrthographicOffCenter(0, static_cast<float>(viewport.Width),
+			static_cast<float>(viewport.Height), 0, 0, -1);
+
+		if (device->UseHalfPixelOffset) {
+			projection.M41 += -0.5F * projection.M11;
+			projection.M42 += -0.5F * projection.M22;
+		}
+
+		const auto matrix = Matrix::Multiply(_transformMatrix, projection);
+
+		_commandList.Reset();
+		_commandList.SetViewport(viewport);
+		_commandList.SetBlendState(_blendState.get());
+		_commandList.SetDepthStencilState(_depthStencilState.get());
+		_commandList.SetRasterizerState(_rasterizerState.get());
+		_commandList.SetConstantData(ShaderStage::Vertex, 0, reinterpret_cast<bytecs const*>(&matrix), sizeof(matrix));
+		_commandList.SetIndexData(_indices.data(), static_cast<intcs>(_indices.size()));
+		_commandList.SetVertexData(_vertices.data(), static_cast<intcs>(_vertices.size()));
+	}
+
+	void SpriteBatch::generate(uintcs const* order, size_t begin, size_t end, VertexPositionColorTexture* vertices) const {
+		const auto& sprites = _sprites;
+		auto i = begin;
+
+		for (; i + 4 <= end; i += 4, vertices += 16) {
+			size_t index[4] = { i, i + 1, i + 2, i + 3 };
+
+			if (order != nullptr) {
+				for (size_t k = 0; k < 4; ++k)
+					index[k] = order[i + k];
+			}
+
+			const auto load = [&](std::vector<float> const& field) {
+				return order == nullptr
+					? Float4::Load(field.data() + i)
+					: Float4::Set(field[index[0]], field[index[1]], field[index[2]], field[index[3]]);
+			};
+
+			const auto x = load(sprites.X);
+			const auto y = load(sprites.Y);
+			const auto sin = load(sprites.Sin);
+			const auto cos = load(sprites.Cos);
+			const auto left = Float4::Set(0.0F) - load(sprites.OriginX);
+			const auto top = Float4::Set(0.0F) - load(sprites.OriginY);
+			const auto right = left + load(sprites.Width);
+			const auto bottom = top + load(sprites.Height);
+
+			const auto leftCos = left * cos;
+			const auto leftSin = left * sin;
+			const auto rightCos = right * cos;
+			const auto rightSin = right * sin;
+			const auto topCos = top * cos;
+			const auto topSin = top * sin;
+			const auto bottomCos = bottom * cos;
+			const auto bottomSin = bottom * sin;
+
+			//Corners in the order of the quad indices: top left, top right, bottom left, bottom right.
+			float corners[8][4];
+			(x + leftCos - topSin).Store(corners[0]);
+			(y + leftSin + topCos).Store(corners[1]);
+			(x + rightCos - topSin).Store(corners[2]);
+			(y + rightSin + topCos).Store(corners[3]);
+			(x + leftCos - bottomSin).Store(corners[4]);
+			(y + leftSin + bottomCos).Store(corners[5]);
+			(x + rightCos - bottomSin).Store(corners[6]);
+			(y + rightSin + bottomCos).Store(corners[7]);
+
+			for (size_t k = 0; k < 4; ++k) {
+				const auto s = index[k];
+				const auto color = dxna::Color(sprites.Colors[s]);
+				const auto depth = sprites.Depth[s];
+				auto vertex = vertices + k * 4;
+
+				vertex[0] = VertexPositionColorTexture(Vector3(corners[0][k], corners[1][k], depth), color, Vector2(sprites.U0[s], sprites.V0[s]));
+				vertex[1] = VertexPositionColorTexture(Vector3(corners[2][k], corners[3][k], depth), color, Vector2(sprites.U1[s], sprites.V0[s]));
+				vertex[2] = VertexPositionColorTexture(Vector3(corners[4][k], corners[5][k], depth), color, Vector2(sprites.U0[s], sprites.V1[s]));
+				vertex[3] = VertexPositionColorTexture(Vector3(corners[6][k], corners[7][k], depth), color, Vector2(sprites.U1[s], sprites.V1[s]));
+			}
+		}
+
+		for (; i < end; ++i, vertices += 4) {
+			const auto s = order != nullptr ? order[i] : i;
+			const auto x = sprites.X[s];
+			const auto y = sprites.Y[s];
+			const auto sin = sprites.Sin[s];
+			const auto cos = sprites.Cos[s];
+			const auto left = 0.0F - sprites.OriginX[s];
+			const auto top = 0.0F - sprites.OriginY[s];
+			const auto right = left + sprites.Width[s];
+			const auto bottom = top + sprites.Height[s];
+			const auto color = dxna::Color(sprites.Colors[s]);
+			const auto depth = sprites.Depth[s];
+
+			vertices[0] = VertexPositionColorTexture(Vector3(x + left * cos - top * sin, y + left * sin + top * cos, depth), color, Vector2(sprites.U0[s], sprites.V0[s]));
+			vertices[1] = VertexPositionColorTexture(Vector3(x + right * cos - top * sin, y + right * sin + top * cos, depth), color, Vector2(sprites.U1[s], sprites.V0[s]));
+			vertices[2] = VertexPositionColorTexture(Vector3(x + left * cos - bottom * sin, y + left * sin + bottom * cos, depth), color, Vector2(sprites.U0[s], sprites.V1[s]));
+			vertices[3] = VertexPositionColorTexture(Vector3(x + right * cos - bottom * sin, y + right * sin + bottom * cos, depth), color, Vector2(sprites.U1[s], sprites.V1[s]));
+		}
+	}
+
+	size_t SpriteBatch::reserve(size_t sprites) {
+		const auto frame = Device()->Frame();
+		const auto retired = [&](ulongcs written) { return written + _framesInFlight <= frame; };
+
+		while (!_ringFrames.empty() && retired(_ringFrames.front().Frame))
+			_ringFrames.pop_front();
+
+		const auto retiredRings = std::erase_if(_retiredRings, [&](RetiredRing const& ring) { return retired(ring.Frame); });
+
+		const auto capacity = static_cast<size_t>(_ringCapacity);
+		auto position = _ringPosition;
+
+		if (_ringFrames.empty()) {
+			position = 0;
+		}
+		else {
+			//The frames in flight hold the ring from the start of the oldest one to the position.
+			const auto tail = _ringFrames.front().Start;
+			auto fits = false;
+
+			if (tail < position) {
+				//Free from the position to the end of the ring, then from its start to the tail.
+				if (position + sprites > capacity)
+					position = 0;
+
+				fits = position != 0 || sprites <= tail;
+			}
+			else {
+				//Free from the position to the tail, and full when they meet.
+				fits = position < tail && position + sprites <= tail;
+			}
+
+			//Every free region is too small: move to a larger ring and keep the old one for the frames that read it.
+			if (!fits) {
+				_retiredRings.push_back(RetiredRing{ std::move(_vertices), _ringFrames.back().Frame });
+				_ringCapacity = static_cast<intcs>(std::max(capacity * 2, capacity + sprites));
+				_vertices = std::vector<VertexPositionColorTexture>(static_cast<size_t>(_ringCapacity) * 4);
+				_ringFrames.clear();
+				position = 0;
+			}
+		}
+
+		if (_ringFrames.empty() || _ringFrames.back().Frame != frame)
+			_ringFrames.push_back(RingFrame{ frame, position });
+
+		if (retiredRings > 0 || static_cast<size_t>(_ringCapacity) != capacity)
+			reportSize();
+
+		_ringPosition = position + sprites;
+		return position;
+	}
+
+	Error SpriteBatch::flush() {
+		const auto count = _sprites.Count;
+
+		if (count == 0)
+			return NoError;
+
+		const auto order = sort();
+		const auto textureAt = [&](size_t i) { return _sprites.Textures[order != nullptr ? order[i] : i]; };
+
+		auto result = NoError;
+		size_t start = 0;
+
+		//Each pass writes one free region of the ring and is submitted as one command list.
+		while (start < count) {
+			const auto passSprites = std::min(count - start, static_cast<size_t>(_ringCapacity));
+			const auto passStart = reserve(passSprites);
+			const auto passEnd = passStart + passSprites;
+			auto position = passStart;
+			Texture2D const* texture = nullptr;
+
+			setup();
+
+			while (start < count && position < passEnd) {
+				const auto limit = std::min({ count, start + MaxBatchSize, start + (passEnd - position) });
+				const auto batchTexture = textureAt(start);
+				auto end = start + 1;
+
+				while (end < limit && textureAt(end) == batchTexture)
+					++end;
+
+				generate(order, start, end, _vertices.data() + position * 4);
+
+				if (batchTexture != texture || position == passStart) {
+					texture = batchTexture;
+					_commandList.SetTexture(0, texture);
+				}
+
+				const auto sprites = static_cast<intcs>(end - start);
+
+				_commandList.DrawIndexed(PrimitiveType::TriangleList, static_cast<intcs>(position * 4), 0, sprites * 2);
+
+				++_statistics.Batches;
+				_statistics.MaxSpritesPerBatch = std::max(_statistics.MaxSpritesPerBatch, sprites);
+
+				position += end - start;
+				start = end;
+			}
+
+			const auto error = Device()->Submit(_commandList);
+			++_statistics.Submissions;
+
+			if (error.HasError() && !result.HasError())
+				result = error;
+		}
+
+		_statistics.Sprites += count;
+		_sprites.Count = 0;
+
+		return result;
+	}
+}
\ No newline at end of file
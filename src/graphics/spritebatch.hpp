@@ -0,0 +1,178 @@
+#ifndef DXNA_GRAPHICS_SPRITEBATCH_HPP
+#define DXNA_GRAPHICS_SPRITEBATCH_HPP
+
+#include <deque>
+#include <vector>
+#include "../structs.hpp"
+#include "../error.hpp"
+#include "../radixsort.hpp"
+#include "../cs/nullable.hpp"
+#include "graphicsresource.hpp"
+#include "commandlist.hpp"
+#include "stateidtable.hpp"
+#include "vertextypes.hpp"
+#include "texture.hpp"
+
+namespace dxna::graphics {
+	//Counters accumulated since the last ResetStatistics.
+	//Reset once per frame to read per-frame values.
+	struct SpriteBatchStatistics {
+		ulongcs Sprites{ 0 };
+		ulongcs Batches{ 0 };
+		//Command lists submitted to the device, one per pass over the vertex ring.
+		ulongcs Submissions{ 0 };
+		intcs MaxSpritesPerBatch{ 0 };
+
+		double SpritesPerBatch() const {
+			return Batches == 0 ? 0.0 : static_cast<double>(Sprites) / static_cast<double>(Batches);
+		}
+	};
+
+	//Draws groups of sprites with the same settings.
+	//
+	//Sprites are kept in SoA form until End, then expanded four at a time with SIMD into
+	//a preallocated ring of vertices and drawn through a static quad index buffer.
+	//Sprites are not instanced: every sprite is four vertices of the ring, and a batch is one indexed draw.
+	//A batch is split when the texture changes, when it reaches MaxBatchSize or when the ring wraps.
+	//Textures and states are referenced by raw pointer and must stay alive until End.
+	//
+	//The submitted commands point into the ring, so the region a frame wrote is only reused once
+	//FramesInFlight more frames have been started with GraphicsDevice::BeginFrame; a frame that would
+	//overwrite it moves to a larger ring instead. Call BeginFrame every frame, or the ring keeps growing.
+	class SpriteBatch : public GraphicsResource {
+	public:
+		//Sprites per draw, limited by the 16-bit indices.
+		static constexpr intcs MaxBatchSize = 16384;
+		static constexpr intcs DefaultRingCapacity = 65536;
+		//The frames a submitted command list can wait to be executed, plus the one being recorded.
+		static constexpr ulongcs DefaultFramesInFlight = 3;
+
+		//ringCapacity is the number of sprites the vertex ring holds.
+		SpriteBatch(GraphicsDevicePtr const& device, intcs ringCapacity = DefaultRingCapacity);
+
+		//Null states select AlphaBlend, DepthStencilState::None and CullCounterClockwise.
+		Error Begin(SpriteSortMode sortMode = SpriteSortMode::Deferred,
+			BlendStatePtr const& blendState = nullptr,
+			DepthStencilStatePtr const& depthStencilState = nullptr,
+			RasterizerStatePtr const& rasterizerState = nullptr,
+			Matrix const& transformMatrix = Matrix::Identity());
+
+		//Sorts and submits the sprites drawn since Begin.
+		Error End();
+
+		//Draws are ignored outside Begin and End.
+		void Draw(Texture2DPtr const& texture, Vector2 const& position, Color const& color) {
+			Draw(texture, position, cs::Nullable<Rectangle>(), color, 0.0F, Vector2(), Vector2(1.0F), SpriteEffects::None, 0.0F);
+		}
+
+		void Draw(Texture2DPtr const& texture, Vector2 const& position, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color) {
+			Draw(texture, position, sourceRectangle, color, 0.0F, Vector2(), Vector2(1.0F), SpriteEffects::None, 0.0F);
+		}
+
+		void Draw(Texture2DPtr const& texture, Vector2 const& position, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color,
+			float rotation, Vector2 const& origin, float scale, SpriteEffects effects, float layerDepth) {
+			Draw(texture, position, sourceRectangle, color, rotation, origin, Vector2(scale), effects, layerDepth);
+		}
+
+		void Draw(Texture2DPtr const& texture, Vector2 const& position, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color,
+			float rotation, Vector2 const& origin, Vector2 const& scale, SpriteEffects effects, float layerDepth);
+
+		void Draw(Texture2DPtr const& texture, Rectangle const& destinationRectangle, Color const& color) {
+			Draw(texture, destinationRectangle, cs::Nullable<Rectangle>(), color, 0.0F, Vector2(), SpriteEffects::None, 0.0F);
+		}
+
+		void Draw(Texture2DPtr const& texture, Rectangle const& destinationRectangle, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color) {
+			Draw(texture, destinationRectangle, sourceRectangle, color, 0.0F, Vector2(), SpriteEffects::None, 0.0F);
+		}
+
+		void Draw(Texture2DPtr const& texture, Rectangle const& destinationRectangle, cs::Nullable<Rectangle> const& sourceRectangle, Color const& color,
+			float rotation, Vector2 const& origin, SpriteEffects effects, float layerDepth);
+
+		SpriteBatchStatistics const& Statistics() const { return _statistics; }
+
+		void ResetStatistics() { _statistics = SpriteBatchStatistics(); }
+
+		//The sprites the current ring holds. It grows when the frames in flight need more.
+		intcs RingCapacity() const { return _ringCapacity; }
+
+		ulongcs FramesInFlight() const { return _framesInFlight; }
+
+		//1 when the command lists are executed as they are submitted.
+		void FramesInFlight(ulongcs value) { _framesInFlight = std::max<ulongcs>(value, 1); }
+
+	private:
+		//Sprite fields in SoA form, so the quads can be generated four sprites at a time.
+		struct SpriteList {
+			std::vector<Texture2D const*> Textures;
+			std::vector<float> X;
+			std::vector<float> Y;
+			std::vector<float> Width;
+			std::vector<float> Height;
+			std::vector<float> OriginX;
+			std::vector<float> OriginY;
+			std::vector<float> Sin;
+			std::vector<float> Cos;
+			std::vector<float> U0;
+			std::vector<float> V0;
+			std::vector<float> U1;
+			std::vector<float> V1;
+			std::vector<float> Depth;
+			std::vector<uintcs> Colors;
+			size_t Count{ 0 };
+
+			void Grow();
+		};
+
+		//Where a frame started writing the ring.
+		struct RingFrame {
+			ulongcs Frame;
+			size_t Start;
+		};
+
+		//A ring replaced by a larger one, kept until the last frame that wrote it retires.
+		struct RetiredRing {
+			std::vector<VertexPositionColorTexture> Vertices;
+			ulongcs Frame;
+		};
+
+		void push(Texture2D const* texture, float x, float y, float width, float height, cs::Nullable<Rectangle> const& sourceRectangle,
+			Color const& color, float rotation, float originX, float originY, SpriteEffects effects, float depth);
+
+		uintcs const* sort();
+		void setup();
+		void generate(uintcs const* order, size_t begin, size_t end, VertexPositionColorTexture* vertices) const;
+		size_t reserve(size_t sprites);
+		void reportSize();
+		Error flush();
+
+		SpriteList _sprites;
+		std::vector<VertexPositionColorTexture> _vertices;
+		std::vector<ushortcs> _indices;
+		std::vector<RadixEntry<uintcs>> _entries;
+		std::vector<RadixEntry<uintcs>> _scratch;
+		std::vector<uintcs> _order;
+		StateIdTable _textureIds;
+		CommandList _commandList;
+		intcs _ringCapacity{ 0 };
+		size_t _ringPosition{ 0 };
+		std::deque<RingFrame> _ringFrames;
+		std::vector<RetiredRing> _retiredRings;
+		ulongcs _framesInFlight{ DefaultFramesInFlight };
+
+		bool _beginCalled{ false };
+		SpriteSortMode _sortMode{ SpriteSortMode::Deferred };
+		BlendStatePtr _blendState;
+		DepthStencilStatePtr _depthStencilState;
+		RasterizerStatePtr _rasterizerState;
+		Matrix _transformMatrix;
+		Error _error;
+
+		BlendStatePtr _defaultBlendState;
+		DepthStencilStatePtr _defaultDepthStencilState;
+		RasterizerStatePtr _defaultRasterizerState;
+
+		SpriteBatchStatistics _statistics;
+	};
+}
+
+#endif
\ No newline at end of file
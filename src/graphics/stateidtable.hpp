@@ -0,0 +1,88 @@
+#ifndef DXNA_GRAPHICS_STATEIDTABLE_HPP
+#define DXNA_GRAPHICS_STATEIDTABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include "../cs/cstypes.hpp"
+
+namespace dxna::graphics {
+	//Maps state pointers to small sequential ids, 0 is reserved for nullptr.
+	//Ids are stable for the lifetime of the table. Lookups use open addressing,
+	//since they run once per field of every queued draw.
+	class StateIdTable {
+	public:
+		uintcs Get(void const* state) {
+			if (state == nullptr)
+				return 0;
+
+			if (state == _lastState)
+				return _lastId;
+
+			if ((_count + 1) * 2 > _slots.size())
+				grow();
+
+			const auto mask = _slots.size() - 1;
+			auto index = hash(state) & mask;
+
+			while (_slots[index].State != state) {
+				if (_slots[index].State == nullptr) {
+					_slots[index] = { state, static_cast<uintcs>(++_count) };
+					break;
+				}
+
+				index = (index + 1) & mask;
+			}
+
+			_lastState = state;
+			_lastId = _slots[index].Id;
+
+			return _lastId;
+		}
+
+		size_t Count() const { return _count; }
+
+		void Clear() {
+			_slots.clear();
+			_count = 0;
+			_lastState = nullptr;
+			_lastId = 0;
+		}
+
+	private:
+		struct Slot {
+			void const* State = nullptr;
+			uintcs Id{ 0 };
+		};
+
+		static size_t hash(void const* state) {
+			const auto value = static_cast<ulongcs>(reinterpret_cast<uintptr_t>(state));
+			return static_cast<size_t>((value * 0x9E3779B97F4A7C15ULL) >> 32);
+		}
+
+		void grow() {
+			auto slots = std::vector<Slot>(_slots.empty() ? 64 : _slots.size() * 2);
+			const auto mask = slots.size() - 1;
+
+			for (const auto& slot : _slots) {
+				if (slot.State == nullptr)
+					continue;
+
+				auto index = hash(slot.State) & mask;
+
+				while (slots[index].State != nullptr)
+					index = (index + 1) & mask;
+
+				slots[index] = slot;
+			}
+
+			_slots.swap(slots);
+		}
+
+		std::vector<Slot> _slots;
+		size_t _count{ 0 };
+		void const* _lastState = nullptr;
+		uintcs _lastId{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
@@ -7,10 +7,10 @@
 
 namespace dxna::graphics {
 	struct SamplerState : public GraphicsResource {
-		constexpr SamplerState() = default;
+		SamplerState() : GraphicsResource(ResourceType::SamplerState) {}
 
-		constexpr SamplerState(std::string const& name, TextureFilter const& filter, TextureAddressMode const& addressMode) {
-			Name = name;
+		SamplerState(std::string const& name, TextureFilter const& filter, TextureAddressMode const& addressMode) : GraphicsResource(ResourceType::SamplerState) {
+			Name(name);
 			Filter = filter;
 			AddressU = addressMode;
 			AddressV = addressMode;
@@ -85,10 +85,10 @@ namespace dxna::graphics {
 	using TargetBlendState_ = dxna::graphics::TargetBlendState;
 
 	struct BlendState : public GraphicsResource {
-		constexpr BlendState() = default;
+		BlendState() : GraphicsResource(ResourceType::BlendState) {}
 
-		BlendState(std::string const& name, Blend const& source, Blend const& destination) {
-			Name = name;
+		BlendState(std::string const& name, Blend const& source, Blend const& destination) : GraphicsResource(ResourceType::BlendState) {
+			Name(name);
 			ColorSourceBlend(source);
 			AlphaSourceBlend(source);
 			ColorDestinationBlend(destination);
@@ -166,10 +166,10 @@ namespace dxna::graphics {
 
 	struct DepthStencilState : public GraphicsResource {
 
-		constexpr DepthStencilState() = default;
+		DepthStencilState() : GraphicsResource(ResourceType::DepthStencilState) {}
 
-		constexpr DepthStencilState(std::string const& name, bool depthBufferEnable, bool depthBufferWriteEnable) {
-			Name = name;
+		DepthStencilState(std::string const& name, bool depthBufferEnable, bool depthBufferWriteEnable) : GraphicsResource(ResourceType::DepthStencilState) {
+			Name(name);
 			DepthBufferEnable = depthBufferEnable;
 			DepthBufferWriteEnable = depthBufferWriteEnable;
 		}
@@ -211,10 +211,10 @@ namespace dxna::graphics {
 	using FillMode_ = dxna::graphics::FillMode;
 
 	struct RasterizerState : public GraphicsResource {
-		constexpr RasterizerState() = default;
+		RasterizerState() : GraphicsResource(ResourceType::RasterizerState) {}
 
-		constexpr RasterizerState(std::string const& name, CullMode const& cullMode) {
-			Name = name;
+		RasterizerState(std::string const& name, CullMode const& cullMode) : GraphicsResource(ResourceType::RasterizerState) {
+			Name(name);
 			CullMode = cullMode;
 		}
 
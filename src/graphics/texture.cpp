@@ -0,0 +1,408 @@
+#include "texture.hpp"
+#include <cmath>
+#include <cstring>
+#include <memory_resource>
+#include "../jobsystem.hpp"
+#include "../memoryarena.hpp"
+
+namespace dxna::graphics {
+	//--------------------------------------------------------------------------------//
+	//								Mipmap filters									  //
+	//--------------------------------------------------------------------------------//
+
+	//Source texels that make one destination texel along an axis, and where their weights are.
+	struct FilterTap {
+		intcs Start{ 0 };
+		size_t Offset{ 0 };
+		size_t Count{ 0 };
+	};
+
+	//The taps of every destination texel along an axis, with their weights in one array.
+	struct Filter {
+		Filter(std::pmr::memory_resource* resource) : Taps(resource), Weights(resource) {}
+
+		std::pmr::vector<FilterTap> Taps;
+		std::pmr::vector<float> Weights;
+	};
+
+	//Modified Bessel function of the first kind, order zero.
+	static double besselI0(double x) {
+		double sum = 1.0;
+		double term = 1.0;
+
+		for (intcs k = 1; k < 32; ++k) {
+			term *= (x / (2.0 * k)) * (x / (2.0 * k));
+			sum += term;
+
+			if (term < sum * 1e-12)
+				break;
+		}
+
+		return sum;
+	}
+
+	//Box weights are the overlap of each source texel with the destination texel.
+	//Kaiser weights are a sinc windowed by a Kaiser window, three destination texels wide.
+	static Filter createTaps(intcs sourceSize, intcs destinationSize, MipmapFilter filter, std::pmr::memory_resource* resource) {
+		constexpr double Radius = 3.0;
+		constexpr double Beta = 4.0;
+		constexpr double Pi = 3.14159265358979323846;
+
+		const auto scale = static_cast<double>(sourceSize) / destinationSize;
+		Filter taps(resource);
+		taps.Taps.resize(destinationSize);
+		//Enough for the widest filter, so the weights never move to a larger block of the arena.
+		taps.Weights.reserve(static_cast<size_t>(destinationSize) * (static_cast<size_t>(2 * Radius * scale) + 2));
+
+		for (intcs i = 0; i < destinationSize; ++i) {
+			auto& tap = taps.Taps[i];
+			tap.Offset = taps.Weights.size();
+
+			if (filter == MipmapFilter::Box) {
+				const auto begin = i * scale;
+				const auto end = (i + 1) * scale;
+
+				tap.Start = static_cast<intcs>(std::floor(begin));
+				const auto last = std::min(static_cast<intcs>(std::ceil(end)), sourceSize);
+
+				for (auto x = tap.Start; x < last; ++x) {
+					const auto overlap = std::min<double>(x + 1, end) - std::max<double>(x, begin);
+					taps.Weights.push_back(static_cast<float>(overlap / scale));
+				}
+
+				tap.Count = taps.Weights.size() - tap.Offset;
+				continue;
+			}
+
+			const auto center = (i + 0.5) * scale - 0.5;
+			const auto support = Radius * scale;
+			const auto last = static_cast<intcs>(std::floor(center + support));
+			double total = 0;
+
+			tap.Start = static_cast<intcs>(std::ceil(center - support));
+
+			for (auto x = tap.Start; x <= last; ++x) {
+				const auto distance = (x - center) / scale;
+				const auto window = distance / Radius;
+				const auto sinc = distance == 0.0 ? 1.0 : std::sin(Pi * distance) / (Pi * distance);
+				const auto kaiser = besselI0(Beta * std::sqrt(std::max(0.0, 1.0 - window * window))) / besselI0(Beta);
+				const auto weight = sinc * kaiser;
+
+				taps.Weights.push_back(static_cast<float>(weight));
+				total += weight;
+			}
+
+			tap.Count = taps.Weights.size() - tap.Offset;
+
+			for (auto k = tap.Offset; k < taps.Weights.size(); ++k)
+				taps.Weights[k] = static_cast<float>(taps.Weights[k] / total);
+		}
+
+		return taps;
+	}
+
+	//Resamples four-channel float texels with separable filters, clamping at the edges.
+	//The result and the temporaries are allocated from the resource.
+	static std::pmr::vector<float> resample(float const* source, intcs sourceWidth, intcs sourceHeight,
+		intcs width, intcs height, MipmapFilter filter, std::pmr::memory_resource* resource) {
+		const auto columns = createTaps(sourceWidth, width, filter, resource);
+		const auto rows = createTaps(sourceHeight, height, filter, resource);
+
+		std::pmr::vector<float> horizontal(static_cast<size_t>(width) * sourceHeight * 4, resource);
+		std::pmr::vector<float> result(static_cast<size_t>(width) * height * 4, resource);
+
+		for (intcs y = 0; y < sourceHeight; ++y) {
+			const auto input = source + static_cast<size_t>(y) * sourceWidth * 4;
+			auto output = horizontal.data() + static_cast<size_t>(y) * width * 4;
+
+			for (intcs x = 0; x < width; ++x, output += 4) {
+				const auto& tap = columns.Taps[x];
+				const auto weights = columns.Weights.data() + tap.Offset;
+				float sum[4] = {};
+
+				for (size_t k = 0; k < tap.Count; ++k) {
+					const auto column = std::clamp(tap.Start + static_cast<intcs>(k), 0, sourceWidth - 1);
+					const auto texel = input + static_cast<size_t>(column) * 4;
+
+					for (intcs channel = 0; channel < 4; ++channel)
+						sum[channel] += texel[channel] * weights[k];
+				}
+
+				std::memcpy(output, sum, sizeof(sum));
+			}
+		}
+
+		const auto rowSize = static_cast<size_t>(width) * 4;
+
+		for (intcs y = 0; y < height; ++y) {
+			const auto& tap = rows.Taps[y];
+			const auto weights = rows.Weights.data() + tap.Offset;
+			auto output = result.data() + y * rowSize;
+
+			for (size_t k = 0; k < tap.Count; ++k) {
+				const auto row = std::clamp(tap.Start + static_cast<intcs>(k), 0, sourceHeight - 1);
+				const auto input = horizontal.data() + row * rowSize;
+				const auto weight = weights[k];
+
+				for (size_t i = 0; i < rowSize; ++i)
+					output[i] += input[i] * weight;
+			}
+		}
+
+		return result;
+	}
+
+	//--------------------------------------------------------------------------------//
+	//								Texture2D										  //
+	//--------------------------------------------------------------------------------//
+
+	Texture2D::Texture2D(GraphicsDevicePtr const& device, intcs width, intcs height, bool mipMap, SurfaceFormat format) :
+		_width(std::max(width, 1)), _height(std::max(height, 1)) {
+		Device(device);
+
+		_format = format;
+		_levelCount = 1;
+
+		if (mipMap) {
+			for (auto size = std::max(_width, _height); size > 1; size >>= 1)
+				++_levelCount;
+		}
+
+		size_t offset = 0;
+
+		for (intcs level = 0; level < _levelCount; ++level) {
+			_levelOffsets.push_back(offset);
+			offset += (LevelSize(level) + 63) & ~static_cast<size_t>(63);
+		}
+
+		_data.resize(offset);
+		ReportSize(_data.size(), true);
+	}
+
+	size_t Texture2D::EvictContent() {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		const auto bytes = _data.size();
+		decltype(_data)().swap(_data);
+		return bytes;
+	}
+
+	//Allocates the texels of an evicted texture under its lock and returns their size, or 0 if they were kept.
+	//The caller reports the size once unlocked: the registry holds its own lock when it locks the texture to evict it.
+	size_t Texture2D::restore() {
+		if (!_data.empty())
+			return 0;
+
+		const auto last = _levelCount - 1;
+		_data.resize(_levelOffsets[last] + ((LevelSize(last) + 63) & ~static_cast<size_t>(63)));
+		Touch();
+		return _data.size();
+	}
+
+	Error Texture2D::region(intcs level, cs::Nullable<Rectangle> const& rect, size_t elementCount, Rectangle& result) const {
+		if (level < 0 || level >= _levelCount)
+			return Error(ErrorCode::GRAPHICS_INVALID_LEVEL, 0);
+
+		const auto width = LevelWidth(level);
+		const auto height = LevelHeight(level);
+
+		result = rect.HasValue() ? rect.Value() : Rectangle(0, 0, width, height);
+
+		if (result.X < 0 || result.Y < 0 || result.Width <= 0 || result.Height <= 0
+			|| result.X + result.Width > width || result.Y + result.Height > height)
+			return Error(ErrorCode::GRAPHICS_INVALID_RECTANGLE, 1);
+
+		if (elementCount < static_cast<size_t>(result.Width) * result.Height)
+			return Error(ErrorCode::ARGUMENT_IS_SMALLER, 3);
+
+		return NoError;
+	}
+
+	Error Texture2D::write(intcs level, cs::Nullable<Rectangle> const& rect, void const* data, size_t elementSize, size_t elementCount) {
+		if (data == nullptr)
+			return Error(ErrorCode::ARGUMENT_IS_NULL, 2);
+
+		if (elementSize != static_cast<size_t>(PixelConverter::GetSize(_format)))
+			return Error(ErrorCode::GRAPHICS_INVALID_ELEMENT_SIZE, 2);
+
+		Rectangle area;
+		const auto error = region(level, rect, elementCount, area);
+
+		if (error.HasError())
+			return error;
+
+		size_t restored;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			restored = restore();
+
+			const auto rowSize = static_cast<size_t>(area.Width) * elementSize;
+			const auto pitch = static_cast<size_t>(LevelWidth(level)) * elementSize;
+			auto target = LevelData(level) + area.Y * pitch + area.X * elementSize;
+			auto source = static_cast<bytecs const*>(data);
+
+			for (intcs y = 0; y < area.Height; ++y, target += pitch, source += rowSize)
+				std::memcpy(target, source, rowSize);
+		}
+
+		if (restored > 0)
+			ReportSize(restored, true);
+
+		return NoError;
+	}
+
+	Error Texture2D::read(intcs level, cs::Nullable<Rectangle> const& rect, void* data, size_t elementSize, size_t elementCount) const {
+		if (data == nullptr)
+			return Error(ErrorCode::ARGUMENT_IS_NULL, 2);
+
+		if (elementSize != static_cast<size_t>(PixelConverter::GetSize(_format)))
+			return Error(ErrorCode::GRAPHICS_INVALID_ELEMENT_SIZE, 2);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_data.empty())
+			return Error(ErrorCode::GRAPHICS_RESOURCE_EVICTED, 0);
+
+		Rectangle area;
+		const auto error = region(level, rect, elementCount, area);
+
+		if (error.HasError())
+			return error;
+
+		const auto rowSize = static_cast<size_t>(area.Width) * elementSize;
+		const auto pitch = static_cast<size_t>(LevelWidth(level)) * elementSize;
+		auto source = LevelData(level) + area.Y * pitch + area.X * elementSize;
+		auto target = static_cast<bytecs*>(data);
+
+		for (intcs y = 0; y < area.Height; ++y, source += pitch, target += rowSize)
+			std::memcpy(target, source, rowSize);
+
+		return NoError;
+	}
+
+	Error Texture2D::SetData(intcs level, cs::Nullable<Rectangle> const& rect, Color const* data, size_t elementCount) {
+		if (_format == SurfaceFormat::Color)
+			return write(level, rect, data, sizeof(Color), elementCount);
+
+		if (data == nullptr)
+			return Error(ErrorCode::ARGUMENT_IS_NULL, 2);
+
+		Rectangle area;
+		const auto error = region(level, rect, elementCount, area);
+
+		if (error.HasError())
+			return error;
+
+		size_t restored;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			restored = restore();
+
+			const auto elementSize = static_cast<size_t>(PixelConverter::GetSize(_format));
+			const auto pitch = static_cast<size_t>(LevelWidth(level)) * elementSize;
+			auto target = LevelData(level) + area.Y * pitch + area.X * elementSize;
+			auto source = reinterpret_cast<uintcs const*>(data);
+
+			for (intcs y = 0; y < area.Height; ++y, target += pitch, source += area.Width) {
+				if (_format == SurfaceFormat::Bgra32)
+					PixelConverter::SwapRedBlue(source, reinterpret_cast<uintcs*>(target), area.Width);
+				else
+					PixelConverter::UnpackRgba8(source, reinterpret_cast<float*>(target), area.Width);
+			}
+		}
+
+		if (restored > 0)
+			ReportSize(restored, true);
+
+		return NoError;
+	}
+
+	Error Texture2D::GetData(intcs level, cs::Nullable<Rectangle> const& rect, Color* data, size_t elementCount) const {
+		if (_format == SurfaceFormat::Color)
+			return read(level, rect, data, sizeof(Color), elementCount);
+
+		if (data == nullptr)
+			return Error(ErrorCode::ARGUMENT_IS_NULL, 2);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_data.empty())
+			return Error(ErrorCode::GRAPHICS_RESOURCE_EVICTED, 0);
+
+		Rectangle area;
+		const auto error = region(level, rect, elementCount, area);
+
+		if (error.HasError())
+			return error;
+
+		const auto elementSize = static_cast<size_t>(PixelConverter::GetSize(_format));
+		const auto pitch = static_cast<size_t>(LevelWidth(level)) * elementSize;
+		auto source = LevelData(level) + area.Y * pitch + area.X * elementSize;
+		auto target = reinterpret_cast<uintcs*>(data);
+
+		for (intcs y = 0; y < area.Height; ++y, source += pitch, target += area.Width) {
+			if (_format == SurfaceFormat::Bgra32)
+				PixelConverter::SwapRedBlue(reinterpret_cast<uintcs const*>(source), target, area.Width);
+			else
+				PixelConverter::PackRgba8(reinterpret_cast<float const*>(source), target, area.Width);
+		}
+
+		return NoError;
+	}
+
+	void Texture2D::GenerateMipmaps(MipmapFilter filter) {
+		if (_levelCount < 2)
+			return;
+
+		//Every level is filtered from level 0, so the levels do not depend on each other.
+		//The float texels live in the scratch arenas of the threads, so filtering does not touch the heap
+		//once the arenas have grown to the texture size.
+		ScratchScope scope;
+		const auto count = static_cast<size_t>(_width) * _height;
+		std::pmr::vector<float> source(count * 4, &scope.Arena());
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_data.empty())
+				return;
+
+			PixelConverter::ToVector4(_format, LevelData(0), source.data(), count);
+		}
+
+		//The texture is only locked to write each level, so it can be used, and the waiting thread can run
+		//other jobs that use it, while the levels are filtered. A level is dropped if the texels were evicted meanwhile.
+		auto& jobs = JobSystem::Shared();
+		JobCounter counter;
+
+		for (intcs level = 1; level < _levelCount; ++level) {
+			jobs.Run(counter, [this, &source, level, filter] {
+				const auto width = LevelWidth(level);
+				const auto height = LevelHeight(level);
+				ScratchScope scratch;
+				const auto texels = resample(source.data(), _width, _height, width, height, filter, &scratch.Arena());
+
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (!_data.empty())
+					PixelConverter::FromVector4(_format, texels.data(), LevelData(level), static_cast<size_t>(width) * height);
+			});
+		}
+
+		jobs.Wait(counter);
+	}
+
+	void Texture2D::PremultiplyAlpha() {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_format == SurfaceFormat::Vector4 || _data.empty())
+			return;
+
+		for (intcs level = 0; level < _levelCount; ++level) {
+			const auto texels = reinterpret_cast<uintcs*>(LevelData(level));
+			PixelConverter::PremultiplyAlpha(texels, texels, static_cast<size_t>(LevelWidth(level)) * LevelHeight(level));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef DXNA_GRAPHICS_TEXTURE_HPP
+#define DXNA_GRAPHICS_TEXTURE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include "../alignedallocator.hpp"
+#include "../error.hpp"
+#include "../cs/nullable.hpp"
+#include "graphicsresource.hpp"
+#include "pixelconverter.hpp"
+
+namespace dxna::graphics {
+	class Texture : public GraphicsResource {
+	public:
+		virtual ~Texture() {}
+
+		intcs LevelCount() const { return _levelCount; }
+
+		SurfaceFormat Format() const { return _format; }
+
+	protected:
+		Texture() : GraphicsResource(ResourceType::Texture) {}
+
+		intcs _levelCount{ 1 };
+		SurfaceFormat _format{ SurfaceFormat::Color };
+	};
+
+	//A 2D texture whose texels are kept in memory.
+	//Every level is tightly packed row by row and starts on a 64-byte boundary,
+	//so uploads and the software backend can stream it directly.
+	//The registry evicts the texels on the thread that draws, so SetData, GetData, GenerateMipmaps and
+	//PremultiplyAlpha lock the texture; LevelData does not, and is meant for the backends on that thread.
+	class Texture2D : public Texture {
+	public:
+		Texture2D(GraphicsDevicePtr const& device, intcs width, intcs height, bool mipMap = false, SurfaceFormat format = SurfaceFormat::Color);
+
+		~Texture2D() override { ReportSize(0); }
+
+		intcs Width() const { return _width; }
+
+		intcs Height() const { return _height; }
+
+		Rectangle Bounds() const { return Rectangle(0, 0, _width, _height); }
+
+		//Evict frees the texels. Reading an evicted texture fails and the backends refuse to bind it;
+		//the next SetData allocates the texels again, cleared, so the content can be loaded back.
+		bool IsEvicted() const {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _data.empty();
+		}
+
+		intcs LevelWidth(intcs level) const { return std::max(_width >> level, 1); }
+
+		intcs LevelHeight(intcs level) const { return std::max(_height >> level, 1); }
+
+		bytecs* LevelData(intcs level) { return _data.data() + _levelOffsets[level]; }
+
+		bytecs const* LevelData(intcs level) const { return _data.data() + _levelOffsets[level]; }
+
+		size_t LevelSize(intcs level) const {
+			return static_cast<size_t>(LevelWidth(level)) * LevelHeight(level) * PixelConverter::GetSize(_format);
+		}
+
+		//Copies colors into level 0, converting them to the format of the texture.
+		Error SetData(Color const* data, size_t elementCount) {
+			return SetData(0, cs::Nullable<Rectangle>(), data, elementCount);
+		}
+
+		Error SetData(intcs level, cs::Nullable<Rectangle> const& rect, Color const* data, size_t elementCount);
+
+		//Copies raw texels, the size of T must match the size of a texel.
+		template <typename T>
+		Error SetData(T const* data, size_t elementCount) {
+			return SetData(0, cs::Nullable<Rectangle>(), data, elementCount);
+		}
+
+		template <typename T>
+		Error SetData(intcs level, cs::Nullable<Rectangle> const& rect, T const* data, size_t elementCount) {
+			return write(level, rect, data, sizeof(T), elementCount);
+		}
+
+		//Copies colors out of level 0, converting them from the format of the texture.
+		Error GetData(Color* data, size_t elementCount) const {
+			return GetData(0, cs::Nullable<Rectangle>(), data, elementCount);
+		}
+
+		Error GetData(intcs level, cs::Nullable<Rectangle> const& rect, Color* data, size_t elementCount) const;
+
+		template <typename T>
+		Error GetData(T* data, size_t elementCount) const {
+			return GetData(0, cs::Nullable<Rectangle>(), data, elementCount);
+		}
+
+		template <typename T>
+		Error GetData(intcs level, cs::Nullable<Rectangle> const& rect, T* data, size_t elementCount) const {
+			return read(level, rect, data, sizeof(T), elementCount);
+		}
+
+		//Rebuilds levels 1 and up from level 0, each level as a job of the shared JobSystem.
+		//Texels are filtered as stored, so colors with alpha should be premultiplied first.
+		void GenerateMipmaps(MipmapFilter filter = MipmapFilter::Box);
+
+		//Multiplies the color of every texel by its alpha. Only 8-bit formats are changed.
+		void PremultiplyAlpha();
+
+	private:
+		Error region(intcs level, cs::Nullable<Rectangle> const& rect, size_t elementCount, Rectangle& result) const;
+		Error write(intcs level, cs::Nullable<Rectangle> const& rect, void const* data, size_t elementSize, size_t elementCount);
+		Error read(intcs level, cs::Nullable<Rectangle> const& rect, void* data, size_t elementSize, size_t elementCount) const;
+		size_t restore();
+		size_t EvictContent() override;
+
+		mutable std::mutex _mutex;
+		intcs _width{ 0 };
+		intcs _height{ 0 };
+		std::vector<size_t> _levelOffsets;
+		std::vector<bytecs, AlignedAllocator<bytecs, 64>> _data;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef DXNA_GRAPHICS_VERTEXTYPES_HPP
+#define DXNA_GRAPHICS_VERTEXTYPES_HPP
+
+#include "../structs.hpp"
+#include "enumerations.hpp"
+
+namespace dxna::graphics {
+	struct VertexPositionColor {
+		Vector3 Position;
+		dxna::Color Color;
+
+		static constexpr VertexFormat Format = VertexFormat::PositionColor;
+
+		constexpr VertexPositionColor() = default;
+
+		constexpr VertexPositionColor(Vector3 const& position, dxna::Color const& color) :
+			Position(position), Color(color) {}
+	};
+
+	struct VertexPositionColorTexture {
+		Vector3 Position;
+		dxna::Color Color;
+		Vector2 TextureCoordinate;
+
+		static constexpr VertexFormat Format = VertexFormat::PositionColorTexture;
+
+		constexpr VertexPositionColorTexture() = default;
+
+		constexpr VertexPositionColorTexture(Vector3 const& position, dxna::Color const& color, Vector2 const& textureCoordinate) :
+			Position(position), Color(color), TextureCoordinate(textureCoordinate) {}
+	};
+
+	static_assert(sizeof(VertexPositionColor) == 16, "VertexPositionColor must match its vertex declaration.");
+	static_assert(sizeof(VertexPositionColorTexture) == 24, "VertexPositionColorTexture must match its vertex declaration.");
+}
+
+#endif
\ No newline at end of file
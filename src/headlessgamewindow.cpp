@@ -0,0 +1,59 @@
+#include "headlessgamewindow.hpp"
+#include <thread>
+
+namespace dxna {
+	HeadlessGameWindow::HeadlessGameWindow(int clientWidth, int clientHeight) :
+		_bounds(0, 0, clientWidth, clientHeight), _start(std::chrono::steady_clock::now()) {
+	}
+
+	void HeadlessGameWindow::ClientBounds(Rectangle const& value) {
+		const auto resized = value.Width != _bounds.Width || value.Height != _bounds.Height;
+		_bounds = value;
+
+		if (resized)
+			OnClientSizeChanged();
+	}
+
+	void HeadlessGameWindow::CurrentOrientation(DisplayOrientation value) {
+		if (value == _orientation)
+			return;
+
+		const auto supported = static_cast<int>(_supportedOrientations);
+
+		if (value != DisplayOrientation::Default && supported != 0 && (supported & static_cast<int>(value)) == 0)
+			return;
+
+		_orientation = value;
+		OnOrientationChanged();
+	}
+
+	void HeadlessGameWindow::Activate() {
+		if (_isActive)
+			return;
+
+		_isActive = true;
+		OnActivated();
+	}
+
+	void HeadlessGameWindow::Deactivate() {
+		if (!_isActive)
+			return;
+
+		_isActive = false;
+		OnDeactivated();
+	}
+
+	void HeadlessGameWindow::Present() {
+		_presentCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (!_vsync)
+			return;
+
+		//Waits for the next refresh boundary since the window was created.
+		const auto period = std::chrono::nanoseconds(1000000000LL / _refreshRate);
+		const auto elapsed = std::chrono::steady_clock::now() - _start;
+		const auto refreshes = elapsed / period + 1;
+
+		std::this_thread::sleep_until(_start + refreshes * period);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef DXNA_HEADLESSGAMEWINDOW_HPP
+#define DXNA_HEADLESSGAMEWINDOW_HPP
+
+#include <atomic>
+#include <chrono>
+#include "gamewindow.hpp"
+
+namespace dxna {
+	//A window with no screen behind it, for servers, tests and benchmarks.
+	//Its size, orientation and focus change only when told to, raising the events a real window would.
+	//With VSync off and Game::IsFixedTimeStep false, Game::Run draws frames as fast as they are produced.
+	class HeadlessGameWindow : public GameWindow {
+	public:
+		static constexpr int DefaultRefreshRate = 60;
+
+		HeadlessGameWindow(int clientWidth = DefaultClientWidth, int clientHeight = DefaultClientHeight);
+
+		virtual Rectangle ClientBounds() const override { return _bounds; }
+
+		//Moves or resizes the client area. Raises ClientSizeChanged when the size changes.
+		void ClientBounds(Rectangle const& value);
+
+		virtual DisplayOrientation CurrentOrientation() const override { return _orientation; }
+
+		//Rotates the window and raises OrientationChanged. Orientations outside
+		//SupportedOrientations are ignored, unless it is Default.
+		void CurrentOrientation(DisplayOrientation value);
+
+		DisplayOrientation SupportedOrientations() const { return _supportedOrientations; }
+
+		virtual bool AllowUserResizing() const override { return _allowUserResizing; }
+		virtual void AllowUserResizing(bool value) override { _allowUserResizing = value; }
+
+		virtual bool IsMouseVisible() const override { return _isMouseVisible; }
+		virtual void IsMouseVisible(bool value) override { _isMouseVisible = value; }
+
+		virtual bool IsMinimizedState() const override { return _isMinimized; }
+		void IsMinimizedState(bool value) { _isMinimized = value; }
+
+		virtual bool IsActive() const override { return _isActive; }
+
+		//Gives the window the focus, raising Activated if it did not have it.
+		void Activate();
+
+		//Takes the focus away, raising Deactivated if the window had it.
+		void Deactivate();
+
+		//Whether Present waits for the next refresh of a display running at RefreshRate.
+		bool VSync() const { return _vsync; }
+		void VSync(bool value) { _vsync = value; }
+
+		int RefreshRate() const { return _refreshRate; }
+		void RefreshRate(int value) { _refreshRate = value > 0 ? value : DefaultRefreshRate; }
+
+		virtual void Present() override;
+
+		//Frames presented since the window was created.
+		ulongcs PresentCount() const { return _presentCount.load(std::memory_order_relaxed); }
+
+	protected:
+		//GameWindow keeps the title; there is nothing to show it on.
+		virtual void SetTitle(std::string const&) override {}
+		virtual void SetSupportedOrientations(DisplayOrientation orientations) override { _supportedOrientations = orientations; }
+
+	private:
+		Rectangle _bounds;
+		DisplayOrientation _orientation{ DisplayOrientation::Default };
+		DisplayOrientation _supportedOrientations{ DisplayOrientation::Default };
+		bool _allowUserResizing{ false };
+		bool _isMouseVisible{ false };
+		bool _isMinimized{ false };
+		bool _isActive{ true };
+		bool _vsync{ true };
+		int _refreshRate{ DefaultRefreshRate };
+		//Present runs on the render thread of a Game while the game thread reads the count.
+		std::atomic<ulongcs> _presentCount{ 0 };
+		std::chrono::steady_clock::time_point _start;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "actionmap.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dxna::input {
+	static inline uint64_t bit(InputSnapshot const& snapshot, InputControl control) {
+		return (snapshot.Controls[control.Index >> 6] >> (control.Index & 63)) & 1;
+	}
+
+	uintcs ActionMap::AddAction(std::string const& name) {
+		const auto found = _actionIndexes.find(name);
+
+		if (found != _actionIndexes.end())
+			return found->second;
+
+		const auto index = static_cast<uintcs>(_actionNames.size());
+
+		_actionNames.push_back(name);
+		_actionIndexes.emplace(name, index);
+		_bindings.resize(_bindings.size() + _slots);
+		_down.resize((_actionNames.size() + 63) / 64);
+		_previous.resize(_down.size());
+
+		return index;
+	}
+
+	uintcs ActionMap::AddAxis(std::string const& name, float deadZone) {
+		const auto found = _axisIndexes.find(name);
+
+		if (found != _axisIndexes.end())
+			return found->second;
+
+		const auto index = static_cast<uintcs>(_axisNames.size());
+
+		_axisNames.push_back(name);
+		_axisIndexes.emplace(name, index);
+		_axisBindings.resize(_axisBindings.size() + _slots);
+		_deadZones.push_back(0);
+		_values.push_back(0);
+		DeadZone(index, deadZone);
+
+		return index;
+	}
+
+	intcs ActionMap::FindAction(std::string const& name) const {
+		const auto found = _actionIndexes.find(name);
+		return found != _actionIndexes.end() ? static_cast<intcs>(found->second) : -1;
+	}
+
+	intcs ActionMap::FindAxis(std::string const& name) const {
+		const auto found = _axisIndexes.find(name);
+		return found != _axisIndexes.end() ? static_cast<intcs>(found->second) : -1;
+	}
+
+	Error ActionMap::Bind(uintcs action, size_t slot, std::initializer_list<InputControl> chord) {
+		if (chord.size() > ActionBinding::MaxChord)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2);
+
+		ActionBinding binding;
+
+		if (chord.size() > 0) {
+			binding = ActionBinding(*chord.begin());
+			std::copy(chord.begin(), chord.end(), binding.Controls.begin());
+		}
+
+		return Bind(action, slot, binding);
+	}
+
+	Error ActionMap::Bind(uintcs action, size_t slot, ActionBinding const& binding) {
+		if (action >= _actionNames.size())
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0);
+
+		if (slot >= _slots)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1);
+
+		for (const auto& control : binding.Controls) {
+			if (control.Index > InputControl::NeverIndex)
+				return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2);
+		}
+
+		_bindings[action * _slots + slot] = binding;
+		return NoError;
+	}
+
+	Error ActionMap::BindAxis(uintcs axis, size_t slot, AxisBinding const& binding) {
+		if (axis >= _axisNames.size())
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0);
+
+		if (slot >= _slots)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1);
+
+		if (binding.Negative.Index > InputControl::NeverIndex || binding.Positive.Index > InputControl::NeverIndex
+			|| static_cast<size_t>(binding.Analog) >= InputSnapshot::AxisCount)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2);
+
+		_axisBindings[axis * _slots + slot] = binding;
+		return NoError;
+	}
+
+	Error ActionMap::DeadZone(uintcs axis, float deadZone) {
+		if (axis >= _axisNames.size())
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0);
+
+		if (deadZone < 0 || deadZone >= 1)
+			return Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1);
+
+		_deadZones[axis] = deadZone;
+		return NoError;
+	}
+
+	void ActionMap::Update(InputSnapshot const& snapshot) {
+		_previous.swap(_down);
+
+		const auto actionCount = _actionNames.size();
+		const auto* binding = _bindings.data();
+
+		for (size_t word = 0; word < _down.size(); ++word) {
+			const auto end = std::min(actionCount, (word + 1) * 64);
+			uint64_t bits = 0;
+
+			for (size_t action = word * 64; action < end; ++action) {
+				uint64_t down = 0;
+
+				for (size_t slot = 0; slot < _slots; ++slot, ++binding) {
+					const auto& controls = binding->Controls;
+					down |= bit(snapshot, controls[0]) & bit(snapshot, controls[1])
+						& bit(snapshot, controls[2]) & bit(snapshot, controls[3]);
+				}
+
+				bits |= down << (action & 63);
+			}
+
+			_down[word] = bits;
+		}
+
+		const auto* axisBinding = _axisBindings.data();
+
+		for (size_t axis = 0; axis < _axisNames.size(); ++axis) {
+			const auto deadZone = _deadZones[axis];
+			const auto rescale = 1.0F / (1.0F - deadZone);
+			float value = 0;
+
+			for (size_t slot = 0; slot < _slots; ++slot, ++axisBinding) {
+				auto read = static_cast<float>(bit(snapshot, axisBinding->Positive))
+					- static_cast<float>(bit(snapshot, axisBinding->Negative))
+					+ snapshot.Axes[static_cast<size_t>(axisBinding->Analog)] * axisBinding->Scale;
+
+				const auto magnitude = std::fabs(read) - deadZone;
+				read = magnitude > 0 ? std::copysign(magnitude * rescale, read) : 0.0F;
+
+				if (std::fabs(read) > std::fabs(value))
+					value = read;
+			}
+
+			_values[axis] = value;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef DXNA_INPUT_ACTIONMAP_HPP
+#define DXNA_INPUT_ACTIONMAP_HPP
+
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "inputsnapshot.hpp"
+#include "../error.hpp"
+
+namespace dxna::input {
+	//Up to MaxChord controls that must all be down for the binding to trigger.
+	struct ActionBinding {
+		static constexpr size_t MaxChord = 4;
+
+		//Unused entries repeat the first control, so every binding tests MaxChord controls
+		//without a branch. An empty binding holds InputControl::Never and never triggers.
+		std::array<InputControl, MaxChord> Controls{};
+
+		constexpr ActionBinding() = default;
+
+		constexpr ActionBinding(InputControl control) {
+			Controls.fill(control);
+		}
+
+		constexpr bool IsEmpty() const { return Controls[0] == InputControl::Never(); }
+
+		constexpr bool operator==(ActionBinding const& other) const = default;
+	};
+
+	//Maps an axis from either two controls, read as -1 and 1, or an analog input times Scale.
+	struct AxisBinding {
+		InputControl Negative{};
+		InputControl Positive{};
+		InputAxis Analog{ InputAxis::None };
+		float Scale{ 1.0F };
+
+		constexpr bool IsEmpty() const {
+			return Negative == InputControl::Never() && Positive == InputControl::Never() && Analog == InputAxis::None;
+		}
+
+		constexpr bool operator==(AxisBinding const& other) const = default;
+	};
+
+	//Named actions and axes bound to controls, evaluated once per frame against an InputSnapshot.
+	//Each action and axis has a fixed number of binding slots stored in flat arrays, so
+	//Update is a straight pass over them and rebinding a slot at runtime rewrites it in place.
+	//Actions and axes are identified by the index returned when they are added.
+	class ActionMap {
+	public:
+		ActionMap(size_t bindingsPerAction = 2) : _slots(bindingsPerAction < 1 ? 1 : bindingsPerAction) {}
+
+		//Adds an action with no bindings and returns its index, or the index of the action already named so.
+		uintcs AddAction(std::string const& name);
+
+		//Adds an axis with no bindings and returns its index, or the index of the axis already named so.
+		uintcs AddAxis(std::string const& name, float deadZone = 0);
+
+		//The index of the named action, or -1.
+		intcs FindAction(std::string const& name) const;
+
+		//The index of the named axis, or -1.
+		intcs FindAxis(std::string const& name) const;
+
+		//Binds a slot of the action to a chord of up to ActionBinding::MaxChord controls.
+		//An empty chord clears the slot.
+		Error Bind(uintcs action, size_t slot, std::initializer_list<InputControl> chord);
+
+		Error Bind(uintcs action, size_t slot, ActionBinding const& binding);
+
+		//Binds a slot of the axis.
+		Error BindAxis(uintcs axis, size_t slot, AxisBinding const& binding);
+
+		//Values of the axis closer to zero than deadZone read as zero, the rest is rescaled to start at zero.
+		Error DeadZone(uintcs axis, float deadZone);
+
+		ActionBinding GetBinding(uintcs action, size_t slot) const { return _bindings[action * _slots + slot]; }
+		AxisBinding GetAxisBinding(uintcs axis, size_t slot) const { return _axisBindings[axis * _slots + slot]; }
+
+		//Evaluates every action and axis against the snapshot of the frame.
+		void Update(InputSnapshot const& snapshot);
+
+		bool IsDown(uintcs action) const { return test(_down, action); }
+
+		//Whether the action went down in the last Update.
+		bool WasPressed(uintcs action) const { return test(_down, action) && !test(_previous, action); }
+
+		//Whether the action went up in the last Update.
+		bool WasReleased(uintcs action) const { return !test(_down, action) && test(_previous, action); }
+
+		//The value of the binding of the axis that reads farthest from zero.
+		float Value(uintcs axis) const { return _values[axis]; }
+
+		size_t ActionCount() const { return _actionNames.size(); }
+		size_t AxisCount() const { return _axisNames.size(); }
+		size_t BindingsPerAction() const { return _slots; }
+
+	private:
+		static bool test(std::vector<uint64_t> const& bits, uintcs index) {
+			return ((bits[index >> 6] >> (index & 63)) & 1) != 0;
+		}
+
+		size_t _slots;
+		std::vector<ActionBinding> _bindings;
+		std::vector<AxisBinding> _axisBindings;
+		std::vector<float> _deadZones;
+		std::vector<float> _values;
+		std::vector<uint64_t> _down;
+		std::vector<uint64_t> _previous;
+		std::vector<std::string> _actionNames;
+		std::vector<std::string> _axisNames;
+		std::unordered_map<std::string, uintcs> _actionIndexes;
+		std::unordered_map<std::string, uintcs> _axisIndexes;
+	};
+}
+
+#endif
\ No newline at end of file
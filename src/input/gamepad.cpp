@@ -1,5 +1,161 @@
 #include "gamepad.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace dxna::input {
+	static inline float stickValue(shortcs value) {
+		//-32768 would read below -1.
+		return std::fmax(static_cast<float>(value) / 32767.0F, -1.0F);
+	}
 
+	static inline shortcs stickReport(float value) {
+		return static_cast<shortcs>(std::clamp(value, -1.0F, 1.0F) * 32767.0F);
+	}
+
+	//Zero up to zone, then rescaled so the filtered value still reaches 1.
+	static inline float independentZone(float value, float zone) {
+		return std::copysign(std::fmax(std::fabs(value) - zone, 0.0F) / (1.0F - zone), value);
+	}
+
+	static inline Vector2 circularZone(Vector2 const& value, float zone) {
+		const auto length = std::sqrt(value.X * value.X + value.Y * value.Y);
+		const auto filtered = std::fmin(std::fmax(length - zone, 0.0F) / (1.0F - zone), 1.0F);
+		const auto scale = filtered / std::fmax(length, 1e-6F);
+		return Vector2(value.X * scale, value.Y * scale);
+	}
+
+	static inline Vector2 stick(Vector2 const& value, float zone, GamePadDeadZone deadZone) {
+		switch (deadZone)
+		{
+		case GamePadDeadZone::IndependentAxes:
+			return Vector2(independentZone(value.X, zone), independentZone(value.Y, zone));
+		case GamePadDeadZone::Circular:
+			return circularZone(value, zone);
+		default:
+			return value;
+		}
+	}
+
+	GamePadState::GamePadState(GamePadReport const& report, GamePadDeadZone deadZone) :
+		IsConnected(report.IsConnected), PacketNumber(report.PacketNumber), Buttons(report.Buttons) {
+		const Vector2 left(stickValue(report.LeftX), stickValue(report.LeftY));
+		const Vector2 right(stickValue(report.RightX), stickValue(report.RightY));
+
+		ThumbSticks.Left = stick(left, LeftThumbDeadZone, deadZone);
+		ThumbSticks.Right = stick(right, RightThumbDeadZone, deadZone);
+
+		const auto threshold = deadZone == GamePadDeadZone::None ? 0.0F : TriggerThreshold;
+		Triggers.Left = independentZone(static_cast<float>(report.LeftTrigger) / 255.0F, threshold);
+		Triggers.Right = independentZone(static_cast<float>(report.RightTrigger) / 255.0F, threshold);
+	}
+
+	void VirtualGamePad::Poll(std::span<GamePadReport> reports) {
+		const auto count = std::min(reports.size(), MaxCount);
+
+		for (size_t i = 0; i < count; ++i) {
+			auto& pad = _pads[i];
+
+			if (pad.Next < pad.Script.size()) {
+				const auto packet = pad.Report.PacketNumber;
+				pad.Report = pad.Script[pad.Next++];
+				pad.Report.PacketNumber = packet + 1;
+
+				if (pad.Loop && pad.Next == pad.Script.size())
+					pad.Next = 0;
+			}
+
+			reports[i] = pad.Report;
+		}
+	}
+
+	void VirtualGamePad::change(Pad& pad) {
+		pad.Script.clear();
+		pad.Next = 0;
+		++pad.Report.PacketNumber;
+	}
+
+	void VirtualGamePad::SetReport(PlayerIndex player, GamePadReport const& report) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		const auto packet = pad.Report.PacketNumber;
+
+		pad.Report = report;
+		pad.Report.PacketNumber = packet;
+		change(pad);
+	}
+
+	void VirtualGamePad::Connect(PlayerIndex player, bool connected) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Report.IsConnected = connected;
+		change(pad);
+	}
+
+	void VirtualGamePad::Press(PlayerIndex player, ButtonValues button) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Report.Buttons |= static_cast<ushortcs>(button);
+		change(pad);
+	}
+
+	void VirtualGamePad::Release(PlayerIndex player, ButtonValues button) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Report.Buttons &= static_cast<ushortcs>(~static_cast<ushortcs>(button));
+		change(pad);
+	}
+
+	void VirtualGamePad::SetThumbSticks(PlayerIndex player, Vector2 const& left, Vector2 const& right) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Report.LeftX = stickReport(left.X);
+		pad.Report.LeftY = stickReport(left.Y);
+		pad.Report.RightX = stickReport(right.X);
+		pad.Report.RightY = stickReport(right.Y);
+		change(pad);
+	}
+
+	void VirtualGamePad::SetTriggers(PlayerIndex player, float left, float right) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Report.LeftTrigger = static_cast<bytecs>(std::clamp(left, 0.0F, 1.0F) * 255.0F + 0.5F);
+		pad.Report.RightTrigger = static_cast<bytecs>(std::clamp(right, 0.0F, 1.0F) * 255.0F + 0.5F);
+		change(pad);
+	}
+
+	void VirtualGamePad::Play(PlayerIndex player, std::vector<GamePadReport> script, bool loop) {
+		auto& pad = _pads[static_cast<size_t>(player)];
+		pad.Script = std::move(script);
+		pad.Next = 0;
+		pad.Loop = loop;
+	}
+
+	static GamePadDevice* device = nullptr;
+	static std::array<GamePadReport, GamePad::MaxCount> reports;
+	static std::array<GamePadState, GamePad::MaxCount> states;
+
+	void GamePad::Device(GamePadDevice* value) {
+		device = value;
+	}
+
+	GamePadDevice* GamePad::Device() {
+		return device;
+	}
+
+	void GamePad::Update() {
+		if (device != nullptr)
+			device->Poll(reports);
+		else
+			reports.fill(GamePadReport());
+
+		for (size_t i = 0; i < MaxCount; ++i)
+			states[i] = GamePadState(reports[i]);
+	}
+
+	GamePadState GamePad::GetState(PlayerIndex player, GamePadDeadZone deadZone) {
+		const auto index = static_cast<size_t>(player);
+
+		if (index >= MaxCount)
+			return GamePadState();
+
+		return deadZone == GamePadDeadZone::IndependentAxes ? states[index] : GamePadState(reports[index], deadZone);
+	}
+
+	std::span<GamePadState const, GamePad::MaxCount> GamePad::GetStates() {
+		return states;
+	}
 }
\ No newline at end of file
@@ -1,8 +1,170 @@
-#ifndef DXNA_NPUT_GAMEPAD_HPP
-#define DXNA_NPUT_GAMEPAD_HPP
+#ifndef DXNA_INPUT_GAMEPAD_HPP
+#define DXNA_INPUT_GAMEPAD_HPP
+
+#include <array>
+#include <span>
+#include <vector>
+#include "buttons.hpp"
+#include "../structs.hpp"
+#include "../cs/cstypes.hpp"
 
 namespace dxna::input {
+	enum class PlayerIndex {
+		One,
+		Two,
+		Three,
+		Four,
+		Five,
+		Six,
+		Seven,
+		Eight
+	};
+
+	//How the thumb sticks are filtered near their rest position.
+	enum class GamePadDeadZone {
+		//Raw values.
+		None,
+		//Each axis of a stick is filtered on its own.
+		IndependentAxes,
+		//The stick is filtered by its distance from the center, so diagonals keep their direction.
+		Circular
+	};
+
+	//What a device reports for one pad, in the ranges XInput uses.
+	struct GamePadReport {
+		bool IsConnected{ false };
+		//Changes whenever the rest of the report does.
+		uintcs PacketNumber{ 0 };
+		//ButtonValues bits.
+		ushortcs Buttons{ 0 };
+		shortcs LeftX{ 0 };
+		shortcs LeftY{ 0 };
+		shortcs RightX{ 0 };
+		shortcs RightY{ 0 };
+		bytecs LeftTrigger{ 0 };
+		bytecs RightTrigger{ 0 };
+
+		constexpr bool operator==(GamePadReport const& other) const = default;
+	};
+
+	struct GamePadThumbSticks {
+		Vector2 Left;
+		Vector2 Right;
+
+		constexpr bool operator==(GamePadThumbSticks const& other) const = default;
+	};
+
+	struct GamePadTriggers {
+		float Left{ 0 };
+		float Right{ 0 };
+
+		constexpr bool operator==(GamePadTriggers const& other) const = default;
+	};
+
+	//The state of a pad: the buttons packed as ButtonValues bits, the sticks from -1 to 1
+	//with Y up and the triggers from 0 to 1, dead zones applied.
+	struct GamePadState {
+		static constexpr float LeftThumbDeadZone = 7849.0F / 32767.0F;
+		static constexpr float RightThumbDeadZone = 8689.0F / 32767.0F;
+		static constexpr float TriggerThreshold = 30.0F / 255.0F;
+
+		bool IsConnected{ false };
+		uintcs PacketNumber{ 0 };
+		ushortcs Buttons{ 0 };
+		GamePadThumbSticks ThumbSticks;
+		GamePadTriggers Triggers;
+
+		constexpr GamePadState() = default;
+
+		//Converts a report without a branch on its values.
+		GamePadState(GamePadReport const& report, GamePadDeadZone deadZone = GamePadDeadZone::IndependentAxes);
+
+		constexpr bool IsButtonDown(ButtonValues button) const {
+			return (Buttons & static_cast<ushortcs>(button)) != 0;
+		}
+
+		constexpr bool IsButtonUp(ButtonValues button) const {
+			return (Buttons & static_cast<ushortcs>(button)) == 0;
+		}
+
+		constexpr bool operator==(GamePadState const& other) const = default;
+	};
+
+	//A source of pad reports. Poll fills every report in one call.
+	class GamePadDevice {
+	public:
+		virtual ~GamePadDevice() = default;
+
+		virtual void Poll(std::span<GamePadReport> reports) = 0;
+	};
+
+	//A device driven by code, for tests, replays and machines without pads.
+	//Each pad either holds the report last set or plays a script, one report per Poll.
+	class VirtualGamePad : public GamePadDevice {
+	public:
+		static constexpr size_t MaxCount = 8;
+
+		void Poll(std::span<GamePadReport> reports) override;
+
+		//Sets the report of the pad, which it keeps until changed. Stops its script.
+		void SetReport(PlayerIndex player, GamePadReport const& report);
+
+		GamePadReport const& GetReport(PlayerIndex player) const { return _pads[static_cast<size_t>(player)].Report; }
+
+		void Connect(PlayerIndex player, bool connected = true);
+
+		void Press(PlayerIndex player, ButtonValues button);
+		void Release(PlayerIndex player, ButtonValues button);
+
+		//Sticks from -1 to 1, triggers from 0 to 1.
+		void SetThumbSticks(PlayerIndex player, Vector2 const& left, Vector2 const& right);
+		void SetTriggers(PlayerIndex player, float left, float right);
+
+		//Plays the reports one per Poll, then holds the last one, or starts over if loop is true.
+		void Play(PlayerIndex player, std::vector<GamePadReport> script, bool loop = false);
+
+		bool IsPlaying(PlayerIndex player) const {
+			const auto& pad = _pads[static_cast<size_t>(player)];
+			return pad.Next < pad.Script.size();
+		}
+
+	private:
+		struct Pad {
+			GamePadReport Report;
+			std::vector<GamePadReport> Script;
+			size_t Next{ 0 };
+			bool Loop{ false };
+		};
+
+		void change(Pad& pad);
+
+		std::array<Pad, MaxCount> _pads;
+	};
+
+	struct GamePad {
+		static constexpr size_t MaxCount = 8;
+
+		//The device Update polls, such as XInputGamePad on Windows or a VirtualGamePad.
+		//Null disconnects every pad. The device must outlive its use.
+		static void Device(GamePadDevice* device);
+		static GamePadDevice* Device();
+
+		//Polls every pad in one pass and converts the reports with independent axes dead zones.
+		//Game thread only; Input::Update calls it.
+		static void Update();
+
+		//The state of the pad at the last Update.
+		static GamePadState GetState(PlayerIndex player, GamePadDeadZone deadZone = GamePadDeadZone::IndependentAxes);
+
+		//The states of every pad at the last Update, with independent axes dead zones.
+		static std::span<GamePadState const, MaxCount> GetStates();
 
+	private:
+		//Esconde construtores para transformar a classe em esttica.
+		constexpr GamePad() = default;
+		constexpr GamePad(GamePad&&) = default;
+		constexpr GamePad(const GamePad&) = default;
+	};
 }
 
 #endif
\ No newline at end of file
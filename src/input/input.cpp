@@ -1 +1,140 @@
-#include "input.hpp"
\ No newline at end of file
+#include "input.hpp"
+
+namespace dxna::input {
+	void InputFrame::Update(InputEventQueue& queue, longcs until) {
+		Clear();
+
+		InputEvent event;
+
+		while (queue.Peek(event) && event.Timestamp <= until) {
+			queue.Pop(event);
+			Apply(event);
+		}
+	}
+
+	void InputFrame::Apply(InputEvent const& event) {
+		_events.push_back(event);
+
+		switch (event.Type) {
+		case InputEventType::KeyDown: {
+			const auto key = static_cast<size_t>(event.Code);
+
+			if (!_keys.IsKeyDown(key))
+				_pressedKeys.setKey(key, true);
+
+			_keys.setKey(key, true);
+			return;
+		}
+		case InputEventType::KeyUp: {
+			const auto key = static_cast<size_t>(event.Code);
+
+			if (_keys.IsKeyDown(key))
+				_releasedKeys.setKey(key, true);
+
+			_keys.setKey(key, false);
+			return;
+		}
+		case InputEventType::MouseMove:
+			_mouse.X = event.X;
+			_mouse.Y = event.Y;
+			return;
+
+		case InputEventType::MouseWheel:
+			_mouse.Wheel += event.X;
+			return;
+
+		case InputEventType::MouseButtonDown:
+			setButton(static_cast<MouseButton>(event.Code), true);
+			return;
+
+		case InputEventType::MouseButtonUp:
+			setButton(static_cast<MouseButton>(event.Code), false);
+			return;
+
+		default:
+			return;
+		}
+	}
+
+	void InputFrame::Clear() {
+		_events.clear();
+		_pressedKeys = KeyboardState();
+		_releasedKeys = KeyboardState();
+		_pressedButtons.fill(false);
+		_releasedButtons.fill(false);
+	}
+
+	void InputFrame::setButton(MouseButton button, bool down) {
+		const auto index = static_cast<size_t>(button);
+
+		if (index >= ButtonCount)
+			return;
+
+		const auto state = down ? ButtonState::Pressed : ButtonState::Released;
+		ButtonState* current = nullptr;
+
+		switch (button) {
+		case MouseButton::Left:
+			current = &_mouse.Left;
+			break;
+		case MouseButton::Right:
+			current = &_mouse.Right;
+			break;
+		case MouseButton::Middle:
+			current = &_mouse.Middle;
+			break;
+		case MouseButton::X1:
+			current = &_mouse.X1;
+			break;
+		case MouseButton::X2:
+			current = &_mouse.X2;
+			break;
+		}
+
+		if (*current != state) {
+			if (down)
+				_pressedButtons[index] = true;
+			else
+				_releasedButtons[index] = true;
+		}
+
+		*current = state;
+	}
+
+	static InputEventQueue& sharedQueue() {
+		static InputEventQueue queue;
+		return queue;
+	}
+
+	static InputFrame& sharedFrame() {
+		static InputFrame frame;
+		return frame;
+	}
+
+	InputEventQueue& Input::Queue() {
+		return sharedQueue();
+	}
+
+	InputFrame const& Input::Frame() {
+		return sharedFrame();
+	}
+
+	void Input::Update() {
+		auto& frame = sharedFrame();
+		frame.Update(sharedQueue());
+
+		Keyboard::SetState(frame.GetKeyboardState());
+
+		const auto mouse = frame.GetMouseState();
+		Mouse::X = mouse.X;
+		Mouse::Y = mouse.Y;
+		Mouse::Wheel = mouse.Wheel;
+		Mouse::Left = mouse.Left;
+		Mouse::Right = mouse.Right;
+		Mouse::Middle = mouse.Middle;
+		Mouse::X1 = mouse.X1;
+		Mouse::X2 = mouse.X2;
+
+		GamePad::Update();
+	}
+}
\ No newline at end of file
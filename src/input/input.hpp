@@ -1,2 +1,30 @@
+#ifndef DXNA_INPUT_INPUT_HPP
+#define DXNA_INPUT_INPUT_HPP
+
 #include "keyboard.hpp"
-#include "mouse.hpp"
\ No newline at end of file
+#include "mouse.hpp"
+#include "inputqueue.hpp"
+#include "inputframe.hpp"
+#include "gamepad.hpp"
+
+namespace dxna::input {
+	struct Input {
+		//The queue the platform window pushes to, from its own thread.
+		static InputEventQueue& Queue();
+
+		//The frame built by the last Update.
+		static InputFrame const& Frame();
+
+		//Game thread only. Starts a frame from the queued events and copies the result
+		//to Keyboard and Mouse, which no other thread writes, then polls GamePad.
+		static void Update();
+
+	private:
+		//Esconde construtores para transformar a classe em esttica.
+		constexpr Input() = default;
+		constexpr Input(Input&&) = default;
+		constexpr Input(const Input&) = default;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef DXNA_INPUT_INPUTFRAME_HPP
+#define DXNA_INPUT_INPUTFRAME_HPP
+
+#include <array>
+#include <limits>
+#include <span>
+#include <vector>
+#include "inputqueue.hpp"
+#include "keyboard.hpp"
+#include "mouse.hpp"
+
+namespace dxna::input {
+	//The input of one frame, built on the game thread from the events of a queue.
+	//Events are applied in the order they happened, so a key pressed and released
+	//within one frame is reported by WasKeyPressed even though it is up afterwards.
+	class InputFrame {
+	public:
+		static constexpr size_t KeyCount = KeyboardState::KeyCount;
+		static constexpr size_t ButtonCount = 5;
+
+		//Applies the queued events stamped up to until, leaving later ones for the next frame.
+		void Update(InputEventQueue& queue, longcs until = std::numeric_limits<longcs>::max());
+
+		//Applies one event, as Update does for each queued one.
+		void Apply(InputEvent const& event);
+
+		//Starts a new frame: clears the events and the pressed and released keys and buttons.
+		void Clear();
+
+		//The events applied since the frame started, in order.
+		std::span<InputEvent const> Events() const { return _events; }
+
+		KeyboardState const& GetKeyboardState() const { return _keys; }
+
+		//The keys that went down during the frame, and those that went up.
+		KeyboardState const& GetPressedKeys() const { return _pressedKeys; }
+		KeyboardState const& GetReleasedKeys() const { return _releasedKeys; }
+
+		MouseState GetMouseState() const { return _mouse; }
+
+		bool IsKeyDown(Keys key) const { return _keys.IsKeyDown(key); }
+
+		//Whether the key went down during the frame. Repeats of a held key do not count.
+		bool WasKeyPressed(Keys key) const { return _pressedKeys.IsKeyDown(key); }
+
+		//Whether the key went up during the frame.
+		bool WasKeyReleased(Keys key) const { return _releasedKeys.IsKeyDown(key); }
+
+		bool WasButtonPressed(MouseButton button) const { return _pressedButtons[static_cast<size_t>(button)]; }
+
+		bool WasButtonReleased(MouseButton button) const { return _releasedButtons[static_cast<size_t>(button)]; }
+
+	private:
+		void setButton(MouseButton button, bool down);
+
+		std::vector<InputEvent> _events;
+		KeyboardState _keys;
+		KeyboardState _pressedKeys;
+		KeyboardState _releasedKeys;
+		std::array<bool, ButtonCount> _pressedButtons{};
+		std::array<bool, ButtonCount> _releasedButtons{};
+		MouseState _mouse;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,147 @@
+#ifndef DXNA_INPUT_INPUTQUEUE_HPP
+#define DXNA_INPUT_INPUTQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include "keys.hpp"
+#include "buttons.hpp"
+#include "../cs/cstypes.hpp"
+
+namespace dxna::input {
+	enum class InputEventType : bytecs {
+		KeyDown,
+		KeyUp,
+		MouseMove,
+		MouseWheel,
+		MouseButtonDown,
+		MouseButtonUp,
+	};
+
+	//One change of an input device.
+	struct InputEvent {
+		//In cs::TimeSpan ticks of InputEvent::Now.
+		longcs Timestamp{ 0 };
+		InputEventType Type{ InputEventType::KeyDown };
+		//The key or the mouse button.
+		intcs Code{ 0 };
+		//The cursor position, or the wheel delta in X.
+		intcs X{ 0 };
+		intcs Y{ 0 };
+
+		//Ticks of a steady clock shared by every producer.
+		static longcs Now() {
+			const auto now = std::chrono::steady_clock::now().time_since_epoch();
+			return std::chrono::duration_cast<std::chrono::duration<longcs, std::ratio<1, 10000000>>>(now).count();
+		}
+
+		static constexpr InputEvent Key(Keys key, bool down, longcs timestamp) {
+			return { timestamp, down ? InputEventType::KeyDown : InputEventType::KeyUp, static_cast<intcs>(key) };
+		}
+
+		static constexpr InputEvent Move(intcs x, intcs y, longcs timestamp) {
+			return { timestamp, InputEventType::MouseMove, 0, x, y };
+		}
+
+		static constexpr InputEvent Wheel(intcs delta, longcs timestamp) {
+			return { timestamp, InputEventType::MouseWheel, 0, delta };
+		}
+
+		static constexpr InputEvent Button(MouseButton button, bool down, longcs timestamp) {
+			return { timestamp, down ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp, static_cast<intcs>(button) };
+		}
+	};
+
+	//Single-producer single-consumer ring of input events, without locks.
+	//The window thread pushes, the game thread pops, in the order they were pushed.
+	class InputEventQueue {
+	public:
+		//A power of two. Far more events than a frame receives.
+		static constexpr size_t Capacity = 1024;
+
+		InputEventQueue() = default;
+		InputEventQueue(InputEventQueue const&) = delete;
+		InputEventQueue& operator=(InputEventQueue const&) = delete;
+
+		//Producer only. Returns false and counts the event as dropped when the queue is full.
+		bool Push(InputEvent const& event) {
+			const auto tail = _tail.load(std::memory_order_relaxed);
+
+			if (tail - _cachedHead >= Capacity) {
+				_cachedHead = _head.load(std::memory_order_acquire);
+
+				if (tail - _cachedHead >= Capacity) {
+					_dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+			}
+
+			_events[tail & Mask] = event;
+			_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		//Consumer only. Takes the oldest event.
+		bool Pop(InputEvent& event) {
+			if (!Peek(event))
+				return false;
+
+			_head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			return true;
+		}
+
+		//Consumer only. Reads the oldest event without taking it.
+		bool Peek(InputEvent& event) {
+			const auto head = _head.load(std::memory_order_relaxed);
+
+			if (head == _cachedTail) {
+				_cachedTail = _tail.load(std::memory_order_acquire);
+
+				if (head == _cachedTail)
+					return false;
+			}
+
+			event = _events[head & Mask];
+			return true;
+		}
+
+		//Events pushed and not popped yet. Exact only on the consumer thread.
+		size_t Size() const {
+			return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+		}
+
+		//Events lost because the queue was full.
+		size_t Dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+	private:
+		static constexpr size_t Mask = Capacity - 1;
+
+		//Each side keeps its own index and a copy of the other on separate cache lines,
+		//so the threads only share a line when the copy runs out.
+		alignas(64) std::atomic<size_t> _head{ 0 };
+		size_t _cachedTail{ 0 };
+		alignas(64) std::atomic<size_t> _tail{ 0 };
+		size_t _cachedHead{ 0 };
+		std::atomic<size_t> _dropped{ 0 };
+		alignas(64) InputEvent _events[Capacity];
+	};
+
+	//Stamps and pushes events. The platform window uses one, and so can any thread
+	//standing in for it, such as a test or a headless run.
+	class InputProducer {
+	public:
+		InputProducer(InputEventQueue& queue) : _queue(&queue) {}
+
+		bool KeyDown(Keys key) { return _queue->Push(InputEvent::Key(key, true, InputEvent::Now())); }
+		bool KeyUp(Keys key) { return _queue->Push(InputEvent::Key(key, false, InputEvent::Now())); }
+		bool MoveMouse(intcs x, intcs y) { return _queue->Push(InputEvent::Move(x, y, InputEvent::Now())); }
+		bool Scroll(intcs delta) { return _queue->Push(InputEvent::Wheel(delta, InputEvent::Now())); }
+		bool Press(MouseButton button) { return _queue->Push(InputEvent::Button(button, true, InputEvent::Now())); }
+		bool Release(MouseButton button) { return _queue->Push(InputEvent::Button(button, false, InputEvent::Now())); }
+
+	private:
+		InputEventQueue* _queue;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "inputrecorder.hpp"
+#include "input.hpp"
+#include "../game.hpp"
+#include <chrono>
+#include <memory>
+
+namespace dxna::input {
+	//The byte opening each frame says what follows it, in this order.
+	//Bits 0 to 3 are set for each keyboard word that changed.
+	static constexpr bytecs MousePositionChanged = 0x10;
+	static constexpr bytecs MouseWheelChanged = 0x20;
+	static constexpr bytecs MouseButtonsChanged = 0x40;
+	static constexpr bytecs ElapsedChanged = 0x80;
+
+	static bytecs buttonMask(MouseState const& mouse) {
+		bytecs mask = 0;
+
+		for (int i = 0; i < 5; ++i) {
+			if (mouse.IsDown(static_cast<MouseButton>(i)))
+				mask |= static_cast<bytecs>(1 << i);
+		}
+
+		return mask;
+	}
+
+	static ButtonState buttonState(bytecs mask, int button) {
+		return (mask & (1 << button)) != 0 ? ButtonState::Pressed : ButtonState::Released;
+	}
+
+	//Reads a little-endian value of size bytes, as BinaryWriter writes them.
+	static bool readValue(cs::Stream& stream, size_t size, ulongcs& value) {
+		bytecs bytes[8];
+
+		if (stream.Read(bytes, 8, 0, static_cast<intcs>(size)) != static_cast<intcs>(size))
+			return false;
+
+		value = 0;
+
+		for (size_t i = 0; i < size; ++i)
+			value |= static_cast<ulongcs>(bytes[i]) << (i * 8);
+
+		return true;
+	}
+
+	InputRecorder::InputRecorder(cs::Stream* stream) : _writer(stream) {
+		_writer.Write(Magic);
+		_writer.Write(Version);
+	}
+
+	Error InputRecorder::Record(GameTime const& gameTime, KeyboardState const& keyboard, MouseState const& mouse) {
+		if (_writer._stream == nullptr)
+			return Error(ErrorCode::CS_STREAM_IS_NULL);
+
+		const auto& words = keyboard.Words();
+		const auto& previousWords = _previous.Keyboard.Words();
+		const auto buttons = buttonMask(mouse);
+		bytecs flags = 0;
+
+		for (size_t i = 0; i < KeyboardState::WordCount; ++i) {
+			if (words[i] != previousWords[i])
+				flags |= static_cast<bytecs>(1 << i);
+		}
+
+		if (mouse.X != _previous.Mouse.X || mouse.Y != _previous.Mouse.Y)
+			flags |= MousePositionChanged;
+
+		if (mouse.Wheel != _previous.Mouse.Wheel)
+			flags |= MouseWheelChanged;
+
+		if (buttons != buttonMask(_previous.Mouse))
+			flags |= MouseButtonsChanged;
+
+		if (gameTime.ElapsedGameTime != _previous.ElapsedGameTime)
+			flags |= ElapsedChanged;
+
+		_writer.Write(flags);
+
+		for (size_t i = 0; i < KeyboardState::WordCount; ++i) {
+			if ((flags & (1 << i)) != 0)
+				_writer.Write(static_cast<ulongcs>(words[i]));
+		}
+
+		if ((flags & MousePositionChanged) != 0) {
+			_writer.Write(static_cast<intcs>(mouse.X));
+			_writer.Write(static_cast<intcs>(mouse.Y));
+		}
+
+		if ((flags & MouseWheelChanged) != 0)
+			_writer.Write(static_cast<longcs>(mouse.Wheel));
+
+		if ((flags & MouseButtonsChanged) != 0)
+			_writer.Write(buttons);
+
+		if ((flags & ElapsedChanged) != 0)
+			_writer.Write(static_cast<longcs>(gameTime.ElapsedGameTime.Ticks()));
+
+		_previous.ElapsedGameTime = gameTime.ElapsedGameTime;
+		_previous.Keyboard = keyboard;
+		_previous.Mouse = mouse;
+		++_frames;
+
+		return NoError;
+	}
+
+	InputReplay::InputReplay(cs::Stream* stream, size_t timeCapacity) :
+		_stream(stream), _frameTimes(timeCapacity) {
+	}
+
+	Error InputReplay::readHeader() {
+		ulongcs magic = 0;
+		ulongcs version = 0;
+
+		if (!readValue(*_stream, 4, magic) || !readValue(*_stream, 4, version))
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		if (magic != InputRecorder::Magic || version != InputRecorder::Version)
+			return Error(ErrorCode::INPUT_BAD_RECORDING);
+
+		_hasHeader = true;
+		return NoError;
+	}
+
+	Error InputReplay::Next(InputRecord& record) {
+		if (_stream == nullptr)
+			return Error(ErrorCode::CS_STREAM_IS_NULL);
+
+		if (!_hasHeader) {
+			const auto error = readHeader();
+
+			if (error.HasError())
+				return error;
+		}
+
+		const auto flags = _stream->ReadByte();
+
+		if (flags < 0)
+			return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+		auto next = _current;
+		auto words = next.Keyboard.Words();
+		ulongcs value = 0;
+
+		for (size_t i = 0; i < KeyboardState::WordCount; ++i) {
+			if ((flags & (1 << i)) == 0)
+				continue;
+
+			if (!readValue(*_stream, 8, value))
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			words[i] = value;
+		}
+
+		if ((flags & MousePositionChanged) != 0) {
+			ulongcs y = 0;
+
+			if (!readValue(*_stream, 4, value) || !readValue(*_stream, 4, y))
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			next.Mouse.X = static_cast<intcs>(static_cast<uintcs>(value));
+			next.Mouse.Y = static_cast<intcs>(static_cast<uintcs>(y));
+		}
+
+		if ((flags & MouseWheelChanged) != 0) {
+			if (!readValue(*_stream, 8, value))
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			next.Mouse.Wheel = static_cast<longcs>(value);
+		}
+
+		if ((flags & MouseButtonsChanged) != 0) {
+			if (!readValue(*_stream, 1, value))
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			const auto mask = static_cast<bytecs>(value);
+			next.Mouse.Left = buttonState(mask, 0);
+			next.Mouse.Right = buttonState(mask, 1);
+			next.Mouse.Middle = buttonState(mask, 2);
+			next.Mouse.X1 = buttonState(mask, 3);
+			next.Mouse.X2 = buttonState(mask, 4);
+		}
+
+		if ((flags & ElapsedChanged) != 0) {
+			if (!readValue(*_stream, 8, value))
+				return Error(ErrorCode::CS_STREAM_ENDOFFILE);
+
+			next.ElapsedGameTime = cs::TimeSpan(static_cast<longcs>(value));
+		}
+
+		next.Keyboard = KeyboardState::FromWords(words);
+		_current = next;
+		record = next;
+		++_frames;
+
+		return NoError;
+	}
+
+	void InputReplay::Push(InputRecord const& record, InputEventQueue& queue) {
+		const auto timestamp = InputEvent::Now();
+		const auto pressed = KeyboardState::Pressed(record.Keyboard, _pushed.Keyboard);
+		const auto released = KeyboardState::Released(record.Keyboard, _pushed.Keyboard);
+		Keys keys[KeyboardState::KeyCount];
+
+		for (size_t i = 0, count = released.GetPressedKeys(keys); i < count; ++i)
+			queue.Push(InputEvent::Key(keys[i], false, timestamp));
+
+		for (size_t i = 0, count = pressed.GetPressedKeys(keys); i < count; ++i)
+			queue.Push(InputEvent::Key(keys[i], true, timestamp));
+
+		const auto& mouse = record.Mouse;
+		const auto& previous = _pushed.Mouse;
+
+		if (mouse.X != previous.X || mouse.Y != previous.Y)
+			queue.Push(InputEvent::Move(mouse.X, mouse.Y, timestamp));
+
+		if (mouse.Wheel != previous.Wheel)
+			queue.Push(InputEvent::Wheel(static_cast<intcs>(mouse.Wheel - previous.Wheel), timestamp));
+
+		for (int i = 0; i < 5; ++i) {
+			const auto button = static_cast<MouseButton>(i);
+
+			if (mouse.IsDown(button) != previous.IsDown(button))
+				queue.Push(InputEvent::Button(button, mouse.IsDown(button), timestamp));
+		}
+
+		_pushed = record;
+	}
+
+	Error InputReplay::Run(Game& game, ulongcs maxFrames) {
+		const auto clock = std::make_shared<ManualGameClock>();
+
+		game.Clock(clock);
+		game.IsFixedTimeStep(true);
+
+		//The first frame is pushed as the changes from the input as it is now, with the
+		//events still queued applied, so the replay starts from the recorded keys, buttons
+		//and wheel whatever an earlier run left held.
+		Input::Update();
+		_pushed.Keyboard = Input::Frame().GetKeyboardState();
+		_pushed.Mouse = Input::Frame().GetMouseState();
+
+		InputRecord record;
+
+		for (ulongcs frame = 0; frame < maxFrames && !game.IsExiting(); ++frame) {
+			const auto error = Next(record);
+
+			if (error == ErrorCode::CS_STREAM_ENDOFFILE)
+				break;
+
+			if (error.HasError())
+				return error;
+
+			//Each recorded update becomes one step of its own length.
+			if (record.ElapsedGameTime > cs::TimeSpan::Zero())
+				game.TargetElapsedTime(record.ElapsedGameTime);
+
+			Push(record, Input::Queue());
+			clock->Advance(record.ElapsedGameTime);
+
+			const auto start = std::chrono::steady_clock::now();
+			game.RunOneFrame();
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+
+			_frameTimes.AddFrame(cs::TimeSpan(static_cast<longcs>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 100)));
+		}
+
+		return NoError;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef DXNA_INPUT_INPUTRECORDER_HPP
+#define DXNA_INPUT_INPUTRECORDER_HPP
+
+#include <limits>
+#include "keyboard.hpp"
+#include "mouse.hpp"
+#include "inputqueue.hpp"
+#include "../error.hpp"
+#include "../gametime.hpp"
+#include "../framestatistics.hpp"
+#include "../cs/stream.hpp"
+#include "../cs/binary.hpp"
+
+namespace dxna {
+	class Game;
+}
+
+namespace dxna::input {
+	//The input state of one frame, with the time the frame covered.
+	struct InputRecord {
+		cs::TimeSpan ElapsedGameTime{ cs::TimeSpan::Zero() };
+		KeyboardState Keyboard;
+		MouseState Mouse;
+	};
+
+	//Writes the input of every frame to a stream, as the changes from the frame before.
+	//A frame where nothing changed takes one byte.
+	class InputRecorder {
+	public:
+		//"DXIR"
+		static constexpr uintcs Magic = 0x52495844;
+		static constexpr uintcs Version = 1;
+
+		//Writes the header. The stream must outlive the recorder.
+		InputRecorder(cs::Stream* stream);
+
+		Error Record(GameTime const& gameTime, KeyboardState const& keyboard, MouseState const& mouse);
+
+		//Records the current Keyboard and Mouse state. Call it once per Update.
+		Error Record(GameTime const& gameTime) {
+			return Record(gameTime, Keyboard::GetState(), Mouse::GetState());
+		}
+
+		ulongcs Frames() const { return _frames; }
+
+	private:
+		cs::BinaryWriter _writer;
+		InputRecord _previous;
+		ulongcs _frames{ 0 };
+	};
+
+	//Reads a recording back, frame by frame.
+	class InputReplay {
+	public:
+		//Ten minutes of frame times at 60 frames a second.
+		static constexpr size_t DefaultTimeCapacity = 36000;
+
+		//The stream must outlive the replay.
+		InputReplay(cs::Stream* stream, size_t timeCapacity = DefaultTimeCapacity);
+
+		//Reads the next frame. Fails with CS_STREAM_ENDOFFILE after the last one.
+		Error Next(InputRecord& record);
+
+		//Pushes the changes from the previously pushed frame to the queue as events.
+		//Before the first push, that is the default state: no keys or buttons down
+		//and the wheel at zero.
+		void Push(InputRecord const& record, InputEventQueue& queue);
+
+		//Replays up to maxFrames frames into the game, without a window: each frame
+		//pushes its input to Input::Queue and runs one Game::RunOneFrame on a
+		//ManualGameClock advanced by the recorded time, at a fixed time step.
+		//The input is replayed from the shared state as Run finds it, so each update sees
+		//the recorded state even after another run. The wall time of every frame goes to FrameTimes.
+		Error Run(Game& game, ulongcs maxFrames = std::numeric_limits<ulongcs>::max());
+
+		ulongcs Frames() const { return _frames; }
+
+		//How long each replayed frame took to run.
+		dxna::FrameStatistics const& FrameTimes() const { return _frameTimes; }
+
+	private:
+		Error readHeader();
+
+		cs::Stream* _stream;
+		InputRecord _current;
+		InputRecord _pushed;
+		ulongcs _frames{ 0 };
+		bool _hasHeader{ false };
+		dxna::FrameStatistics _frameTimes;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef DXNA_INPUT_INPUTSNAPSHOT_HPP
+#define DXNA_INPUT_INPUTSNAPSHOT_HPP
+
+#include <array>
+#include <cstdint>
+#include <bit>
+#include <span>
+#include "keyboard.hpp"
+#include "mouse.hpp"
+#include "gamepad.hpp"
+#include "../cs/cstypes.hpp"
+
+namespace dxna::input {
+	//A key, a mouse button or a pad button, numbered in a single space so the input of a frame is one bitset.
+	struct InputControl {
+		static constexpr ushortcs MouseButtonBase = 256;
+		//Sixteen ButtonValues bits per pad.
+		static constexpr ushortcs GamePadButtonBase = 320;
+		//A control that is never down, for unused binding slots.
+		static constexpr ushortcs NeverIndex = 511;
+
+		ushortcs Index{ NeverIndex };
+
+		static constexpr InputControl Key(Keys key) { return { static_cast<ushortcs>(static_cast<size_t>(key) & 255) }; }
+		static constexpr InputControl Button(MouseButton button) { return { static_cast<ushortcs>(MouseButtonBase + static_cast<ushortcs>(button)) }; }
+		static constexpr InputControl GamePadButton(PlayerIndex player, ButtonValues button) {
+			return { static_cast<ushortcs>(GamePadButtonBase + static_cast<ushortcs>(player) * 16
+				+ std::countr_zero(static_cast<ushortcs>(button))) };
+		}
+		static constexpr InputControl Never() { return {}; }
+
+		constexpr bool operator==(InputControl const& other) const = default;
+	};
+
+	//An analog input, read as a float.
+	enum class InputAxis : bytecs {
+		//Always zero, for unused binding slots.
+		None,
+		//Cursor movement since the previous frame, in pixels.
+		MouseX,
+		MouseY,
+		//Wheel movement since the previous frame, in notches of 120.
+		MouseWheel,
+		//Six axes per pad, in GamePadAxis order. See GamePadInput.
+		GamePad,
+	};
+
+	enum class GamePadAxis : bytecs {
+		LeftX,
+		LeftY,
+		RightX,
+		RightY,
+		LeftTrigger,
+		RightTrigger
+	};
+
+	//The InputAxis of an axis of a pad.
+	constexpr InputAxis GamePadInput(PlayerIndex player, GamePadAxis axis) {
+		return static_cast<InputAxis>(static_cast<size_t>(InputAxis::GamePad) + static_cast<size_t>(player) * 6 + static_cast<size_t>(axis));
+	}
+
+	//Every control and axis of one frame.
+	struct InputSnapshot {
+		static constexpr size_t ControlCount = 512;
+		static constexpr size_t WordCount = ControlCount / 64;
+		static constexpr size_t AxisCount = 64;
+
+		std::array<uint64_t, WordCount> Controls{};
+		std::array<float, AxisCount> Axes{};
+
+		constexpr bool IsDown(InputControl control) const {
+			return ((Controls[control.Index >> 6] >> (control.Index & 63)) & 1) != 0;
+		}
+
+		constexpr void Set(InputControl control, bool down) {
+			if (control.Index >= InputControl::NeverIndex)
+				return;
+
+			const auto bit = uint64_t{ 1 } << (control.Index & 63);
+			Controls[control.Index >> 6] = down ? Controls[control.Index >> 6] | bit : Controls[control.Index >> 6] & ~bit;
+		}
+
+		constexpr float Axis(InputAxis axis) const { return Axes[static_cast<size_t>(axis)]; }
+
+		//The snapshot of the keyboard, the mouse and up to GamePad::MaxCount pads, with the mouse
+		//movement measured from previousMouse.
+		static constexpr InputSnapshot Capture(KeyboardState const& keyboard, MouseState const& mouse, MouseState const& previousMouse,
+			std::span<GamePadState const> gamePads = {}) {
+			InputSnapshot snapshot;
+			const auto& words = keyboard.Words();
+
+			for (size_t i = 0; i < KeyboardState::WordCount; ++i)
+				snapshot.Controls[i] = words[i];
+
+			for (ushortcs i = 0; i < 5; ++i) {
+				const auto button = static_cast<MouseButton>(i);
+				snapshot.Set(InputControl::Button(button), mouse.IsDown(button));
+			}
+
+			snapshot.Axes[static_cast<size_t>(InputAxis::MouseX)] = static_cast<float>(mouse.X - previousMouse.X);
+			snapshot.Axes[static_cast<size_t>(InputAxis::MouseY)] = static_cast<float>(mouse.Y - previousMouse.Y);
+			snapshot.Axes[static_cast<size_t>(InputAxis::MouseWheel)] = static_cast<float>(mouse.Wheel - previousMouse.Wheel) / 120.0F;
+
+			for (size_t i = 0; i < gamePads.size() && i < GamePad::MaxCount; ++i) {
+				const auto& pad = gamePads[i];
+				const auto player = static_cast<PlayerIndex>(i);
+				const auto first = InputControl::GamePadButtonBase + i * 16;
+
+				snapshot.Controls[first >> 6] |= static_cast<uint64_t>(pad.Buttons) << (first & 63);
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::LeftX))] = pad.ThumbSticks.Left.X;
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::LeftY))] = pad.ThumbSticks.Left.Y;
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::RightX))] = pad.ThumbSticks.Right.X;
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::RightY))] = pad.ThumbSticks.Right.Y;
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::LeftTrigger))] = pad.Triggers.Left;
+				snapshot.Axes[static_cast<size_t>(GamePadInput(player, GamePadAxis::RightTrigger))] = pad.Triggers.Right;
+			}
+
+			return snapshot;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
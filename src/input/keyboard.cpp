@@ -1,5 +1,5 @@
 #include "keyboard.hpp"
 
 namespace dxna::input {
-	std::vector<bool> Keyboard::flags = std::vector<bool>(255);
+	KeyboardState Keyboard::state;
 }
\ No newline at end of file
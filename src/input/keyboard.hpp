@@ -2,48 +2,60 @@
 #define DXNA_NPUT_KEYBOARD_HPP
 
 #include "keys.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
 #include <vector>
 
 namespace dxna::input {
 	struct Keyboard;
+	class InputFrame;
 
 	struct KeyboardState {	
-		//Para acesso amigo a funo interna AddPressedKey
+		//Para acesso amigo a funo interna setKey
 		friend struct Keyboard;
+		friend class InputFrame;
+
+		static constexpr size_t KeyCount = 256;
+		static constexpr size_t WordCount = KeyCount / 64;
+
 		constexpr KeyboardState() = default;
 
+		//The state with the given keys down.
+		constexpr KeyboardState(std::initializer_list<Keys> keys) {
+			for (const auto key : keys)
+				setKey(static_cast<size_t>(key), true);
+		}
+
+		constexpr KeyboardState(std::span<Keys const> keys) {
+			for (const auto key : keys)
+				setKey(static_cast<size_t>(key), true);
+		}
+
 		//Obtm TRUE caso a tecla informada esteja pressionada.
 		constexpr bool IsKeyDown(Keys const& key) const {
-			if (index < 0)
-				return false;	
-
-			return checkSlots((int)key);
+			return IsKeyDown(static_cast<size_t>(key));
 		}
 
 		//Obtm TRUE caso a tecla informada esteja pressionada.
-		bool constexpr IsKeyDown(size_t vkkey) const {
-			if (index < 0)
+		constexpr bool IsKeyDown(size_t vkkey) const {
+			if (vkkey >= KeyCount)
 				return false;
 
-			return checkSlots(static_cast<int>(vkkey));
-
-			return false;
+			return ((_words[vkkey >> 6] >> (vkkey & 63)) & 1) != 0;
 		}
 
 		//Obtm TRUE caso a tecla informada esteja liberada.
 		constexpr bool IsKeyUp(Keys const& key) const {		
-			if (index < 0)
-				return true;
-
-			return !checkSlots((int)key);
+			return !IsKeyDown(key);
 		}
 
 		//Obtm TRUE caso a tecla informada esteja liberada.
 		constexpr bool IsKeyUp(size_t vkkey) const {
-			if (index == 0)
-				return true;			
-
-			return !checkSlots((int)vkkey);
+			return !IsKeyDown(vkkey);
 		}
 
 		//Operador para acesso direto para verificar se uma tecla est pressionada
@@ -54,132 +66,141 @@ namespace dxna::input {
 		//Operador para acesso direto para verificar se uma tecla est pressionada
 		constexpr KeyState operator[](size_t const& vkkey) const {
 			return IsKeyDown(vkkey) ? KeyState::Down : KeyState::Up;
-		}					
+		}
+
+		constexpr bool operator==(KeyboardState const& other) const = default;
+
+		//The number of keys down.
+		constexpr size_t GetPressedKeyCount() const {
+			size_t count = 0;
+
+			for (const auto word : _words)
+				count += static_cast<size_t>(std::popcount(word));
 
-	private:		
-		constexpr bool checkSlots(int const& value) const {
-			return value == slot0 || value == slot1
-				|| value == slot2 || value == slot3
-				|| value == slot4 || value == slot5
-				|| value == slot6 || value == slot7
-				|| value == slot8 || value == slot9;
+			return count;
 		}
 
-		//Internal: Adiciona teclas pressionadas ao estado atual, com o mximo de 10 registros.
-		//Retorna true caso a operao seja bem sucedida ou no exceda os 10 registros.
-		constexpr bool AddPressedKey(size_t const& vkkey) {
-			++index;
+		//Writes the keys down, in ascending order, to keys and returns how many there are.
+		//Keys beyond the size of the span are not written.
+		constexpr size_t GetPressedKeys(std::span<Keys> keys) const {
+			size_t count = 0;
 
-			if (index == MAX_KEYS)
-				return false;
+			for (size_t i = 0; i < WordCount; ++i) {
+				for (auto word = _words[i]; word != 0; word &= word - 1) {
+					if (count < keys.size())
+						keys[count] = static_cast<Keys>(i * 64 + static_cast<size_t>(std::countr_zero(word)));
 
-			switch (index)
-			{
-			case 0:
-				slot0 = static_cast<int>(vkkey);
-				break;
-			case 1:
-				slot1 = static_cast<int>(vkkey);
-				break;
-			case 2:
-				slot2 = static_cast<int>(vkkey);
-				break;
-			case 3:
-				slot3 = static_cast<int>(vkkey);
-				break;
-			case 4:
-				slot4 = static_cast<int>(vkkey);
-				break;
-			case 5:
-				slot5 = static_cast<int>(vkkey);
-				break;
-			case 6:
-				slot6 = static_cast<int>(vkkey);
-				break;
-			case 7:
-				slot7 = static_cast<int>(vkkey);
-				break;
-			case 8:
-				slot8 = static_cast<int>(vkkey);
-				break;
-			case 9:
-				slot9 = static_cast<int>(vkkey);
-				break;
-			default:
-				return false;
+					++count;
+				}
 			}
 
-			return true;
-		}
-
-		static constexpr int MAX_KEYS = 10;
-		
-		int index{ -1 };		
-		int slot0{ -1 };
-		int slot1{ -1 };
-		int slot2{ -1 };
-		int slot3{ -1 };
-		int slot4{ -1 };
-		int slot5{ -1 };
-		int slot6{ -1 };
-		int slot7{ -1 };
-		int slot8{ -1 };
-		int slot9{ -1 };
+			return count;
+		}
+
+		std::vector<Keys> GetPressedKeys() const {
+			std::vector<Keys> keys(GetPressedKeyCount());
+			GetPressedKeys(keys);
+			return keys;
+		}
+
+		//The keys down in current and up in previous.
+		static constexpr KeyboardState Pressed(KeyboardState const& current, KeyboardState const& previous) {
+			KeyboardState state;
+
+			for (size_t i = 0; i < WordCount; ++i)
+				state._words[i] = current._words[i] & ~previous._words[i];
+
+			return state;
+		}
+
+		//The keys up in current and down in previous.
+		static constexpr KeyboardState Released(KeyboardState const& current, KeyboardState const& previous) {
+			return Pressed(previous, current);
+		}
+
+		//Whether the key is down now and was up in the previous state.
+		constexpr bool WasJustPressed(Keys const& key, KeyboardState const& previous) const {
+			return IsKeyDown(key) && !previous.IsKeyDown(key);
+		}
+
+		//Whether the key is up now and was down in the previous state.
+		constexpr bool WasJustReleased(Keys const& key, KeyboardState const& previous) const {
+			return !IsKeyDown(key) && previous.IsKeyDown(key);
+		}
+
+		//Whether any key of mask is down, one AND per word.
+		constexpr bool IsAnyKeyDown(KeyboardState const& mask) const {
+			uint64_t any = 0;
+
+			for (size_t i = 0; i < WordCount; ++i)
+				any |= _words[i] & mask._words[i];
+
+			return any != 0;
+		}
+
+		//The bits of the keys down, key k being bit k % 64 of word k / 64.
+		constexpr std::array<uint64_t, WordCount> const& Words() const { return _words; }
+
+		static constexpr KeyboardState FromWords(std::array<uint64_t, WordCount> const& words) {
+			KeyboardState state;
+			state._words = words;
+			return state;
+		}
+
+	private:
+		constexpr void setKey(size_t vkkey, bool down) {
+			if (vkkey >= KeyCount)
+				return;
+
+			const auto bit = uint64_t{ 1 } << (vkkey & 63);
+
+			if (down)
+				_words[vkkey >> 6] |= bit;
+			else
+				_words[vkkey >> 6] &= ~bit;
+		}
+
+		std::array<uint64_t, WordCount> _words{};
 	};
 
 	struct Keyboard {
 		//Obtm o estado atual do teclado.
 		static KeyboardState GetState() {	
-			KeyboardState state;				
-
-			for (size_t i = 0; i < 255; ++i) {
-				if (flags[i]) {					
-					const auto result = state.AddPressedKey(i);					
-
-					if (!result)
-						break;
-				}
-			}				
-
 			return state;
 		}
 
 		//Obtm TRUE caso a tecla informada esteja pressionada.
-		static constexpr bool IsKeyDown(Keys const& key) {
-			return flags[(int)key];
+		static bool IsKeyDown(Keys const& key) {
+			return state.IsKeyDown(key);
 		}
 
 		//Obtm TRUE caso a tecla informada esteja pressionada.
-		bool constexpr IsKeyDown(size_t vkkey) const {
-			if (vkkey > 255)
-				return false;
-
-			return flags[vkkey];
+		static bool IsKeyDown(size_t vkkey) {
+			return state.IsKeyDown(vkkey);
 		}
 
 		//Obtm TRUE caso a tecla informada esteja liberada.
-		static constexpr bool IsKeyUp(Keys const& key) {
-			return !flags[static_cast<int>(key)];
+		static bool IsKeyUp(Keys const& key) {
+			return state.IsKeyUp(key);
 		}
 
 		//Obtm TRUE caso a tecla informada esteja liberada.
-		static constexpr bool IsKeyUp(size_t vkkey) {
-			if (vkkey > 255)
-				return false;
-
-			return !flags[vkkey];
+		static bool IsKeyUp(size_t vkkey) {
+			return state.IsKeyUp(vkkey);
 		}
 
 		//Define uma flag de teclado.
-		static constexpr void SetFlag(size_t vkkey, bool value) {
-			if (vkkey > 255)
-				return;
+		static void SetFlag(size_t vkkey, bool value) {
+			state.setKey(vkkey, value);
+		}
 
-			flags[vkkey] = value;
+		//Replaces the whole state, as Input::Update does every frame.
+		static void SetState(KeyboardState const& value) {
+			state = value;
 		}
 
 	private:
-		static std::vector<bool> flags;
+		static KeyboardState state;
 
 		//Esconde construtores para transformar a classe em esttica.
 		constexpr Keyboard() = default;
@@ -188,4 +209,4 @@ namespace dxna::input {
 	};
 }
 
-#endif
+#endif
\ No newline at end of file
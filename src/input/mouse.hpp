@@ -61,17 +61,19 @@ namespace dxna::input {
 			default:
 				return false;
 			}
-		}		
+		}
+
+		constexpr bool operator==(MouseState const& other) const = default;
 	};
 
 	struct Mouse {
 		//Obtm o estado atual do teclado.
-		static constexpr MouseState GetState() {
+		static MouseState GetState() {
 			return MouseState(X, Y, Wheel, Left, Right, Middle, X1, X2);
 		}		
 
 		//Obtm TRUE caso o boto informado estaja pressionado.
-		static constexpr bool IsDown(MouseButton const& button) {
+		static bool IsDown(MouseButton const& button) {
 			switch (button)
 			{
 			case MouseButton::Left:
@@ -90,7 +92,7 @@ namespace dxna::input {
 		}
 
 		//Obtm TRUE caso o boto informado estaja liberado.
-		static constexpr bool IsUp(MouseButton const& button) {					
+		static bool IsUp(MouseButton const& button) {					
 			switch (button)
 			{
 			case MouseButton::Left:
@@ -0,0 +1,190 @@
+#include "jobsystem.hpp"
+#include "profiler.hpp"
+
+namespace dxna {
+	struct JobSystem::Worker {
+		JobSystem* Owner{ nullptr };
+		size_t Index{ 0 };
+		WorkStealingQueue<Job, JobPoolSize> Queue;
+		std::unique_ptr<Job[]> Jobs{ new Job[JobPoolSize] };
+		size_t NextJob{ 0 };
+		//Picks the first victim to steal from, so thieves spread over the workers.
+		uint32_t Random{ 0 };
+	};
+
+	thread_local JobSystem::Worker* JobSystem::_currentWorker = nullptr;
+
+	size_t JobSystem::DefaultWorkerCount() {
+		const auto threads = static_cast<size_t>(std::thread::hardware_concurrency());
+		return threads > 1 ? threads - 1 : 1;
+	}
+
+	JobSystem::JobSystem(size_t workerCount) {
+		for (size_t i = 0; i < workerCount; ++i) {
+			auto worker = std::make_unique<Worker>();
+			worker->Owner = this;
+			worker->Index = i;
+			worker->Random = static_cast<uint32_t>(i * 2654435761u + 1);
+			_workers.push_back(std::move(worker));
+		}
+
+		for (size_t i = 0; i < workerCount; ++i)
+			_threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+
+	JobSystem::~JobSystem() {
+		_running.store(false, std::memory_order_release);
+		_queued.fetch_add(1, std::memory_order_release);
+		_queued.notify_all();
+
+		for (auto& thread : _threads)
+			thread.join();
+
+		//Jobs nobody waited for still run, so their callables are destroyed.
+		while (TryRunOne()) {}
+	}
+
+	JobSystem& JobSystem::Shared() {
+		static JobSystem system;
+		return system;
+	}
+
+	JobSystem::Worker* JobSystem::current() const {
+		return _currentWorker != nullptr && _currentWorker->Owner == this ? _currentWorker : nullptr;
+	}
+
+	Job* JobSystem::allocate() {
+		auto worker = current();
+
+		if (worker == nullptr) {
+			auto job = new Job();
+			job->Detached = true;
+			return job;
+		}
+
+		//Slots are reused in order; a slot still in flight is skipped,
+		//and when all are, pending jobs are run until one frees up.
+		for (;;) {
+			for (size_t i = 0; i < JobPoolSize; ++i) {
+				auto& job = worker->Jobs[worker->NextJob++ & (JobPoolSize - 1)];
+
+				if (!job.InUse.load(std::memory_order_acquire)) {
+					job.InUse.store(true, std::memory_order_relaxed);
+					return &job;
+				}
+			}
+
+			if (!TryRunOne())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::submit(Job* job) {
+		auto worker = current();
+
+		if (worker != nullptr) {
+			//A full deque runs the job right away, which also bounds the recursion of spawning jobs.
+			if (!worker->Queue.Push(job)) {
+				execute(*job);
+				return;
+			}
+		}
+		else {
+			std::lock_guard<std::mutex> lock(_sharedMutex);
+			_shared.push_back(job);
+		}
+
+		_queued.fetch_add(1, std::memory_order_release);
+		_queued.notify_one();
+	}
+
+	Job* JobSystem::take(Worker* worker) {
+		Job* job = nullptr;
+
+		if (worker != nullptr)
+			job = worker->Queue.Pop();
+
+		if (job == nullptr && _queued.load(std::memory_order_acquire) > 0) {
+			{
+				std::lock_guard<std::mutex> lock(_sharedMutex);
+
+				if (!_shared.empty()) {
+					job = _shared.front();
+					_shared.pop_front();
+				}
+			}
+
+			const auto count = _workers.size();
+			auto victim = worker != nullptr ? (worker->Random = worker->Random * 1664525u + 1013904223u) : 0u;
+
+			for (size_t i = 0; i < count && job == nullptr; ++i) {
+				auto& other = _workers[(victim + i) % count];
+
+				if (other.get() != worker)
+					job = other->Queue.Steal();
+			}
+		}
+
+		if (job != nullptr)
+			_queued.fetch_sub(1, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	void JobSystem::execute(Job& job) {
+		const auto counter = job.Counter;
+
+		{
+			DXNA_PROFILE_SCOPE("Job");
+			job.Function(job);
+		}
+
+		if (job.Detached)
+			delete &job;
+		else
+			job.InUse.store(false, std::memory_order_release);
+
+		counter->_pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool JobSystem::TryRunOne() {
+		auto job = take(current());
+
+		if (job == nullptr)
+			return false;
+
+		execute(*job);
+		return true;
+	}
+
+	void JobSystem::Wait(JobCounter const& counter) {
+		while (!counter.IsDone()) {
+			if (!TryRunOne())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::workerLoop(size_t index) {
+		auto worker = _workers[index].get();
+		_currentWorker = worker;
+		DXNA_PROFILE_THREAD("dxna worker");
+
+		while (_running.load(std::memory_order_acquire)) {
+			if (auto job = take(worker)) {
+				execute(*job);
+				continue;
+			}
+
+			//Sleeps until a job is queued. A count above zero means a job is being
+			//pushed or stolen right now, so it is worth looking again.
+			const auto queued = _queued.load(std::memory_order_acquire);
+
+			if (queued <= 0)
+				_queued.wait(queued, std::memory_order_acquire);
+			else
+				std::this_thread::yield();
+		}
+
+		_currentWorker = nullptr;
+	}
+}
\ No newline at end of file
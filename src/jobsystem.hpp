@@ -0,0 +1,164 @@
+#ifndef DXNA_JOBSYSTEM_HPP
+#define DXNA_JOBSYSTEM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include "workstealingqueue.hpp"
+
+namespace dxna {
+	//Counts the unfinished jobs of a group.
+	//A job may start more jobs on the counter it runs under, so waiting on a counter
+	//also waits for the children of its jobs.
+	class JobCounter {
+	public:
+		JobCounter() = default;
+		JobCounter(JobCounter const&) = delete;
+		JobCounter& operator=(JobCounter const&) = delete;
+
+		bool IsDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+		size_t Pending() const { return static_cast<size_t>(_pending.load(std::memory_order_relaxed)); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<int64_t> _pending{ 0 };
+	};
+
+	//A unit of work. Callables that fit in Storage are kept in place, larger ones on the heap.
+	struct Job {
+		static constexpr size_t StorageSize = 48;
+
+		//Runs the callable and destroys it.
+		void (*Function)(Job& job) { nullptr };
+		JobCounter* Counter{ nullptr };
+		std::atomic<bool> InUse{ false };
+		//Allocated by a thread outside the system, deleted after it runs.
+		bool Detached{ false };
+		alignas(std::max_align_t) unsigned char Storage[StorageSize];
+	};
+
+	//Work-stealing scheduler over a fixed set of worker threads.
+	//Each worker owns a lock-free deque: jobs started from a worker go to its deque,
+	//idle workers steal from the others. Jobs started from other threads go through a
+	//shared queue. Wait runs jobs instead of blocking, so waits may nest inside jobs.
+	class JobSystem {
+	public:
+		//Jobs a worker may have in flight before it reuses a slot, a power of two.
+		static constexpr size_t JobPoolSize = 4096;
+
+		//One worker per hardware thread, minus the thread that waits.
+		static size_t DefaultWorkerCount();
+
+		//With no workers every job runs on the thread that waits for it.
+		JobSystem(size_t workerCount = DefaultWorkerCount());
+		~JobSystem();
+
+		JobSystem(JobSystem const&) = delete;
+		JobSystem& operator=(JobSystem const&) = delete;
+
+		//A system shared by the engine, created on first use.
+		static JobSystem& Shared();
+
+		size_t WorkerCount() const { return _workers.size(); }
+
+		//Starts func() as a job of the counter.
+		template <typename TFunc>
+		void Run(JobCounter& counter, TFunc&& func) {
+			using Callable = std::decay_t<TFunc>;
+
+			auto job = allocate();
+			job->Counter = &counter;
+
+			if constexpr (sizeof(Callable) <= Job::StorageSize && alignof(Callable) <= alignof(std::max_align_t)) {
+				new (job->Storage) Callable(std::forward<TFunc>(func));
+				job->Function = [](Job& job) {
+					auto callable = std::launder(reinterpret_cast<Callable*>(job.Storage));
+					(*callable)();
+					callable->~Callable();
+				};
+			}
+			else {
+				auto callable = new Callable(std::forward<TFunc>(func));
+				std::memcpy(job->Storage, &callable, sizeof(callable));
+				job->Function = [](Job& job) {
+					Callable* callable;
+					std::memcpy(&callable, job.Storage, sizeof(callable));
+					(*callable)();
+					delete callable;
+				};
+			}
+
+			counter._pending.fetch_add(1, std::memory_order_relaxed);
+			submit(job);
+		}
+
+		//Runs pending jobs on the calling thread until every job of the counter has finished.
+		void Wait(JobCounter const& counter);
+
+		//Runs one pending job on the calling thread, if any. Lets a scheduler of its own,
+		//such as a coroutine loop, make progress while polling JobCounter::IsDone.
+		bool TryRunOne();
+
+		//Calls func(first, last) over consecutive ranges covering [begin, end) in parallel,
+		//and returns when all of them are done. A grain size of zero splits the range
+		//in a few chunks per thread.
+		template <typename TFunc>
+		void ParallelFor(size_t begin, size_t end, TFunc&& func, size_t grainSize = 0) {
+			if (end <= begin)
+				return;
+
+			const auto count = end - begin;
+			const auto chunks = grainSize > 0
+				? (count + grainSize - 1) / grainSize
+				: std::min(count, (_workers.size() + 1) * 4);
+
+			if (chunks <= 1) {
+				func(begin, end);
+				return;
+			}
+
+			const auto size = (count + chunks - 1) / chunks;
+			JobCounter counter;
+
+			for (auto first = begin + size; first < end; first += size) {
+				const auto last = std::min(first + size, end);
+				Run(counter, [&func, first, last] { func(first, last); });
+			}
+
+			//The caller takes the first chunk instead of idling.
+			func(begin, std::min(begin + size, end));
+			Wait(counter);
+		}
+
+	private:
+		struct Worker;
+
+		Job* allocate();
+		void submit(Job* job);
+		Job* take(Worker* worker);
+		void execute(Job& job);
+		void workerLoop(size_t index);
+		Worker* current() const;
+
+		static thread_local Worker* _currentWorker;
+
+		std::vector<std::unique_ptr<Worker>> _workers;
+		std::vector<std::thread> _threads;
+		std::mutex _sharedMutex;
+		std::deque<Job*> _shared;
+		std::atomic<int64_t> _queued{ 0 };
+		std::atomic<bool> _running{ true };
+	};
+}
+
+#endif
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include <iostream>
 #include "main.hpp"
 #include "cs/cs.hpp"
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <sstream>
 #include <string>
 #include <cstdio>
@@ -54,11 +56,18 @@ void Write(Stream* fs)
 	writer.Write(s);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+#ifdef _WIN32
 	SetConsoleOutputCP(CP_UTF8);
+#endif
 	setvbuf(stdout, nullptr, _IONBF, 0);
 
-	FileStream fs("D:/file4.bin");
+	if (argc < 2) {
+		cout << "usage: dxna <file>" << endl;
+		return 1;
+	}
+
+	FileStream fs(argv[1]);
 	cout << "length: " << fs.Length() << endl;
 
 	auto a = dynamic_cast<Stream*>(&fs);
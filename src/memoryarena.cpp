@@ -0,0 +1,132 @@
+#include "memoryarena.hpp"
+#include <algorithm>
+
+namespace dxna {
+	//Chunks start on a cache line.
+	static constexpr size_t ChunkAlignment = 64;
+
+	static std::byte* newChunk(size_t size) {
+		return static_cast<std::byte*>(::operator new(size, std::align_val_t(ChunkAlignment)));
+	}
+
+	static void deleteChunk(std::byte* data) {
+		::operator delete(data, std::align_val_t(ChunkAlignment));
+	}
+
+	MemoryArena::MemoryArena(size_t chunkSize) :
+		_chunkSize(std::max<size_t>(chunkSize, ChunkAlignment)) {
+	}
+
+	MemoryArena::~MemoryArena() {
+		freeChunks();
+	}
+
+	void MemoryArena::freeChunks() {
+		for (auto& chunk : _chunks)
+			deleteChunk(chunk.Data);
+
+		_chunks.clear();
+		_current = 0;
+		_usedBefore = 0;
+		_cursor = nullptr;
+		_end = nullptr;
+	}
+
+	void MemoryArena::useChunk(size_t index, size_t offset) {
+		_current = index;
+		_cursor = _chunks[index].Data + offset;
+		_end = _chunks[index].Data + _chunks[index].Size;
+	}
+
+	size_t MemoryArena::used() const {
+		return _cursor == nullptr ? 0 : _usedBefore + static_cast<size_t>(_cursor - _chunks[_current].Data);
+	}
+
+	void* MemoryArena::allocateChunk(size_t size, size_t alignment) {
+		//The worst case padding to reach the alignment from the start of a chunk.
+		const auto needed = size + (alignment > ChunkAlignment ? alignment - ChunkAlignment : 0);
+
+		_highWaterMark = std::max(_highWaterMark, used());
+
+		//Moves on to the next kept chunk if it is large enough, otherwise puts a new one before it.
+		size_t next = _cursor == nullptr ? 0 : _current + 1;
+
+		if (_cursor != nullptr)
+			_usedBefore += _chunks[_current].Size;
+
+		if (next >= _chunks.size() || _chunks[next].Size < needed) {
+			Chunk chunk;
+			chunk.Size = std::max(_chunkSize, needed);
+			chunk.Data = newChunk(chunk.Size);
+			_chunks.insert(_chunks.begin() + static_cast<std::ptrdiff_t>(next), chunk);
+			++_chunkAllocations;
+		}
+
+		useChunk(next, 0);
+		return Allocate(size, alignment);
+	}
+
+	MemoryArena::Marker MemoryArena::Mark() const {
+		Marker marker;
+
+		if (_cursor != nullptr) {
+			marker.Chunk = _current;
+			marker.Offset = static_cast<size_t>(_cursor - _chunks[_current].Data);
+			marker.UsedBefore = _usedBefore;
+		}
+
+		return marker;
+	}
+
+	void MemoryArena::Rewind(Marker const& marker) {
+		_highWaterMark = std::max(_highWaterMark, used());
+
+		if (_chunks.empty())
+			return;
+
+		_usedBefore = marker.UsedBefore;
+		useChunk(marker.Chunk, marker.Offset);
+	}
+
+	void MemoryArena::Reset() {
+		_highWaterMark = std::max(_highWaterMark, used());
+
+		if (_chunks.size() > 1) {
+			size_t total = 0;
+
+			for (const auto& chunk : _chunks)
+				total += chunk.Size;
+
+			freeChunks();
+
+			Chunk chunk;
+			chunk.Size = total;
+			chunk.Data = newChunk(total);
+			_chunks.push_back(chunk);
+			++_chunkAllocations;
+		}
+
+		_usedBefore = 0;
+
+		if (!_chunks.empty())
+			useChunk(0, 0);
+	}
+
+	ArenaStatistics MemoryArena::Statistics() const {
+		ArenaStatistics statistics;
+		statistics.Used = used();
+		statistics.HighWaterMark = std::max(_highWaterMark, statistics.Used);
+		statistics.ChunkCount = _chunks.size();
+		statistics.ChunkAllocations = _chunkAllocations;
+
+		for (const auto& chunk : _chunks)
+			statistics.Capacity += chunk.Size;
+
+		return statistics;
+	}
+
+	MemoryArena& MemoryArena::Scratch() {
+		static thread_local MemoryArena arena;
+		return arena;
+	}
+}
\ No newline at end of file
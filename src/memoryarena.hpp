@@ -0,0 +1,140 @@
+#ifndef DXNA_MEMORYARENA_HPP
+#define DXNA_MEMORYARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace dxna {
+	struct ArenaStatistics {
+		//Bytes handed out since the last Reset, counting the unused ends of full chunks.
+		size_t Used{ 0 };
+		size_t Capacity{ 0 };
+		//The most Used has been since the arena was created.
+		size_t HighWaterMark{ 0 };
+		size_t ChunkCount{ 0 };
+		//How many times the arena went to the heap for a chunk.
+		size_t ChunkAllocations{ 0 };
+	};
+
+	//A bump allocator: Allocate moves a pointer forward through chunks of memory, and everything
+	//is freed at once by Reset or by rewinding to a Marker. Deallocate does nothing.
+	//It is a std::pmr::memory_resource, so std::pmr containers can use it for their temporaries.
+	//Once the chunks have grown to the largest use, allocating never reaches the heap.
+	//Not thread safe: each thread uses its own arena, such as Scratch.
+	class MemoryArena : public std::pmr::memory_resource {
+	public:
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		//A position to rewind to.
+		struct Marker {
+			size_t Chunk{ 0 };
+			size_t Offset{ 0 };
+			size_t UsedBefore{ 0 };
+		};
+
+		MemoryArena(size_t chunkSize = DefaultChunkSize);
+		MemoryArena(MemoryArena const&) = delete;
+		MemoryArena& operator=(MemoryArena const&) = delete;
+		~MemoryArena() override;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+			const auto address = (reinterpret_cast<uintptr_t>(_cursor) + alignment - 1) & ~(alignment - 1);
+
+			if (_cursor != nullptr && address <= reinterpret_cast<uintptr_t>(_end)
+				&& size <= reinterpret_cast<uintptr_t>(_end) - address) {
+				_cursor = reinterpret_cast<std::byte*>(address + size);
+				return reinterpret_cast<void*>(address);
+			}
+
+			return allocateChunk(size, alignment);
+		}
+
+		//Constructs an object in the arena. Its destructor is never called, so it must not need one.
+		template <typename T, typename... TArgs>
+		T* New(TArgs&&... args) {
+			static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed.");
+			return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+		}
+
+		//Value-initialized array in the arena.
+		template <typename T>
+		std::span<T> NewArray(size_t count) {
+			static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed.");
+			auto data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+			std::uninitialized_value_construct_n(data, count);
+			return std::span<T>(data, count);
+		}
+
+		Marker Mark() const;
+
+		//Frees everything allocated after the marker was taken. The chunks are kept.
+		void Rewind(Marker const& marker);
+
+		//Frees everything. Chunks grown during the use are merged into one, so the next use
+		//of the same size fits in a single chunk.
+		void Reset();
+
+		ArenaStatistics Statistics() const;
+
+		//The scratch arena of the calling thread. Take a ScratchScope before using it.
+		static MemoryArena& Scratch();
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override {
+			return Allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void*, size_t, size_t) override {}
+
+		bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+			return this == &other;
+		}
+
+	private:
+		struct Chunk {
+			std::byte* Data{ nullptr };
+			size_t Size{ 0 };
+		};
+
+		void* allocateChunk(size_t size, size_t alignment);
+		void useChunk(size_t index, size_t offset);
+		size_t used() const;
+		void freeChunks();
+
+		size_t _chunkSize;
+		std::vector<Chunk> _chunks;
+		size_t _current{ 0 };
+		size_t _usedBefore{ 0 };
+		std::byte* _cursor{ nullptr };
+		std::byte* _end{ nullptr };
+		size_t _highWaterMark{ 0 };
+		size_t _chunkAllocations{ 0 };
+	};
+
+	//Rewinds an arena, by default the thread's scratch arena, to where it was when the scope began.
+	//Scopes on one arena must end in the reverse order they began.
+	class ScratchScope {
+	public:
+		ScratchScope(MemoryArena& arena = MemoryArena::Scratch()) : _arena(arena), _marker(arena.Mark()) {}
+		ScratchScope(ScratchScope const&) = delete;
+		ScratchScope& operator=(ScratchScope const&) = delete;
+
+		~ScratchScope() {
+			_arena.Rewind(_marker);
+		}
+
+		MemoryArena& Arena() const { return _arena; }
+
+	private:
+		MemoryArena& _arena;
+		MemoryArena::Marker _marker;
+	};
+}
+
+#endif
\ No newline at end of file
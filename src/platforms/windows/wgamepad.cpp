@@ -0,0 +1,39 @@
+#include "wgamepad.hpp"
+#include <Xinput.h>
+
+namespace dxna::input {
+	void XInputGamePad::Poll(std::span<GamePadReport> reports) {
+		for (size_t i = 0; i < reports.size(); ++i) {
+			auto& report = reports[i];
+
+			if (i >= UserCount) {
+				report = GamePadReport();
+				continue;
+			}
+
+			if (_probeWait[i] > 0) {
+				--_probeWait[i];
+				report = GamePadReport();
+				continue;
+			}
+
+			XINPUT_STATE state{};
+
+			if (XInputGetState(static_cast<DWORD>(i), &state) != ERROR_SUCCESS) {
+				_probeWait[i] = ProbeInterval - 1;
+				report = GamePadReport();
+				continue;
+			}
+
+			report.IsConnected = true;
+			report.PacketNumber = state.dwPacketNumber;
+			report.Buttons = state.Gamepad.wButtons;
+			report.LeftX = state.Gamepad.sThumbLX;
+			report.LeftY = state.Gamepad.sThumbLY;
+			report.RightX = state.Gamepad.sThumbRX;
+			report.RightY = state.Gamepad.sThumbRY;
+			report.LeftTrigger = state.Gamepad.bLeftTrigger;
+			report.RightTrigger = state.Gamepad.bRightTrigger;
+		}
+	}
+}
\ No newline at end of file
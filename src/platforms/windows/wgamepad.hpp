@@ -0,0 +1,23 @@
+#ifndef DXNA_PLT_WIN_WGAMEPAD_HPP
+#define DXNA_PLT_WIN_WGAMEPAD_HPP
+
+#include "win32includes.hpp"
+#include "../../input/gamepad.hpp"
+#include <array>
+
+namespace dxna::input {
+	//Reads the four XInput pads. Pads five to eight are never connected.
+	class XInputGamePad : public GamePadDevice {
+	public:
+		static constexpr size_t UserCount = 4;
+		//XInputGetState is slow on an empty slot, so those are probed once in this many polls.
+		static constexpr size_t ProbeInterval = 60;
+
+		void Poll(std::span<GamePadReport> reports) override;
+
+	private:
+		std::array<size_t, UserCount> _probeWait{};
+	};
+}
+
+#endif
\ No newline at end of file
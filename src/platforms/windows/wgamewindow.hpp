@@ -40,6 +40,10 @@ namespace dxna {
 			return IsIconic(hwnd);
 		}
 
+		virtual bool IsActive() const override {
+			return hwnd != nullptr && GetForegroundWindow() == hwnd;
+		}
+
 		LRESULT InternalWinProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
 		
 		cs::EventHandler<GameWindow, cs::EventArgs> Suspend;
@@ -5,62 +5,67 @@
 #include "../../input/input.hpp"
 
 namespace dxna::input{
-	static constexpr void KeyboardWinProc(UINT message, WPARAM wparam, LPARAM lparam) {
+	//The procedures only push events: the game thread builds the input state from
+	//them in Input::Update, so nothing here is shared with it but the queue.
+	static void KeyboardWinProc(UINT message, WPARAM wparam, LPARAM lparam) {
+		InputProducer producer(Input::Queue());
+
 		switch (message)
 		{
 		case WM_KEYDOWN:
-			Keyboard::SetFlag(wparam, true);
+			producer.KeyDown(static_cast<Keys>(wparam));
 			return;
 		case WM_KEYUP:
-			Keyboard::SetFlag(wparam, false);
+			producer.KeyUp(static_cast<Keys>(wparam));
 			return;
 		default:
 			return;
 		}
 	}
 
-	static constexpr void MouseWinProc(UINT message, WPARAM wparam, LPARAM lparam) {
+	static void MouseWinProc(UINT message, WPARAM wparam, LPARAM lparam) {
+		InputProducer producer(Input::Queue());
+
 		switch (message)
 		{
 		case WM_MOUSEMOVE:
-			Mouse::X = GET_X_LPARAM(lparam);
-			Mouse::Y = GET_Y_LPARAM(lparam);
+			producer.MoveMouse(GET_X_LPARAM(lparam), GET_Y_LPARAM(lparam));
 			return;
 		case WM_MOUSEWHEEL:
-			Mouse::Wheel += GET_WHEEL_DELTA_WPARAM(wparam);
+			producer.Scroll(GET_WHEEL_DELTA_WPARAM(wparam));
 			return;
 		case WM_LBUTTONDOWN:
-			Mouse::Left = ButtonState::Pressed;
+			producer.Press(MouseButton::Left);
 			return;
 		case WM_LBUTTONUP:
-			Mouse::Left = ButtonState::Released;
+			producer.Release(MouseButton::Left);
 			return;
 		case WM_MBUTTONDOWN:
-			Mouse::Middle = ButtonState::Pressed;
+			producer.Press(MouseButton::Middle);
 			return;
 		case WM_MBUTTONUP:
-			Mouse::Middle = ButtonState::Released;
+			producer.Release(MouseButton::Middle);
 			return;
 		case WM_RBUTTONDOWN:
-			Mouse::Right = ButtonState::Pressed;
+			producer.Press(MouseButton::Right);
 			return;
 		case WM_RBUTTONUP:
-			Mouse::Right = ButtonState::Released;
+			producer.Release(MouseButton::Right);
 			return;
 		case WM_XBUTTONDOWN:
 			if (GET_XBUTTON_WPARAM(wparam) == MK_XBUTTON1) {
-				Mouse::X1 = ButtonState::Pressed;
+				producer.Press(MouseButton::X1);
 			}
 			else if (GET_XBUTTON_WPARAM(wparam) == MK_XBUTTON2) {
-				Mouse::X2 = ButtonState::Pressed;
+				producer.Press(MouseButton::X2);
 			}
 			return;
 		case WM_XBUTTONUP:
 			if (GET_XBUTTON_WPARAM(wparam) == MK_XBUTTON1) {
-				Mouse::X1 = ButtonState::Released;
+				producer.Release(MouseButton::X1);
 			}
 			else if (GET_XBUTTON_WPARAM(wparam) == MK_XBUTTON2) {
-				Mouse::X2 = ButtonState::Released;
+				producer.Release(MouseButton::X2);
 			}
 			return;
 		default:
@@ -0,0 +1,392 @@
+#include "profiler.hpp"
+#include "cs/stream.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace dxna {
+	std::atomic<bool> Profiler::_enabled{ true };
+
+	static constexpr size_t ChunkSize = 16384;
+	static constexpr size_t MaxChunks = 256;
+
+	//Events of one thread, in chunks that are never moved. Only the owner writes and
+	//publishes the count with release, so the events below it can be read without locks.
+	struct ProfileThread {
+		ProfileThread() = default;
+		ProfileThread(ProfileThread const&) = delete;
+		ProfileThread& operator=(ProfileThread const&) = delete;
+
+		~ProfileThread() {
+			for (auto& chunk : Chunks)
+				delete[] chunk.load(std::memory_order_relaxed);
+		}
+
+		uintcs Id{ 0 };
+		std::atomic<char const*> Name{ nullptr };
+		std::atomic<ProfileEvent*> Chunks[MaxChunks]{};
+		std::atomic<size_t> Count{ 0 };
+		//Clear generation the events belong to.
+		std::atomic<ulongcs> Generation{ 0 };
+		std::atomic<ulongcs> Dropped{ 0 };
+		//Set when the owner thread ends, after its last event.
+		std::atomic<bool> Exited{ false };
+		//The thread exited and its events were exported or cleared: the next new thread takes
+		//its chunks. Guarded by threadsMutex.
+		bool Free{ false };
+	};
+
+	//Threads are kept after they exit, until their events have been exported.
+	static std::mutex threadsMutex;
+	static std::vector<std::unique_ptr<ProfileThread>> threads;
+	static uintcs nextThreadId{ 0 };
+	//Exports run one at a time, so the chunks of a thread freed by one are not reused while another reads them.
+	static std::mutex exportMutex;
+	static std::atomic<ulongcs> clearGeneration{ 0 };
+	static std::atomic<ulongcs> frameIndex{ 0 };
+	static thread_local ProfileThread* currentThread = nullptr;
+
+	//Marks the events of the thread as complete when it ends.
+	struct ProfileThreadExit {
+		~ProfileThreadExit() {
+			if (currentThread != nullptr)
+				currentThread->Exited.store(true, std::memory_order_release);
+		}
+	};
+
+	//Reference points to convert timestamps to seconds.
+	static const auto calibrationTicks = Profiler::Now();
+	static const auto calibrationTime = std::chrono::steady_clock::now();
+
+	//An exited thread whose events were cleared, or that recorded none, has nothing left to export.
+	static bool isFree(ProfileThread const& thread, ulongcs generation) {
+		return thread.Free || (thread.Exited.load(std::memory_order_acquire)
+			&& (thread.Generation.load(std::memory_order_relaxed) != generation || thread.Count.load(std::memory_order_relaxed) == 0));
+	}
+
+	static ProfileThread& profileThread() {
+		if (currentThread == nullptr) {
+			static thread_local ProfileThreadExit threadExit;
+			const auto generation = clearGeneration.load(std::memory_order_relaxed);
+
+			//A running export may still read the chunks of a freed thread: take new ones meanwhile.
+			std::unique_lock<std::mutex> exportLock(exportMutex, std::try_to_lock);
+			std::lock_guard<std::mutex> lock(threadsMutex);
+
+			for (auto const& thread : threads) {
+				if (!exportLock.owns_lock() || !isFree(*thread, generation))
+					continue;
+
+				thread->Name.store(nullptr, std::memory_order_relaxed);
+				thread->Count.store(0, std::memory_order_relaxed);
+				thread->Dropped.store(0, std::memory_order_relaxed);
+				thread->Exited.store(false, std::memory_order_relaxed);
+				thread->Free = false;
+				currentThread = thread.get();
+				break;
+			}
+
+			if (currentThread == nullptr) {
+				threads.push_back(std::make_unique<ProfileThread>());
+				currentThread = threads.back().get();
+			}
+
+			currentThread->Id = nextThreadId++;
+			currentThread->Generation.store(generation, std::memory_order_relaxed);
+		}
+
+		return *currentThread;
+	}
+
+	void Profiler::record(char const* name, ulongcs start, ulongcs value, ProfileEventType type) {
+		auto& thread = profileThread();
+		auto count = thread.Count.load(std::memory_order_relaxed);
+		const auto generation = clearGeneration.load(std::memory_order_relaxed);
+
+		if (thread.Generation.load(std::memory_order_relaxed) != generation) {
+			thread.Generation.store(generation, std::memory_order_relaxed);
+			count = 0;
+		}
+
+		const auto chunkIndex = count / ChunkSize;
+
+		if (chunkIndex >= MaxChunks) {
+			thread.Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto chunk = thread.Chunks[chunkIndex].load(std::memory_order_relaxed);
+
+		if (chunk == nullptr) {
+			chunk = new ProfileEvent[ChunkSize];
+			thread.Chunks[chunkIndex].store(chunk, std::memory_order_release);
+		}
+
+		chunk[count % ChunkSize] = { name, start, value, type };
+		thread.Count.store(count + 1, std::memory_order_release);
+	}
+
+	void Profiler::Counter(char const* name, double value) {
+		if (!Enabled())
+			return;
+
+		ulongcs bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		record(name, Now(), bits, ProfileEventType::Counter);
+	}
+
+	void Profiler::Frame() {
+		if (!Enabled())
+			return;
+
+		record("Frame", Now(), frameIndex.fetch_add(1, std::memory_order_relaxed), ProfileEventType::Frame);
+	}
+
+	void Profiler::ThreadName(char const* name) {
+		profileThread().Name.store(name, std::memory_order_relaxed);
+	}
+
+	double Profiler::TicksPerSecond() {
+#if defined(DXNA_PROFILE_TSC)
+		//The TSC rate is measured over at least 10 ms since start-up.
+		auto elapsed = std::chrono::steady_clock::now() - calibrationTime;
+
+		if (elapsed < std::chrono::milliseconds(10)) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10) - elapsed);
+			elapsed = std::chrono::steady_clock::now() - calibrationTime;
+		}
+
+		const auto ticks = Now() - calibrationTicks;
+		const auto seconds = std::chrono::duration<double>(elapsed).count();
+		return static_cast<double>(ticks) / seconds;
+#else
+		return 1e9;
+#endif
+	}
+
+	void Profiler::Clear() {
+		clearGeneration.fetch_add(1, std::memory_order_relaxed);
+		frameIndex.store(0, std::memory_order_relaxed);
+	}
+
+	//Events of a thread recorded since the last Clear.
+	struct ThreadSnapshot {
+		ProfileThread* Thread;
+		size_t Count;
+		//The thread had ended, so Count holds all its events.
+		bool Exited;
+	};
+
+	static std::vector<ThreadSnapshot> snapshot() {
+		std::vector<ThreadSnapshot> result;
+		const auto generation = clearGeneration.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+
+		for (auto const& thread : threads) {
+			if (thread->Free)
+				continue;
+
+			const auto exited = thread->Exited.load(std::memory_order_acquire);
+			const auto count = thread->Count.load(std::memory_order_acquire);
+
+			if (thread->Generation.load(std::memory_order_relaxed) == generation && count > 0)
+				result.push_back({ thread.get(), count, exited });
+		}
+
+		return result;
+	}
+
+	//Once exported, the events of exited threads are dropped and their chunks reused.
+	static void release(std::vector<ThreadSnapshot> const& snapshots) {
+		std::lock_guard<std::mutex> lock(threadsMutex);
+
+		for (auto const& snapshot : snapshots) {
+			if (snapshot.Exited)
+				snapshot.Thread->Free = true;
+		}
+	}
+
+	static ProfileEvent const& eventAt(ProfileThread const& thread, size_t index) {
+		return thread.Chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+	}
+
+	static void writeBytes(cs::Stream& stream, void const* data, size_t size) {
+		stream.Write(static_cast<bytecs const*>(data), static_cast<intcs>(size), 0, static_cast<intcs>(size));
+	}
+
+	static void appendJsonString(std::string& json, char const* text) {
+		json += '"';
+
+		for (auto c = text != nullptr ? text : ""; *c != '\0'; ++c) {
+			switch (*c) {
+			case '"': json += "\\\""; break;
+			case '\\': json += "\\\\"; break;
+			case '\n': json += "\\n"; break;
+			default:
+				if (static_cast<unsigned char>(*c) < 0x20) {
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+					json += escaped;
+				}
+				else {
+					json += *c;
+				}
+			}
+		}
+
+		json += '"';
+	}
+
+	void Profiler::WriteChromeTrace(cs::Stream& stream) {
+		std::lock_guard<std::mutex> lock(exportMutex);
+		const auto snapshots = snapshot();
+		const auto microsecondsPerTick = 1e6 / TicksPerSecond();
+		auto base = std::numeric_limits<ulongcs>::max();
+
+		for (auto const& snapshot : snapshots) {
+			for (size_t i = 0; i < snapshot.Count; ++i)
+				base = std::min(base, eventAt(*snapshot.Thread, i).Start);
+		}
+
+		std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		char number[64];
+		auto first = true;
+
+		const auto separator = [&] {
+			if (!first)
+				json += ",\n";
+
+			first = false;
+		};
+
+		for (auto const& snapshot : snapshots) {
+			const auto& thread = *snapshot.Thread;
+			const auto name = thread.Name.load(std::memory_order_relaxed);
+
+			if (name != nullptr) {
+				separator();
+				std::snprintf(number, sizeof(number), "%u", thread.Id);
+				json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":";
+				json += number;
+				json += ",\"args\":{\"name\":";
+				appendJsonString(json, name);
+				json += "}}";
+			}
+
+			for (size_t i = 0; i < snapshot.Count; ++i) {
+				const auto& event = eventAt(thread, i);
+				const auto timestamp = (event.Start - base) * microsecondsPerTick;
+
+				separator();
+				json += "{\"name\":";
+				appendJsonString(json, event.Name);
+
+				switch (event.Type) {
+				case ProfileEventType::Zone:
+					std::snprintf(number, sizeof(number), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+						timestamp, (event.Value - event.Start) * microsecondsPerTick);
+					json += number;
+					break;
+				case ProfileEventType::Counter: {
+					double value;
+					std::memcpy(&value, &event.Value, sizeof(value));
+					std::snprintf(number, sizeof(number), ",\"ph\":\"C\",\"ts\":%.3f,\"args\":{\"value\":%.17g}", timestamp, value);
+					json += number;
+					break;
+				}
+				case ProfileEventType::Frame:
+					std::snprintf(number, sizeof(number), ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"args\":{\"frame\":%llu}",
+						timestamp, static_cast<unsigned long long>(event.Value));
+					json += number;
+					break;
+				}
+
+				std::snprintf(number, sizeof(number), ",\"pid\":1,\"tid\":%u}", thread.Id);
+				json += number;
+			}
+		}
+
+		json += "]}\n";
+		writeBytes(stream, json.data(), json.size());
+		release(snapshots);
+	}
+
+	static void appendVarint(std::vector<bytecs>& data, ulongcs value) {
+		while (value >= 0x80) {
+			data.push_back(static_cast<bytecs>(value | 0x80));
+			value >>= 7;
+		}
+
+		data.push_back(static_cast<bytecs>(value));
+	}
+
+	static void appendString(std::vector<bytecs>& data, char const* text) {
+		const auto length = text != nullptr ? std::strlen(text) : 0;
+		appendVarint(data, length);
+		data.insert(data.end(), text, text + length);
+	}
+
+	void Profiler::WriteBinary(cs::Stream& stream) {
+		constexpr uintcs Version = 1;
+
+		std::lock_guard<std::mutex> lock(exportMutex);
+		const auto snapshots = snapshot();
+		const auto ticksPerSecond = TicksPerSecond();
+		std::unordered_map<char const*, ulongcs> nameIndexes;
+		std::vector<char const*> names;
+
+		for (auto const& snapshot : snapshots) {
+			for (size_t i = 0; i < snapshot.Count; ++i) {
+				const auto name = eventAt(*snapshot.Thread, i).Name;
+
+				if (nameIndexes.emplace(name, names.size()).second)
+					names.push_back(name);
+			}
+		}
+
+		std::vector<bytecs> data = { 'D', 'X', 'N', 'A', 'P', 'R', 'O', 'F' };
+		bytecs fixed[12];
+		std::memcpy(fixed, &Version, sizeof(Version));
+		std::memcpy(fixed + 4, &ticksPerSecond, sizeof(ticksPerSecond));
+		data.insert(data.end(), fixed, fixed + sizeof(fixed));
+
+		appendVarint(data, names.size());
+
+		for (const auto name : names)
+			appendString(data, name);
+
+		appendVarint(data, snapshots.size());
+
+		for (auto const& snapshot : snapshots) {
+			const auto& thread = *snapshot.Thread;
+			ulongcs previous = 0;
+
+			appendVarint(data, thread.Id);
+			appendString(data, thread.Name.load(std::memory_order_relaxed));
+			appendVarint(data, snapshot.Count);
+
+			for (size_t i = 0; i < snapshot.Count; ++i) {
+				const auto& event = eventAt(thread, i);
+
+				//Zones are recorded when they end, so starts may go back: deltas are zigzag encoded.
+				const auto delta = static_cast<longcs>(event.Start - previous);
+				previous = event.Start;
+
+				data.push_back(static_cast<bytecs>(event.Type));
+				appendVarint(data, nameIndexes[event.Name]);
+				appendVarint(data, (static_cast<ulongcs>(delta) << 1) ^ static_cast<ulongcs>(delta >> 63));
+				appendVarint(data, event.Type == ProfileEventType::Zone ? event.Value - event.Start : event.Value);
+			}
+		}
+
+		writeBytes(stream, data.data(), data.size());
+		release(snapshots);
+	}
+}
\ No newline at end of file
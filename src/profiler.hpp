@@ -0,0 +1,130 @@
+#ifndef DXNA_PROFILER_HPP
+#define DXNA_PROFILER_HPP
+
+//
+// Frame profiler. Zones, counters and frame markers are recorded into per-thread
+// buffers without locks and exported as Chrome trace-event JSON (chrome://tracing,
+// Perfetto) or a compact binary format.
+//
+// The macros record only when DXNA_PROFILE is defined to a nonzero value,
+// otherwise they expand to nothing. Names must be string literals.
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "cs/cstypes.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define DXNA_PROFILE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define DXNA_PROFILE_TSC 1
+#endif
+
+namespace cs {
+	class Stream;
+}
+
+namespace dxna {
+	enum class ProfileEventType : bytecs {
+		Zone,
+		Counter,
+		Frame,
+	};
+
+	struct ProfileEvent {
+		char const* Name;
+		ulongcs Start;
+		//End of a zone, bits of the double value of a counter, index of a frame.
+		ulongcs Value;
+		ProfileEventType Type;
+	};
+
+	class Profiler {
+	public:
+		//Raw timestamp: the TSC where available, steady_clock nanoseconds otherwise.
+		static ulongcs Now() {
+#if defined(DXNA_PROFILE_TSC)
+			return __rdtsc();
+#else
+			return static_cast<ulongcs>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+		}
+
+		static bool Enabled() { return _enabled.load(std::memory_order_relaxed); }
+		//Pauses or resumes recording. Recording starts enabled.
+		static void Enabled(bool value) { _enabled.store(value, std::memory_order_relaxed); }
+
+		static void Zone(char const* name, ulongcs start, ulongcs end) {
+			record(name, start, end, ProfileEventType::Zone);
+		}
+
+		static void Counter(char const* name, double value);
+
+		//Marks the start of a frame.
+		static void Frame();
+
+		//Names the calling thread in the exported traces.
+		static void ThreadName(char const* name);
+
+		//Timestamps per second, measured against steady_clock.
+		static double TicksPerSecond();
+
+		//Drops the recorded events. Threads still recording drop theirs on their next event.
+		static void Clear();
+
+		//Writes the events recorded so far as Chrome trace-event JSON.
+		//The events of threads that have ended are written by one export only, WriteChromeTrace or
+		//WriteBinary, then their buffers are reused.
+		static void WriteChromeTrace(cs::Stream& stream);
+
+		//Writes the events recorded so far in the binary format:
+		//"DXNAPROF", version, ticks per second, name table, then per thread its id, name
+		//and events as type, name index, start delta and value, all 7-bit encoded.
+		static void WriteBinary(cs::Stream& stream);
+
+	private:
+		static void record(char const* name, ulongcs start, ulongcs value, ProfileEventType type);
+
+		static std::atomic<bool> _enabled;
+	};
+
+	//Records a zone from its construction to its destruction.
+	class ProfileScope {
+	public:
+		explicit ProfileScope(char const* name) : _name(name), _start(Profiler::Enabled() ? Profiler::Now() : 0) {}
+
+		~ProfileScope() {
+			if (_start != 0)
+				Profiler::Zone(_name, _start, Profiler::Now());
+		}
+
+		ProfileScope(ProfileScope const&) = delete;
+		ProfileScope& operator=(ProfileScope const&) = delete;
+
+	private:
+		char const* _name;
+		ulongcs _start;
+	};
+}
+
+#define DXNA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DXNA_PROFILE_CONCAT(a, b) DXNA_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(DXNA_PROFILE) && DXNA_PROFILE
+#define DXNA_PROFILE_SCOPE(name) ::dxna::ProfileScope DXNA_PROFILE_CONCAT(dxnaProfileScope, __LINE__)(name)
+#define DXNA_PROFILE_COUNTER(name, value) ::dxna::Profiler::Counter(name, static_cast<double>(value))
+#define DXNA_PROFILE_FRAME() ::dxna::Profiler::Frame()
+#define DXNA_PROFILE_THREAD(name) ::dxna::Profiler::ThreadName(name)
+#else
+#define DXNA_PROFILE_SCOPE(name)
+#define DXNA_PROFILE_COUNTER(name, value)
+#define DXNA_PROFILE_FRAME()
+#define DXNA_PROFILE_THREAD(name)
+#endif
+
+#endif
\ No newline at end of file
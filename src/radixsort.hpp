@@ -0,0 +1,70 @@
+#ifndef DXNA_RADIXSORT_HPP
+#define DXNA_RADIXSORT_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace dxna {
+	//A key and the index of the element it was computed from.
+	template <typename TKey>
+	struct RadixEntry {
+		TKey Key;
+		uint32_t Index;
+	};
+
+	//Stable LSD radix sort of the entries by key, O(n).
+	//Uses 11-bit digits, so the histograms of all digits are built in a single pass
+	//and fit in L1; digits shared by every key are skipped.
+	//Returns the buffer holding the sorted entries, either entries or scratch.
+	template <typename TKey>
+	RadixEntry<TKey>* RadixSort(RadixEntry<TKey>* entries, RadixEntry<TKey>* scratch, size_t count) {
+		constexpr size_t DigitBits = 11;
+		constexpr size_t DigitCount = (sizeof(TKey) * 8 + DigitBits - 1) / DigitBits;
+		constexpr size_t BucketCount = size_t(1) << DigitBits;
+		constexpr TKey DigitMask = static_cast<TKey>(BucketCount - 1);
+
+		if (count < 2)
+			return entries;
+
+		std::array<std::array<uint32_t, BucketCount>, DigitCount> histograms{};
+
+		for (size_t i = 0; i < count; ++i) {
+			const auto key = entries[i].Key;
+
+			for (size_t digit = 0; digit < DigitCount; ++digit)
+				++histograms[digit][(key >> (digit * DigitBits)) & DigitMask];
+		}
+
+		auto source = entries;
+		auto destination = scratch;
+
+		for (size_t digit = 0; digit < DigitCount; ++digit) {
+			auto& histogram = histograms[digit];
+			const auto shift = digit * DigitBits;
+
+			if (histogram[(source[0].Key >> shift) & DigitMask] == count)
+				continue;
+
+			uint32_t offset = 0;
+
+			for (auto& bucket : histogram) {
+				const auto size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				const auto& entry = source[i];
+				destination[histogram[(entry.Key >> shift) & DigitMask]++] = entry;
+			}
+
+			std::swap(source, destination);
+		}
+
+		return source;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,197 @@
+#ifndef DXNA_SIMD_HPP
+#define DXNA_SIMD_HPP
+
+//
+// Thin wrappers over the SIMD registers of the target, with a scalar fallback.
+// SSE2 is part of every x64 target, NEON of every AArch64 target.
+//
+
+#include <cstdint>
+#include <cmath>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DXNA_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define DXNA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace dxna::simd {
+	//Four packed floats.
+	struct Float4 {
+#if defined(DXNA_SIMD_SSE2)
+		__m128 Value;
+
+		static Float4 Load(float const* source) { return { _mm_loadu_ps(source) }; }
+		static Float4 Set(float value) { return { _mm_set1_ps(value) }; }
+		static Float4 Set(float x, float y, float z, float w) { return { _mm_setr_ps(x, y, z, w) }; }
+		void Store(float* destination) const { _mm_storeu_ps(destination, Value); }
+
+		friend Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.Value, b.Value) }; }
+		friend Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.Value, b.Value) }; }
+		friend Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.Value, b.Value) }; }
+		friend Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.Value, b.Value) }; }
+
+		static Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.Value, b.Value) }; }
+		static Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.Value, b.Value) }; }
+
+		//Bit i of the result is set when lane i of a is greater than lane i of b.
+		static int GreaterMask(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmpgt_ps(a.Value, b.Value)); }
+		static int GreaterEqualMask(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmpge_ps(a.Value, b.Value)); }
+
+		//Lane masks, all bits set where the comparison holds, for Select.
+		static Float4 Less(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.Value, b.Value) }; }
+		static Float4 Equal(Float4 a, Float4 b) { return { _mm_cmpeq_ps(a.Value, b.Value) }; }
+
+		//Lanes of a where the mask is set, of b elsewhere.
+		static Float4 Select(Float4 mask, Float4 a, Float4 b) {
+			return { _mm_or_ps(_mm_and_ps(mask.Value, a.Value), _mm_andnot_ps(mask.Value, b.Value)) };
+		}
+
+		//Rounds toward zero. Lanes must fit in an int.
+		static Float4 Truncate(Float4 a) { return { _mm_cvtepi32_ps(_mm_cvttps_epi32(a.Value)) }; }
+#elif defined(DXNA_SIMD_NEON)
+		float32x4_t Value;
+
+		static Float4 Load(float const* source) { return { vld1q_f32(source) }; }
+		static Float4 Set(float value) { return { vdupq_n_f32(value) }; }
+		static Float4 Set(float x, float y, float z, float w) {
+			const float values[4] = { x, y, z, w };
+			return { vld1q_f32(values) };
+		}
+		void Store(float* destination) const { vst1q_f32(destination, Value); }
+
+		friend Float4 operator+(Float4 a, Float4 b) { return { vaddq_f32(a.Value, b.Value) }; }
+		friend Float4 operator-(Float4 a, Float4 b) { return { vsubq_f32(a.Value, b.Value) }; }
+		friend Float4 operator*(Float4 a, Float4 b) { return { vmulq_f32(a.Value, b.Value) }; }
+		friend Float4 operator/(Float4 a, Float4 b) { return { vdivq_f32(a.Value, b.Value) }; }
+
+		static Float4 Min(Float4 a, Float4 b) { return { vminq_f32(a.Value, b.Value) }; }
+		static Float4 Max(Float4 a, Float4 b) { return { vmaxq_f32(a.Value, b.Value) }; }
+
+		static int GreaterMask(Float4 a, Float4 b) { return mask(vcgtq_f32(a.Value, b.Value)); }
+		static int GreaterEqualMask(Float4 a, Float4 b) { return mask(vcgeq_f32(a.Value, b.Value)); }
+
+		static Float4 Less(Float4 a, Float4 b) { return { vreinterpretq_f32_u32(vcltq_f32(a.Value, b.Value)) }; }
+		static Float4 Equal(Float4 a, Float4 b) { return { vreinterpretq_f32_u32(vceqq_f32(a.Value, b.Value)) }; }
+
+		static Float4 Select(Float4 mask, Float4 a, Float4 b) {
+			return { vbslq_f32(vreinterpretq_u32_f32(mask.Value), a.Value, b.Value) };
+		}
+
+		static Float4 Truncate(Float4 a) { return { vcvtq_f32_s32(vcvtq_s32_f32(a.Value)) }; }
+
+	private:
+		static int mask(uint32x4_t lanes) {
+			return static_cast<int>((vgetq_lane_u32(lanes, 0) & 1) | (vgetq_lane_u32(lanes, 1) & 2)
+				| (vgetq_lane_u32(lanes, 2) & 4) | (vgetq_lane_u32(lanes, 3) & 8));
+		}
+	public:
+#else
+		float Value[4];
+
+		static Float4 Load(float const* source) { return { { source[0], source[1], source[2], source[3] } }; }
+		static Float4 Set(float value) { return { { value, value, value, value } }; }
+		static Float4 Set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+		void Store(float* destination) const {
+			for (int i = 0; i < 4; ++i)
+				destination[i] = Value[i];
+		}
+
+		friend Float4 operator+(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x + y; }); }
+		friend Float4 operator-(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x - y; }); }
+		friend Float4 operator*(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x * y; }); }
+		friend Float4 operator/(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x / y; }); }
+
+		static Float4 Min(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x < y ? x : y; }); }
+		static Float4 Max(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return x > y ? x : y; }); }
+
+		static int GreaterMask(Float4 a, Float4 b) {
+			int result = 0;
+			for (int i = 0; i < 4; ++i)
+				result |= (a.Value[i] > b.Value[i] ? 1 : 0) << i;
+			return result;
+		}
+
+		static int GreaterEqualMask(Float4 a, Float4 b) {
+			int result = 0;
+			for (int i = 0; i < 4; ++i)
+				result |= (a.Value[i] >= b.Value[i] ? 1 : 0) << i;
+			return result;
+		}
+
+		static Float4 Less(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return lane(x < y); }); }
+		static Float4 Equal(Float4 a, Float4 b) { return apply(a, b, [](float x, float y) { return lane(x == y); }); }
+
+		static Float4 Select(Float4 mask, Float4 a, Float4 b) {
+			Float4 result;
+			for (int i = 0; i < 4; ++i)
+				result.Value[i] = std::bit_cast<uint32_t>(mask.Value[i]) != 0 ? a.Value[i] : b.Value[i];
+			return result;
+		}
+
+		static Float4 Truncate(Float4 a) { return apply(a, a, [](float x, float) { return std::trunc(x); }); }
+
+	private:
+		template <typename TFunc>
+		static Float4 apply(Float4 a, Float4 b, TFunc func) {
+			Float4 result;
+			for (int i = 0; i < 4; ++i)
+				result.Value[i] = func(a.Value[i], b.Value[i]);
+			return result;
+		}
+
+		static float lane(bool value) { return std::bit_cast<float>(value ? 0xFFFFFFFFu : 0u); }
+	public:
+#endif
+		//Returns a * b + c.
+		static Float4 MultiplyAdd(Float4 a, Float4 b, Float4 c) { return a * b + c; }
+	};
+
+	//Converts four colors given by channel, in [0, 1], to four packed RGBA8 values,
+	//red in the least significant byte.
+	inline void PackUnorm8(Float4 r, Float4 g, Float4 b, Float4 a, uint32_t* destination) {
+#if defined(DXNA_SIMD_SSE2)
+		const auto zero = _mm_setzero_ps();
+		const auto scale = _mm_set1_ps(255.0F);
+		const auto half = _mm_set1_ps(0.5F);
+		const auto convert = [&](Float4 value) {
+			const auto clamped = _mm_min_ps(_mm_max_ps(value.Value, zero), _mm_set1_ps(1.0F));
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+		};
+
+		const auto packed = _mm_or_si128(
+			_mm_or_si128(convert(r), _mm_slli_epi32(convert(g), 8)),
+			_mm_or_si128(_mm_slli_epi32(convert(b), 16), _mm_slli_epi32(convert(a), 24)));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packed);
+#elif defined(DXNA_SIMD_NEON)
+		const auto convert = [](Float4 value) {
+			const auto clamped = vminq_f32(vmaxq_f32(value.Value, vdupq_n_f32(0.0F)), vdupq_n_f32(1.0F));
+			return vcvtq_u32_f32(vaddq_f32(vmulq_f32(clamped, vdupq_n_f32(255.0F)), vdupq_n_f32(0.5F)));
+		};
+
+		const auto packed = vorrq_u32(
+			vorrq_u32(convert(r), vshlq_n_u32(convert(g), 8)),
+			vorrq_u32(vshlq_n_u32(convert(b), 16), vshlq_n_u32(convert(a), 24)));
+
+		vst1q_u32(destination, packed);
+#else
+		for (int i = 0; i < 4; ++i) {
+			const float channels[4] = { r.Value[i], g.Value[i], b.Value[i], a.Value[i] };
+			uint32_t packed = 0;
+
+			for (int channel = 0; channel < 4; ++channel) {
+				const auto value = channels[channel] < 0.0F ? 0.0F : (channels[channel] > 1.0F ? 1.0F : channels[channel]);
+				packed |= static_cast<uint32_t>(value * 255.0F + 0.5F) << (channel * 8);
+			}
+
+			destination[i] = packed;
+		}
+#endif
+	}
+}
+
+#endif
\ No newline at end of file
@@ -2127,8 +2127,8 @@ namespace dxna {
 			case 5:
 				return _planes5;
 			default:
-				auto p = Plane();
-				return p;
+				//Out of range, there is no empty plane to refer to.
+				return _planes0;
 			}
 		}
 
@@ -2152,7 +2152,8 @@ namespace dxna {
 			case 7:
 				return _corners7;
 			default:
-				return Vector3();
+				//Out of range, there is no empty corner to refer to.
+				return _corners0;
 			}
 		}
 
@@ -2250,15 +2251,15 @@ namespace dxna {
 		}
 
 		nullfloat Intersects(BoundingFrustum const& frustum) const {
-			frustum.Intersects(*this);
+			return frustum.Intersects(*this);
 		}
 
 		nullfloat Intersects(Plane const& plane) {
-			plane.Intersects(*this);
+			return plane.Intersects(*this);
 		}
 
 		nullfloat Intersects(BoundingSphere const& sphere) const {
-			sphere.Intersects(*this);
+			return sphere.Intersects(*this);
 		}
 	};
 
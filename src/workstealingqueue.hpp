@@ -0,0 +1,93 @@
+#ifndef DXNA_WORKSTEALINGQUEUE_HPP
+#define DXNA_WORKSTEALINGQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dxna {
+	//Chase-Lev deque of pointers with a fixed capacity, a power of two.
+	//The owner thread pushes and pops at the bottom, any thread steals from the top
+	//without locks.
+	template <typename T, size_t Capacity = 4096>
+	class WorkStealingQueue {
+	public:
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+		WorkStealingQueue() = default;
+		WorkStealingQueue(WorkStealingQueue const&) = delete;
+		WorkStealingQueue& operator=(WorkStealingQueue const&) = delete;
+
+		//Owner only. Returns false when the queue is full.
+		bool Push(T* item) {
+			const auto bottom = _bottom.load(std::memory_order_relaxed);
+			const auto top = _top.load(std::memory_order_acquire);
+
+			if (bottom - top >= static_cast<int64_t>(Capacity))
+				return false;
+
+			_items[bottom & Mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		//Owner only. Takes the most recently pushed item.
+		T* Pop() {
+			const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+			_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = _top.load(std::memory_order_relaxed);
+
+			if (top > bottom) {
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			auto item = _items[bottom & Mask].load(std::memory_order_relaxed);
+
+			//The last item may be stolen at the same time, the CAS decides who gets it.
+			if (top == bottom) {
+				if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+
+				_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		//Any thread. Takes the oldest item, or null when empty or when another thread won the race.
+		T* Steal() {
+			auto top = _top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto bottom = _bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			auto item = _items[top & Mask].load(std::memory_order_relaxed);
+
+			if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+		//An estimate, exact only when no other thread uses the queue.
+		size_t Count() const {
+			const auto count = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+			return count > 0 ? static_cast<size_t>(count) : 0;
+		}
+
+	private:
+		static constexpr int64_t Mask = static_cast<int64_t>(Capacity - 1);
+
+		//Top and bottom on their own cache lines, thieves hammer the first.
+		alignas(64) std::atomic<int64_t> _top{ 0 };
+		alignas(64) std::atomic<int64_t> _bottom{ 0 };
+		alignas(64) std::atomic<T*> _items[Capacity]{};
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "test.hpp"
+#include "../src/input/actionmap.hpp"
+#include <cmath>
+#include <initializer_list>
+#include <string>
+
+using namespace dxna::input;
+
+namespace dxna::test {
+	static InputSnapshot snapshotWith(std::initializer_list<InputControl> down) {
+		InputSnapshot snapshot;
+
+		for (const auto control : down)
+			snapshot.Set(control, true);
+
+		return snapshot;
+	}
+
+	static InputSnapshot snapshotWith(InputAxis axis, float value, std::initializer_list<InputControl> down = {}) {
+		auto snapshot = snapshotWith(down);
+		snapshot.Axes[static_cast<size_t>(axis)] = value;
+		return snapshot;
+	}
+
+	static bool near(float value, float expected) {
+		return std::fabs(value - expected) < 1e-5F;
+	}
+
+	void ActionMapTests(Runner& runner) {
+		const auto control = InputControl::Key(Keys::LeftControl);
+		const auto s = InputControl::Key(Keys::S);
+		const auto space = InputControl::Key(Keys::Space);
+		const auto enter = InputControl::Key(Keys::Enter);
+		const auto left = InputControl::Key(Keys::A);
+		const auto right = InputControl::Key(Keys::D);
+		const auto stickX = GamePadInput(PlayerIndex::One, GamePadAxis::LeftX);
+
+		runner.Run("ActionMap triggers a chord only with every control down", [&](Context& context) {
+			ActionMap map;
+			const auto save = map.AddAction("save");
+			DXNA_CHECK(map.AddAction("save") == save && map.FindAction("save") == static_cast<intcs>(save));
+			DXNA_CHECK(map.FindAction("load") == -1);
+
+			DXNA_CHECK(!map.Bind(save, 0, { control, s }).HasError());
+			DXNA_CHECK(!map.Bind(save, 1, { enter }).HasError());
+
+			map.Update(snapshotWith({ s }));
+			DXNA_CHECK(!map.IsDown(save));
+
+			map.Update(snapshotWith({ control }));
+			DXNA_CHECK(!map.IsDown(save));
+
+			map.Update(snapshotWith({ control, s }));
+			DXNA_CHECK(map.IsDown(save));
+
+			//Either slot triggers the action.
+			map.Update(snapshotWith({ enter }));
+			DXNA_CHECK(map.IsDown(save));
+
+			//Unused slots never trigger.
+			map.Update(snapshotWith({}));
+			DXNA_CHECK(!map.IsDown(save));
+		});
+
+		runner.Run("ActionMap reports the edges of each action", [&](Context& context) {
+			ActionMap map(1);
+			const auto jump = map.AddAction("jump");
+			const auto fire = map.AddAction("fire");
+			map.Bind(jump, 0, { space });
+			map.Bind(fire, 0, { enter });
+
+			map.Update(snapshotWith({ space }));
+			DXNA_CHECK(map.WasPressed(jump) && !map.WasReleased(jump));
+			DXNA_CHECK(!map.IsDown(fire) && !map.WasPressed(fire));
+
+			map.Update(snapshotWith({ space, enter }));
+			DXNA_CHECK(map.IsDown(jump) && !map.WasPressed(jump));
+			DXNA_CHECK(map.WasPressed(fire));
+
+			map.Update(snapshotWith({ enter }));
+			DXNA_CHECK(map.WasReleased(jump) && !map.IsDown(jump));
+			DXNA_CHECK(map.IsDown(fire) && !map.WasPressed(fire) && !map.WasReleased(fire));
+
+			map.Update(snapshotWith({}));
+			DXNA_CHECK(!map.WasReleased(jump) && map.WasReleased(fire));
+		});
+
+		runner.Run("ActionMap keeps the edges past the first 64 actions", [&](Context& context) {
+			ActionMap map(1);
+			uintcs last = 0;
+
+			for (intcs i = 0; i < 70; ++i)
+				last = map.AddAction("action " + std::to_string(i));
+
+			map.Bind(last, 0, { space });
+			map.Update(snapshotWith({ space }));
+			DXNA_CHECK(map.WasPressed(last) && !map.IsDown(0));
+
+			map.Update(snapshotWith({}));
+			DXNA_CHECK(map.WasReleased(last));
+		});
+
+		runner.Run("ActionMap rescales an axis past its dead zone", [&](Context& context) {
+			ActionMap map(1);
+			const auto move = map.AddAxis("move", 0.2F);
+			DXNA_CHECK(!map.BindAxis(move, 0, { {}, {}, stickX, 1.0F }).HasError());
+
+			map.Update(snapshotWith(stickX, 0.1F));
+			DXNA_CHECK(map.Value(move) == 0.0F);
+
+			map.Update(snapshotWith(stickX, -0.2F));
+			DXNA_CHECK(map.Value(move) == 0.0F);
+
+			map.Update(snapshotWith(stickX, 0.6F));
+			DXNA_CHECK(near(map.Value(move), 0.5F));
+
+			map.Update(snapshotWith(stickX, -1.0F));
+			DXNA_CHECK(near(map.Value(move), -1.0F));
+
+			//Digital controls read as -1 and 1, and the scale applies to the analog input.
+			DXNA_CHECK(!map.DeadZone(move, 0).HasError());
+			map.BindAxis(move, 0, { left, right, stickX, -2.0F });
+			map.Update(snapshotWith(stickX, 0.25F, { right }));
+			DXNA_CHECK(near(map.Value(move), 0.5F));
+
+			DXNA_CHECK(map.DeadZone(move, 1.0F) == ErrorCode::ARGUMENT_OUT_OF_RANGE);
+			DXNA_CHECK(map.DeadZone(move, -0.1F) == ErrorCode::ARGUMENT_OUT_OF_RANGE);
+			DXNA_CHECK(map.DeadZone(move + 1, 0.1F) == ErrorCode::ARGUMENT_OUT_OF_RANGE);
+		});
+
+		runner.Run("ActionMap takes the axis slot that reads farthest from zero", [&](Context& context) {
+			ActionMap map;
+			const auto move = map.AddAxis("move");
+			map.BindAxis(move, 0, { left, right, InputAxis::None, 1.0F });
+			map.BindAxis(move, 1, { {}, {}, stickX, 1.0F });
+
+			map.Update(snapshotWith(stickX, 0.5F, { right }));
+			DXNA_CHECK(map.Value(move) == 1.0F);
+
+			map.Update(snapshotWith(stickX, -0.5F));
+			DXNA_CHECK(near(map.Value(move), -0.5F));
+
+			//Opposite directions: the larger one wins, not their sum.
+			map.Update(snapshotWith(stickX, 0.7F, { left }));
+			DXNA_CHECK(map.Value(move) == -1.0F);
+
+			//Both keys cancel out in their own slot.
+			map.Update(snapshotWith(stickX, 0.3F, { left, right }));
+			DXNA_CHECK(near(map.Value(move), 0.3F));
+		});
+
+		runner.Run("ActionMap uses a slot rebound between updates", [&](Context& context) {
+			ActionMap map(1);
+			const auto jump = map.AddAction("jump");
+			map.Bind(jump, 0, { space });
+
+			map.Update(snapshotWith({ space }));
+			DXNA_CHECK(map.WasPressed(jump));
+
+			//Space is still held, but no longer bound.
+			DXNA_CHECK(!map.Bind(jump, 0, { enter }).HasError());
+			DXNA_CHECK(map.GetBinding(jump, 0) == ActionBinding(enter));
+
+			map.Update(snapshotWith({ space }));
+			DXNA_CHECK(map.WasReleased(jump));
+
+			map.Update(snapshotWith({ space, enter }));
+			DXNA_CHECK(map.WasPressed(jump));
+
+			//An empty chord clears the slot.
+			DXNA_CHECK(!map.Bind(jump, 0, {}).HasError());
+			DXNA_CHECK(map.GetBinding(jump, 0).IsEmpty());
+
+			map.Update(snapshotWith({ space, enter }));
+			DXNA_CHECK(map.WasReleased(jump));
+		});
+
+		runner.Run("ActionMap rejects bindings it cannot hold", [&](Context& context) {
+			ActionMap map(2);
+			const auto jump = map.AddAction("jump");
+			const auto move = map.AddAxis("move");
+			map.Bind(jump, 0, { space });
+
+			const auto chord = map.Bind(jump, 0, { control, s, space, enter, left });
+			DXNA_CHECK(chord == Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2));
+			DXNA_CHECK(map.GetBinding(jump, 0) == ActionBinding(space));
+
+			//Exactly MaxChord controls fit.
+			DXNA_CHECK(!map.Bind(jump, 1, { control, s, space, enter }).HasError());
+
+			DXNA_CHECK(map.Bind(jump + 1, 0, { space }) == Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 0));
+			DXNA_CHECK(map.Bind(jump, 2, { space }) == Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1));
+			DXNA_CHECK(map.Bind(jump, 0, ActionBinding(InputControl{ 600 })) == Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2));
+
+			DXNA_CHECK(map.BindAxis(move, 2, { left, right, InputAxis::None, 1.0F }) == Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 1));
+			DXNA_CHECK(map.BindAxis(move, 0, { left, right, static_cast<InputAxis>(InputSnapshot::AxisCount), 1.0F })
+				== Error(ErrorCode::ARGUMENT_OUT_OF_RANGE, 2));
+			DXNA_CHECK(map.GetAxisBinding(move, 0).IsEmpty());
+		});
+	}
+}
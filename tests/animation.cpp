@@ -0,0 +1,123 @@
+#include "test.hpp"
+#include "../src/animationclip.hpp"
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace dxna::test {
+	static constexpr uintcs Targets = 3;
+
+	//A clip with a translation and a rotation track on each target.
+	static std::vector<bytecs> clipBytes() {
+		const float times[] = { 0.0F, 0.5F, 1.0F, 2.0F };
+		const Vector3 translations[] = { Vector3(0.0F), Vector3(1.0F, 0.0F, 0.0F), Vector3(1.0F, 2.0F, 0.0F), Vector3(0.0F, 2.0F, 3.0F) };
+		const Quaternion rotations[] = {
+			Quaternion::Identity(), Quaternion::CreateFromYawPitchRoll(0.5F, 0.0F, 0.0F),
+			Quaternion::CreateFromYawPitchRoll(1.0F, 0.2F, 0.0F), Quaternion::CreateFromYawPitchRoll(1.5F, 0.4F, 0.1F) };
+		AnimationClipBuilder builder(2.0F);
+
+		for (uintcs target = 0; target < Targets; ++target) {
+			builder.AddTrack(target, AnimationTrackType::Translation, times, translations);
+			builder.AddTrack(target, times, rotations, 0.0F, target % 2 == 0);
+		}
+
+		AnimationClip clip;
+		builder.Build(clip);
+
+		cs::MemoryStream stream(0);
+		cs::BinaryWriter writer(&stream);
+		clip.Write(writer);
+
+		std::span<bytecs const> buffer;
+		stream.TryGetBuffer(buffer);
+		return std::vector<bytecs>(buffer.begin(), buffer.end());
+	}
+
+	template <typename T>
+	static void poke(std::vector<bytecs>& data, size_t offset, T const& value) {
+		std::memcpy(data.data() + offset, &value, sizeof(T));
+	}
+
+	template <typename T>
+	static T peek(std::vector<bytecs> const& data, size_t offset) {
+		T value;
+		std::memcpy(&value, data.data() + offset, sizeof(T));
+		return value;
+	}
+
+	//Loads from memory, then reads from a stream that does not expose its buffer.
+	static void checkRejected(Context& context, std::vector<bytecs> const& data, ErrorCode expected) {
+		AnimationClip clip;
+		DXNA_CHECK(AnimationClip::Load(data, clip) == expected);
+		DXNA_CHECK(clip.TrackCount() == 0);
+
+		cs::MemoryStream stream(data, 0, data.size(), false, false);
+		DXNA_CHECK(AnimationClip::Read(stream, clip) == expected);
+		DXNA_CHECK(clip.TrackCount() == 0);
+	}
+
+	void AnimationTests(Runner& runner) {
+		runner.Run("AnimationClip loads and reads its written bytes", [&](Context& context) {
+			const auto data = clipBytes();
+			AnimationClip loaded;
+			AnimationClip read;
+			cs::MemoryStream stream(data, 0, data.size(), false, false);
+
+			DXNA_CHECK(!AnimationClip::Load(data, loaded).HasError());
+			DXNA_CHECK(!AnimationClip::Read(stream, read).HasError());
+			DXNA_CHECK(loaded.TargetCount() == Targets && read.TargetCount() == Targets);
+			DXNA_CHECK(loaded.Duration() == 2.0F);
+
+			AnimationPose pose1(Targets);
+			AnimationPose pose2(Targets);
+			AnimationCursor cursor1;
+			AnimationCursor cursor2;
+			loaded.Sample(0.75F, cursor1, pose1);
+			read.Sample(0.75F, cursor2, pose2);
+
+			DXNA_CHECK(pose1.Translations[2] == Vector3(1.0F, 1.0F, 0.0F));
+			DXNA_CHECK(pose1.Translations == pose2.Translations);
+			DXNA_CHECK(pose1.Rotations == pose2.Rotations);
+		});
+
+		runner.Run("AnimationClip rejects a target out of range", [&](Context& context) {
+			auto data = clipBytes();
+			//The target of the last track.
+			poke(data, AnimationClip::HeaderSize + (Targets * 2 - 1) * AnimationClip::TrackSize, uintcs{ 0xFFFFFFFF });
+
+			checkRejected(context, data, ErrorCode::ANIMATION_TARGET_OUT_OF_RANGE);
+		});
+
+		runner.Run("AnimationClip rejects key times out of order", [&](Context& context) {
+			auto data = clipBytes();
+			//Swaps the second and third key times of the first track.
+			const auto times = static_cast<size_t>(peek<uintcs>(data, AnimationClip::HeaderSize + 12));
+			const auto second = peek<float>(data, times + 4);
+			poke(data, times + 4, peek<float>(data, times + 8));
+			poke(data, times + 8, second);
+
+			checkRejected(context, data, ErrorCode::ANIMATION_KEYS_NOT_SORTED);
+		});
+
+		runner.Run("AnimationClip rejects a NaN key time", [&](Context& context) {
+			auto data = clipBytes();
+			const auto times = static_cast<size_t>(peek<uintcs>(data, AnimationClip::HeaderSize + 12));
+			poke(data, times + 8, std::numeric_limits<float>::quiet_NaN());
+
+			checkRejected(context, data, ErrorCode::ANIMATION_KEYS_NOT_SORTED);
+		});
+
+		runner.Run("AnimationClip skips targets beyond the pose", [&](Context& context) {
+			const auto data = clipBytes();
+			AnimationClip clip;
+			DXNA_CHECK(!AnimationClip::Load(data, clip).HasError());
+
+			AnimationPose pose(1);
+			AnimationCursor cursor;
+			clip.Sample(2.0F, cursor, pose);
+
+			DXNA_CHECK(pose.TargetCount() == 1);
+			DXNA_CHECK(pose.Translations[0] == Vector3(0.0F, 2.0F, 3.0F));
+		});
+	}
+}
\ No newline at end of file
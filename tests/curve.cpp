@@ -0,0 +1,86 @@
+#include "test.hpp"
+#include "../src/compiledcurve.hpp"
+#include <cmath>
+#include <vector>
+
+namespace dxna::test {
+	static constexpr CurveLoopType LoopTypes[] = {
+		CurveLoopType::Constant, CurveLoopType::Cycle, CurveLoopType::CycleOffset,
+		CurveLoopType::Oscillate, CurveLoopType::Linear };
+
+	//Positions before, inside and after the keys, several cycles away.
+	static std::vector<float> positions(float first, float last) {
+		std::vector<float> result;
+
+		for (float position = first - 7.5F; position <= last + 7.5F; position += 0.3125F)
+			result.push_back(position);
+
+		return result;
+	}
+
+	static Curve curve(std::vector<CurveKey> const& keys, CurveLoopType loop) {
+		Curve result;
+		result.PreLoop = loop;
+		result.PostLoop = loop;
+
+		for (const auto& key : keys)
+			result.Keys.Add(key);
+
+		return result;
+	}
+
+	void CurveTests(Runner& runner) {
+		runner.Run("CompiledCurve matches Curve::Evaluate", [&](Context& context) {
+			for (const auto loop : LoopTypes) {
+				auto source = curve({ CurveKey(0.0F, 1.0F), CurveKey(1.0F, 3.0F), CurveKey(2.5F, -2.0F),
+					CurveKey(4.0F, 0.5F, 0, 0, CurveContinuity::Step), CurveKey(5.0F, 2.0F) }, loop);
+				source.ComputeTangents(CurveTangent::Smooth, CurveTangent::Smooth);
+				const CompiledCurve compiled(source);
+
+				for (const auto position : positions(0.0F, 5.0F))
+					DXNA_CHECK(std::abs(compiled.Evaluate(position) - source.Evaluate(position)) < 1e-4F);
+			}
+		});
+
+		runner.Run("CompiledCurve span matches scalar Evaluate", [&](Context& context) {
+			for (const auto loop : LoopTypes) {
+				auto source = curve({ CurveKey(-1.0F, 2.0F), CurveKey(0.5F, -1.0F), CurveKey(3.0F, 4.0F) }, loop);
+				source.ComputeTangents(CurveTangent::Smooth, CurveTangent::Smooth);
+				const CompiledCurve compiled(source);
+				const auto inputs = positions(-1.0F, 3.0F);
+				std::vector<float> values(inputs.size());
+
+				DXNA_CHECK(!compiled.Evaluate(inputs, values).HasError());
+
+				for (size_t i = 0; i < inputs.size(); ++i)
+					DXNA_CHECK(std::abs(values[i] - compiled.Evaluate(inputs[i])) < 1e-4F);
+			}
+		});
+
+		//Every key at one position leaves no length to loop over: the curve is its first key.
+		runner.Run("CompiledCurve with zero length is constant", [&](Context& context) {
+			for (const auto loop : LoopTypes) {
+				auto compiled = CompiledCurve(curve({ CurveKey(2.0F, 5.0F, 1.0F, 1.0F), CurveKey(2.0F, 7.0F, -1.0F, -1.0F) }, loop));
+				const auto inputs = positions(2.0F, 2.0F);
+				std::vector<float> values(inputs.size());
+				size_t hint = 0;
+
+				DXNA_CHECK(!compiled.Evaluate(inputs, values).HasError());
+
+				for (size_t i = 0; i < inputs.size(); ++i) {
+					DXNA_CHECK(compiled.Evaluate(inputs[i]) == 5.0F);
+					DXNA_CHECK(compiled.Evaluate(inputs[i], hint) == 5.0F);
+					DXNA_CHECK(values[i] == 5.0F);
+				}
+
+				DXNA_CHECK(!compiled.Bake(16).HasError());
+
+				for (const auto position : inputs)
+					DXNA_CHECK(compiled.EvaluateBaked(position) == 5.0F);
+
+				DXNA_CHECK(!compiled.Bake(0.001F, 64).HasError());
+				DXNA_CHECK(compiled.BakedError() == 0.0F);
+			}
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "test.hpp"
+#include "../src/eventbus.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dxna::test {
+	struct BusEventArgs : public cs::EventArgs {
+		BusEventArgs(intcs thread, intcs sequence) : Thread(thread), Sequence(sequence) {}
+
+		intcs Thread;
+		intcs Sequence;
+	};
+
+	using BusEvent = cs::EventHandler<intcs, BusEventArgs>;
+
+	void EventBusTests(Runner& runner) {
+		runner.Run("EventBus dispatches the events of each thread in order", [&](Context& context) {
+			constexpr intcs Threads = 4;
+			constexpr intcs Count = 20000;
+
+			EventBus bus(64);
+			BusEvent event;
+			std::vector<intcs> next(Threads, 0);
+			intcs outOfOrder = 0;
+			intcs received = 0;
+
+			event.Subscribe([&](BusEventArgs const& e) {
+				if (e.Sequence != next[e.Thread])
+					++outOfOrder;
+
+				next[e.Thread] = e.Sequence + 1;
+				++received;
+			});
+
+			const intcs sender = 0;
+			std::vector<std::thread> threads;
+
+			for (intcs t = 0; t < Threads; ++t) {
+				threads.emplace_back([&, t] {
+					//The small queue fills up, so most events are raised again after a drop.
+					for (intcs i = 0; i < Count; ++i) {
+						while (!bus.Raise(event, sender, BusEventArgs(t, i)))
+							std::this_thread::yield();
+					}
+				});
+			}
+
+			while (received < Threads * Count)
+				bus.Drain();
+
+			for (auto& thread : threads)
+				thread.join();
+
+			const auto& statistics = bus.Statistics<intcs, BusEventArgs>();
+			DXNA_CHECK(outOfOrder == 0);
+			DXNA_CHECK(bus.ThreadCount() == static_cast<size_t>(Threads));
+			DXNA_CHECK(statistics.Dispatched == static_cast<ulongcs>(Threads * Count));
+			DXNA_CHECK(bus.Drain() == 0);
+		});
+
+		runner.Run("EventBus drops and counts events past a full queue", [&](Context& context) {
+			EventBus bus(3);
+			BusEvent event;
+			intcs received = 0;
+			event.Subscribe([&] { ++received; });
+
+			const intcs sender = 0;
+			const auto& statistics = bus.Statistics<intcs, BusEventArgs>();
+
+			//The capacity is rounded up to four.
+			for (intcs i = 0; i < 4; ++i)
+				DXNA_CHECK(bus.Raise(event, sender, BusEventArgs(0, i)));
+
+			DXNA_CHECK(!bus.Raise(event, sender, BusEventArgs(0, 4)));
+			DXNA_CHECK(!bus.Raise(event, sender, BusEventArgs(0, 5)));
+			DXNA_CHECK(statistics.Dropped == 0);
+
+			DXNA_CHECK(bus.Drain() == 4);
+			DXNA_CHECK(received == 4);
+			DXNA_CHECK(statistics.Dispatched == 4);
+			DXNA_CHECK(statistics.Dropped == 2);
+
+			//The drained slots are free again.
+			DXNA_CHECK(bus.Raise(event, sender, BusEventArgs(0, 6)));
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(statistics.Dropped == 2);
+		});
+
+		runner.Run("EventBus defers the events raised during a drain", [&](Context& context) {
+			EventBus bus;
+			BusEvent event;
+			const intcs sender = 0;
+			std::vector<intcs> sequences;
+
+			event.Subscribe([&](BusEventArgs const& e) {
+				sequences.push_back(e.Sequence);
+
+				if (e.Sequence < 3)
+					bus.Raise(event, sender, BusEventArgs(0, e.Sequence + 1));
+			});
+
+			bus.Raise(event, sender, BusEventArgs(0, 0));
+
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(sequences.size() == 1);
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(bus.Drain() == 0);
+			DXNA_CHECK((sequences == std::vector<intcs>{ 0, 1, 2, 3 }));
+		});
+
+		runner.Run("EventBus defers the events raised during a drain onto a queue it has yet to reach", [&](Context& context) {
+			EventBus bus;
+			BusEvent event;
+			const intcs sender = 0;
+			std::vector<intcs> threads;
+
+			//The handler of the worker event raises on the queue of the draining thread.
+			event.Subscribe([&](BusEventArgs const& e) {
+				threads.push_back(e.Thread);
+
+				if (e.Thread == 1)
+					bus.Raise(event, sender, BusEventArgs(0, 1));
+			});
+
+			//This thread raises first, so its queue is older and comes after the worker's.
+			bus.Raise(event, sender, BusEventArgs(0, 0));
+
+			std::thread worker([&] { bus.Raise(event, sender, BusEventArgs(1, 0)); });
+			worker.join();
+
+			DXNA_CHECK(bus.ThreadCount() == 2);
+			DXNA_CHECK(bus.Drain() == 2);
+			DXNA_CHECK((threads == std::vector<intcs>{ 1, 0 }));
+			DXNA_CHECK(bus.Drain() == 1);
+			DXNA_CHECK(bus.Drain() == 0);
+		});
+
+		runner.Run("EventBus buckets latencies by powers of two microseconds", [&](Context& context) {
+			DXNA_CHECK(EventStatistics::Bucket(0) == 0);
+			DXNA_CHECK(EventStatistics::Bucket(999) == 0);
+			DXNA_CHECK(EventStatistics::Bucket(1000) == 1);
+			DXNA_CHECK(EventStatistics::Bucket(1999) == 1);
+			DXNA_CHECK(EventStatistics::Bucket(2000) == 2);
+			DXNA_CHECK(EventStatistics::Bucket(3999) == 2);
+			DXNA_CHECK(EventStatistics::Bucket(4000) == 3);
+			DXNA_CHECK(EventStatistics::Bucket((ulongcs{ 1 } << 17) * 1000 - 1) == 17);
+			DXNA_CHECK(EventStatistics::Bucket((ulongcs{ 1 } << 17) * 1000) == 18);
+			DXNA_CHECK(EventStatistics::Bucket((ulongcs{ 1 } << 18) * 1000) == EventStatistics::BucketCount - 1);
+			DXNA_CHECK(EventStatistics::Bucket(~ulongcs{ 0 }) == EventStatistics::BucketCount - 1);
+
+			EventStatistics statistics;
+			DXNA_CHECK(statistics.LatencyPercentile(0.5) == 0);
+
+			//Fifty events under 1 us, forty under 4 us and ten past the last bound.
+			statistics.Dispatched = 100;
+			statistics.MaxLatency = 5000000000;
+			statistics.Latency[0] = 50;
+			statistics.Latency[2] = 40;
+			statistics.Latency[EventStatistics::BucketCount - 1] = 10;
+
+			DXNA_CHECK(statistics.LatencyPercentile(0.0) == 1000);
+			DXNA_CHECK(statistics.LatencyPercentile(0.5) == 1000);
+			DXNA_CHECK(statistics.LatencyPercentile(0.51) == 4000);
+			DXNA_CHECK(statistics.LatencyPercentile(0.9) == 4000);
+			DXNA_CHECK(statistics.LatencyPercentile(0.95) == 5000000000);
+			DXNA_CHECK(statistics.LatencyPercentile(1.0) == 5000000000);
+		});
+	}
+}
@@ -0,0 +1,375 @@
+#include "test.hpp"
+#include "../src/cs/eventqueue.hpp"
+#include <string>
+#include <vector>
+
+namespace dxna::test {
+	struct EventSender {
+		intcs Value{ 0 };
+	};
+
+	struct OrderArgs : cs::EventArgs {
+		OrderArgs(intcs sequence) : Sequence(sequence) {}
+
+		intcs Sequence;
+	};
+
+	//Arguments large enough to spread the events of a queue over several blocks.
+	struct LargeArgs : cs::EventArgs {
+		LargeArgs(intcs sequence) : Sequence(sequence) {}
+
+		intcs Sequence;
+		char Payload[200]{};
+	};
+
+	//Arguments larger than a block of the queue.
+	struct HugeArgs : cs::EventArgs {
+		HugeArgs(intcs sequence) : Sequence(sequence) {}
+
+		intcs Sequence;
+		char Payload[cs::EventQueue::BlockSize + 1]{};
+	};
+
+	//Counts the live copies, to find callables and arguments destroyed twice or never.
+	struct Tracked {
+		static inline intcs Live = 0;
+
+		Tracked() { ++Live; }
+		Tracked(Tracked const& other) : Value(other.Value) { ++Live; }
+		Tracked(Tracked&& other) noexcept : Value(other.Value) { ++Live; }
+		~Tracked() { --Live; }
+
+		intcs Value{ 0 };
+	};
+
+	struct TrackedArgs : cs::EventArgs {
+		Tracked Object;
+	};
+
+	using OrderEvent = cs::EventHandler<EventSender, OrderArgs>;
+
+	static std::vector<intcs> calls;
+
+	static void first(EventSender const&, OrderArgs const&) { calls.push_back(1); }
+
+	static void second(EventSender const&, OrderArgs const&) { calls.push_back(2); }
+
+	struct Counter {
+		intcs Total{ 0 };
+
+		void Add(EventSender const& sender, OrderArgs const& e) { Total += sender.Value + e.Sequence; }
+
+		intcs Get(intcs value) const { return Total + value; }
+	};
+
+	void EventTests(Runner& runner) {
+		runner.Run("EventHandler operator-= removes the last subscription only", [&](Context& context) {
+			OrderEvent event;
+			const EventSender sender;
+
+			event += first;
+			event += second;
+			event += first;
+			DXNA_CHECK(event.Count() == 3);
+
+			event -= first;
+			DXNA_CHECK(event.Count() == 2);
+
+			calls.clear();
+			event.Invoke(sender, OrderArgs(0));
+			DXNA_CHECK((calls == std::vector<intcs>{ 1, 2 }));
+
+			event -= first;
+			event -= first;
+			DXNA_CHECK(event.Count() == 1);
+
+			calls.clear();
+			event.Invoke(sender, OrderArgs(0));
+			DXNA_CHECK((calls == std::vector<intcs>{ 2 }));
+
+			event -= second;
+			DXNA_CHECK(event.IsEmpty());
+		});
+
+		runner.Run("EventHandler Unsubscribe removes a token once", [&](Context& context) {
+			OrderEvent event;
+			const EventSender sender{ 5 };
+			Counter counter;
+			intcs lambdas = 0;
+
+			const auto method = event.Subscribe(&counter, &Counter::Add);
+			const auto lambda = event.Subscribe([&] { ++lambdas; });
+			DXNA_CHECK(method.IsValid() && lambda.IsValid() && !(method == lambda));
+
+			event.Invoke(sender, OrderArgs(1));
+			DXNA_CHECK(counter.Total == 6 && lambdas == 1);
+
+			DXNA_CHECK(event.Unsubscribe(method));
+			DXNA_CHECK(!event.Unsubscribe(method));
+			DXNA_CHECK(!event.Unsubscribe(cs::EventToken()));
+			DXNA_CHECK(event.Count() == 1);
+
+			event.Invoke(sender, OrderArgs(1));
+			DXNA_CHECK(counter.Total == 6 && lambdas == 2);
+		});
+
+		runner.Run("EventHandler handlers change the subscriptions while invoked", [&](Context& context) {
+			OrderEvent event;
+			const EventSender sender;
+			std::vector<std::string> log;
+			cs::EventToken self;
+			cs::EventToken later;
+			cs::EventToken added;
+			cs::EventToken dropped;
+
+			//Removes itself and the handler after it, and adds two handlers, one removed right away.
+			self = event.Subscribe([&] {
+				log.push_back("self");
+				DXNA_CHECK(event.Unsubscribe(self));
+				DXNA_CHECK(event.Unsubscribe(later));
+
+				added = event.Subscribe([&] { log.push_back("added"); });
+				dropped = event.Subscribe([&] { log.push_back("dropped"); });
+				DXNA_CHECK(event.Unsubscribe(dropped));
+				DXNA_CHECK(event.Count() == 2);
+			});
+
+			later = event.Subscribe([&] { log.push_back("later"); });
+			event.Subscribe([&](OrderArgs const& e) {
+				log.push_back("last");
+
+				//A nested Invoke sees the same handlers, and leaves the tidying to the outer one.
+				if (e.Sequence == 0)
+					event.Invoke(sender, OrderArgs(1));
+			});
+
+			event.Invoke(sender, OrderArgs(0));
+			DXNA_CHECK((log == std::vector<std::string>{ "self", "last", "last" }));
+			DXNA_CHECK(event.Count() == 2);
+
+			log.clear();
+			event.Invoke(sender, OrderArgs(1));
+			DXNA_CHECK((log == std::vector<std::string>{ "last", "added" }));
+		});
+
+		runner.Run("EventHandler tidies up after a handler throws", [&](Context& context) {
+			OrderEvent event;
+			const EventSender sender;
+			intcs calls = 0;
+			cs::EventToken thrower;
+
+			//Removes itself and adds a handler, then throws out of the Invoke.
+			thrower = event.Subscribe([&] {
+				event.Unsubscribe(thrower);
+				event.Subscribe([&] { ++calls; });
+				throw 1;
+			});
+
+			bool thrown = false;
+
+			try {
+				event.Invoke(sender, OrderArgs(0));
+			}
+			catch (int) {
+				thrown = true;
+			}
+
+			DXNA_CHECK(thrown && event.Count() == 1);
+
+			//The changes took effect, and a handler subscribed now is added at once.
+			event.Invoke(sender, OrderArgs(1));
+			DXNA_CHECK(calls == 1);
+
+			const auto token = event.Subscribe([&] { calls += 10; });
+			event.Invoke(sender, OrderArgs(2));
+			DXNA_CHECK(calls == 12);
+
+			DXNA_CHECK(event.Unsubscribe(token) && event.Count() == 1);
+		});
+
+		runner.Run("Delegate stores small callables inline and large ones on the heap", [&](Context& context) {
+			using Function = cs::Delegate<intcs(intcs)>;
+
+			DXNA_CHECK(!Function());
+			DXNA_CHECK(!Function(nullptr));
+
+			Function pointer = [](intcs value) { return value * 2; };
+			DXNA_CHECK(pointer.IsInline() && pointer(4) == 8);
+
+			const intcs offset = 3;
+			Function small = [offset](intcs value) { return value + offset; };
+			DXNA_CHECK(small.IsInline() && small(4) == 7);
+
+			intcs large[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+			Function heap = [large](intcs value) { return large[7] + value; };
+			DXNA_CHECK(!heap.IsInline() && heap(1) == 9);
+
+			Counter counter{ 10 };
+			Function method(&counter, &Counter::Get);
+			DXNA_CHECK(method.IsInline() && method(1) == 11);
+
+			counter.Total = 20;
+			DXNA_CHECK(method(1) == 21);
+		});
+
+		runner.Run("Delegate copies and moves its callable", [&](Context& context) {
+			using Function = cs::Delegate<intcs()>;
+
+			for (const bool inlined : { true, false }) {
+				Tracked::Live = 0;
+
+				{
+					Tracked tracked;
+					tracked.Value = 7;
+					intcs padding[8] = {};
+
+					Function original = inlined
+						? Function([tracked]() mutable { return ++tracked.Value; })
+						: Function([tracked, padding]() mutable { return ++tracked.Value + padding[0]; });
+
+					DXNA_CHECK(original.IsInline() == inlined);
+					DXNA_CHECK(Tracked::Live == 2);
+
+					//Each copy has a callable, and a state, of its own.
+					Function copy = original;
+					DXNA_CHECK(Tracked::Live == 3);
+					DXNA_CHECK(original() == 8 && original() == 9 && copy() == 8);
+
+					Function moved = std::move(original);
+					DXNA_CHECK(!original && moved() == 10);
+					DXNA_CHECK(Tracked::Live == 3);
+
+					copy = moved;
+					DXNA_CHECK(Tracked::Live == 3 && copy() == 11);
+
+					moved = nullptr;
+					DXNA_CHECK(!moved && Tracked::Live == 2);
+
+					moved = std::move(copy);
+					DXNA_CHECK(!copy && moved() == 12 && Tracked::Live == 2);
+				}
+
+				DXNA_CHECK(Tracked::Live == 0);
+			}
+		});
+
+		runner.Run("EventQueue dispatches in raise order across blocks", [&](Context& context) {
+			cs::EventQueue queue;
+			const EventSender sender;
+			cs::EventHandler<EventSender, OrderArgs> small;
+			cs::EventHandler<EventSender, LargeArgs> large;
+			cs::EventHandler<EventSender, HugeArgs> huge;
+			std::vector<intcs> order;
+
+			small.Subscribe([&](OrderArgs const& e) { order.push_back(e.Sequence); });
+			large.Subscribe([&](LargeArgs const& e) { order.push_back(e.Sequence); });
+			huge.Subscribe([&](HugeArgs const& e) { order.push_back(e.Sequence); });
+
+			for (intcs pass = 0; pass < 2; ++pass) {
+				std::vector<intcs> expected;
+
+				for (intcs i = 0; i < 300; ++i) {
+					if (i == 150)
+						queue.Raise(huge, sender, HugeArgs(i));
+					else if (i % 3 == 0)
+						queue.Raise(small, sender, OrderArgs(i));
+					else
+						queue.Raise(large, sender, LargeArgs(i));
+
+					expected.push_back(i);
+				}
+
+				DXNA_CHECK(queue.Count() == 300);
+
+				order.clear();
+				DXNA_CHECK(queue.Dispatch() == 300);
+				DXNA_CHECK(order == expected);
+				DXNA_CHECK(queue.IsEmpty());
+			}
+		});
+
+		runner.Run("EventQueue defers events raised while dispatching", [&](Context& context) {
+			cs::EventQueue queue;
+			const EventSender sender;
+			OrderEvent event;
+			std::vector<intcs> order;
+
+			event.Subscribe([&](OrderArgs const& e) {
+				order.push_back(e.Sequence);
+
+				if (e.Sequence < 10)
+					queue.Raise(event, sender, OrderArgs(e.Sequence + 10));
+			});
+
+			queue.Raise(event, sender, OrderArgs(0));
+			queue.Raise(event, sender, OrderArgs(1));
+
+			DXNA_CHECK(queue.Dispatch() == 2);
+			DXNA_CHECK((order == std::vector<intcs>{ 0, 1 }));
+			DXNA_CHECK(queue.Count() == 2);
+
+			DXNA_CHECK(queue.Dispatch() == 2);
+			DXNA_CHECK((order == std::vector<intcs>{ 0, 1, 10, 11 }));
+			DXNA_CHECK(queue.Dispatch() == 0);
+		});
+
+		runner.Run("EventQueue ignores a Dispatch called by a handler", [&](Context& context) {
+			cs::EventQueue queue;
+			const EventSender sender;
+			OrderEvent event;
+			std::vector<intcs> order;
+			std::vector<size_t> nested;
+
+			event.Subscribe([&](OrderArgs const& e) {
+				order.push_back(e.Sequence);
+
+				if (e.Sequence < 10) {
+					queue.Raise(event, sender, OrderArgs(e.Sequence + 10));
+					nested.push_back(queue.Dispatch());
+				}
+			});
+
+			queue.Raise(event, sender, OrderArgs(0));
+			queue.Raise(event, sender, OrderArgs(1));
+
+			DXNA_CHECK(queue.Dispatch() == 2);
+			DXNA_CHECK((order == std::vector<intcs>{ 0, 1 }));
+			DXNA_CHECK((nested == std::vector<size_t>{ 0, 0 }));
+
+			//The events raised before the nested calls wait for the next Dispatch.
+			DXNA_CHECK(queue.Dispatch() == 2);
+			DXNA_CHECK((order == std::vector<intcs>{ 0, 1, 10, 11 }));
+			DXNA_CHECK(queue.IsEmpty());
+		});
+
+		runner.Run("EventQueue destroys the arguments it drops", [&](Context& context) {
+			Tracked::Live = 0;
+			const EventSender sender;
+			cs::EventHandler<EventSender, TrackedArgs> event;
+			intcs invoked = 0;
+			event.Subscribe([&] { ++invoked; });
+
+			{
+				cs::EventQueue queue;
+				const TrackedArgs args;
+
+				for (intcs i = 0; i < 100; ++i)
+					queue.Raise(event, sender, args);
+
+				DXNA_CHECK(Tracked::Live == 101);
+
+				queue.Clear();
+				DXNA_CHECK(invoked == 0 && queue.IsEmpty() && Tracked::Live == 1);
+
+				for (intcs i = 0; i < 10; ++i)
+					queue.Raise(event, sender, args);
+
+				DXNA_CHECK(queue.Dispatch() == 10 && invoked == 10 && Tracked::Live == 1);
+
+				queue.Raise(event, sender, args);
+			}
+
+			DXNA_CHECK(invoked == 10 && Tracked::Live == 0);
+		});
+	}
+}
@@ -0,0 +1,253 @@
+#include "test.hpp"
+#include "../src/game.hpp"
+#include "../src/headlessgamewindow.hpp"
+#include "../src/input/input.hpp"
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace dxna::input;
+
+namespace dxna::test {
+	//Counts the updates that saw a key go down, and those that saw it held.
+	class KeyGame : public Game {
+	public:
+		KeyGame(Keys key) : _key(key) {}
+
+		intcs Updates{ 0 };
+		intcs Pressed{ 0 };
+		intcs Down{ 0 };
+		bool ExitOnUpdate{ false };
+
+	protected:
+		void Update(GameTime const&) override {
+			++Updates;
+
+			if (Input::Frame().WasKeyPressed(_key))
+				++Pressed;
+
+			if (Keyboard::IsKeyDown(_key))
+				++Down;
+
+			if (ExitOnUpdate)
+				Exit();
+		}
+
+	private:
+		Keys _key;
+	};
+
+	//Counts the frames drawn, on whichever thread draws them.
+	class DrawCountGame : public Game {
+	public:
+		DrawCountGame() {
+			IsFixedTimeStep(false);
+			UseRenderThread(true);
+		}
+
+		std::atomic<intcs> Draws{ 0 };
+		//Read once the frames are drawn.
+		std::set<std::thread::id> Threads;
+
+	protected:
+		void Draw(GameTime const&) override {
+			++Draws;
+			Threads.insert(std::this_thread::get_id());
+		}
+	};
+
+	//Keeps the time every update and every draw saw.
+	class StepGame : public Game {
+	public:
+		std::vector<GameTime> Updates;
+		std::vector<GameTime> Draws;
+
+	protected:
+		void Update(GameTime const& gameTime) override { Updates.push_back(gameTime); }
+		void Draw(GameTime const& gameTime) override { Draws.push_back(gameTime); }
+	};
+
+	//Leaves the shared input with the key up and no events, for the tests after.
+	static void releaseKey(Keys key) {
+		InputProducer(Input::Queue()).KeyUp(key);
+		Input::Update();
+		Input::Update();
+	}
+
+	void GameTests(Runner& runner) {
+		runner.Run("Game reports a key press to one update of a tick", [&](Context& context) {
+			const auto clock = std::make_shared<ManualGameClock>();
+			KeyGame game(Keys::A);
+			game.Clock(clock);
+			game.RunOneFrame();
+
+			const auto updates = game.Updates;
+			InputProducer(Input::Queue()).KeyDown(Keys::A);
+			clock->Advance(cs::TimeSpan(game.TargetElapsedTime().Ticks() * 3));
+			game.RunOneFrame();
+
+			DXNA_CHECK(game.Updates - updates == 3);
+			DXNA_CHECK(game.Pressed == 1);
+			DXNA_CHECK(game.Down == 3);
+
+			releaseKey(Keys::A);
+		});
+
+		runner.Run("Game reports the queued input to the first update of Run", [&](Context& context) {
+			KeyGame game(Keys::B);
+			game.Clock(std::make_shared<ManualGameClock>());
+			game.ExitOnUpdate = true;
+
+			InputProducer(Input::Queue()).KeyDown(Keys::B);
+			game.Run();
+
+			DXNA_CHECK(game.Updates == 1);
+			DXNA_CHECK(game.Pressed == 1);
+
+			releaseKey(Keys::B);
+		});
+
+		runner.Run("Game drops the steps past MaxUpdatesPerFrame and keeps the fraction of a step", [&](Context& context) {
+			const auto clock = std::make_shared<ManualGameClock>();
+			StepGame game;
+			game.Clock(clock);
+			const auto step = game.TargetElapsedTime().Ticks();
+
+			//The first frame waits for one step.
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 1 && clock->Now().Ticks() == step);
+
+			//Eight and a half steps behind: five are run, three dropped, and the half step is kept.
+			clock->Advance(cs::TimeSpan(step * 8 + step / 2));
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 6);
+			DXNA_CHECK(game.Draws.back().ElapsedGameTime.Ticks() == step * 5);
+			DXNA_CHECK(game.Draws.back().TotalGameTime.Ticks() == step * 6);
+
+			//The next frame waits only for the other half.
+			const auto before = clock->Now();
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 7);
+			DXNA_CHECK((clock->Now() - before).Ticks() == step - step / 2);
+
+			//Under the cap, the fraction is kept too.
+			clock->Advance(cs::TimeSpan(step * 2 + step / 4));
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 9);
+
+			const auto statistics = game.FrameStatistics();
+			DXNA_CHECK(statistics.Frames() == 4);
+			DXNA_CHECK(statistics.Updates() == 9);
+			DXNA_CHECK(statistics.SkippedUpdates() == 3);
+
+			//Every fixed update advances the game time by one step.
+			bool fixed = true;
+
+			for (size_t i = 0; i < game.Updates.size(); ++i)
+				fixed = fixed && game.Updates[i].ElapsedGameTime.Ticks() == step && game.Updates[i].TotalGameTime.Ticks() == step * static_cast<int64_t>(i + 1);
+
+			DXNA_CHECK(fixed);
+		});
+
+		runner.Run("Game runs slowly after the lag threshold and recovers as the lag is paid back", [&](Context& context) {
+			const auto clock = std::make_shared<ManualGameClock>();
+			StepGame game;
+			game.Clock(clock);
+			const auto step = game.TargetElapsedTime().Ticks();
+			std::vector<bool> slow;
+			game.RunOneFrame();
+
+			const auto frame = [&](int64_t steps) {
+				clock->Advance(cs::TimeSpan(step * steps));
+				game.RunOneFrame();
+				slow.push_back(game.Updates.back().IsRunningSlowly);
+			};
+
+			//Two steps of lag, then five: over the threshold.
+			frame(3);
+			frame(4);
+			DXNA_CHECK((slow == std::vector<bool>{ false, true }));
+
+			//Frames of one step pay it back one at a time.
+			slow.clear();
+
+			for (intcs i = 0; i < 7; ++i)
+				frame(0);
+
+			DXNA_CHECK((slow == std::vector<bool>{ true, true, true, true, true, false, false }));
+			DXNA_CHECK(game.FrameStatistics().SkippedUpdates() == 0);
+		});
+
+		runner.Run("Game does not catch up past MaxElapsedTime", [&](Context& context) {
+			const auto clock = std::make_shared<ManualGameClock>();
+			StepGame game;
+			game.Clock(clock);
+			game.MaxUpdatesPerFrame(100);
+			const auto step = game.TargetElapsedTime().Ticks();
+			game.MaxElapsedTime(cs::TimeSpan(step * 3));
+
+			game.RunOneFrame();
+
+			//A ten second stall counts as three steps, none of them dropped.
+			clock->Advance(cs::TimeSpan::FromSeconds(10));
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 4);
+			DXNA_CHECK(game.Draws.back().TotalGameTime.Ticks() == step * 4);
+			DXNA_CHECK(game.FrameStatistics().SkippedUpdates() == 0);
+
+			//The frame time is measured before the clamp.
+			DXNA_CHECK(game.FrameStatistics().Max() == cs::TimeSpan::FromSeconds(10));
+
+			//Nothing is left over: the next frame waits a whole step.
+			const auto before = clock->Now();
+			game.RunOneFrame();
+			DXNA_CHECK(game.Updates.size() == 5 && (clock->Now() - before).Ticks() == step);
+		});
+
+		runner.Run("Game takes the active state of its window", [&](Context& context) {
+			const auto window = std::make_shared<HeadlessGameWindow>();
+			KeyGame game(Keys::A);
+
+			window->Deactivate();
+			game.Window(window);
+			DXNA_CHECK(!game.IsActive());
+
+			window->Activate();
+			DXNA_CHECK(game.IsActive());
+
+			window->Deactivate();
+			DXNA_CHECK(!game.IsActive());
+
+			game.Window(nullptr);
+			DXNA_CHECK(game.IsActive());
+		});
+
+		runner.Run("Game draws and presents each RunOneFrame before it returns", [&](Context& context) {
+			const auto first = std::make_shared<HeadlessGameWindow>();
+			const auto second = std::make_shared<HeadlessGameWindow>();
+			first->VSync(false);
+			second->VSync(false);
+
+			for (intcs i = 0; i < 4; ++i) {
+				//Destroyed right after its frames, without calling Shutdown.
+				DrawCountGame game;
+				game.Clock(std::make_shared<ManualGameClock>());
+				game.Window(first);
+				game.RunOneFrame();
+
+				game.Window(second);
+				game.RunOneFrame();
+				game.RunOneFrame();
+
+				DXNA_CHECK(game.Draws == 3);
+
+				//One render thread draws every frame of the game.
+				DXNA_CHECK(game.Threads.size() == 1 && game.Threads.count(std::this_thread::get_id()) == 0);
+			}
+
+			DXNA_CHECK(first->PresentCount() == 4);
+			DXNA_CHECK(second->PresentCount() == 8);
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "test.hpp"
+#include "../src/input/gamepad.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace dxna::input;
+
+namespace dxna::test {
+	static bool near(float value, float expected) {
+		return std::fabs(value - expected) < 1e-5F;
+	}
+
+	static GamePadReport stickReport(shortcs x, shortcs y) {
+		GamePadReport report;
+		report.IsConnected = true;
+		report.LeftX = x;
+		report.LeftY = y;
+		return report;
+	}
+
+	static GamePadReport buttonReport(ushortcs buttons) {
+		GamePadReport report;
+		report.IsConnected = true;
+		report.Buttons = buttons;
+		return report;
+	}
+
+	//Polls one report of each pad.
+	static std::vector<GamePadReport> poll(GamePadDevice& device) {
+		std::vector<GamePadReport> reports(GamePad::MaxCount);
+		device.Poll(reports);
+		return reports;
+	}
+
+	void GamePadTests(Runner& runner) {
+		runner.Run("GamePadState reads raw sticks without a dead zone", [&](Context& context) {
+			const GamePadState state(stickReport(16384, -32768), GamePadDeadZone::None);
+			DXNA_CHECK(state.IsConnected);
+			DXNA_CHECK(near(state.ThumbSticks.Left.X, 16384.0F / 32767.0F));
+
+			//-32768 would read below -1.
+			DXNA_CHECK(state.ThumbSticks.Left.Y == -1.0F);
+
+			const GamePadState small(stickReport(100, 32767), GamePadDeadZone::None);
+			DXNA_CHECK(near(small.ThumbSticks.Left.X, 100.0F / 32767.0F) && small.ThumbSticks.Left.Y == 1.0F);
+		});
+
+		runner.Run("GamePadState filters each axis on its own with IndependentAxes", [&](Context& context) {
+			constexpr auto zone = GamePadState::LeftThumbDeadZone;
+
+			const GamePadState rest(stickReport(7000, -7849));
+			DXNA_CHECK(rest.ThumbSticks.Left.X == 0.0F && rest.ThumbSticks.Left.Y == 0.0F);
+
+			const GamePadState full(stickReport(32767, -32768));
+			DXNA_CHECK(near(full.ThumbSticks.Left.X, 1.0F) && full.ThumbSticks.Left.Y == -1.0F);
+
+			//Rescaled so the filtered value starts at zero.
+			const GamePadState half(stickReport(16384, 0));
+			DXNA_CHECK(near(half.ThumbSticks.Left.X, (16384.0F / 32767.0F - zone) / (1.0F - zone)));
+
+			//A diagonal under the zone on each axis is dropped.
+			const GamePadState diagonal(stickReport(6000, 6000));
+			DXNA_CHECK(diagonal.ThumbSticks.Left.X == 0.0F && diagonal.ThumbSticks.Left.Y == 0.0F);
+
+			//The right stick has its own zone.
+			GamePadReport report;
+			report.RightX = 8000;
+			report.LeftX = 8000;
+			const GamePadState sticks(report);
+			DXNA_CHECK(sticks.ThumbSticks.Left.X > 0.0F && sticks.ThumbSticks.Right.X == 0.0F);
+		});
+
+		runner.Run("GamePadState keeps the direction of diagonals with Circular", [&](Context& context) {
+			constexpr auto zone = GamePadState::LeftThumbDeadZone;
+
+			//Each axis is under the zone, but the distance from the center is not.
+			const GamePadState diagonal(stickReport(6000, 6000), GamePadDeadZone::Circular);
+			const auto length = std::sqrt(2.0F) * 6000.0F / 32767.0F;
+			DXNA_CHECK(diagonal.ThumbSticks.Left.X > 0.0F && diagonal.ThumbSticks.Left.X == diagonal.ThumbSticks.Left.Y);
+			DXNA_CHECK(near(std::sqrt(2.0F) * diagonal.ThumbSticks.Left.X, (length - zone) / (1.0F - zone)));
+
+			const GamePadState skewed(stickReport(20000, -10000), GamePadDeadZone::Circular);
+			DXNA_CHECK(near(skewed.ThumbSticks.Left.X / skewed.ThumbSticks.Left.Y, -2.0F));
+
+			//A corner reaches the edge of the circle, not past it.
+			const GamePadState corner(stickReport(32767, -32768), GamePadDeadZone::Circular);
+			DXNA_CHECK(near(corner.ThumbSticks.Left.X, std::sqrt(0.5F)) && near(corner.ThumbSticks.Left.Y, -std::sqrt(0.5F)));
+
+			const GamePadState rest(stickReport(5000, -5000), GamePadDeadZone::Circular);
+			DXNA_CHECK(rest.ThumbSticks.Left.X == 0.0F && rest.ThumbSticks.Left.Y == 0.0F);
+		});
+
+		runner.Run("GamePadState drops trigger values under the threshold", [&](Context& context) {
+			GamePadReport report;
+			report.LeftTrigger = 30;
+			report.RightTrigger = 31;
+
+			const GamePadState filtered(report);
+			DXNA_CHECK(filtered.Triggers.Left == 0.0F);
+			DXNA_CHECK(near(filtered.Triggers.Right, (31.0F / 255.0F - GamePadState::TriggerThreshold) / (1.0F - GamePadState::TriggerThreshold)));
+
+			report.LeftTrigger = 255;
+			report.RightTrigger = 29;
+			const GamePadState circular(report, GamePadDeadZone::Circular);
+			DXNA_CHECK(near(circular.Triggers.Left, 1.0F) && circular.Triggers.Right == 0.0F);
+
+			//Without a dead zone the triggers are raw too.
+			const GamePadState raw(report, GamePadDeadZone::None);
+			DXNA_CHECK(near(raw.Triggers.Right, 29.0F / 255.0F));
+		});
+
+		runner.Run("VirtualGamePad plays a script, then holds its last report", [&](Context& context) {
+			VirtualGamePad device;
+			device.Play(PlayerIndex::Two, { buttonReport(1), buttonReport(2), buttonReport(3) });
+			DXNA_CHECK(device.IsPlaying(PlayerIndex::Two));
+
+			std::vector<ushortcs> buttons;
+			std::vector<uintcs> packets;
+
+			for (intcs i = 0; i < 5; ++i) {
+				const auto reports = poll(device);
+				buttons.push_back(reports[1].Buttons);
+				packets.push_back(reports[1].PacketNumber);
+				DXNA_CHECK(!reports[0].IsConnected);
+			}
+
+			DXNA_CHECK((buttons == std::vector<ushortcs>{ 1, 2, 3, 3, 3 }));
+			DXNA_CHECK((packets == std::vector<uintcs>{ 1, 2, 3, 3, 3 }));
+			DXNA_CHECK(!device.IsPlaying(PlayerIndex::Two));
+
+			//Setting the pad stops a script.
+			device.Play(PlayerIndex::Two, { buttonReport(8), buttonReport(9) });
+			poll(device);
+			device.Press(PlayerIndex::Two, ButtonValues::A);
+			DXNA_CHECK(!device.IsPlaying(PlayerIndex::Two));
+			DXNA_CHECK(poll(device)[1].Buttons == (8 | static_cast<ushortcs>(ButtonValues::A)));
+		});
+
+		runner.Run("VirtualGamePad starts a looped script over", [&](Context& context) {
+			VirtualGamePad device;
+			device.Play(PlayerIndex::One, { buttonReport(1), buttonReport(2), buttonReport(3) }, true);
+
+			std::vector<ushortcs> buttons;
+			uintcs packet = 0;
+			bool advanced = true;
+
+			for (intcs i = 0; i < 7; ++i) {
+				const auto report = poll(device)[0];
+				buttons.push_back(report.Buttons);
+				advanced = advanced && report.PacketNumber == packet + 1;
+				packet = report.PacketNumber;
+			}
+
+			DXNA_CHECK((buttons == std::vector<ushortcs>{ 1, 2, 3, 1, 2, 3, 1 }));
+			DXNA_CHECK(advanced && device.IsPlaying(PlayerIndex::One));
+		});
+
+		runner.Run("VirtualGamePad advances the packet number on every change", [&](Context& context) {
+			VirtualGamePad device;
+			const auto player = PlayerIndex::Three;
+			uintcs packet = device.GetReport(player).PacketNumber;
+
+			const auto changed = [&] {
+				const auto next = device.GetReport(player).PacketNumber;
+				const auto result = next == packet + 1;
+				packet = next;
+				return result;
+			};
+
+			device.Connect(player);
+			DXNA_CHECK(changed() && device.GetReport(player).IsConnected);
+
+			device.Press(player, ButtonValues::B);
+			DXNA_CHECK(changed() && device.GetReport(player).Buttons == static_cast<ushortcs>(ButtonValues::B));
+
+			device.Release(player, ButtonValues::B);
+			DXNA_CHECK(changed() && device.GetReport(player).Buttons == 0);
+
+			device.SetThumbSticks(player, Vector2(1.0F, -2.0F), Vector2(0.5F, 0.0F));
+			DXNA_CHECK(changed());
+			DXNA_CHECK(device.GetReport(player).LeftX == 32767 && device.GetReport(player).LeftY == -32767);
+			DXNA_CHECK(device.GetReport(player).RightX == 16383);
+
+			device.SetTriggers(player, 0.5F, 2.0F);
+			DXNA_CHECK(changed());
+			DXNA_CHECK(device.GetReport(player).LeftTrigger == 128 && device.GetReport(player).RightTrigger == 255);
+
+			//The packet number of the report set is ignored.
+			auto report = buttonReport(4);
+			report.PacketNumber = 1000;
+			device.SetReport(player, report);
+			DXNA_CHECK(changed() && device.GetReport(player).Buttons == 4);
+
+			//Polling without a change keeps it.
+			poll(device);
+			DXNA_CHECK(device.GetReport(player).PacketNumber == packet);
+		});
+
+		runner.Run("GamePad updates every pad from its device", [&](Context& context) {
+			VirtualGamePad device;
+
+			for (size_t i = 0; i < GamePad::MaxCount; ++i) {
+				auto report = stickReport(static_cast<shortcs>(10000 + i * 1000), 0);
+				report.Buttons = static_cast<ushortcs>(1 << i);
+				device.SetReport(static_cast<PlayerIndex>(i), report);
+			}
+
+			GamePad::Device(&device);
+			GamePad::Update();
+			DXNA_CHECK(GamePad::Device() == &device);
+
+			const auto states = GamePad::GetStates();
+			bool filled = true;
+
+			for (size_t i = 0; i < GamePad::MaxCount; ++i) {
+				const auto player = static_cast<PlayerIndex>(i);
+				const auto& report = device.GetReport(player);
+
+				filled = filled && states[i].IsConnected && states[i].Buttons == (1 << i)
+					&& states[i] == GamePadState(report)
+					&& GamePad::GetState(player) == states[i]
+					&& GamePad::GetState(player, GamePadDeadZone::None) == GamePadState(report, GamePadDeadZone::None);
+			}
+
+			DXNA_CHECK(filled);
+			DXNA_CHECK(GamePad::GetState(static_cast<PlayerIndex>(GamePad::MaxCount)) == GamePadState());
+
+			//Without a device every pad is disconnected.
+			GamePad::Device(nullptr);
+			GamePad::Update();
+
+			bool cleared = true;
+
+			for (size_t i = 0; i < GamePad::MaxCount; ++i)
+				cleared = cleared && GamePad::GetStates()[i] == GamePadState();
+
+			DXNA_CHECK(cleared);
+		});
+	}
+}
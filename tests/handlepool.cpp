@@ -0,0 +1,198 @@
+#include "test.hpp"
+#include "../src/graphics/handlepool.hpp"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	struct Throwing {
+		Throwing(bool fail, intcs value) : Value(value) {
+			if (fail)
+				throw std::runtime_error("construction failed");
+		}
+
+		intcs Value;
+	};
+
+	//Counts the objects alive, to check when a pool destroys them.
+	struct Counted {
+		static inline intcs Live = 0;
+
+		Counted(intcs value) : Value(value) { ++Live; }
+		~Counted() { --Live; }
+
+		intcs Value;
+	};
+
+	struct HandlePoolAccess {
+		template <typename T>
+		static void Generation(HandlePool<T>& pool, uintcs index, uintcs generation) {
+			pool._slots[index].Generation = generation;
+		}
+	};
+
+	static bool createFails(HandlePool<Throwing>& pool) {
+		try {
+			pool.Create(true, 0);
+			return false;
+		}
+		catch (std::runtime_error const&) {
+			return true;
+		}
+	}
+
+	void HandlePoolTests(Runner& runner) {
+		//The slot the constructor would have taken is the one the next object gets.
+		runner.Run("HandlePool keeps the slot of a constructor that throws", [&](Context& context) {
+			HandlePool<Throwing> pool(1);
+
+			DXNA_CHECK(createFails(pool));
+			DXNA_CHECK(pool.Count() == 0);
+
+			const auto first = pool.Create(false, 1);
+			DXNA_CHECK(first.Index == 0);
+
+			pool.Release(first);
+			pool.EndFrame();
+
+			DXNA_CHECK(createFails(pool));
+			DXNA_CHECK(pool.Count() == 0);
+
+			const auto second = pool.Create(false, 2);
+			DXNA_CHECK(second.Index == 0 && second.Generation == first.Generation + 1);
+			DXNA_CHECK(pool.Get(second)->Value == 2);
+			DXNA_CHECK(pool.Capacity() == HandlePool<Throwing>::PageSize);
+		});
+
+		runner.Run("HandlePool finds the handle of its objects only", [&](Context& context) {
+			HandlePool<Throwing> pool;
+			std::vector<Handle<Throwing>> handles;
+
+			for (intcs i = 0; i < 150; ++i)
+				handles.push_back(pool.Create(false, i));
+
+			for (const auto& handle : handles)
+				DXNA_CHECK(pool.HandleOf(pool.Get(handle)) == handle);
+
+			const Throwing outside(false, 0);
+			DXNA_CHECK(pool.HandleOf(&outside).IsNull());
+			DXNA_CHECK(pool.HandleOf(nullptr).IsNull());
+
+			const auto released = pool.Get(handles[70]);
+			pool.Release(handles[70]);
+			DXNA_CHECK(pool.HandleOf(released).IsNull());
+		});
+
+		runner.Run("HandlePool makes a released handle stale at once", [&](Context& context) {
+			Counted::Live = 0;
+			HandlePool<Counted> pool;
+
+			const auto kept = pool.Create(1);
+			const auto released = pool.Create(2);
+			DXNA_CHECK(pool.Count() == 2 && pool.IsValid(released));
+
+			DXNA_CHECK(pool.Release(released));
+			DXNA_CHECK(!pool.IsValid(released) && pool.Get(released) == nullptr);
+			DXNA_CHECK(!pool.Release(released));
+			DXNA_CHECK(pool.Count() == 1 && pool.RetiredCount() == 1);
+			DXNA_CHECK(pool.Get(kept)->Value == 1);
+
+			DXNA_CHECK(!pool.IsValid(Handle<Counted>()));
+			DXNA_CHECK(!pool.IsValid(Handle<Counted>{ 1000, 1 }));
+			DXNA_CHECK(!pool.Release(Handle<Counted>()));
+
+			//Still alive until its frames are over.
+			DXNA_CHECK(Counted::Live == 2);
+		});
+
+		runner.Run("HandlePool destroys released objects after the frames in flight", [&](Context& context) {
+			Counted::Live = 0;
+
+			{
+				HandlePool<Counted> pool(3);
+				const auto first = pool.Create(1);
+				pool.Create(2);
+
+				pool.Release(first);
+
+				pool.EndFrame();
+				pool.EndFrame();
+				DXNA_CHECK(Counted::Live == 2 && pool.RetiredCount() == 1);
+
+				pool.EndFrame();
+				DXNA_CHECK(Counted::Live == 1 && pool.RetiredCount() == 0);
+
+				//The freed slot is reused, with a new generation.
+				const auto reused = pool.Create(3);
+				DXNA_CHECK(reused.Index == first.Index && reused.Generation != first.Generation);
+				DXNA_CHECK(!pool.IsValid(first) && pool.Get(reused)->Value == 3);
+
+				//Flush destroys without waiting for the frames.
+				pool.Release(reused);
+				DXNA_CHECK(Counted::Live == 2);
+				pool.Flush();
+				DXNA_CHECK(Counted::Live == 1 && pool.RetiredCount() == 0);
+
+				//The pool destroys the live and the released objects it still has.
+				pool.Release(pool.Create(4));
+				DXNA_CHECK(Counted::Live == 2);
+			}
+
+			DXNA_CHECK(Counted::Live == 0);
+		});
+
+		runner.Run("HandlePool releases a shared handle with its last copy", [&](Context& context) {
+			Counted::Live = 0;
+			HandlePool<Counted> pool(1);
+			const auto handle = pool.Create(5);
+
+			{
+				auto shared = pool.Share(handle);
+				DXNA_CHECK(shared && shared->Value == 5);
+
+				auto copy = shared;
+				shared.reset();
+				DXNA_CHECK(pool.IsValid(handle) && copy->Value == 5);
+			}
+
+			DXNA_CHECK(!pool.IsValid(handle) && pool.RetiredCount() == 1);
+			DXNA_CHECK(Counted::Live == 1);
+			DXNA_CHECK(pool.Share(handle) == nullptr);
+
+			pool.EndFrame();
+			DXNA_CHECK(Counted::Live == 0);
+		});
+
+		runner.Run("HandlePool never reuses a slot at its last generation", [&](Context& context) {
+			Counted::Live = 0;
+			HandlePool<Counted> pool(1);
+
+			const auto first = pool.Create(1);
+			pool.Release(first);
+			pool.Flush();
+
+			HandlePoolAccess::Generation(pool, first.Index, std::numeric_limits<uintcs>::max() - 1);
+
+			const auto last = pool.Create(2);
+			DXNA_CHECK(last.Index == first.Index && last.Generation == std::numeric_limits<uintcs>::max() - 1);
+
+			pool.Release(last);
+			pool.EndFrame();
+			DXNA_CHECK(Counted::Live == 0);
+
+			//The slot is retired for good: the next objects take new slots.
+			const auto next = pool.Create(3);
+			const auto after = pool.Create(4);
+			DXNA_CHECK(next.Index != first.Index && after.Index != first.Index);
+			DXNA_CHECK(!pool.IsValid(first) && !pool.IsValid(last));
+			DXNA_CHECK(!pool.IsValid(Handle<Counted>{ first.Index, std::numeric_limits<uintcs>::max() }));
+			DXNA_CHECK(!pool.IsValid(Handle<Counted>{ first.Index, 0 }));
+
+			pool.Release(next);
+			pool.Release(after);
+			pool.Flush();
+		});
+	}
+}
\ No newline at end of file
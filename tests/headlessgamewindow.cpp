@@ -0,0 +1,132 @@
+#include "test.hpp"
+#include "../src/headlessgamewindow.hpp"
+#include <chrono>
+#include <thread>
+
+namespace dxna::test {
+	//Sets the orientations like a graphics device manager would.
+	class OrientedWindow : public HeadlessGameWindow {
+	public:
+		using HeadlessGameWindow::SetSupportedOrientations;
+	};
+
+	void HeadlessGameWindowTests(Runner& runner) {
+		runner.Run("HeadlessGameWindow raises ClientSizeChanged only when the size changes", [&](Context& context) {
+			HeadlessGameWindow window(320, 240);
+			intcs changes = 0;
+			const auto token = window.ClientSizeChanged.Subscribe([&] { ++changes; });
+
+			DXNA_CHECK(window.ClientBounds() == Rectangle(0, 0, 320, 240));
+
+			//Moving keeps the size.
+			window.ClientBounds(Rectangle(10, 20, 320, 240));
+			DXNA_CHECK(changes == 0 && window.ClientBounds() == Rectangle(10, 20, 320, 240));
+
+			window.ClientBounds(Rectangle(10, 20, 640, 240));
+			window.ClientBounds(Rectangle(10, 20, 640, 480));
+			DXNA_CHECK(changes == 2 && window.ClientBounds() == Rectangle(10, 20, 640, 480));
+
+			window.ClientBounds(Rectangle(10, 20, 640, 480));
+			DXNA_CHECK(changes == 2);
+		});
+
+		runner.Run("HeadlessGameWindow only takes the supported orientations", [&](Context& context) {
+			OrientedWindow window;
+			intcs changes = 0;
+			const auto token = window.OrientationChanged.Subscribe([&] { ++changes; });
+
+			//Default supports every orientation.
+			window.CurrentOrientation(DisplayOrientation::Portrait);
+			DXNA_CHECK(changes == 1 && window.CurrentOrientation() == DisplayOrientation::Portrait);
+
+			window.SetSupportedOrientations(static_cast<DisplayOrientation>(
+				static_cast<int>(DisplayOrientation::LandscapeLeft) | static_cast<int>(DisplayOrientation::LandscapeRight)));
+
+			window.CurrentOrientation(DisplayOrientation::LandscapeRight);
+			DXNA_CHECK(changes == 2 && window.CurrentOrientation() == DisplayOrientation::LandscapeRight);
+
+			window.CurrentOrientation(DisplayOrientation::Portrait);
+			DXNA_CHECK(changes == 2 && window.CurrentOrientation() == DisplayOrientation::LandscapeRight);
+
+			//Setting the orientation it has raises nothing.
+			window.CurrentOrientation(DisplayOrientation::LandscapeRight);
+			DXNA_CHECK(changes == 2);
+
+			//Default is always taken.
+			window.CurrentOrientation(DisplayOrientation::Default);
+			DXNA_CHECK(changes == 3 && window.CurrentOrientation() == DisplayOrientation::Default);
+		});
+
+		runner.Run("HeadlessGameWindow raises Activated and Deactivated only on a change", [&](Context& context) {
+			HeadlessGameWindow window;
+			intcs activated = 0;
+			intcs deactivated = 0;
+			const auto onActivated = window.Activated.Subscribe([&] { ++activated; });
+			const auto onDeactivated = window.Deactivated.Subscribe([&] { ++deactivated; });
+
+			//It starts with the focus.
+			DXNA_CHECK(window.IsActive());
+			window.Activate();
+			DXNA_CHECK(activated == 0);
+
+			window.Deactivate();
+			window.Deactivate();
+			DXNA_CHECK(!window.IsActive() && deactivated == 1);
+
+			window.Activate();
+			window.Activate();
+			DXNA_CHECK(window.IsActive() && activated == 1 && deactivated == 1);
+		});
+
+		runner.Run("HeadlessGameWindow waits for the next refresh on Present with VSync", [&](Context& context) {
+			HeadlessGameWindow window;
+			DXNA_CHECK(window.VSync() && window.RefreshRate() == HeadlessGameWindow::DefaultRefreshRate);
+
+			window.RefreshRate(0);
+			DXNA_CHECK(window.RefreshRate() == HeadlessGameWindow::DefaultRefreshRate);
+
+			//At 100 Hz, five presents end on five boundaries, at least four periods apart.
+			window.RefreshRate(100);
+			auto start = std::chrono::steady_clock::now();
+
+			for (intcs i = 0; i < 5; ++i)
+				window.Present();
+
+			DXNA_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(40));
+
+			//Without VSync, Present returns at once.
+			window.VSync(false);
+			start = std::chrono::steady_clock::now();
+
+			for (intcs i = 0; i < 5; ++i)
+				window.Present();
+
+			DXNA_CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(40));
+			DXNA_CHECK(window.PresentCount() == 10);
+		});
+
+		runner.Run("HeadlessGameWindow counts the frames another thread presents", [&](Context& context) {
+			HeadlessGameWindow window;
+			window.VSync(false);
+
+			std::thread presenter([&] {
+				for (intcs i = 0; i < 10000; ++i)
+					window.Present();
+			});
+
+			//Read while the other thread presents, so a sanitizer sees the race if there is one.
+			ulongcs last = 0;
+			bool increasing = true;
+
+			while (last < 10000) {
+				const auto count = window.PresentCount();
+				increasing = increasing && count >= last;
+				last = count;
+				std::this_thread::yield();
+			}
+
+			presenter.join();
+			DXNA_CHECK(increasing && window.PresentCount() == 10000);
+		});
+	}
+}
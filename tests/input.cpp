@@ -0,0 +1,127 @@
+#include "test.hpp"
+#include "../src/game.hpp"
+#include "../src/input/input.hpp"
+#include "../src/input/inputrecorder.hpp"
+#include <vector>
+
+using namespace dxna::input;
+
+namespace dxna::test {
+	//Keeps the input every update saw, and records it when given a recorder.
+	class InputGame : public Game {
+	public:
+		InputRecorder* Recorder{ nullptr };
+		std::vector<InputRecord> Frames;
+
+	protected:
+		void Update(GameTime const& gameTime) override {
+			if (Recorder != nullptr)
+				Recorder->Record(gameTime);
+
+			Frames.push_back({ gameTime.ElapsedGameTime, Keyboard::GetState(), Mouse::GetState() });
+		}
+	};
+
+	//Keys, buttons, moves and scrolls now and then, some still held at the end.
+	static void produceInput(InputProducer& producer, intcs frame) {
+		if (frame % 7 == 0)
+			producer.KeyDown(static_cast<Keys>(static_cast<intcs>(Keys::A) + frame / 7 % 5));
+
+		if (frame % 11 == 0)
+			producer.KeyUp(static_cast<Keys>(static_cast<intcs>(Keys::A) + frame / 11 % 5));
+
+		if (frame % 5 == 0)
+			producer.MoveMouse(frame, frame * 2);
+
+		if (frame % 13 == 0)
+			producer.Scroll(120);
+
+		if (frame % 17 == 0)
+			producer.Press(MouseButton::Left);
+		else if (frame % 17 == 8)
+			producer.Release(MouseButton::Left);
+	}
+
+	//Leaves the shared input with nothing held, for the tests after.
+	static void releaseInput() {
+		InputProducer producer(Input::Queue());
+		const auto& frame = Input::Frame();
+		const auto mouse = frame.GetMouseState();
+		Keys keys[KeyboardState::KeyCount];
+
+		for (size_t i = 0, count = frame.GetKeyboardState().GetPressedKeys(keys); i < count; ++i)
+			producer.KeyUp(keys[i]);
+
+		for (int i = 0; i < 5; ++i)
+			producer.Release(static_cast<MouseButton>(i));
+
+		producer.MoveMouse(0, 0);
+		producer.Scroll(static_cast<intcs>(-mouse.Wheel));
+		Input::Update();
+		Input::Update();
+	}
+
+	void InputTests(Runner& runner) {
+		//The second replay starts with the keys, button and wheel the first one left.
+		runner.Run("InputReplay replays every frame twice in one process", [&](Context& context) {
+			constexpr intcs FrameCount = 120;
+
+			cs::MemoryStream recording(0);
+			InputRecorder recorder(&recording);
+			InputProducer producer(Input::Queue());
+			const auto clock = std::make_shared<ManualGameClock>();
+			InputGame recorded;
+			recorded.Clock(clock);
+			recorded.Recorder = &recorder;
+
+			for (intcs frame = 0; frame < FrameCount; ++frame) {
+				produceInput(producer, frame);
+				clock->Advance(recorded.TargetElapsedTime());
+				recorded.RunOneFrame();
+			}
+
+			DXNA_CHECK(recorded.Frames.size() == static_cast<size_t>(FrameCount));
+			DXNA_CHECK(recorded.Frames.back().Keyboard.GetPressedKeyCount() > 0);
+			DXNA_CHECK(recorded.Frames.back().Mouse.Wheel != 0);
+
+			for (intcs run = 0; run < 2; ++run) {
+				//Input the recording never saw, queued before the replay.
+				producer.KeyDown(Keys::Z);
+				producer.Scroll(-360);
+
+				recording.Position(0);
+				InputReplay replay(&recording);
+				InputGame replayed;
+
+				DXNA_CHECK(!replay.Run(replayed).HasError());
+
+				if (!DXNA_CHECK(replayed.Frames.size() == recorded.Frames.size()))
+					continue;
+
+				size_t mismatches = 0;
+
+				for (size_t i = 0; i < recorded.Frames.size(); ++i) {
+					if (!(replayed.Frames[i].Keyboard == recorded.Frames[i].Keyboard && replayed.Frames[i].Mouse == recorded.Frames[i].Mouse))
+						++mismatches;
+				}
+
+				if (!DXNA_CHECK(mismatches == 0))
+					std::printf("    run %d: %zu of %zu frames differ\n", run + 1, mismatches, recorded.Frames.size());
+			}
+
+			releaseInput();
+		});
+
+		//There is no such key to hold down, on the state or on the shared keyboard.
+		runner.Run("Input keys out of range are up", [&](Context& context) {
+			const KeyboardState state({ Keys::A });
+
+			for (const auto key : { KeyboardState::KeyCount, KeyboardState::KeyCount + 64, static_cast<size_t>(-1) }) {
+				DXNA_CHECK(!state.IsKeyDown(key));
+				DXNA_CHECK(state.IsKeyUp(key));
+				DXNA_CHECK(!Keyboard::IsKeyDown(key));
+				DXNA_CHECK(Keyboard::IsKeyUp(key));
+			}
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "test.hpp"
+#include "../src/cs/cstypes.hpp"
+#include "../src/jobsystem.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dxna::test {
+	//Whether every counter from first on was incremented exactly once.
+	static bool allOnce(std::vector<std::atomic<intcs>> const& counts, size_t first = 0) {
+		for (auto i = first; i < counts.size(); ++i) {
+			if (counts[i].load() != 1)
+				return false;
+		}
+
+		return true;
+	}
+
+	void JobSystemTests(Runner& runner) {
+		runner.Run("JobSystem deque hands every item to exactly one thread", [&](Context& context) {
+			constexpr intcs Count = 200000;
+			constexpr intcs Thieves = 3;
+
+			std::vector<intcs> items(Count);
+			std::vector<std::atomic<intcs>> taken(Count);
+			WorkStealingQueue<intcs, 256> queue;
+			std::atomic<bool> done{ false };
+
+			for (intcs i = 0; i < Count; ++i)
+				items[i] = i;
+
+			std::vector<std::thread> thieves;
+
+			for (intcs t = 0; t < Thieves; ++t) {
+				thieves.emplace_back([&] {
+					while (!done.load(std::memory_order_acquire) || queue.Count() > 0) {
+						if (auto item = queue.Steal())
+							++taken[*item];
+					}
+				});
+			}
+
+			//The owner pops every other round, so pops race the thieves for the last items.
+			for (intcs i = 0; i < Count;) {
+				if (queue.Push(&items[i]))
+					++i;
+				else if (auto item = queue.Pop())
+					++taken[*item];
+
+				if (i % 2 == 0) {
+					if (auto item = queue.Pop())
+						++taken[*item];
+				}
+			}
+
+			while (auto item = queue.Pop())
+				++taken[*item];
+
+			done.store(true, std::memory_order_release);
+
+			for (auto& thief : thieves)
+				thief.join();
+
+			DXNA_CHECK(queue.Count() == 0);
+			DXNA_CHECK(allOnce(taken));
+		});
+
+		runner.Run("JobSystem ParallelFor visits every index once", [&](Context& context) {
+			JobSystem system(3);
+
+			for (const size_t grainSize : { 0, 1, 3, 7, 13, 999, 1001 }) {
+				constexpr size_t Begin = 17;
+				constexpr size_t End = 1017;
+
+				std::vector<std::atomic<intcs>> counts(End);
+				std::atomic<bool> outside{ false };
+
+				system.ParallelFor(Begin, End, [&](size_t first, size_t last) {
+					if (first >= last || first < Begin || last > End)
+						outside = true;
+
+					for (auto i = first; i < last; ++i)
+						++counts[i];
+				}, grainSize);
+
+				DXNA_CHECK(!outside);
+
+				for (size_t i = 0; i < Begin; ++i)
+					DXNA_CHECK(counts[i] == 0);
+
+				DXNA_CHECK(allOnce(counts, Begin));
+			}
+
+			intcs calls = 0;
+			system.ParallelFor(5, 5, [&](size_t, size_t) { ++calls; });
+			system.ParallelFor(6, 5, [&](size_t, size_t) { ++calls; });
+			DXNA_CHECK(calls == 0);
+		});
+
+		runner.Run("JobSystem Wait covers the children of its jobs", [&](Context& context) {
+			for (const size_t workers : { 0, 1, 4 }) {
+				JobSystem system(workers);
+				JobCounter counter;
+				std::atomic<intcs> parents{ 0 };
+				std::atomic<intcs> children{ 0 };
+				std::atomic<intcs> grandchildren{ 0 };
+
+				for (intcs i = 0; i < 8; ++i) {
+					system.Run(counter, [&] {
+						++parents;
+
+						for (intcs j = 0; j < 8; ++j) {
+							system.Run(counter, [&] {
+								++children;
+
+								for (intcs k = 0; k < 4; ++k)
+									system.Run(counter, [&] { ++grandchildren; });
+							});
+						}
+					});
+				}
+
+				system.Wait(counter);
+
+				DXNA_CHECK(counter.IsDone());
+				DXNA_CHECK(parents == 8);
+				DXNA_CHECK(children == 64);
+				DXNA_CHECK(grandchildren == 256);
+			}
+		});
+
+		runner.Run("JobSystem nests Wait and ParallelFor inside jobs", [&](Context& context) {
+			JobSystem system(3);
+			std::vector<std::atomic<intcs>> counts(64 * 64);
+
+			system.ParallelFor(0, 64, [&](size_t first, size_t last) {
+				for (auto row = first; row < last; ++row) {
+					system.ParallelFor(0, 64, [&, row](size_t begin, size_t end) {
+						for (auto column = begin; column < end; ++column)
+							++counts[row * 64 + column];
+					}, 5);
+				}
+			}, 3);
+
+			DXNA_CHECK(allOnce(counts));
+		});
+
+		runner.Run("JobSystem runs jobs started from outside threads", [&](Context& context) {
+			JobSystem system(2);
+			std::vector<std::atomic<intcs>> counts(4 * 1000);
+			std::vector<std::thread> threads;
+			JobCounter shared;
+
+			for (size_t t = 0; t < 4; ++t) {
+				threads.emplace_back([&, t] {
+					//Half waits on its own counter from the outside thread, half is waited for by the test.
+					JobCounter own;
+
+					for (size_t i = 0; i < 1000; ++i)
+						system.Run(i % 2 == 0 ? own : shared, [&counts, t, i] { ++counts[t * 1000 + i]; });
+
+					system.Wait(own);
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+
+			system.Wait(shared);
+			DXNA_CHECK(allOnce(counts));
+		});
+
+		runner.Run("JobSystem runs every job once under steal contention", [&](Context& context) {
+			constexpr size_t Count = 3 * JobSystem::JobPoolSize;
+
+			JobSystem system(7);
+			std::vector<std::atomic<intcs>> counts(Count);
+			JobCounter counter;
+
+			//One job fills its worker's deque past its capacity while the others steal from it.
+			system.Run(counter, [&] {
+				for (size_t i = 0; i < Count; ++i)
+					system.Run(counter, [&counts, i] { ++counts[i]; });
+			});
+
+			system.Wait(counter);
+			DXNA_CHECK(allOnce(counts));
+		});
+
+		runner.Run("JobSystem runs the queued jobs when destroyed", [&](Context& context) {
+			for (const size_t workers : { 0, 2 }) {
+				std::atomic<intcs> ran{ 0 };
+				JobCounter counter;
+
+				{
+					JobSystem system(workers);
+
+					for (intcs i = 0; i < 500; ++i) {
+						system.Run(counter, [&] {
+							std::this_thread::yield();
+							++ran;
+						});
+					}
+				}
+
+				DXNA_CHECK(ran == 500);
+				DXNA_CHECK(counter.IsDone());
+			}
+		});
+	}
+}
@@ -0,0 +1,43 @@
+#include "test.hpp"
+#include <cstring>
+
+using namespace dxna::test;
+
+//Usage: dxna_tests [--filter text] [--update]
+int main(int argc, char* argv[]) {
+	Runner runner;
+
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			runner.Filter(argv[++i]);
+		else if (std::strcmp(argv[i], "--update") == 0)
+			runner.Update(true);
+		else {
+			std::fprintf(stderr, "usage: %s [--filter text] [--update]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	ActionMapTests(runner);
+	AnimationTests(runner);
+	CurveTests(runner);
+	EventBusTests(runner);
+	EventTests(runner);
+	GameTests(runner);
+	GamePadTests(runner);
+	HandlePoolTests(runner);
+	HeadlessGameWindowTests(runner);
+	InputTests(runner);
+	JobSystemTests(runner);
+	MemoryArenaTests(runner);
+	PixelConverterTests(runner);
+	ProfilerTests(runner);
+	RenderQueueTests(runner);
+	ResourceRegistryTests(runner);
+	SoftwareBackendTests(runner);
+	SpriteBatchTests(runner);
+	TextureTests(runner);
+
+	std::printf("%zu of %zu tests failed\n", runner.Failed(), runner.Count());
+	return runner.Failed() == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "test.hpp"
+#include "../src/memoryarena.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace dxna::test {
+	static bool isAligned(void const* pointer, size_t alignment) {
+		return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+	}
+
+	struct ArenaPoint {
+		int X;
+		int Y;
+	};
+
+	void MemoryArenaTests(Runner& runner) {
+		runner.Run("MemoryArena bumps through a chunk and counts its use", [&](Context& context) {
+			MemoryArena arena(1024);
+			DXNA_CHECK(arena.Statistics().Capacity == 0 && arena.Statistics().Used == 0);
+
+			const auto first = static_cast<std::byte*>(arena.Allocate(96));
+			const auto second = static_cast<std::byte*>(arena.Allocate(160));
+			DXNA_CHECK(second == first + 96);
+			DXNA_CHECK(isAligned(first, 64));
+
+			const auto point = arena.New<ArenaPoint>(ArenaPoint{ 1, 2 });
+			DXNA_CHECK(point->X == 1 && point->Y == 2 && isAligned(point, alignof(ArenaPoint)));
+
+			const auto values = arena.NewArray<int>(10);
+			DXNA_CHECK(values.size() == 10 && values[0] == 0 && values[9] == 0);
+
+			const auto statistics = arena.Statistics();
+			DXNA_CHECK(statistics.Used == 256 + sizeof(ArenaPoint) + 10 * sizeof(int));
+			DXNA_CHECK(statistics.Capacity == 1024);
+			DXNA_CHECK(statistics.ChunkCount == 1 && statistics.ChunkAllocations == 1);
+		});
+
+		runner.Run("MemoryArena puts a new chunk before a kept chunk too small", [&](Context& context) {
+			MemoryArena arena(1024);
+			const auto start = arena.Mark();
+
+			arena.Allocate(1000);
+			arena.Allocate(1000);
+			DXNA_CHECK(arena.Statistics().ChunkCount == 2);
+
+			//The second chunk is kept, but cannot take 4000 bytes.
+			arena.Rewind(start);
+			arena.Allocate(1000);
+			const auto large = arena.Allocate(4000);
+			DXNA_CHECK(large != nullptr);
+
+			auto statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkCount == 3 && statistics.ChunkAllocations == 3);
+			DXNA_CHECK(statistics.Capacity == 1024 + 4000 + 1024);
+			DXNA_CHECK(statistics.Used == 1024 + 4000);
+
+			//The small chunk comes after the new one, and is used before going to the heap.
+			arena.Allocate(1000);
+			statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkAllocations == 3);
+			DXNA_CHECK(statistics.Used == 1024 + 4000 + 1000);
+		});
+
+		runner.Run("MemoryArena rewinds to a marker across chunks", [&](Context& context) {
+			MemoryArena arena(1024);
+			arena.Allocate(512);
+
+			const auto marker = arena.Mark();
+			const auto used = arena.Statistics().Used;
+			const auto afterMarker = arena.Allocate(256);
+
+			for (int i = 0; i < 8; ++i)
+				arena.Allocate(800);
+
+			DXNA_CHECK(arena.Statistics().ChunkCount > 2);
+
+			arena.Rewind(marker);
+			DXNA_CHECK(arena.Statistics().Used == used);
+			DXNA_CHECK(arena.Allocate(256) == afterMarker);
+
+			//The chunks are kept: filling them again does not allocate.
+			const auto allocations = arena.Statistics().ChunkAllocations;
+
+			for (int i = 0; i < 8; ++i)
+				arena.Allocate(800);
+
+			DXNA_CHECK(arena.Statistics().ChunkAllocations == allocations);
+
+			//Scopes rewind on the arena they were given.
+			const auto beforeScope = arena.Statistics().Used;
+
+			{
+				ScratchScope scope(arena);
+				scope.Arena().Allocate(5000);
+			}
+
+			DXNA_CHECK(arena.Statistics().Used == beforeScope);
+		});
+
+		runner.Run("MemoryArena merges its chunks on Reset", [&](Context& context) {
+			MemoryArena arena(1024);
+
+			for (int i = 0; i < 5; ++i)
+				arena.Allocate(1000);
+
+			auto statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkCount == 5 && statistics.Capacity == 5 * 1024);
+
+			arena.Reset();
+			statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkCount == 1 && statistics.Capacity == 5 * 1024);
+			DXNA_CHECK(statistics.ChunkAllocations == 6 && statistics.Used == 0);
+
+			//The same use now fits in the merged chunk, frame after frame.
+			for (int frame = 0; frame < 3; ++frame) {
+				for (int i = 0; i < 5; ++i)
+					arena.Allocate(1000);
+
+				arena.Reset();
+			}
+
+			statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkCount == 1 && statistics.ChunkAllocations == 6);
+		});
+
+		runner.Run("MemoryArena keeps the high water mark over rewinds and resets", [&](Context& context) {
+			MemoryArena arena(1024);
+			const auto start = arena.Mark();
+
+			arena.Allocate(96);
+			arena.Allocate(160);
+			arena.Rewind(start);
+			DXNA_CHECK(arena.Statistics().Used == 0 && arena.Statistics().HighWaterMark == 256);
+
+			//The unused end of a full chunk counts as used.
+			arena.Allocate(512);
+			arena.Allocate(1000);
+			DXNA_CHECK(arena.Statistics().Used == 1024 + 1000);
+			DXNA_CHECK(arena.Statistics().HighWaterMark == 1024 + 1000);
+
+			arena.Reset();
+			arena.Allocate(64);
+			DXNA_CHECK(arena.Statistics().Used == 64 && arena.Statistics().HighWaterMark == 1024 + 1000);
+		});
+
+		runner.Run("MemoryArena aligns beyond a cache line", [&](Context& context) {
+			MemoryArena arena(1024);
+
+			for (const size_t alignment : { 128, 256, 4096, 16384 }) {
+				arena.Allocate(3, 1);
+				const auto data = arena.Allocate(10, alignment);
+				DXNA_CHECK(isAligned(data, alignment));
+
+				//The next allocation does not overlap it.
+				const auto next = static_cast<std::byte*>(arena.Allocate(1, 1));
+				DXNA_CHECK(next < static_cast<std::byte*>(data) || next >= static_cast<std::byte*>(data) + 10);
+			}
+
+			MemoryArena fresh(64);
+			DXNA_CHECK(isAligned(fresh.Allocate(64, 8192), 8192));
+		});
+
+		runner.Run("MemoryArena backs std::pmr containers", [&](Context& context) {
+			MemoryArena arena(4096);
+
+			for (int frame = 0; frame < 3; ++frame) {
+				{
+					std::pmr::vector<int> values(&arena);
+
+					for (int i = 0; i < 1000; ++i)
+						values.push_back(i * frame);
+
+					bool matches = values.size() == 1000;
+
+					for (int i = 0; i < 1000 && matches; ++i)
+						matches = values[i] == i * frame;
+
+					DXNA_CHECK(matches);
+					DXNA_CHECK(arena.Statistics().Used >= 1000 * sizeof(int));
+				}
+
+				arena.Reset();
+			}
+
+			//Only the first frame grew the arena; its chunks were merged at the first Reset.
+			const auto statistics = arena.Statistics();
+			DXNA_CHECK(statistics.ChunkCount == 1);
+			DXNA_CHECK(statistics.HighWaterMark >= 1000 * sizeof(int));
+		});
+	}
+}
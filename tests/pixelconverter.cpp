@@ -0,0 +1,135 @@
+#include "test.hpp"
+#include "../src/graphics/pixelconverter.hpp"
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	//Lengths around the widths of the SIMD loops, so every tail is converted too, and one past
+	//the chunk ToVector4 uses for Bgra32.
+	static const std::vector<size_t> lengths = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 300 };
+
+	//Pixels whose channels go through every byte value once the count reaches 256.
+	static std::vector<uintcs> pattern(size_t count) {
+		std::vector<uintcs> pixels(count);
+
+		for (size_t i = 0; i < count; ++i) {
+			const auto value = static_cast<uintcs>(i * 37 + 11);
+			pixels[i] = (value & 0xFF) | ((value * 3 + 1) & 0xFF) << 8 | ((value * 7 + 5) & 0xFF) << 16 | ((value * 13 + 2) & 0xFF) << 24;
+		}
+
+		return pixels;
+	}
+
+	static uintcs swapped(uintcs pixel) {
+		return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+	}
+
+	void PixelConverterTests(Runner& runner) {
+		runner.Run("PixelConverter swaps red and blue at every length", [&](Context& context) {
+			for (const auto count : lengths) {
+				const auto pixels = pattern(count);
+				std::vector<uintcs> result(count);
+				PixelConverter::SwapRedBlue(pixels.data(), result.data(), count);
+
+				bool same = true;
+
+				for (size_t i = 0; i < count; ++i)
+					same = same && result[i] == swapped(pixels[i]);
+
+				//In place, swapping back restores the pixels.
+				PixelConverter::SwapRedBlue(result.data(), result.data(), count);
+				DXNA_CHECK(same && result == pixels);
+			}
+		});
+
+		runner.Run("PixelConverter unpacks and packs RGBA8 at every length", [&](Context& context) {
+			for (const auto count : lengths) {
+				const auto pixels = pattern(count);
+				std::vector<float> floats(count * 4);
+				PixelConverter::UnpackRgba8(pixels.data(), floats.data(), count);
+
+				bool scaled = true;
+
+				for (size_t i = 0; i < count; ++i) {
+					for (intcs channel = 0; channel < 4; ++channel)
+						scaled = scaled && floats[i * 4 + channel] == ((pixels[i] >> (channel * 8)) & 0xFF) * (1.0F / 255.0F);
+				}
+
+				std::vector<uintcs> packed(count);
+				PixelConverter::PackRgba8(floats.data(), packed.data(), count);
+				DXNA_CHECK(scaled && packed == pixels);
+			}
+		});
+
+		runner.Run("PixelConverter clamps and rounds the floats it packs", [&](Context& context) {
+			for (const auto count : lengths) {
+				std::vector<float> floats;
+
+				for (size_t i = 0; i < count; ++i)
+					floats.insert(floats.end(), { -0.5F, 1.5F, 0.5F, 1.0F / 255.0F * 0.49F });
+
+				std::vector<uintcs> packed(count);
+				PixelConverter::PackRgba8(floats.data(), packed.data(), count);
+				DXNA_CHECK((packed == std::vector<uintcs>(count, 0x0080FF00)));
+			}
+		});
+
+		runner.Run("PixelConverter converts Color and Bgra32 through Vector4", [&](Context& context) {
+			for (const auto count : lengths) {
+				const auto colors = pattern(count);
+				std::vector<uintcs> bgra(count);
+
+				for (size_t i = 0; i < count; ++i)
+					bgra[i] = swapped(colors[i]);
+
+				std::vector<float> expected(count * 4);
+				PixelConverter::UnpackRgba8(colors.data(), expected.data(), count);
+
+				//Both formats read as the same floats in RGBA order.
+				std::vector<float> fromColor(count * 4);
+				std::vector<float> fromBgra(count * 4);
+				PixelConverter::ToVector4(SurfaceFormat::Color, colors.data(), fromColor.data(), count);
+				PixelConverter::ToVector4(SurfaceFormat::Bgra32, bgra.data(), fromBgra.data(), count);
+				DXNA_CHECK(fromColor == expected && fromBgra == expected);
+
+				std::vector<uintcs> toColor(count);
+				std::vector<uintcs> toBgra(count);
+				PixelConverter::FromVector4(SurfaceFormat::Color, expected.data(), toColor.data(), count);
+				PixelConverter::FromVector4(SurfaceFormat::Bgra32, expected.data(), toBgra.data(), count);
+				DXNA_CHECK(toColor == colors && toBgra == bgra);
+
+				//Vector4 is copied as is, in place too.
+				std::vector<float> copy(count * 4);
+				PixelConverter::ToVector4(SurfaceFormat::Vector4, expected.data(), copy.data(), count);
+				PixelConverter::FromVector4(SurfaceFormat::Vector4, copy.data(), copy.data(), count);
+				DXNA_CHECK(copy == expected);
+			}
+		});
+
+		runner.Run("PixelConverter premultiplies alpha at every length", [&](Context& context) {
+			for (const auto count : lengths) {
+				const auto pixels = pattern(count);
+				std::vector<uintcs> result(count);
+				PixelConverter::PremultiplyAlpha(pixels.data(), result.data(), count);
+
+				bool rounded = true;
+
+				for (size_t i = 0; i < count; ++i) {
+					const auto alpha = pixels[i] >> 24;
+					uintcs expected = alpha << 24;
+
+					//c * alpha / 255 is never halfway between two integers, so this rounds to nearest.
+					for (intcs channel = 0; channel < 3; ++channel)
+						expected |= ((((pixels[i] >> (channel * 8)) & 0xFF) * alpha + 127) / 255) << (channel * 8);
+
+					rounded = rounded && result[i] == expected;
+				}
+
+				auto inPlace = pixels;
+				PixelConverter::PremultiplyAlpha(inPlace.data(), inPlace.data(), count);
+				DXNA_CHECK(rounded && inPlace == result);
+			}
+		});
+	}
+}
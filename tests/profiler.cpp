@@ -0,0 +1,309 @@
+#include "test.hpp"
+#include "../src/profiler.hpp"
+#include "../src/cs/stream.hpp"
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dxna::test {
+	struct TraceEvent {
+		ProfileEventType Type;
+		std::string Name;
+		ulongcs Start;
+		//Duration of a zone, as recorded otherwise.
+		ulongcs Value;
+	};
+
+	struct TraceThread {
+		ulongcs Id;
+		std::string Name;
+		std::vector<TraceEvent> Events;
+	};
+
+	struct BinaryTrace {
+		double TicksPerSecond{ 0 };
+		std::vector<std::string> Names;
+		std::vector<TraceThread> Threads;
+
+		TraceThread const* Thread(std::string const& name) const {
+			for (const auto& thread : Threads) {
+				if (thread.Name == name)
+					return &thread;
+			}
+
+			return nullptr;
+		}
+	};
+
+	//Reads the format written by Profiler::WriteBinary, and fails on anything left over or missing.
+	class TraceReader {
+	public:
+		TraceReader(std::span<bytecs const> data) : _data(data) {}
+
+		bool Read(BinaryTrace& trace) {
+			if (_data.size() < 20 || std::memcmp(_data.data(), "DXNAPROF", 8) != 0)
+				return false;
+
+			uintcs version;
+			std::memcpy(&version, _data.data() + 8, sizeof(version));
+			std::memcpy(&trace.TicksPerSecond, _data.data() + 12, sizeof(trace.TicksPerSecond));
+			_position = 20;
+
+			if (version != 1)
+				return false;
+
+			const auto nameCount = varint();
+
+			for (ulongcs i = 0; i < nameCount && _valid; ++i)
+				trace.Names.push_back(string());
+
+			const auto threadCount = varint();
+
+			for (ulongcs t = 0; t < threadCount && _valid; ++t) {
+				TraceThread thread;
+				thread.Id = varint();
+				thread.Name = string();
+
+				const auto eventCount = varint();
+				ulongcs previous = 0;
+
+				for (ulongcs i = 0; i < eventCount && _valid; ++i) {
+					TraceEvent event;
+					event.Type = static_cast<ProfileEventType>(byte());
+
+					const auto name = varint();
+					_valid = _valid && name < trace.Names.size();
+
+					if (!_valid)
+						break;
+
+					event.Name = trace.Names[name];
+
+					const auto zigzag = varint();
+					previous += static_cast<ulongcs>(static_cast<longcs>(zigzag >> 1) ^ -static_cast<longcs>(zigzag & 1));
+					event.Start = previous;
+					event.Value = varint();
+					thread.Events.push_back(event);
+				}
+
+				trace.Threads.push_back(thread);
+			}
+
+			return _valid && _position == _data.size();
+		}
+
+	private:
+		bytecs byte() {
+			if (_position >= _data.size()) {
+				_valid = false;
+				return 0;
+			}
+
+			return _data[_position++];
+		}
+
+		ulongcs varint() {
+			ulongcs value = 0;
+
+			for (intcs shift = 0; shift < 64 && _valid; shift += 7) {
+				const auto next = byte();
+				value |= static_cast<ulongcs>(next & 0x7F) << shift;
+
+				if ((next & 0x80) == 0)
+					return value;
+			}
+
+			_valid = false;
+			return 0;
+		}
+
+		std::string string() {
+			const auto length = varint();
+
+			if (!_valid || _data.size() - _position < length) {
+				_valid = false;
+				return std::string();
+			}
+
+			std::string text(reinterpret_cast<char const*>(_data.data() + _position), length);
+			_position += length;
+			return text;
+		}
+
+		std::span<bytecs const> _data;
+		size_t _position{ 0 };
+		bool _valid{ true };
+	};
+
+	static bool exportBinary(BinaryTrace& trace) {
+		cs::MemoryStream stream(0);
+		Profiler::WriteBinary(stream);
+
+		std::span<bytecs const> buffer;
+		stream.TryGetBuffer(buffer);
+		return TraceReader(buffer).Read(trace);
+	}
+
+	static std::string exportChromeTrace() {
+		cs::MemoryStream stream(0);
+		Profiler::WriteChromeTrace(stream);
+
+		std::span<bytecs const> buffer;
+		stream.TryGetBuffer(buffer);
+		return std::string(reinterpret_cast<char const*>(buffer.data()), buffer.size());
+	}
+
+	static bool sameEvent(TraceEvent const& event, ProfileEventType type, char const* name, ulongcs start, ulongcs value) {
+		return event.Type == type && event.Name == name && event.Start == start && event.Value == value;
+	}
+
+	static bool contains(std::string const& text, char const* part) {
+		return text.find(part) != std::string::npos;
+	}
+
+	void ProfilerTests(Runner& runner) {
+		runner.Run("Profiler writes the events of each thread in the binary format", [&](Context& context) {
+			Profiler::Clear();
+			Profiler::ThreadName("profiler main");
+
+			//Zones are recorded when they end: the outer one starts before the inner one, and the delta goes back.
+			Profiler::Zone("inner", 1000, 1500);
+			Profiler::Zone("outer", 900, 2000);
+			Profiler::Zone("outer", 5000000000ULL, 5000000001ULL);
+			Profiler::Zone("inner", 10, 20);
+
+			std::thread recorder([] {
+				Profiler::ThreadName("profiler worker");
+				Profiler::Zone("inner", 300, 310);
+				Profiler::Counter("load", 0.75);
+			});
+
+			recorder.join();
+
+			BinaryTrace trace;
+			DXNA_CHECK(exportBinary(trace));
+			DXNA_CHECK(trace.TicksPerSecond > 0);
+			DXNA_CHECK(trace.Threads.size() == 2);
+
+			//Names are stored once for all threads.
+			DXNA_CHECK((trace.Names == std::vector<std::string>{ "inner", "outer", "load" }));
+
+			const auto main = trace.Thread("profiler main");
+			const auto worker = trace.Thread("profiler worker");
+			DXNA_CHECK(main != nullptr && worker != nullptr);
+
+			if (main != nullptr && worker != nullptr) {
+				DXNA_CHECK(main->Id != worker->Id);
+				DXNA_CHECK(main->Events.size() == 4);
+				DXNA_CHECK(worker->Events.size() == 2);
+
+				if (main->Events.size() == 4) {
+					DXNA_CHECK(sameEvent(main->Events[0], ProfileEventType::Zone, "inner", 1000, 500));
+					DXNA_CHECK(sameEvent(main->Events[1], ProfileEventType::Zone, "outer", 900, 1100));
+					DXNA_CHECK(sameEvent(main->Events[2], ProfileEventType::Zone, "outer", 5000000000ULL, 1));
+					DXNA_CHECK(sameEvent(main->Events[3], ProfileEventType::Zone, "inner", 10, 10));
+				}
+
+				if (worker->Events.size() == 2) {
+					DXNA_CHECK(sameEvent(worker->Events[0], ProfileEventType::Zone, "inner", 300, 10));
+
+					const auto& counter = worker->Events[1];
+					double value;
+					std::memcpy(&value, &counter.Value, sizeof(value));
+					DXNA_CHECK(counter.Type == ProfileEventType::Counter && counter.Name == "load" && value == 0.75);
+				}
+			}
+
+			Profiler::Clear();
+		});
+
+		runner.Run("Profiler escapes the names in the Chrome trace", [&](Context& context) {
+			Profiler::Clear();
+			Profiler::ThreadName("profiler \"main\"");
+			Profiler::Zone("quote \" backslash \\ line\n tab\t", 100, 250);
+			Profiler::Counter("count", 3.0);
+			Profiler::Frame();
+
+			const auto json = exportChromeTrace();
+			DXNA_CHECK(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+			DXNA_CHECK(json.size() >= 3 && json.compare(json.size() - 3, 3, "]}\n") == 0);
+			DXNA_CHECK(contains(json, "\"args\":{\"name\":\"profiler \\\"main\\\"\"}"));
+			DXNA_CHECK(contains(json, "{\"name\":\"quote \\\" backslash \\\\ line\\n tab\\u0009\",\"ph\":\"X\""));
+			DXNA_CHECK(contains(json, "\"args\":{\"value\":3}"));
+			DXNA_CHECK(contains(json, "\"ph\":\"i\",\"s\":\"g\""));
+			DXNA_CHECK(contains(json, "\"args\":{\"frame\":0}"));
+
+			//The trace starts at the earliest event, and durations are in microseconds.
+			const auto duration = 150 * 1e6 / Profiler::TicksPerSecond();
+			char expected[64];
+			std::snprintf(expected, sizeof(expected), "\"ts\":0.000,\"dur\":%.3f", duration);
+			DXNA_CHECK(contains(json, expected));
+
+			//No raw control character is left.
+			bool raw = false;
+
+			for (const auto c : json)
+				raw = raw || (static_cast<unsigned char>(c) < 0x20 && c != '\n');
+
+			DXNA_CHECK(!raw);
+			Profiler::Clear();
+		});
+
+		runner.Run("Profiler exports an ended thread once, then reuses its buffers", [&](Context& context) {
+			Profiler::Clear();
+			Profiler::Zone("running", 1, 2);
+
+			std::thread first([] {
+				Profiler::ThreadName("profiler first");
+
+				for (ulongcs i = 0; i < 3; ++i)
+					Profiler::Zone("first", i * 10, i * 10 + 5);
+			});
+
+			first.join();
+
+			BinaryTrace trace;
+			DXNA_CHECK(exportBinary(trace));
+			DXNA_CHECK(trace.Thread("profiler first") != nullptr && trace.Thread("profiler first")->Events.size() == 3);
+
+			//The ended thread is gone from the next export; the running one is written again.
+			const auto json = exportChromeTrace();
+			DXNA_CHECK(!contains(json, "profiler first"));
+			DXNA_CHECK(contains(json, "\"running\""));
+
+			//A new thread starts with no events, whether or not it took the buffers of the first.
+			std::thread second([] {
+				Profiler::ThreadName("profiler second");
+				Profiler::Zone("second", 40, 45);
+			});
+
+			second.join();
+
+			trace = BinaryTrace();
+			DXNA_CHECK(exportBinary(trace));
+			DXNA_CHECK(trace.Thread("profiler first") == nullptr);
+
+			const auto thread = trace.Thread("profiler second");
+			DXNA_CHECK(thread != nullptr && thread->Events.size() == 1);
+
+			if (thread != nullptr && thread->Events.size() == 1)
+				DXNA_CHECK(sameEvent(thread->Events[0], ProfileEventType::Zone, "second", 40, 5));
+
+			//Events of an ended thread cleared before any export are never written.
+			std::thread cleared([] {
+				Profiler::ThreadName("profiler cleared");
+				Profiler::Zone("cleared", 1, 2);
+			});
+
+			cleared.join();
+			Profiler::Clear();
+
+			trace = BinaryTrace();
+			DXNA_CHECK(exportBinary(trace));
+			DXNA_CHECK(trace.Threads.empty());
+		});
+	}
+}
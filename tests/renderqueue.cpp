@@ -0,0 +1,158 @@
+#include "test.hpp"
+#include "../src/graphics/graphics.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	//Sorts a copy of the entries both ways and compares the order of the indices.
+	template <typename TKey>
+	static bool sortsLikeStableSort(std::vector<RadixEntry<TKey>> entries) {
+		auto expected = entries;
+		std::stable_sort(expected.begin(), expected.end(), [](RadixEntry<TKey> const& left, RadixEntry<TKey> const& right) {
+			return left.Key < right.Key;
+		});
+
+		std::vector<RadixEntry<TKey>> scratch(entries.size());
+		const auto sorted = RadixSort(entries.data(), scratch.data(), entries.size());
+
+		for (size_t i = 0; i < entries.size(); ++i) {
+			if (sorted[i].Key != expected[i].Key || sorted[i].Index != expected[i].Index)
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename TKey, typename TFunc>
+	static std::vector<RadixEntry<TKey>> radixEntries(size_t count, TFunc&& key) {
+		std::vector<RadixEntry<TKey>> entries(count);
+
+		for (size_t i = 0; i < count; ++i)
+			entries[i] = { key(i), static_cast<uint32_t>(i) };
+
+		return entries;
+	}
+
+	static std::vector<float> submittedDepths(RenderQueue& queue) {
+		queue.Sort();
+
+		std::vector<float> depths;
+
+		for (const auto index : queue.SubmissionOrder())
+			depths.push_back(queue.At(index).Depth);
+
+		return depths;
+	}
+
+	void RenderQueueTests(Runner& runner) {
+		runner.Run("RadixSort orders like std::stable_sort", [&](Context& context) {
+			std::mt19937_64 random(7);
+
+			//Few distinct keys, so stability decides the order of most entries.
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(5000, [&](size_t) { return random() % 16; })));
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(5000, [&](size_t) { return random(); })));
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<uintcs>(5000, [&](size_t) { return static_cast<uintcs>(random()); })));
+
+			//Only the middle digits differ: the low and high ones are skipped.
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(5000, [&](size_t) {
+				return 0xAB00000000000005ULL | (random() % 1000) << 24;
+			})));
+
+			//One digit only, and every key the same.
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(3000, [&](size_t) { return random() % 2048; })));
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(3000, [&](size_t) { return 42ULL; })));
+
+			//Already sorted and reversed.
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(3000, [&](size_t i) { return static_cast<ulongcs>(i) << 40; })));
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(3000, [&](size_t i) { return ~static_cast<ulongcs>(i); })));
+
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(1, [&](size_t) { return 3ULL; })));
+			DXNA_CHECK(sortsLikeStableSort(radixEntries<ulongcs>(0, [&](size_t) { return 3ULL; })));
+		});
+
+		runner.Run("RenderQueue draws opaque front to back and transparent back to front", [&](Context& context) {
+			RenderQueue queue;
+
+			for (const auto depth : { 5.0F, 0.5F, 100.0F, 2.0F }) {
+				RenderItem item;
+				item.Depth = depth;
+				queue.Add(item);
+
+				item.Bucket = RenderBucket::Transparent;
+				item.Depth = depth + 1.0F;
+				queue.Add(item);
+			}
+
+			DXNA_CHECK((submittedDepths(queue) == std::vector<float>{ 0.5F, 2.0F, 5.0F, 100.0F, 101.0F, 6.0F, 3.0F, 1.5F }));
+		});
+
+		runner.Run("RenderQueue orders by layer, then groups opaque draws by state", [&](Context& context) {
+			RenderQueue queue;
+			BlendState first;
+			BlendState second;
+
+			const auto add = [&](bytecs layer, BlendState const* blend, float depth, RenderBucket bucket) {
+				RenderItem item;
+				item.Layer = layer;
+				item.Blend = blend;
+				item.Depth = depth;
+				item.Bucket = bucket;
+				queue.Add(item);
+			};
+
+			//The first state seen gets the lower id, so its draws come first.
+			add(0, &first, 4.0F, RenderBucket::Opaque);
+			add(0, &second, 1.0F, RenderBucket::Opaque);
+			add(0, &first, 2.0F, RenderBucket::Opaque);
+			add(0, &second, 3.0F, RenderBucket::Opaque);
+			add(1, &first, 0.25F, RenderBucket::Opaque);
+			add(0, &second, 7.0F, RenderBucket::Transparent);
+			add(0, &first, 8.0F, RenderBucket::Transparent);
+
+			DXNA_CHECK((submittedDepths(queue) == std::vector<float>{ 2.0F, 4.0F, 1.0F, 3.0F, 8.0F, 7.0F, 0.25F }));
+
+			//Negative depths count as zero, and equal keys keep the order they were added in.
+			queue.Clear();
+			add(0, nullptr, -1.0F, RenderBucket::Opaque);
+			add(0, nullptr, 0.0F, RenderBucket::Opaque);
+			add(0, nullptr, -2.0F, RenderBucket::Opaque);
+
+			DXNA_CHECK((submittedDepths(queue) == std::vector<float>{ -1.0F, 0.0F, -2.0F }));
+			DXNA_CHECK(RenderQueue::QuantizeDepth(1.0F) < RenderQueue::QuantizeDepth(1.5F));
+			DXNA_CHECK(RenderQueue::QuantizeDepth(-3.0F) == 0);
+		});
+
+		runner.Run("RenderQueue records only the state changes it needs", [&](Context& context) {
+			RenderQueue queue;
+			BlendState blend;
+			DepthStencilState depthStencil;
+
+			for (intcs i = 0; i < 4; ++i) {
+				RenderItem item;
+				item.Blend = &blend;
+				item.DepthStencil = &depthStencil;
+				item.Depth = static_cast<float>(i);
+				item.PrimitiveCount = 1;
+				queue.Add(item);
+			}
+
+			CommandList commandList;
+			queue.Submit(commandList);
+
+			size_t states = 0;
+			size_t draws = 0;
+
+			for (const auto& command : commandList.Commands()) {
+				if (command.Type == CommandType::Draw)
+					++draws;
+				else
+					++states;
+			}
+
+			DXNA_CHECK(draws == 4 && states == 2);
+		});
+	}
+}
@@ -0,0 +1,201 @@
+#include "test.hpp"
+#include "../src/graphics/graphics.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	//A resource whose whole content can be evicted.
+	class EvictableResource : public GraphicsResource {
+	public:
+		EvictableResource(ResourceType type, std::string const& name, size_t bytes) : GraphicsResource(type), _bytes(bytes) {
+			Name(name);
+			ReportSize(bytes, true);
+		}
+
+		~EvictableResource() override { ReportSize(0); }
+
+		intcs Evictions{ 0 };
+
+	protected:
+		size_t EvictContent() override {
+			++Evictions;
+
+			const auto bytes = _bytes;
+			_bytes = 0;
+			return bytes;
+		}
+
+	private:
+		size_t _bytes;
+	};
+
+	//Budgets the shared registry for one test, and records what it evicts.
+	class RegistryScope {
+	public:
+		RegistryScope() : Registry(ResourceRegistry::Shared()) {
+			_token = Registry.Evicted.Subscribe([this](ResourceEvictedEventArgs const& e) { Evicted.push_back(e); });
+		}
+
+		~RegistryScope() {
+			Registry.Evicted.Unsubscribe(_token);
+			Registry.Budget(ResourceRegistry::Unlimited);
+
+			for (size_t type = 0; type < ResourceTypeCount; ++type)
+				Registry.Budget(static_cast<ResourceType>(type), ResourceRegistry::Unlimited);
+
+			Registry.FramesInFlight(ResourceRegistry::DefaultFramesInFlight);
+		}
+
+		//Ends enough frames for everything touched so far to leave the frames in flight.
+		void Retire() {
+			for (ulongcs i = 0; i < Registry.FramesInFlight(); ++i)
+				Registry.EndFrame();
+		}
+
+		ResourceRegistry& Registry;
+		std::vector<ResourceEvictedEventArgs> Evicted;
+
+	private:
+		cs::EventToken _token;
+	};
+
+	//The ids of the resources among ids, in the order of ResourceRegistry::Resources.
+	static std::vector<ResourceId> resourceOrder(std::vector<ResourceId> const& ids) {
+		std::vector<ResourceId> order;
+
+		for (const auto& info : ResourceRegistry::Shared().Resources()) {
+			if (std::find(ids.begin(), ids.end(), info.Id) != ids.end())
+				order.push_back(info.Id);
+		}
+
+		return order;
+	}
+
+	void ResourceRegistryTests(Runner& runner) {
+		runner.Run("ResourceRegistry evicts the least recently used first", [&](Context& context) {
+			RegistryScope scope;
+			EvictableResource a(ResourceType::Shader, "a", 100);
+			EvictableResource b(ResourceType::Shader, "b", 100);
+			EvictableResource c(ResourceType::Shader, "c", 100);
+
+			b.Touch();
+			scope.Registry.EndFrame();
+			c.Touch();
+			scope.Registry.EndFrame();
+			a.Touch();
+			scope.Retire();
+
+			DXNA_CHECK((resourceOrder({ a.Id(), b.Id(), c.Id() }) == std::vector<ResourceId>{ b.Id(), c.Id(), a.Id() }));
+
+			scope.Registry.Budget(ResourceType::Shader, 150);
+			DXNA_CHECK(scope.Registry.EndFrame() == 200);
+
+			DXNA_CHECK(a.Evictions == 0 && b.Evictions == 1 && c.Evictions == 1);
+			DXNA_CHECK(a.SizeInBytes() == 100 && b.SizeInBytes() == 0 && c.SizeInBytes() == 0);
+			DXNA_CHECK(scope.Evicted.size() == 2);
+
+			if (scope.Evicted.size() == 2) {
+				DXNA_CHECK(scope.Evicted[0].Resource == b.Id() && scope.Evicted[0].Name == "b");
+				DXNA_CHECK(scope.Evicted[1].Resource == c.Id() && scope.Evicted[1].Name == "c");
+				DXNA_CHECK(scope.Evicted[0].Type == ResourceType::Shader && scope.Evicted[0].Bytes == 100);
+			}
+
+			const auto report = scope.Registry.Report();
+			DXNA_CHECK(report.Types[static_cast<size_t>(ResourceType::Shader)].Bytes == 100);
+
+			//Within the budget, nothing more is evicted.
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+		});
+
+		runner.Run("ResourceRegistry keeps resources used by frames in flight", [&](Context& context) {
+			RegistryScope scope;
+			scope.Registry.FramesInFlight(3);
+
+			EvictableResource resource(ResourceType::Shader, "in flight", 64);
+			resource.Touch();
+			scope.Registry.Budget(0);
+
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+			DXNA_CHECK(resource.Evictions == 0);
+
+			//Touching it again restarts the frames it is kept for.
+			resource.Touch();
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+			DXNA_CHECK(resource.Evictions == 0);
+
+			DXNA_CHECK(scope.Registry.EndFrame() == 64);
+			DXNA_CHECK(resource.Evictions == 1);
+		});
+
+		runner.Run("ResourceRegistry meets each type budget with its own type", [&](Context& context) {
+			RegistryScope scope;
+			EvictableResource oldEffect(ResourceType::Effect, "effect", 1000);
+			scope.Registry.EndFrame();
+			EvictableResource shader(ResourceType::Shader, "shader", 10);
+			EvictableResource newEffect(ResourceType::Effect, "new effect", 1000);
+			scope.Retire();
+
+			//The older effect is left alone: only the shaders are over their budget.
+			scope.Registry.Budget(ResourceType::Shader, 5);
+			DXNA_CHECK(scope.Registry.EnforceBudgets() == 10);
+			DXNA_CHECK(shader.Evictions == 1 && oldEffect.Evictions == 0 && newEffect.Evictions == 0);
+
+			//The total budget takes the least recently used of any type.
+			scope.Registry.Budget(1500);
+			DXNA_CHECK(scope.Registry.EnforceBudgets() == 1000);
+			DXNA_CHECK(oldEffect.Evictions == 1 && newEffect.Evictions == 0);
+
+			const auto report = scope.Registry.Report();
+			DXNA_CHECK(report.Types[static_cast<size_t>(ResourceType::Shader)].Budget == 5);
+			DXNA_CHECK(report.Types[static_cast<size_t>(ResourceType::Effect)].Budget == ResourceRegistry::Unlimited);
+			DXNA_CHECK(report.Budget == 1500);
+		});
+
+		runner.Run("ResourceRegistry reports the name set last", [&](Context& context) {
+			RegistryScope scope;
+			EvictableResource resource(ResourceType::Shader, "first", 8);
+			resource.Name("second");
+
+			const auto copy = resource;
+			DXNA_CHECK(copy.Name() == "second" && copy.Id() != resource.Id());
+
+			std::string name;
+
+			for (const auto& info : scope.Registry.Resources()) {
+				if (info.Id == resource.Id())
+					name = info.Name;
+			}
+
+			DXNA_CHECK(name == "second");
+		});
+
+		runner.Run("ResourceRegistry evicts the texels of a Texture2D", [&](Context& context) {
+			RegistryScope scope;
+			Texture2D texture(nullptr, 16, 16);
+			std::vector<Color> colors(16 * 16, Color(1, 2, 3, 4));
+
+			DXNA_CHECK(!texture.SetData(colors.data(), colors.size()).HasError());
+			DXNA_CHECK(texture.SizeInBytes() == 16 * 16 * 4);
+			scope.Retire();
+
+			scope.Registry.Budget(ResourceType::Texture, 0);
+			DXNA_CHECK(scope.Registry.EndFrame() == 16 * 16 * 4);
+			DXNA_CHECK(texture.IsEvicted() && texture.SizeInBytes() == 0);
+			DXNA_CHECK(texture.GetData(colors.data(), colors.size()) == ErrorCode::GRAPHICS_RESOURCE_EVICTED);
+
+			//SetData loads it back, and the touch keeps it for the frames in flight.
+			scope.Registry.Budget(ResourceType::Texture, ResourceRegistry::Unlimited);
+			DXNA_CHECK(!texture.SetData(colors.data(), colors.size()).HasError());
+			DXNA_CHECK(!texture.GetData(colors.data(), colors.size()).HasError());
+			DXNA_CHECK(colors[255] == Color(1, 2, 3, 4));
+
+			scope.Registry.Budget(ResourceType::Texture, 0);
+			DXNA_CHECK(scope.Registry.EndFrame() == 0);
+			DXNA_CHECK(!texture.IsEvicted());
+		});
+	}
+}
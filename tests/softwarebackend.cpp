@@ -0,0 +1,302 @@
+#include "test.hpp"
+#include "../src/graphics/graphics.hpp"
+#include "../src/graphics/softwarebackend.hpp"
+#include "../src/graphics/spritebatch.hpp"
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	//Two by two tiles, so the scenes cross tile edges.
+	static constexpr intcs Width = 128;
+	static constexpr intcs Height = 96;
+	//Largest difference of a channel, and the share of pixels that may exceed it, before an image
+	//differs from its reference: edges may round differently on other compilers and SIMD paths.
+	static constexpr intcs ChannelTolerance = 2;
+	static constexpr double PixelTolerance = 0.005;
+
+	struct Scene {
+		char const* Name;
+		std::function<void(GraphicsDevicePtr const&)> Draw;
+	};
+
+	static std::vector<uintcs> render(Scene const& scene, intcs threadCount) {
+		auto backend = std::make_shared<SoftwareBackend>(Width, Height, threadCount);
+		auto device = std::make_shared<GraphicsDevice>(backend);
+		device->Viewport(Viewport(0, 0, Width, Height));
+
+		device->BeginFrame();
+		scene.Draw(device);
+		device->Present();
+
+		const auto colors = backend->Framebuffer().Colors();
+		return std::vector<uintcs>(colors, colors + static_cast<size_t>(Width) * Height);
+	}
+
+	static std::string referencePath(char const* name) {
+		return std::string(DXNA_TEST_DATA) + "/softwarebackend_" + name + ".pam";
+	}
+
+	//The images are PAM files: a text header, then the RGBA bytes of each pixel row by row.
+	static bool writeImage(std::string const& path, std::vector<uintcs> const& colors) {
+		auto file = std::fopen(path.c_str(), "wb");
+
+		if (file == nullptr)
+			return false;
+
+		std::fprintf(file, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n", Width, Height);
+
+		for (const auto packed : colors) {
+			const unsigned char pixel[4] = {
+				static_cast<unsigned char>(packed), static_cast<unsigned char>(packed >> 8),
+				static_cast<unsigned char>(packed >> 16), static_cast<unsigned char>(packed >> 24) };
+			std::fwrite(pixel, 1, sizeof(pixel), file);
+		}
+
+		return std::fclose(file) == 0;
+	}
+
+	static bool readImage(std::string const& path, std::vector<uintcs>& colors) {
+		auto file = std::fopen(path.c_str(), "rb");
+
+		if (file == nullptr)
+			return false;
+
+		int width = 0;
+		int height = 0;
+		const auto header = std::fscanf(file, "P7 WIDTH %d HEIGHT %d DEPTH 4 MAXVAL 255 TUPLTYPE RGB_ALPHA ENDHDR", &width, &height);
+
+		if (header != 2 || width != Width || height != Height || std::fgetc(file) != '\n') {
+			std::fclose(file);
+			return false;
+		}
+
+		colors.resize(static_cast<size_t>(width) * height);
+
+		for (auto& packed : colors) {
+			unsigned char pixel[4] = {};
+
+			if (std::fread(pixel, 1, sizeof(pixel), file) != sizeof(pixel)) {
+				std::fclose(file);
+				return false;
+			}
+
+			packed = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | (static_cast<uintcs>(pixel[3]) << 24);
+		}
+
+		std::fclose(file);
+		return true;
+	}
+
+	//The pixels with a channel further than ChannelTolerance from the reference.
+	static size_t countDifferences(std::vector<uintcs> const& colors, std::vector<uintcs> const& reference) {
+		size_t count = 0;
+
+		for (size_t i = 0; i < colors.size(); ++i) {
+			for (intcs shift = 0; shift < 32; shift += 8) {
+				const auto a = static_cast<intcs>((colors[i] >> shift) & 0xFF);
+				const auto b = static_cast<intcs>((reference[i] >> shift) & 0xFF);
+
+				if (std::abs(a - b) > ChannelTolerance) {
+					++count;
+					break;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	static void submit(GraphicsDevicePtr const& device, std::function<void(CommandList&)> const& record) {
+		CommandList list;
+		record(list);
+		device->Submit(list);
+	}
+
+	static Texture2DPtr solidTexture(GraphicsDevicePtr const& device, Color const& color) {
+		auto texture = std::make_shared<Texture2D>(device, 1, 1);
+		texture->SetData(&color, 1);
+		return texture;
+	}
+
+	static std::vector<Scene> scenes() {
+		std::vector<Scene> result;
+
+		//Three triangles in clip space: the middle one is drawn last but behind, and the
+		//sloped one cuts through the first.
+		result.push_back({ "depth", [](GraphicsDevicePtr const& device) {
+			static const DepthStencilState depth = DepthStencilState::Default();
+			static const BlendState opaque = BlendState::Opaque();
+			static const RasterizerState cullNone = RasterizerState::CullNone();
+			static const VertexPositionColor vertices[] = {
+				{ Vector3(-0.9F, -0.8F, 0.5F), Color(255, 0, 0) },
+				{ Vector3(0.6F, -0.8F, 0.5F), Color(255, 0, 0) },
+				{ Vector3(-0.2F, 0.9F, 0.5F), Color(255, 0, 0) },
+				{ Vector3(-0.9F, 0.7F, 0.1F), Color(0, 0, 255) },
+				{ Vector3(0.9F, 0.7F, 0.9F), Color(0, 0, 255) },
+				{ Vector3(0.9F, -0.6F, 0.9F), Color(0, 0, 255) },
+				{ Vector3(-0.5F, -0.3F, 0.7F), Color(0, 255, 0) },
+				{ Vector3(0.8F, -0.1F, 0.7F), Color(0, 255, 0) },
+				{ Vector3(0.1F, 0.6F, 0.7F), Color(0, 255, 0) },
+			};
+
+			submit(device, [](CommandList& list) {
+				list.Clear(ClearOptions::All, Colors::Black, 1.0F, 0);
+				list.SetViewport(Viewport(0, 0, Width, Height));
+				list.SetBlendState(&opaque);
+				list.SetDepthStencilState(&depth);
+				list.SetRasterizerState(&cullNone);
+				list.SetVertexData(vertices, 9);
+				list.Draw(PrimitiveType::TriangleList, 0, 3);
+			});
+		} });
+
+		//Translucent quads with alpha blending, then with additive blending.
+		result.push_back({ "blend", [](GraphicsDevicePtr const& device) {
+			const auto white = solidTexture(device, Colors::White);
+			const auto alphaBlend = std::make_shared<BlendState>(BlendState::AlphaBlend());
+			const auto additive = std::make_shared<BlendState>(BlendState::Additive());
+			SpriteBatch spriteBatch(device);
+
+			submit(device, [](CommandList& list) { list.Clear(ClearOptions::All, Colors::CornflowerBlue, 1.0F, 0); });
+
+			spriteBatch.Begin(SpriteSortMode::Deferred, alphaBlend);
+			spriteBatch.Draw(white, Rectangle(8, 8, 70, 50), Color(128, 0, 0, 128));
+			spriteBatch.Draw(white, Rectangle(40, 30, 70, 50), Color(0, 96, 0, 96));
+			spriteBatch.End();
+
+			spriteBatch.Begin(SpriteSortMode::Deferred, additive);
+			spriteBatch.Draw(white, Rectangle(30, 20, 90, 30), Color(0, 0, 200, 160));
+			spriteBatch.End();
+		} });
+
+		//Rotated quads clipped by a scissor rectangle across the tile edges.
+		result.push_back({ "scissor", [](GraphicsDevicePtr const& device) {
+			const auto white = solidTexture(device, Colors::White);
+			const auto scissor = std::make_shared<RasterizerState>(RasterizerState::CullNone());
+			scissor->ScissorTestEnable = true;
+			SpriteBatch spriteBatch(device);
+
+			submit(device, [](CommandList& list) {
+				list.Clear(ClearOptions::All, Colors::Black, 1.0F, 0);
+				list.SetScissorRectangle(Rectangle(20, 12, 80, 60));
+			});
+
+			spriteBatch.Begin(SpriteSortMode::Deferred, nullptr, nullptr, scissor);
+			spriteBatch.Draw(white, Vector2(64.0F, 48.0F), cs::Nullable<Rectangle>(), Color(255, 200, 0),
+				0.6F, Vector2(0.5F), Vector2(110.0F, 30.0F), SpriteEffects::None, 0.0F);
+			spriteBatch.Draw(white, Vector2(64.0F, 48.0F), cs::Nullable<Rectangle>(), Color(0, 160, 255),
+				-0.6F, Vector2(0.5F), Vector2(110.0F, 20.0F), SpriteEffects::None, 0.0F);
+			spriteBatch.End();
+		} });
+
+		//A 16x16 texture scaled, rotated, flipped and cut with a source rectangle, tinted.
+		result.push_back({ "textured", [](GraphicsDevicePtr const& device) {
+			auto texture = std::make_shared<Texture2D>(device, 16, 16);
+			std::vector<Color> texels(16 * 16);
+
+			for (intcs y = 0; y < 16; ++y) {
+				for (intcs x = 0; x < 16; ++x) {
+					const auto checker = ((x / 4) + (y / 4)) % 2 == 0;
+					texels[y * 16 + x] = checker ? Color(x * 16, y * 16, 255) : Color(255, 255 - x * 16, y * 8);
+				}
+			}
+
+			texture->SetData(texels.data(), texels.size());
+			SpriteBatch spriteBatch(device);
+
+			submit(device, [](CommandList& list) { list.Clear(ClearOptions::All, Colors::Black, 1.0F, 0); });
+
+			spriteBatch.Begin();
+			spriteBatch.Draw(texture, Rectangle(4, 4, 64, 64), Colors::White);
+			spriteBatch.Draw(texture, Vector2(96.0F, 56.0F), cs::Nullable<Rectangle>(), Color(255, 255, 255),
+				0.4F, Vector2(8.0F), 2.5F, SpriteEffects::FlipHorizontally, 0.0F);
+			spriteBatch.Draw(texture, Rectangle(70, 4, 48, 24), cs::Nullable<Rectangle>(Rectangle(4, 4, 8, 4)), Color(255, 128, 128),
+				0.0F, Vector2(), SpriteEffects::FlipVertically, 0.0F);
+			spriteBatch.End();
+		} });
+
+		return result;
+	}
+
+	//Covers the whole framebuffer with one triangle whose vertices all have the texture coordinate (u, v),
+	//sampling a 2x2 texture, and returns the pixel at the center.
+	static uintcs renderTexel(float u, float v) {
+		auto backend = std::make_shared<SoftwareBackend>(Width, Height, 1);
+		auto device = std::make_shared<GraphicsDevice>(backend);
+		device->Viewport(Viewport(0, 0, Width, Height));
+
+		auto texture = std::make_shared<Texture2D>(device, 2, 2);
+		const Color texels[] = { Color(255, 0, 0), Color(0, 255, 0), Color(0, 0, 255), Color(255, 255, 0) };
+		texture->SetData(texels, 4);
+
+		static const BlendState opaque = BlendState::Opaque();
+		static const RasterizerState cullNone = RasterizerState::CullNone();
+		const VertexPositionColorTexture vertices[] = {
+			{ Vector3(-1.0F, -1.0F, 0.5F), Colors::White, Vector2(u, v) },
+			{ Vector3(3.0F, -1.0F, 0.5F), Colors::White, Vector2(u, v) },
+			{ Vector3(-1.0F, 3.0F, 0.5F), Colors::White, Vector2(u, v) },
+		};
+
+		device->BeginFrame();
+		submit(device, [&](CommandList& list) {
+			list.Clear(ClearOptions::All, Colors::Black, 1.0F, 0);
+			list.SetViewport(Viewport(0, 0, Width, Height));
+			list.SetBlendState(&opaque);
+			list.SetRasterizerState(&cullNone);
+			list.SetTexture(0, texture.get());
+			list.SetVertexData(vertices, 3);
+			list.Draw(PrimitiveType::TriangleList, 0, 1);
+		});
+		device->Present();
+
+		return backend->Framebuffer().Colors()[static_cast<size_t>(Height / 2) * Width + Width / 2];
+	}
+
+	void SoftwareBackendTests(Runner& runner) {
+		for (const auto& scene : scenes()) {
+			runner.Run(std::string("SoftwareBackend reference image, ") + scene.Name, [&](Context& context) {
+				const auto colors = render(scene, 1);
+				const auto path = referencePath(scene.Name);
+
+				if (runner.Update()) {
+					DXNA_CHECK(writeImage(path, colors));
+					return;
+				}
+
+				std::vector<uintcs> reference;
+
+				if (!DXNA_CHECK(readImage(path, reference)))
+					return;
+
+				const auto differences = countDifferences(colors, reference);
+
+				if (!DXNA_CHECK(differences <= colors.size() * PixelTolerance))
+					std::printf("    %zu pixels differ from %s\n", differences, path.c_str());
+			});
+
+			//Tiles are rasterized in submission order whatever thread takes them, so the image is exact.
+			runner.Run(std::string("SoftwareBackend same image on 1 and 3 threads, ") + scene.Name, [&](Context& context) {
+				DXNA_CHECK(render(scene, 1) == render(scene, 3));
+			});
+		}
+
+		runner.Run("SoftwareBackend wraps out of range and NaN texture coordinates", [&](Context& context) {
+			const auto nan = std::numeric_limits<float>::quiet_NaN();
+			const auto infinity = std::numeric_limits<float>::infinity();
+			const uintcs texels[] = { renderTexel(0.25F, 0.25F), renderTexel(0.75F, 0.25F), renderTexel(0.25F, 0.75F), renderTexel(0.75F, 0.75F) };
+
+			DXNA_CHECK(texels[0] != texels[1] && texels[0] != texels[2] && texels[1] != texels[3]);
+			DXNA_CHECK(renderTexel(-3.25F, 2.75F) == texels[3]);
+			DXNA_CHECK(renderTexel(1e20F, -1e20F) == texels[0]);
+			DXNA_CHECK(renderTexel(5.25F, -0.25F) == texels[2]);
+
+			//Coordinates without a texel take the first one.
+			DXNA_CHECK(renderTexel(nan, nan) == texels[0]);
+			DXNA_CHECK(renderTexel(infinity, -infinity) == texels[0]);
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "test.hpp"
+#include "../src/graphics/graphics.hpp"
+#include <cstring>
+#include <deque>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	//Executes like the headless backend, and stands in for a GPU that reads the vertices of a
+	//frame until FramesInFlight later frames have begun: it keeps a copy of every region drawn
+	//and counts the regions that change while their frame is still in flight.
+	class InFlightBackend : public HeadlessBackend {
+	public:
+		InFlightBackend(ulongcs framesInFlight) : _framesInFlight(framesInFlight) {}
+
+		ulongcs Overwritten{ 0 };
+		ulongcs Regions{ 0 };
+
+		void BeginFrame() override {
+			HeadlessBackend::BeginFrame();
+			++_frame;
+
+			while (!_regions.empty() && _regions.front().Frame + _framesInFlight <= _frame)
+				_regions.pop_front();
+
+			check();
+		}
+
+		Error Execute(CommandList const& commandList) override {
+			check();
+
+			VertexPositionColorTexture const* vertices = nullptr;
+
+			for (const auto& command : commandList.Commands()) {
+				if (command.Type == CommandType::SetVertexData)
+					vertices = static_cast<VertexPositionColorTexture const*>(command.VertexData.Data);
+				else if (command.Type == CommandType::DrawIndexed && vertices != nullptr) {
+					const auto first = vertices + command.DrawIndexed.BaseVertex;
+					_regions.push_back(Region{ _frame, first,
+						std::vector<VertexPositionColorTexture>(first, first + command.DrawIndexed.PrimitiveCount * 2) });
+					++Regions;
+				}
+			}
+
+			return HeadlessBackend::Execute(commandList);
+		}
+
+	private:
+		struct Region {
+			ulongcs Frame;
+			VertexPositionColorTexture const* Data;
+			std::vector<VertexPositionColorTexture> Copy;
+		};
+
+		void check() {
+			for (auto& region : _regions) {
+				if (std::memcmp(region.Data, region.Copy.data(), region.Copy.size() * sizeof(VertexPositionColorTexture)) != 0) {
+					++Overwritten;
+					//Counted once.
+					std::memcpy(region.Copy.data(), region.Data, region.Copy.size() * sizeof(VertexPositionColorTexture));
+				}
+			}
+		}
+
+		ulongcs _framesInFlight;
+		ulongcs _frame{ 0 };
+		std::deque<Region> _regions;
+	};
+
+	void SpriteBatchTests(Runner& runner) {
+		runner.Run("SpriteBatch reuses the ring only after its frames retire", [&](Context& context) {
+			constexpr ulongcs FramesInFlight = 3;
+			constexpr intcs RingCapacity = 100;
+
+			auto backend = std::make_shared<InFlightBackend>(FramesInFlight);
+			auto device = std::make_shared<GraphicsDevice>(backend);
+			device->Viewport(Viewport(0, 0, 320, 240));
+
+			const auto first = std::make_shared<Texture2D>(device, 8, 8);
+			const auto second = std::make_shared<Texture2D>(device, 8, 8);
+
+			SpriteBatch spriteBatch(device, RingCapacity);
+			spriteBatch.FramesInFlight(FramesInFlight);
+
+			//Every frame draws its sprites at other positions, so a reused region always changes.
+			const auto frame = [&](intcs index, intcs sprites, intcs batches) {
+				device->BeginFrame();
+
+				for (intcs batch = 0; batch < batches; ++batch) {
+					spriteBatch.Begin();
+
+					for (intcs i = 0; i < sprites; ++i) {
+						const auto position = Vector2(static_cast<float>(index * 7 + batch), static_cast<float>(i));
+						spriteBatch.Draw(i % 2 == 0 ? first : second, position, Colors::White);
+					}
+
+					spriteBatch.End();
+				}
+
+				device->Present();
+			};
+
+			//Three frames of 30 sprites fit the ring, so it wraps and is reused without growing.
+			for (intcs i = 0; i < 12; ++i)
+				frame(i, 30, 1);
+
+			DXNA_CHECK(spriteBatch.RingCapacity() == RingCapacity);
+			DXNA_CHECK(spriteBatch.Statistics().Sprites == 12 * 30);
+
+			//Three frames of two 15-sprite batches also fit.
+			for (intcs i = 12; i < 20; ++i)
+				frame(i, 15, 2);
+
+			DXNA_CHECK(spriteBatch.RingCapacity() == RingCapacity);
+
+			//Three frames of 60 do not: the batch moves to a larger ring and keeps the old one for its frames.
+			for (intcs i = 20; i < 30; ++i)
+				frame(i, 60, 1);
+
+			DXNA_CHECK(spriteBatch.RingCapacity() > RingCapacity);
+
+			const auto& statistics = backend->Statistics();
+			DXNA_CHECK(backend->Regions > 0);
+			DXNA_CHECK(backend->Overwritten == 0);
+			DXNA_CHECK(statistics.Errors == 0);
+			DXNA_CHECK(statistics.Draws == backend->Regions);
+			DXNA_CHECK(statistics.Primitives == 2 * spriteBatch.Statistics().Sprites);
+		});
+
+		runner.Run("SpriteBatch reuses the ring at once with one frame in flight", [&](Context& context) {
+			auto backend = std::make_shared<InFlightBackend>(1);
+			auto device = std::make_shared<GraphicsDevice>(backend);
+			device->Viewport(Viewport(0, 0, 320, 240));
+
+			const auto texture = std::make_shared<Texture2D>(device, 8, 8);
+			SpriteBatch spriteBatch(device, 64);
+			spriteBatch.FramesInFlight(1);
+
+			for (intcs i = 0; i < 10; ++i) {
+				device->BeginFrame();
+				spriteBatch.Begin();
+
+				for (intcs s = 0; s < 64; ++s)
+					spriteBatch.Draw(texture, Vector2(static_cast<float>(i), static_cast<float>(s)), Colors::White);
+
+				spriteBatch.End();
+				device->Present();
+			}
+
+			DXNA_CHECK(spriteBatch.RingCapacity() == 64);
+			DXNA_CHECK(backend->Overwritten == 0);
+			DXNA_CHECK(backend->Statistics().Errors == 0);
+		});
+	}
+}
@@ -0,0 +1,107 @@
+#ifndef DXNA_TESTS_TEST_HPP
+#define DXNA_TESTS_TEST_HPP
+
+#include <cstdio>
+#include <string>
+
+namespace dxna::test {
+	//The checks of one test. A test fails when any of its checks fails, and keeps running
+	//so one run reports every failed check.
+	class Context {
+	public:
+		bool Check(bool condition, char const* expression, char const* file, int line) {
+			if (!condition) {
+				std::printf("    %s:%d: %s\n", file, line, expression);
+				++_failures;
+			}
+
+			return condition;
+		}
+
+		size_t Failures() const { return _failures; }
+
+	private:
+		size_t _failures{ 0 };
+	};
+
+	//Runs the tests whose name contains the filter and counts the failed ones.
+	class Runner {
+	public:
+		//Only the tests whose name contains the filter are run. Empty runs all.
+		void Filter(std::string const& value) { _filter = value; }
+
+		//Tests with reference data write it instead of comparing with it.
+		void Update(bool value) { _update = value; }
+
+		bool Update() const { return _update; }
+
+		template <typename TFunc>
+		void Run(std::string const& name, TFunc&& func) {
+			if (!_filter.empty() && name.find(_filter) == std::string::npos)
+				return;
+
+			Context context;
+			func(context);
+
+			++_count;
+
+			if (context.Failures() > 0)
+				++_failed;
+
+			std::printf("%-60s %s\n", name.c_str(), context.Failures() == 0 ? "ok" : "FAILED");
+		}
+
+		size_t Count() const { return _count; }
+
+		size_t Failed() const { return _failed; }
+
+	private:
+		std::string _filter;
+		bool _update{ false };
+		size_t _count{ 0 };
+		size_t _failed{ 0 };
+	};
+
+	void ActionMapTests(Runner& runner);
+
+	void AnimationTests(Runner& runner);
+
+	void CurveTests(Runner& runner);
+
+	void EventBusTests(Runner& runner);
+
+	void EventTests(Runner& runner);
+
+	void GameTests(Runner& runner);
+
+	void GamePadTests(Runner& runner);
+
+	void HandlePoolTests(Runner& runner);
+
+	void HeadlessGameWindowTests(Runner& runner);
+
+	void InputTests(Runner& runner);
+
+	void JobSystemTests(Runner& runner);
+
+	void MemoryArenaTests(Runner& runner);
+
+	void PixelConverterTests(Runner& runner);
+
+	void ProfilerTests(Runner& runner);
+
+	void RenderQueueTests(Runner& runner);
+
+	void ResourceRegistryTests(Runner& runner);
+
+	void SoftwareBackendTests(Runner& runner);
+
+	void SpriteBatchTests(Runner& runner);
+
+	void TextureTests(Runner& runner);
+}
+
+//Checks a condition inside a test and records the expression if it is false.
+#define DXNA_CHECK(condition) context.Check((condition), #condition, __FILE__, __LINE__)
+
+#endif
\ No newline at end of file
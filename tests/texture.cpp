@@ -0,0 +1,184 @@
+#include "test.hpp"
+#include "../src/graphics/graphics.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace dxna::graphics;
+
+namespace dxna::test {
+	static bool near(float value, float expected) {
+		return std::fabs(value - expected) < 1e-5F;
+	}
+
+	//Reads a whole level as colors.
+	static std::vector<Color> levelColors(Texture2D const& texture, intcs level) {
+		std::vector<Color> colors(static_cast<size_t>(texture.LevelWidth(level)) * texture.LevelHeight(level));
+		texture.GetData(level, cs::Nullable<Rectangle>(), colors.data(), colors.size());
+		return colors;
+	}
+
+	void TextureTests(Runner& runner) {
+		runner.Run("Texture2D halves each level of the mip chain down to 1x1", [&](Context& context) {
+			struct Chain {
+				intcs Width;
+				intcs Height;
+				std::vector<std::pair<intcs, intcs>> Levels;
+			};
+
+			const std::vector<Chain> chains = {
+				{ 16, 16, { { 16, 16 }, { 8, 8 }, { 4, 4 }, { 2, 2 }, { 1, 1 } } },
+				{ 5, 3, { { 5, 3 }, { 2, 1 }, { 1, 1 } } },
+				{ 3, 7, { { 3, 7 }, { 1, 3 }, { 1, 1 } } },
+				{ 100, 1, { { 100, 1 }, { 50, 1 }, { 25, 1 }, { 12, 1 }, { 6, 1 }, { 3, 1 }, { 1, 1 } } },
+				{ 1, 1, { { 1, 1 } } },
+			};
+
+			for (const auto& chain : chains) {
+				Texture2D texture(nullptr, chain.Width, chain.Height, true);
+				DXNA_CHECK(texture.LevelCount() == static_cast<intcs>(chain.Levels.size()));
+
+				if (texture.LevelCount() != static_cast<intcs>(chain.Levels.size()))
+					continue;
+
+				bool sized = true;
+				size_t total = 0;
+
+				for (intcs level = 0; level < texture.LevelCount(); ++level) {
+					const auto& [width, height] = chain.Levels[level];
+					sized = sized && texture.LevelWidth(level) == width && texture.LevelHeight(level) == height
+						&& texture.LevelSize(level) == static_cast<size_t>(width) * height * 4
+						&& reinterpret_cast<std::uintptr_t>(texture.LevelData(level)) % 64 == 0;
+
+					total += (texture.LevelSize(level) + 63) & ~static_cast<size_t>(63);
+				}
+
+				DXNA_CHECK(sized && texture.SizeInBytes() == total);
+			}
+
+			DXNA_CHECK(Texture2D(nullptr, 16, 16).LevelCount() == 1);
+			DXNA_CHECK(Texture2D(nullptr, 5, 3, true, SurfaceFormat::Vector4).LevelSize(1) == 2 * 16);
+		});
+
+		runner.Run("Texture2D converts colors to and from its format", [&](Context& context) {
+			//Rows of five texels leave a tail after the SIMD loops.
+			std::vector<Color> colors;
+
+			for (intcs i = 0; i < 15; ++i)
+				colors.push_back(Color(i * 17, 255 - i * 3, i * 5 + 1, 128 + i));
+
+			Texture2D bgra(nullptr, 5, 3, false, SurfaceFormat::Bgra32);
+			DXNA_CHECK(!bgra.SetData(colors.data(), colors.size()).HasError());
+
+			std::vector<uintcs> raw(colors.size());
+			DXNA_CHECK(!bgra.GetData(raw.data(), raw.size()).HasError());
+			DXNA_CHECK(raw[7] == Color(colors[7].B(), colors[7].G(), colors[7].R(), colors[7].A()).PackedValue());
+			DXNA_CHECK(levelColors(bgra, 0) == colors);
+
+			Texture2D vector(nullptr, 5, 3, false, SurfaceFormat::Vector4);
+			DXNA_CHECK(!vector.SetData(colors.data(), colors.size()).HasError());
+
+			std::vector<Vector4> floats(colors.size());
+			DXNA_CHECK(!vector.GetData(floats.data(), floats.size()).HasError());
+			DXNA_CHECK(near(floats[14].X, colors[14].R() / 255.0F) && near(floats[14].W, colors[14].A() / 255.0F));
+			DXNA_CHECK(levelColors(vector, 0) == colors);
+
+			//Only the texel size of the format is taken as raw data.
+			DXNA_CHECK(vector.SetData(raw.data(), raw.size()) == ErrorCode::GRAPHICS_INVALID_ELEMENT_SIZE);
+		});
+
+		runner.Run("Texture2D averages 2x2 blocks with the box filter", [&](Context& context) {
+			Texture2D texture(nullptr, 4, 4, true);
+			std::vector<Color> colors;
+
+			for (intcs i = 0; i < 16; ++i)
+				colors.push_back(Color(i * 16, 255 - i * 16, 10, 255));
+
+			texture.SetData(colors.data(), colors.size());
+			texture.GenerateMipmaps();
+
+			//Red of the four blocks: (0 + 16 + 64 + 80) / 4, and so on.
+			DXNA_CHECK((levelColors(texture, 1) == std::vector<Color>{
+				Color(40, 215, 10, 255), Color(72, 183, 10, 255), Color(168, 87, 10, 255), Color(200, 55, 10, 255) }));
+
+			DXNA_CHECK((levelColors(texture, 2) == std::vector<Color>{ Color(120, 135, 10, 255) }));
+
+			//Level 0 is left as it is.
+			DXNA_CHECK(levelColors(texture, 0) == colors);
+		});
+
+		runner.Run("Texture2D weighs the texels a box covers in part at odd sizes", [&](Context& context) {
+			//Five texels into two: each covers two and a half.
+			Texture2D row(nullptr, 5, 1, true, SurfaceFormat::Vector4);
+			std::vector<Vector4> texels;
+
+			for (intcs i = 0; i < 5; ++i)
+				texels.push_back(Vector4(static_cast<float>(i)));
+
+			row.SetData(texels.data(), texels.size());
+			row.GenerateMipmaps();
+
+			std::vector<Vector4> level(2);
+			row.GetData(1, cs::Nullable<Rectangle>(), level.data(), level.size());
+			DXNA_CHECK(near(level[0].X, (0 + 1 + 0.5F * 2) / 2.5F) && near(level[1].X, (0.5F * 2 + 3 + 4) / 2.5F));
+
+			row.GetData(2, cs::Nullable<Rectangle>(), level.data(), 1);
+			DXNA_CHECK(near(level[0].X, 2.0F) && near(level[0].W, 2.0F));
+
+			//Nine texels into one.
+			Texture2D square(nullptr, 3, 3, true, SurfaceFormat::Vector4);
+			texels.clear();
+
+			for (intcs i = 0; i < 9; ++i)
+				texels.push_back(Vector4(static_cast<float>(i)));
+
+			square.SetData(texels.data(), texels.size());
+			square.GenerateMipmaps();
+			square.GetData(1, cs::Nullable<Rectangle>(), level.data(), 1);
+			DXNA_CHECK(square.LevelCount() == 2 && near(level[0].Y, 4.0F));
+		});
+
+		runner.Run("Texture2D drops the levels whose texels are evicted during GenerateMipmaps", [&](Context& context) {
+			Texture2D texture(nullptr, 128, 128, true);
+			const std::vector<Color> colors(128 * 128, Color(200, 100, 50, 255));
+			bool evicted = true;
+			bool cleared = true;
+
+			//A generation left alone sets how long the others take. The eviction lands at a later
+			//point of each of them: before the texels are read, then while the levels are filtered.
+			//Wherever it lands, the texture stays evicted and no level is written after it.
+			texture.SetData(colors.data(), colors.size());
+			const auto start = std::chrono::steady_clock::now();
+			texture.GenerateMipmaps(MipmapFilter::Kaiser);
+			const auto duration = std::chrono::steady_clock::now() - start;
+
+			for (intcs attempt = 0; attempt < 8; ++attempt) {
+				texture.SetData(colors.data(), colors.size());
+
+				std::thread generator([&] { texture.GenerateMipmaps(MipmapFilter::Kaiser); });
+				std::this_thread::sleep_for(duration * attempt / 8);
+				texture.Evict();
+				generator.join();
+
+				evicted = evicted && texture.IsEvicted();
+
+				//Loading level 0 back clears the other levels.
+				texture.SetData(colors.data(), colors.size());
+
+				for (intcs level = 1; level < texture.LevelCount(); ++level) {
+					for (const auto& color : levelColors(texture, level))
+						cleared = cleared && color == Color(0U);
+				}
+			}
+
+			DXNA_CHECK(evicted && cleared);
+
+			//Once evicted, there is nothing to generate from.
+			texture.Evict();
+			texture.GenerateMipmaps();
+			DXNA_CHECK(texture.IsEvicted());
+		});
+	}
+}